@@ -34,8 +34,11 @@
  *********************/
 
 /* Test the graphical performance of your MCU
- * with different settings*/
+ * with different settings. Off on the controller,
+ * turned on by the host render benchmark*/
+#ifndef LV_USE_BENCHMARK
 #define LV_USE_BENCHMARK   0
+#endif
 
 /*A demo application with Keyboard, Text area, List and Chart
  * placed on Tab view */
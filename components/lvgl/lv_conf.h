@@ -52,6 +52,13 @@
  * Can be changed in the display driver (`lv_disp_drv_t`).*/
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 
+/* Default fixed cost of a flush, as the number of pixels refreshed in the same time.
+ * Invalidated areas are refreshed together when it is cheaper than refreshing them apart.
+ * At 40 MHz the ILI9341 takes 0.4 us a pixel, and the window commands and the setup
+ * of a flush about 160 us.
+ * Can be changed in the display driver (`lv_disp_drv_t`). 0: join only overlapping areas*/
+#define LV_DISP_DEF_FLUSH_COST       400     /*[px]*/
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -61,6 +61,12 @@
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 #endif
 
+/* Default fixed cost of a flush, as the number of pixels refreshed in the same time.
+ * Can be changed in the display driver (`lv_disp_drv_t`). 0: join only overlapping areas*/
+#ifndef LV_DISP_DEF_FLUSH_COST
+#define LV_DISP_DEF_FLUSH_COST       0       /*[px]*/
+#endif
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -34,6 +34,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static uint32_t lv_refr_get_area_cost(const lv_area_t * area_p);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
@@ -183,8 +184,9 @@ void lv_disp_refr_task(lv_task_t * task)
             /* With true double buffering the flushing should be only the address change of the
              * current frame buffer. Wait until the address change is ready and copy the changed
              * content to the other frame buffer (new active VDB) to keep the buffers synchronized*/
-            while(vdb->flushing)
-                ;
+            while(vdb->flushing) {
+                if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+            }
 
             uint8_t * buf_act = (uint8_t *)vdb->buf_act;
             uint8_t * buf_ina = (uint8_t *)vdb->buf_act == vdb->buf1 ? vdb->buf2 : vdb->buf1;
@@ -244,16 +246,13 @@ static void lv_refr_join_area(void)
                 continue;
             }
 
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
-
             lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
+            /*Join two area only if refreshing the joined area is cheaper.
+             *Without flush cost only areas on each other can be joined: the joined area of two
+             *separate areas is never smaller than them*/
+            if(lv_refr_get_area_cost(&joined_area) < (lv_refr_get_area_cost(&disp_refr->inv_areas[join_in]) +
+                                                      lv_refr_get_area_cost(&disp_refr->inv_areas[join_from]))) {
                 lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
                 /*Mark 'join_form' is joined into 'join_in'*/
@@ -263,6 +262,29 @@ static void lv_refr_join_area(void)
     }
 }
 
+/**
+ * Get the cost of refreshing an area: its pixels plus the fixed cost of every flush it is sent in
+ * @param area_p pointer to an area
+ * @return the cost of the area in pixels (see `flush_cost` in `lv_disp_drv_t`)
+ */
+static uint32_t lv_refr_get_area_cost(const lv_area_t * area_p)
+{
+    uint32_t cost = lv_area_get_size(area_p);
+
+    /*With true double buffering the screen is flushed once whatever the areas are*/
+    if(disp_refr->driver.flush_cost == 0 || lv_disp_is_true_double_buf(disp_refr)) return cost;
+
+    /*The area is flushed in parts of as many full rows as fit into the VDB (see `lv_refr_area`)*/
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    uint32_t h          = lv_area_get_height(area_p);
+    uint32_t max_row    = vdb->size / lv_area_get_width(area_p);
+    if(max_row == 0) max_row = 1;
+
+    cost += ((h + max_row - 1) / max_row) * disp_refr->driver.flush_cost;
+
+    return cost;
+}
+
 /**
  * Refresh the joined areas
  */
@@ -379,8 +401,9 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     /*In non double buffered mode, before rendering the next part wait until the previous image is
      * flushed*/
     if(lv_disp_is_double_buf(disp_refr) == false) {
-        while(vdb->flushing)
-            ;
+        while(vdb->flushing) {
+            if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+        }
     }
 
     lv_obj_t * top_p;
@@ -564,8 +587,9 @@ static void lv_refr_vdb_flush(void)
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
      * one*/
     if(lv_disp_is_double_buf(disp_refr)) {
-        while(vdb->flushing)
-            ;
+        while(vdb->flushing) {
+            if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+        }
     }
 
     vdb->flushing = 1;
@@ -62,6 +62,7 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->buffer           = NULL;
     driver->rotated          = 0;
     driver->color_chroma_key = LV_COLOR_TRANSP;
+    driver->flush_cost       = LV_DISP_DEF_FLUSH_COST;
 
 #if LV_ANTIALIAS
     driver->antialiasing = true;
@@ -98,6 +98,10 @@ typedef struct _disp_drv_t
      * number of flushed pixels */
     void (*monitor_cb)(struct _disp_drv_t * disp_drv, uint32_t time, uint32_t px);
 
+    /** OPTIONAL: Called periodically while lvgl waits for a flush to be finished.
+     * E.g. to block the task until the flush is ready instead of spinning */
+    void (*wait_cb)(struct _disp_drv_t * disp_drv);
+
 #if LV_USE_GPU
     /** OPTIONAL: Blend two memories using opacity (GPU only)*/
     void (*gpu_blend_cb)(struct _disp_drv_t * disp_drv, lv_color_t * dest, const lv_color_t * src, uint32_t length,
@@ -108,6 +112,13 @@ typedef struct _disp_drv_t
                         const lv_area_t * fill_area, lv_color_t color);
 #endif
 
+    /** Fixed cost of a flush (sending the window commands, starting the transfer, finding the
+     * objects to draw...) as the number of pixels refreshed in the same time.
+     * Invalidated areas are refreshed together when it is cheaper than refreshing them apart.
+     * 0: join only the areas on each other whose joined area is smaller.
+     * `LV_DISP_DEF_FLUSH_COST` by default. (lv_conf.h)*/
+    uint16_t flush_cost;
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_TRANSP` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
@@ -44,6 +44,8 @@ static void lv_chart_draw_axes(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_inv_lines(lv_obj_t * chart, uint16_t i);
 static void lv_chart_inv_points(lv_obj_t * chart, uint16_t i);
 static void lv_chart_inv_cols(lv_obj_t * chart, uint16_t i);
+static void lv_chart_get_point_range(lv_obj_t * chart, const lv_area_t * mask, lv_coord_t pad, uint16_t * first,
+                                     uint16_t * last);
 
 /**********************
  *  STATIC VARIABLES
@@ -419,6 +421,33 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
     }
 }
 
+/**
+ * Set the value of a point of a data series, and redraw only the area around it
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param y the new value of the point
+ * @param id the index of the point in the `points` array of the series
+ */
+void lv_chart_set_point_id(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y, uint16_t id)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(id >= ext->point_cnt) return;
+
+    ser->points[id] = y;
+
+    /*In shift mode the points are drawn from `start_point`*/
+    uint16_t i = id;
+    if(ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT) {
+        i = (id + ext->point_cnt - ser->start_point) % ext->point_cnt;
+    }
+
+    if(ext->type & LV_CHART_TYPE_LINE) lv_chart_inv_lines(chart, i);
+    if(ext->type & LV_CHART_TYPE_COLUMN) lv_chart_inv_cols(chart, i);
+    if(ext->type & LV_CHART_TYPE_POINT) lv_chart_inv_points(chart, i);
+    if(ext->type & LV_CHART_TYPE_VERTICAL_LINE) lv_chart_inv_lines(chart, i);
+    if(ext->type & LV_CHART_TYPE_AREA) lv_chart_inv_lines(chart, i);
+}
+
 /**
  * Set update mode of the chart object.
  * @param chart pointer to a chart object
@@ -738,6 +767,8 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
 
     uint16_t i;
+    uint16_t first;
+    uint16_t last;
     lv_point_t p1;
     lv_point_t p2;
     lv_coord_t w     = lv_obj_get_width(chart);
@@ -754,6 +785,10 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
     style.line.opa   = ext->series.opa;
     style.line.width = ext->series.width;
 
+    /*Only the lines reaching into the mask are drawn, so redrawing a few columns of a streaming
+     * chart doesn't depend on the number of points*/
+    lv_chart_get_point_range(chart, mask, ext->series.width + LV_ANTIALIAS, &first, &last);
+
     /*Go through all data lines*/
     LV_LL_READ_BACK(ext->series_ll, ser)
     {
@@ -762,14 +797,14 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
         lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
 
         p1.x = 0 + x_ofs;
-        p2.x = 0 + x_ofs;
+        p2.x = (first == 0 ? 0 : ((w * first) / (ext->point_cnt - 1))) + x_ofs;
 
-        p_prev = start_point;
+        p_prev = (start_point + first) % ext->point_cnt;
         y_tmp  = (int32_t)((int32_t)ser->points[p_prev] - ext->ymin) * h;
         y_tmp  = y_tmp / (ext->ymax - ext->ymin);
         p2.y   = h - y_tmp + y_ofs;
 
-        for(i = 1; i < ext->point_cnt; i++) {
+        for(i = first + 1; i <= last; i++) {
             p1.x = p2.x;
             p1.y = p2.y;
 
@@ -799,6 +834,8 @@ static void lv_chart_draw_points(lv_obj_t * chart, const lv_area_t * mask)
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
 
     uint16_t i;
+    uint16_t first;
+    uint16_t last;
     lv_area_t cir_a;
     lv_coord_t w     = lv_obj_get_width(chart);
     lv_coord_t h     = lv_obj_get_height(chart);
@@ -816,6 +853,9 @@ static void lv_chart_draw_points(lv_obj_t * chart, const lv_area_t * mask)
     style_point.body.opa          = ext->series.opa;
     style_point.body.radius       = ext->series.width;
 
+    /*Only the points reaching into the mask are drawn*/
+    lv_chart_get_point_range(chart, mask, style_point.body.radius + LV_ANTIALIAS, &first, &last);
+
     /*Go through all data lines*/
 
     LV_LL_READ_BACK(ext->series_ll, ser)
@@ -825,7 +865,7 @@ static void lv_chart_draw_points(lv_obj_t * chart, const lv_area_t * mask)
         style_point.body.main_color = ser->color;
         style_point.body.grad_color = lv_color_mix(LV_COLOR_BLACK, ser->color, ext->series.dark);
 
-        for(i = 0; i < ext->point_cnt; i++) {
+        for(i = first; i <= last; i++) {
             cir_a.x1 = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
             cir_a.x2 = cir_a.x1 + style_point.body.radius;
             cir_a.x1 -= style_point.body.radius;
@@ -982,6 +1022,8 @@ static void lv_chart_draw_areas(lv_obj_t * chart, const lv_area_t * mask)
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
 
     uint16_t i;
+    uint16_t first;
+    uint16_t last;
     lv_point_t p1;
     lv_point_t p2;
     lv_coord_t w     = lv_obj_get_width(chart);
@@ -996,6 +1038,9 @@ static void lv_chart_draw_areas(lv_obj_t * chart, const lv_area_t * mask)
     lv_style_t style;
     lv_style_copy(&style, &lv_style_plain);
 
+    /*Only the areas under the lines reaching into the mask are drawn*/
+    lv_chart_get_point_range(chart, mask, LV_ANTIALIAS, &first, &last);
+
     /*Go through all data lines*/
     LV_LL_READ_BACK(ext->series_ll, ser)
     {
@@ -1003,14 +1048,14 @@ static void lv_chart_draw_areas(lv_obj_t * chart, const lv_area_t * mask)
         style.body.main_color  = ser->color;
         style.body.opa         = ext->series.opa;
 
-        p2.x = 0 + x_ofs;
+        p2.x = (first == 0 ? 0 : ((w * first) / (ext->point_cnt - 1))) + x_ofs;
 
-        p_prev = start_point;
+        p_prev = (start_point + first) % ext->point_cnt;
         y_tmp  = (int32_t)((int32_t)ser->points[p_prev] - ext->ymin) * h;
         y_tmp  = y_tmp / (ext->ymax - ext->ymin);
         p2.y   = h - y_tmp + y_ofs;
 
-        for(i = 1; i < ext->point_cnt; i++) {
+        for(i = first + 1; i <= last; i++) {
             p1.x = p2.x;
             p1.y = p2.y;
 
@@ -1334,4 +1379,40 @@ static void lv_chart_inv_cols(lv_obj_t * chart, uint16_t i)
     lv_inv_area(lv_obj_get_disp(chart), &col_a);
 }
 
+/**
+ * Get the range of points whose drawing can reach into an area.
+ * The x coordinate of the point `i` (in drawing order) is `(w * i) / (point_cnt - 1)`.
+ * @param chart pointer to chart object
+ * @param mask the area being drawn
+ * @param pad how far the drawing of a point, or of the line from it, reaches past its x coordinate
+ * @param first pointer to store the first point to draw (in drawing order)
+ * @param last pointer to store the last point to draw (in drawing order)
+ */
+static void lv_chart_get_point_range(lv_obj_t * chart, const lv_area_t * mask, lv_coord_t pad, uint16_t * first,
+                                     uint16_t * last)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    lv_coord_t w         = lv_obj_get_width(chart);
+    int32_t x1           = (int32_t)mask->x1 - chart->coords.x1 - pad;
+    int32_t x2           = (int32_t)mask->x2 - chart->coords.x1 + pad;
+    int32_t i1;
+    int32_t i2;
+
+    *first = 0;
+    *last  = ext->point_cnt - 1;
+
+    if(ext->point_cnt < 2 || w <= 0) return;
+
+    /*The last point at the left of the area and the first one at its right are included too, the
+     * lines from them cross it*/
+    i1 = x1 <= 0 ? 0 : (x1 * (ext->point_cnt - 1)) / w;
+    i2 = x2 < 0 ? 0 : ((x2 * (ext->point_cnt - 1)) / w) + 1;
+
+    if(i1 > *last) i1 = *last;
+    if(i2 > *last) i2 = *last;
+
+    *first = (uint16_t)i1;
+    *last  = (uint16_t)i2;
+}
+
 #endif
@@ -220,6 +220,15 @@ void lv_chart_set_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y
  */
 void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y);
 
+/**
+ * Set the value of a point of a data series, and redraw only the area around it
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param y the new value of the point
+ * @param id the index of the point in the `points` array of the series
+ */
+void lv_chart_set_point_id(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y, uint16_t id);
+
 /**
  * Set update mode of the chart object.
  * @param chart pointer to a chart object
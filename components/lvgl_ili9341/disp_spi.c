@@ -20,6 +20,12 @@
 /*********************
  *      DEFINES
  *********************/
+/*Transactions of the ring, room for two whole flushes: 3 commands, 2 data, colors.
+ *A power of 2*/
+#define DISP_SPI_RING_SIZE 16
+
+/*Longest time to block for a flush in `disp_spi_wait`, before checking again*/
+#define DISP_SPI_WAIT_TIMEOUT_MS 100
 
 /**********************
  *      TYPEDEFS
@@ -28,14 +34,21 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void IRAM_ATTR spi_pre_transfer (spi_transaction_t *trans);
 static void IRAM_ATTR spi_ready (spi_transaction_t *trans);
+static void spi_collect_results(void);
+static spi_transaction_t * spi_take_trans(uint32_t flags);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static spi_device_handle_t spi;
-static volatile bool spi_trans_in_progress;
-static volatile bool spi_color_sent;
+static SemaphoreHandle_t flush_done_sem;
+
+/*Transactions being sent, read by the SPI driver until their results are collected*/
+static spi_transaction_t trans_ring[DISP_SPI_RING_SIZE];
+static uint8_t trans_next;              /*Next slot of the ring to take*/
+static uint8_t trans_queued;            /*Transactions queued and not collected yet*/
 
 /**********************
  *      MACROS
@@ -62,8 +75,8 @@ void disp_spi_init(void)
             .clock_speed_hz=40*1000*1000,           //Clock out at 40 MHz
             .mode=0,                                //SPI mode 0
             .spics_io_num=DISP_SPI_CS,              //CS pin
-            .queue_size=1,
-            .pre_cb=NULL,
+            .queue_size=DISP_SPI_RING_SIZE,
+            .pre_cb=spi_pre_transfer,
             .post_cb=spi_ready,
             .flags = SPI_DEVICE_HALFDUPLEX
     };
@@ -75,55 +88,131 @@ void disp_spi_init(void)
     //Attach the LCD to the SPI bus
     ret=spi_bus_add_device(VSPI_HOST, &devcfg, &spi);
     assert(ret==ESP_OK);
+
+    flush_done_sem = xSemaphoreCreateBinary();
+    assert(flush_done_sem != NULL);
 }
 
-void disp_spi_send_data(uint8_t * data, uint16_t length)
+/**
+ * Send a command or its parameters, and wait until they are sent.
+ * Only for the initialization, when no flush is in progress.
+ * @param data bytes to send
+ * @param length number of bytes
+ * @param flags `DISP_SPI_DC_DATA` for parameters, 0 for a command
+ */
+void disp_spi_send_data(uint8_t * data, uint16_t length, uint32_t flags)
 {
     if (length == 0) return;           //no need to send anything
 
-    while(spi_trans_in_progress);
-
     spi_transaction_t t = {
         .length = length * 8, // transaction length is in bits
-        .tx_buffer = data
+        .tx_buffer = data,
+        .user = (void *)flags
     };
 
-    spi_trans_in_progress = true;
-    spi_color_sent = false;             //Mark the "lv_flush_ready" NOT needs to be called in "spi_ready"
-    spi_device_queue_trans(spi, &t, portMAX_DELAY);
+    spi_device_polling_transmit(spi, &t);
+}
+
+/**
+ * Queue a command or its parameters, and return without waiting for them.
+ * @param data bytes to send, copied
+ * @param length number of bytes, up to 4
+ * @param flags `DISP_SPI_DC_DATA` for parameters, 0 for a command
+ */
+void disp_spi_queue_data(const uint8_t * data, uint8_t length, uint32_t flags)
+{
+    if(length == 0 || length > 4) return;
+
+    spi_transaction_t * t = spi_take_trans(flags);
+
+    t->flags = SPI_TRANS_USE_TXDATA;
+    t->length = length * 8;
+    memcpy(t->tx_data, data, length);
 
+    spi_device_queue_trans(spi, t, portMAX_DELAY);
 }
 
-void disp_spi_send_colors(uint8_t * data, uint16_t length)
+/**
+ * Queue the colors of a flush, and return without waiting for them.
+ * lvgl is told the flush is ready once they are sent, until then they must stay untouched.
+ * @param data colors to send
+ * @param length number of bytes
+ */
+void disp_spi_queue_colors(const void * data, uint32_t length)
 {
-    if (length == 0) return;           //no need to send anything
+    spi_transaction_t * t = spi_take_trans(DISP_SPI_DC_DATA | DISP_SPI_FLUSH_READY);
 
-    while(spi_trans_in_progress);
+    t->length = length * 8;
+    t->tx_buffer = data;
 
-    spi_transaction_t t = {
-        .length = length * 8, // transaction length is in bits
-        .tx_buffer = data
-    };
-    
-    spi_trans_in_progress = true;
-    spi_color_sent = true;              //Mark the "lv_flush_ready" needs to be called in "spi_ready"
-    spi_device_queue_trans(spi, &t, portMAX_DELAY);
+    spi_device_queue_trans(spi, t, portMAX_DELAY);
 }
 
+/**
+ * Block until a flush is ready. To be called by lvgl while it waits for a flush,
+ * so the CPU is left to other tasks instead of spinning.
+ */
+void disp_spi_wait(void)
+{
+    xSemaphoreTake(flush_done_sem, pdMS_TO_TICKS(DISP_SPI_WAIT_TIMEOUT_MS));
+}
 
 bool disp_spi_is_busy(void)
 {
-    return spi_trans_in_progress;
+    spi_collect_results();
+    return trans_queued != 0;
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+static void IRAM_ATTR spi_pre_transfer (spi_transaction_t *trans)
+{
+    gpio_set_level(ILI9341_DC, ((uint32_t)trans->user & DISP_SPI_DC_DATA) ? 1 : 0);
+}
+
 static void IRAM_ATTR spi_ready (spi_transaction_t *trans)
 {
-    spi_trans_in_progress = false;
+    BaseType_t task_woken = pdFALSE;
+
+    if((uint32_t)trans->user & DISP_SPI_FLUSH_READY) {
+        lv_disp_t * disp = lv_refr_get_disp_refreshing();
+        lv_disp_flush_ready(&disp->driver);
+
+        xSemaphoreGiveFromISR(flush_done_sem, &task_woken);
+        if(task_woken == pdTRUE) portYIELD_FROM_ISR();
+    }
+}
+
+static void spi_collect_results(void)
+{
+    spi_transaction_t * trans;
+
+    while(trans_queued != 0 && spi_device_get_trans_result(spi, &trans, 0) == ESP_OK) {
+        trans_queued--;
+    }
+}
+
+/*Take the next slot of the ring. Transactions complete in order, so once collected the
+ *oldest slot is free. The ring only fills up if lvgl queued more than two flushes*/
+static spi_transaction_t * spi_take_trans(uint32_t flags)
+{
+    spi_transaction_t * trans;
+
+    spi_collect_results();
+
+    if(trans_queued == DISP_SPI_RING_SIZE) {
+        spi_device_get_trans_result(spi, &trans, portMAX_DELAY);
+        trans_queued--;
+    }
+
+    trans = &trans_ring[trans_next];
+    trans_next = (trans_next + 1) & (DISP_SPI_RING_SIZE - 1);
+    trans_queued++;
+
+    memset(trans, 0, sizeof(spi_transaction_t));
+    trans->user = (void *)flags;
 
-    lv_disp_t * disp = lv_refr_get_disp_refreshing();
-    if(spi_color_sent) lv_disp_flush_ready(&disp->driver);
+    return trans;
 }
@@ -24,6 +24,10 @@ extern "C" {
 #define DISP_SPI_CLK CONFIG_LVGL_DISP_SPI_CLK
 #define DISP_SPI_CS CONFIG_LVGL_DISP_SPI_CS
 
+/*Flags of a transaction, in its `user` field*/
+#define DISP_SPI_DC_DATA     0x01   /*DC pin high: parameters or colors. Low: a command*/
+#define DISP_SPI_FLUSH_READY 0x02   /*Last transaction of a flush*/
+
 
 /**********************
  *      TYPEDEFS
@@ -33,8 +37,10 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 void disp_spi_init(void);
-void disp_spi_send_data(uint8_t * data, uint16_t length);
-void disp_spi_send_colors(uint8_t * data, uint16_t length);
+void disp_spi_send_data(uint8_t * data, uint16_t length, uint32_t flags);
+void disp_spi_queue_data(const uint8_t * data, uint8_t length, uint32_t flags);
+void disp_spi_queue_colors(const void * data, uint32_t length);
+void disp_spi_wait(void);
 bool disp_spi_is_busy(void);
 
 /**********************
@@ -15,6 +15,9 @@
 /*********************
  *      DEFINES
  *********************/
+#define ILI9341_CMD_CASET 0x2A  /*Column address set*/
+#define ILI9341_CMD_PASET 0x2B  /*Page address set*/
+#define ILI9341_CMD_RAMWR 0x2C  /*Memory write*/
 
 /**********************
  *      TYPEDEFS
@@ -32,11 +35,13 @@ typedef struct {
  **********************/
 static void ili9341_send_cmd(uint8_t cmd);
 static void ili9341_send_data(void * data, uint16_t length);
-static void ili9341_send_color(void * data, uint16_t length);
+static void ili9341_queue_range(uint8_t cmd, lv_coord_t start, lv_coord_t end);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*Window of the last flush, -1 until the first one. Ranges kept by the display aren't sent again*/
+static lv_area_t flush_window = {-1, -1, -1, -1};
 
 /**********************
  *      MACROS
@@ -116,31 +121,29 @@ void ili9341_init(void)
 
 void ili9341_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map)
 {
-	uint8_t data[4];
-
-	/*Column addresses*/
-	ili9341_send_cmd(0x2A);
-	data[0] = (area->x1 >> 8) & 0xFF;
-	data[1] = area->x1 & 0xFF;
-	data[2] = (area->x2 >> 8) & 0xFF;
-	data[3] = area->x2 & 0xFF;
-	ili9341_send_data(data, 4);
+	uint8_t cmd = ILI9341_CMD_RAMWR;
+	uint32_t size = lv_area_get_width(area) * lv_area_get_height(area);
 
-	/*Page addresses*/
-	ili9341_send_cmd(0x2B);
-	data[0] = (area->y1 >> 8) & 0xFF;
-	data[1] = area->y1 & 0xFF;
-	data[2] = (area->y2 >> 8) & 0xFF;
-	data[3] = area->y2 & 0xFF;
-	ili9341_send_data(data, 4);
+	/*The window setup and the colors are queued at once, and sent while lvgl renders
+	 *into the other buffer. `lv_disp_flush_ready` is called once the colors are sent.
+	 *Full width strips and areas of the same rows only need the range that changed*/
+	if(area->x1 != flush_window.x1 || area->x2 != flush_window.x2) {
+		ili9341_queue_range(ILI9341_CMD_CASET, area->x1, area->x2);
+	}
 
-	/*Memory write*/
-	ili9341_send_cmd(0x2C);
+	if(area->y1 != flush_window.y1 || area->y2 != flush_window.y2) {
+		ili9341_queue_range(ILI9341_CMD_PASET, area->y1, area->y2);
+	}
 
+	lv_area_copy(&flush_window, area);
 
-	uint32_t size = lv_area_get_width(area) * lv_area_get_height(area);
+	disp_spi_queue_data(&cmd, 1, 0);
+	disp_spi_queue_colors(color_map, size * 2);
+}
 
-	ili9341_send_color((void*)color_map, size * 2);
+void ili9341_wait(lv_disp_drv_t * drv)
+{
+	disp_spi_wait();
 }
 
 void ili9341_enable_backlight(bool backlight)
@@ -166,28 +169,23 @@ void ili9341_enable_backlight(bool backlight)
 
 static void ili9341_send_cmd(uint8_t cmd)
 {
-	  while(disp_spi_is_busy()) {
-			taskYIELD();
-		};
-	  gpio_set_level(ILI9341_DC, 0);	 /*Command mode*/
-	  disp_spi_send_data(&cmd, 1);
+	disp_spi_send_data(&cmd, 1, 0);
 }
 
 static void ili9341_send_data(void * data, uint16_t length)
 {
-	  while(disp_spi_is_busy()) {
-			taskYIELD();
-		};
-	  gpio_set_level(ILI9341_DC, 1);	 /*Data mode*/
-	  disp_spi_send_data(data, length);
+	disp_spi_send_data(data, length, DISP_SPI_DC_DATA);
 }
 
-static void ili9341_send_color(void * data, uint16_t length)
+static void ili9341_queue_range(uint8_t cmd, lv_coord_t start, lv_coord_t end)
 {
-		while(disp_spi_is_busy()) {
-			taskYIELD();
-		};
-    gpio_set_level(ILI9341_DC, 1);   /*Data mode*/
-    disp_spi_send_colors(data, length);
-}
+	uint8_t data[4];
+
+	data[0] = (start >> 8) & 0xFF;
+	data[1] = start & 0xFF;
+	data[2] = (end >> 8) & 0xFF;
+	data[3] = end & 0xFF;
 
+	disp_spi_queue_data(&cmd, 1, 0);
+	disp_spi_queue_data(data, 4, DISP_SPI_DC_DATA);
+}
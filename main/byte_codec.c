@@ -0,0 +1,170 @@
+/*!
+ *******************************************************************************
+ * @file byte_codec.c
+ *
+ * @brief Little endian fields and CRC-16 shared by the binary formats of the
+ *        firmware: profile snapshots, programs, run log, event captures and
+ *        telemetry frames
+ *
+ * Fields are written byte by byte, so the buffers don't need any alignment and
+ * the formats don't depend on the byte order of the CPU.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "byte_codec.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief CRC-16/CCITT-FALSE parameters
+#define CRC16_POLYNOMIAL                    (0x1021)
+#define CRC16_INITIAL_VALUE                 (0xFFFF)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Compute the CRC-16/CCITT-FALSE of a buffer
+ *
+ * @param[in]           p_buffer            Buffer to compute the CRC of
+ * @param[in]           size                Size of the buffer
+ *
+ * @return              uint16_t            CRC of the buffer
+ */
+uint16_t byte_codec_crc16(uint8_t const * const p_buffer, size_t const size)
+{
+        uint16_t crc = CRC16_INITIAL_VALUE;
+        size_t i;
+        uint8_t bit;
+
+        for (i = 0; (NULL != p_buffer) && (size > i); i++) {
+                crc ^= (uint16_t)(p_buffer[i] << 8);
+
+                for (bit = 0; 8 > bit; bit++) {
+                        if (0 != (crc & 0x8000)) {
+                                crc = (uint16_t)((crc << 1) ^ CRC16_POLYNOMIAL);
+                        } else {
+                                crc = (uint16_t)(crc << 1);
+                        }
+                }
+        }
+
+        return crc;
+}
+
+/*!
+ * @brief Write a little endian 16 bit value
+ *
+ * @param[out]          p_buffer            Where to write the value
+ * @param[in]           value               Value to write
+ *
+ * @return              -                   -
+ */
+void byte_codec_put_u16(uint8_t * const p_buffer, uint16_t const value)
+{
+        p_buffer[0] = (uint8_t)(value & 0xFF);
+        p_buffer[1] = (uint8_t)(value >> 8);
+}
+
+/*!
+ * @brief Read a little endian 16 bit value
+ *
+ * @param[in]           p_buffer            Where to read the value from
+ *
+ * @return              uint16_t            Value read
+ */
+uint16_t byte_codec_get_u16(uint8_t const * const p_buffer)
+{
+        return (uint16_t)(p_buffer[0] | (p_buffer[1] << 8));
+}
+
+/*!
+ * @brief Write a little endian 32 bit value
+ *
+ * @param[out]          p_buffer            Where to write the value
+ * @param[in]           value               Value to write
+ *
+ * @return              -                   -
+ */
+void byte_codec_put_u32(uint8_t * const p_buffer, uint32_t const value)
+{
+        byte_codec_put_u16(&p_buffer[0], (uint16_t)value);
+        byte_codec_put_u16(&p_buffer[2], (uint16_t)(value >> 16));
+}
+
+/*!
+ * @brief Read a little endian 32 bit value
+ *
+ * @param[in]           p_buffer            Where to read the value from
+ *
+ * @return              uint32_t            Value read
+ */
+uint32_t byte_codec_get_u32(uint8_t const * const p_buffer)
+{
+        return ((uint32_t)byte_codec_get_u16(&p_buffer[0]) |
+                ((uint32_t)byte_codec_get_u16(&p_buffer[2]) << 16));
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,75 @@
+/*!
+ *******************************************************************************
+ * @file byte_codec.h
+ *
+ * @brief Little endian fields and CRC-16 shared by the binary formats of the
+ *        firmware: profile snapshots, programs, run log, event captures and
+ *        telemetry frames
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef BYTE_CODEC_H
+#define BYTE_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Compute the CRC-16/CCITT-FALSE of a buffer
+uint16_t byte_codec_crc16(uint8_t const * const p_buffer, size_t const size);
+
+//! @brief Write a little endian 16 bit value
+void byte_codec_put_u16(uint8_t * const p_buffer, uint16_t const value);
+
+//! @brief Read a little endian 16 bit value
+uint16_t byte_codec_get_u16(uint8_t const * const p_buffer);
+
+//! @brief Write a little endian 32 bit value
+void byte_codec_put_u32(uint8_t * const p_buffer, uint32_t const value);
+
+//! @brief Read a little endian 32 bit value
+uint32_t byte_codec_get_u32(uint8_t const * const p_buffer);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //BYTE_CODEC_H
@@ -25,6 +25,38 @@
 #define CONFIGURATION_THERMOCOUPLE_COUNT    (1)
 #define CONFIGURATION_WDT_TIMEOUT_S         (3)
 
+//! @brief Save the capture of the last state machine events when erroring out
+#define CONFIGURATION_CAPTURE_SAVE_ON_ERROR (1)
+
+//! @brief Temperature in Celsius assumed at the start of a run when it isn't
+//!        measured, such as for the trajectory of a profile not running yet
+#define CONFIGURATION_AMBIENT_TEMPERATURE_C         (25)
+
+//! @brief Profile changes are written to NVS once none came for this long...
+#define CONFIGURATION_PROFILE_FLUSH_IDLE_MS         (2000)
+
+//! @brief ...or once the oldest of them waited for this long
+#define CONFIGURATION_PROFILE_FLUSH_MAX_DELAY_MS    (10000)
+
+//! @brief Size in bytes of the profile console receive buffer, enough to
+//!        queue a whole catalogue of `PUT` requests sent back to back
+#define CONFIGURATION_PROFILE_CONSOLE_RX_BUFFER_SIZE (1024)
+
+//! @brief Size in bytes of the profile console transmit buffer, enough for a
+//!        whole catalogue listing to be sent without blocking
+#define CONFIGURATION_PROFILE_CONSOLE_TX_BUFFER_SIZE (1024)
+
+//! @brief Period of the telemetry stream at boot, in milliseconds. 0 keeps
+//!        it off until requested over the console
+#define CONFIGURATION_TELEMETRY_PERIOD_MS           (0)
+
+//! @brief A hold is settled once the temperature stays within this many
+//!        Celsius of its target
+#define CONFIGURATION_RUN_SETTLING_BAND_C           (3)
+
+//! @brief Number of run summaries kept in NVS, older ones are replaced
+#define CONFIGURATION_RUN_HISTORY_CNT               (8)
+
 /*
  *******************************************************************************
  * Public Data Types                                                           *
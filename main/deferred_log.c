@@ -0,0 +1,351 @@
+/*!
+ *******************************************************************************
+ * @file deferred_log.c
+ *
+ * @brief Logging for hot paths: records are stored as a format and its
+ *        arguments, and formatted later by a task at the idle priority
+ *
+ * `ESP_LOGx` formats its message and writes it out on the stack of the
+ * caller, under the lock of the log, which takes tens of microseconds and
+ * can block. `DEFERRED_LOGx` instead stores a record: the address of its
+ * format, its timestamp and up to `DEFERRED_LOG_ARGS_MAX` integer arguments.
+ *
+ * Each core has a ring of records of its own (see `deferred_log_ring`), so
+ * producers on different cores never touch the same counters, and producers
+ * on the same core never wait for each other. A task at the idle priority
+ * formats the records of both rings and writes them out through `esp_log`,
+ * in the same format as `ESP_LOGx`. When it lags behind, records are dropped
+ * and counted instead.
+ *
+ * The average cost of a call, and of the formatting it saves, are measured in
+ * CPU cycles and can be read with `deferred_log_get_stats`.
+ *
+ * @note Records are printed by the task some time after they were made, but
+ *       with the time they were made at. Records still in the rings are lost
+ *       on a panic, so errors leading to one should still use `ESP_LOGx`.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_cpu.h"
+#include "esp_log.h"
+
+#include "deferred_log_ring.h"
+#include "deferred_log.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Formatter task priority, runs when nothing else does
+#define DEFERRED_LOG_TASK_PRIORITY          (tskIDLE_PRIORITY)
+
+//! @brief Period the formatter task empties the rings at
+#define DEFERRED_LOG_FLUSH_PERIOD_MS        (50)
+
+//! @brief Size of a formatted message, longer ones are cut
+#define DEFERRED_LOG_MESSAGE_SIZE           (96)
+
+//! @brief Weight of the last call in the average costs, as a power of 2
+#define DEFERRED_LOG_AVERAGE_SHIFT          (4)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+//! @brief Letter of each level, as printed by `ESP_LOGx`
+static char const m_level_letters[] = {'N', 'E', 'W', 'I', 'D', 'V'};
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Move an average cost towards a new sample
+static void update_average(uint32_t * const p_average, uint32_t const sample);
+
+//! @brief Format a record and write it out
+static void output_record(deferred_log_record_t const * const p_record);
+
+//! @brief Deferred log formatter task
+static void deferred_log_task(void * pvParameters);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Whether the module is initialized or not
+static bool m_is_initialized = false;
+
+//! @brief Formatter task handle
+static TaskHandle_t m_deferred_log_task_h = NULL;
+
+//! @brief Records waiting to be formatted, one ring per core
+static deferred_log_ring_t m_rings[portNUM_PROCESSORS];
+
+//! @brief Average cost of a call on each core. Calls preempting each other
+//!        may lose an update, which doesn't matter to an average
+static uint32_t m_write_cycles[portNUM_PROCESSORS];
+
+//! @brief Average cost of formatting a record, only used by the task
+static uint32_t m_format_cycles = 0;
+
+//! @brief Number of records formatted, only written by the task
+static uint32_t m_record_count = 0;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize the deferred log
+ *
+ * Records made before are dropped.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Module already initialized or
+ *                                          couldn't create the task
+ */
+bool deferred_log_init(void)
+{
+        BaseType_t result;
+        size_t i;
+        bool success = !m_is_initialized;
+
+        for (i = 0; (success) && (portNUM_PROCESSORS > i); i++) {
+                success = deferred_log_ring_init(&m_rings[i]);
+        }
+
+        if (success) {
+                result = xTaskCreate(deferred_log_task,
+                                     "deferred_log_task",
+                                     configMINIMAL_STACK_SIZE * 3,
+                                     NULL,
+                                     DEFERRED_LOG_TASK_PRIORITY,
+                                     &m_deferred_log_task_h);
+
+                success = (pdPASS == result);
+        }
+
+        if (success) {
+                m_is_initialized = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Store a record, to be formatted later
+ *
+ * Use it through the `DEFERRED_LOGx` macros. Records are dropped if the
+ * module isn't initialized or the ring of the core is full.
+ *
+ * @param[in]           p_format            Format of the record, static
+ * @param[in]           p_args              Arguments of the format
+ * @param[in]           arg_count           Number of arguments, the ones past
+ *                                          `DEFERRED_LOG_ARGS_MAX` are ignored
+ *
+ * @return              -                   -
+ */
+void deferred_log_write(deferred_log_format_t const * const p_format,
+                        int32_t const * const p_args,
+                        size_t const arg_count)
+{
+        uint32_t const start_cycles = esp_cpu_get_ccount();
+        BaseType_t const core = xPortGetCoreID();
+        deferred_log_record_t record;
+        size_t i;
+
+        if (m_is_initialized) {
+                record.p_format = p_format;
+                record.time_ms = esp_log_timestamp();
+                record.arg_count = (uint8_t)((DEFERRED_LOG_ARGS_MAX < arg_count) ?
+                                             DEFERRED_LOG_ARGS_MAX : arg_count);
+
+                for (i = 0; DEFERRED_LOG_ARGS_MAX > i; i++) {
+                        record.args[i] = ((record.arg_count > i) ? p_args[i] : 0);
+                }
+
+                (void)deferred_log_ring_push(&m_rings[core], &record);
+
+                update_average(&m_write_cycles[core],
+                               esp_cpu_get_ccount() - start_cycles);
+        }
+}
+
+/*!
+ * @brief Get the cost of the records, and the number of them dropped
+ *
+ * The cycles saved on every call are the difference of both costs.
+ *
+ * @param[out]          p_stats             Pointer where to store the costs
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer or module not
+ *                                          initialized
+ */
+bool deferred_log_get_stats(deferred_log_stats_t * const p_stats)
+{
+        uint32_t write_cycles = 0;
+        uint32_t core_count = 0;
+        size_t i;
+        bool const success = ((NULL != p_stats) && (m_is_initialized));
+
+        if (success) {
+                p_stats->dropped_count = 0;
+
+                // Averaged over the cores that made any call
+                for (i = 0; portNUM_PROCESSORS > i; i++) {
+                        if (0 != m_write_cycles[i]) {
+                                write_cycles += m_write_cycles[i];
+                                core_count++;
+                        }
+
+                        p_stats->dropped_count +=
+                                deferred_log_ring_get_dropped_count(&m_rings[i]);
+                }
+
+                p_stats->write_cycles = ((0 != core_count) ?
+                                         (write_cycles / core_count) : 0);
+                p_stats->format_cycles = m_format_cycles;
+                p_stats->record_count = m_record_count;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Move an average cost towards a new sample
+ *
+ * @param[in,out]       p_average           Pointer to the average
+ * @param[in]           sample              New sample
+ *
+ * @return              -                   -
+ */
+static void update_average(uint32_t * const p_average, uint32_t const sample)
+{
+        int32_t const difference = (int32_t)(sample - *p_average);
+
+        // The first sample is taken as is
+        *p_average = ((0 == *p_average) ?
+                      sample :
+                      (uint32_t)((int32_t)*p_average +
+                                 (difference >> DEFERRED_LOG_AVERAGE_SHIFT)));
+}
+
+/*!
+ * @brief Format a record and write it out
+ *
+ * @param[in]           p_record            Pointer to the record
+ *
+ * @return              -                   -
+ */
+static void output_record(deferred_log_record_t const * const p_record)
+{
+        uint32_t const start_cycles = esp_cpu_get_ccount();
+        deferred_log_format_t const * const p_format = p_record->p_format;
+        char message[DEFERRED_LOG_MESSAGE_SIZE];
+
+        // Arguments past the ones the format takes are ignored
+        (void)snprintf(message, sizeof(message), p_format->p_format,
+                       p_record->args[0], p_record->args[1],
+                       p_record->args[2], p_record->args[3]);
+
+        esp_log_write(p_format->level, p_format->p_tag, "%c (%u) %s: %s\n",
+                      m_level_letters[p_format->level],
+                      p_record->time_ms,
+                      p_format->p_tag,
+                      message);
+
+        update_average(&m_format_cycles, esp_cpu_get_ccount() - start_cycles);
+        m_record_count++;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Deferred log formatter task
+ *
+ * Wakes up periodically and empties the rings, taking a record from each core
+ * in turn.
+ *
+ * @param               pvParameters        Not used
+ *
+ * @return              -                   -
+ */
+static void deferred_log_task(void * pvParameters)
+{
+        deferred_log_record_t record;
+        bool is_taken;
+        size_t i;
+
+        (void)pvParameters;
+
+        for (;;) {
+                vTaskDelay(pdMS_TO_TICKS(DEFERRED_LOG_FLUSH_PERIOD_MS));
+
+                do {
+                        is_taken = false;
+
+                        for (i = 0; portNUM_PROCESSORS > i; i++) {
+                                if (deferred_log_ring_pop(&m_rings[i], &record)) {
+                                        output_record(&record);
+                                        is_taken = true;
+                                }
+                        }
+                } while (is_taken);
+        }
+}
@@ -0,0 +1,122 @@
+/*!
+ *******************************************************************************
+ * @file deferred_log.h
+ *
+ * @brief Logging for hot paths: records are stored as a format and its
+ *        arguments, and formatted later by a task at the idle priority
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include "esp_log.h"
+#include "deferred_log_ring.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Log a record without formatting it
+ *
+ * Same as `ESP_LOGx`, but the format is only referenced and the arguments only
+ * copied, up to `DEFERRED_LOG_ARGS_MAX` of them. The format must only take
+ * integer arguments, such as `%d`, `%u` or `%x`.
+ */
+#define DEFERRED_LOG(level, tag, format, ...)                                   \
+        do {                                                                    \
+                static deferred_log_format_t const deferred_log_format = {      \
+                        (level), (tag), (format)                                \
+                };                                                              \
+                int32_t const deferred_log_args[] = {0, ##__VA_ARGS__};         \
+                deferred_log_write(&deferred_log_format,                        \
+                                   &deferred_log_args[1],                       \
+                                   (sizeof(deferred_log_args) /                 \
+                                    sizeof(deferred_log_args[0])) - 1);         \
+        } while (0)
+
+#define DEFERRED_LOGE(tag, format, ...)                                         \
+        DEFERRED_LOG(ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+#define DEFERRED_LOGW(tag, format, ...)                                         \
+        DEFERRED_LOG(ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+#define DEFERRED_LOGI(tag, format, ...)                                         \
+        DEFERRED_LOG(ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Format of a record, its identifier is its address
+typedef struct {
+        //! @brief Level of the record
+        esp_log_level_t level;
+
+        //! @brief Tag of the record
+        char const * p_tag;
+
+        //! @brief `printf` format, taking only integer arguments
+        char const * p_format;
+} deferred_log_format_t;
+
+//! @brief Cost of the records
+typedef struct {
+        //! @brief Average CPU cycles taken by a call, storing the record
+        uint32_t write_cycles;
+
+        //! @brief Average CPU cycles taken to format and output a record, as
+        //!        a call to `ESP_LOGx` used to take
+        uint32_t format_cycles;
+
+        //! @brief Number of records formatted
+        uint32_t record_count;
+
+        //! @brief Number of records dropped because the task lagged behind
+        uint32_t dropped_count;
+} deferred_log_stats_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize the deferred log
+bool deferred_log_init(void);
+
+//! @brief Store a record, to be formatted later
+void deferred_log_write(deferred_log_format_t const * const p_format,
+                        int32_t const * const p_args,
+                        size_t const arg_count);
+
+//! @brief Get the cost of the records, and the number of them dropped
+bool deferred_log_get_stats(deferred_log_stats_t * const p_stats);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //DEFERRED_LOG_H
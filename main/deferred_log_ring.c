@@ -0,0 +1,235 @@
+/*!
+ *******************************************************************************
+ * @file deferred_log_ring.c
+ *
+ * @brief Lock-free ring of log records, between any number of producers and
+ *        a single consumer
+ *
+ * Producers can be preempted by other producers at any point, so each of
+ * them first claims a position by moving the head forward with a compare and
+ * swap, then writes the record in the slot of the position, and last marks
+ * the slot as written by moving its sequence one past the position. The
+ * consumer only reads a slot once marked, and hands it back for the next
+ * turn around the ring by moving its sequence one ring size forward.
+ *
+ * No producer ever waits for another one, nor for the consumer: when the slot
+ * of the head is still taken the ring is full, and the record is dropped and
+ * counted. A producer preempted between its claim and its mark only holds the
+ * consumer back, not other producers.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "deferred_log_ring.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Mask turning a position into an index
+#define INDEX_MASK                          (DEFERRED_LOG_RING_SIZE - 1)
+
+#if (0 != (DEFERRED_LOG_RING_SIZE & INDEX_MASK))
+#error "DEFERRED_LOG_RING_SIZE must be a power of 2"
+#endif
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Empty a ring
+ *
+ * @note Not to be called while the ring is in use
+ *
+ * @param[out]          p_ring              Pointer to the ring
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool deferred_log_ring_init(deferred_log_ring_t * const p_ring)
+{
+        uint32_t i;
+        bool const success = (NULL != p_ring);
+
+        if (success) {
+                (void)memset(p_ring, 0, sizeof(*p_ring));
+
+                for (i = 0; DEFERRED_LOG_RING_SIZE > i; i++) {
+                        p_ring->slots[i].sequence = i;
+                }
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Add a record to the ring, from any producer
+ *
+ * @param[in,out]       p_ring              Pointer to the ring
+ * @param[in]           p_record            Pointer to the record
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, or the ring
+ *                                          was full and the record was dropped
+ */
+bool deferred_log_ring_push(deferred_log_ring_t * const p_ring,
+                            deferred_log_record_t const * const p_record)
+{
+        deferred_log_ring_slot_t * p_slot = NULL;
+        uint32_t position = 0;
+        int32_t turn;
+        bool is_claimed = false;
+        bool success = ((NULL != p_ring) && (NULL != p_record));
+
+        if (success) {
+                position = __atomic_load_n(&p_ring->head, __ATOMIC_RELAXED);
+        }
+
+        while ((success) && (!is_claimed)) {
+                p_slot = &p_ring->slots[position & INDEX_MASK];
+                turn = (int32_t)(__atomic_load_n(&p_slot->sequence, __ATOMIC_ACQUIRE) -
+                                 position);
+
+                if (0 == turn) {
+                        // On failure, position is updated to the current head
+                        is_claimed = __atomic_compare_exchange_n(&p_ring->head,
+                                                                 &position,
+                                                                 position + 1,
+                                                                 true,
+                                                                 __ATOMIC_RELAXED,
+                                                                 __ATOMIC_RELAXED);
+                } else if (0 > turn) {
+                        // Not read yet since the previous turn around
+                        (void)__atomic_fetch_add(&p_ring->dropped_count, 1,
+                                                 __ATOMIC_RELAXED);
+                        success = false;
+                } else {
+                        // Claimed by another producer since the head was read
+                        position = __atomic_load_n(&p_ring->head, __ATOMIC_RELAXED);
+                }
+        }
+
+        if (success) {
+                p_slot->record = *p_record;
+                __atomic_store_n(&p_slot->sequence, position + 1, __ATOMIC_RELEASE);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Take the oldest record from the ring, from the consumer
+ *
+ * @param[in,out]       p_ring              Pointer to the ring
+ * @param[out]          p_record            Pointer where to store the record
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If a record was taken
+ * @retval              False               If a pointer is null, the ring is
+ *                                          empty or its oldest record is still
+ *                                          being written
+ */
+bool deferred_log_ring_pop(deferred_log_ring_t * const p_ring,
+                           deferred_log_record_t * const p_record)
+{
+        deferred_log_ring_slot_t * p_slot = NULL;
+        uint32_t position = 0;
+        bool success = ((NULL != p_ring) && (NULL != p_record));
+
+        if (success) {
+                position = p_ring->tail;
+                p_slot = &p_ring->slots[position & INDEX_MASK];
+                success = ((position + 1) ==
+                           __atomic_load_n(&p_slot->sequence, __ATOMIC_ACQUIRE));
+        }
+
+        if (success) {
+                *p_record = p_slot->record;
+                __atomic_store_n(&p_slot->sequence,
+                                 position + DEFERRED_LOG_RING_SIZE,
+                                 __ATOMIC_RELEASE);
+                p_ring->tail = position + 1;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the number of records dropped for lack of room
+ *
+ * @param[in]           p_ring              Pointer to the ring
+ *
+ * @return              uint32_t            Number of records dropped, 0 if
+ *                                          pointer is null
+ */
+uint32_t deferred_log_ring_get_dropped_count(deferred_log_ring_t const * const p_ring)
+{
+        return ((NULL != p_ring) ?
+                __atomic_load_n(&p_ring->dropped_count, __ATOMIC_RELAXED) : 0);
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
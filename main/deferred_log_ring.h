@@ -0,0 +1,114 @@
+/*!
+ *******************************************************************************
+ * @file deferred_log_ring.h
+ *
+ * @brief Lock-free ring of log records, between any number of producers and
+ *        a single consumer
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef DEFERRED_LOG_RING_H
+#define DEFERRED_LOG_RING_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Number of records the ring holds, a power of 2
+#define DEFERRED_LOG_RING_SIZE                          (32)
+
+//! @brief Largest number of arguments of a record
+#define DEFERRED_LOG_ARGS_MAX                           (4)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Log record, a format and its arguments, not formatted yet
+typedef struct {
+        //! @brief Identifier of the format, opaque to the ring
+        void const * p_format;
+
+        //! @brief Time of the record, in milliseconds
+        uint32_t time_ms;
+
+        //! @brief Number of arguments
+        uint8_t arg_count;
+
+        //! @brief Integer arguments of the format
+        int32_t args[DEFERRED_LOG_ARGS_MAX];
+} deferred_log_record_t;
+
+//! @brief Slot of the ring
+typedef struct {
+        //! @brief Turn of the slot: equal to its position when free, and one
+        //!        past it once its record is written
+        uint32_t sequence;
+
+        //! @brief Record
+        deferred_log_record_t record;
+} deferred_log_ring_slot_t;
+
+//! @brief Ring of records
+typedef struct {
+        //! @brief Slots, indexed by the positions modulo the size
+        deferred_log_ring_slot_t slots[DEFERRED_LOG_RING_SIZE];
+
+        //! @brief Position of the next record written, claimed by producers
+        uint32_t head;
+
+        //! @brief Position of the next record read, only used by the consumer
+        uint32_t tail;
+
+        //! @brief Number of records dropped for lack of room
+        uint32_t dropped_count;
+} deferred_log_ring_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Empty a ring
+bool deferred_log_ring_init(deferred_log_ring_t * const p_ring);
+
+//! @brief Add a record to the ring, from any producer
+bool deferred_log_ring_push(deferred_log_ring_t * const p_ring,
+                            deferred_log_record_t const * const p_record);
+
+//! @brief Take the oldest record from the ring, from the consumer
+bool deferred_log_ring_pop(deferred_log_ring_t * const p_ring,
+                           deferred_log_record_t * const p_record);
+
+//! @brief Get the number of records dropped for lack of room
+uint32_t deferred_log_ring_get_dropped_count(deferred_log_ring_t const * const p_ring);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //DEFERRED_LOG_RING_H
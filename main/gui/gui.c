@@ -19,15 +19,23 @@
  *******************************************************************************
  */
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "lvgl.h"
+#include "esp_log.h"
+#include "esp_timer.h"
 #include "elegance4.c"
 #include "state_machine/states/state_machine_states.h"
 #include "state_machine/state_machine.h"
 
 #include "gui.h"
 #include "gui/gui_ctrls/gui_ctrls_main.h"
+#include "gui/gui_ctrls/gui_ctrls_graph.h"
 #include "gui/gui_ctrls/gui_ctrls_profile.h"
 #include "gui/gui_views/gui_views_main.h"
+#include "gui/gui_views/gui_views_graph.h"
 #include "gui/gui_views/gui_views_profile.h"
 
 /*
@@ -36,6 +44,15 @@
  *******************************************************************************
  */
 
+#define TAG                                 __FILENAME__
+
+//! @brief Period the main and graph tabs look for a new temperature sample
+//!        at, no shorter than the display refresh period
+#define GUI_REFRESH_PERIOD_MS               (LV_DISP_DEF_REFR_PERIOD)
+
+//! @brief Period the refresh statistics are computed at
+#define GUI_STATS_PERIOD_MS                 (10000)
+
 /*
  *******************************************************************************
  * Data types                                                                  *
@@ -54,7 +71,11 @@
  *******************************************************************************
  */
 
-static void label_refresher_task(void * p_parameters);
+static void refresh_task(lv_task_t * p_task);
+
+static void stats_task(lv_task_t * p_task);
+
+static uint32_t get_idle_time_us(void);
 
 /*
  *******************************************************************************
@@ -73,6 +94,23 @@ static lv_obj_t * m_p_tab_1;
 static lv_obj_t * m_p_tab_2;
 static lv_obj_t * m_p_tab_3;
 
+//! @brief Refresh statistics of the last period
+static gui_refresh_stats_t m_stats;
+
+//! @brief Pixels sent to the display, refreshes and time spent on them since
+//!        the start of the period
+static uint32_t m_pixel_count = 0;
+static uint32_t m_refresh_count = 0;
+static uint32_t m_refresh_ms = 0;
+
+//! @brief Time the period started at
+static uint32_t m_stats_start_ms = 0;
+
+//! @brief Time and idle time of the core running the GUI at the start of the
+//!        period, in microseconds
+static int64_t m_stats_start_us = 0;
+static uint32_t m_idle_start_us = 0;
+
 /*
  *******************************************************************************
  * Public Function Bodies                                                      *
@@ -84,7 +122,14 @@ void gui_init(void)
         lv_obj_t * p_scr = lv_scr_act();
         lv_theme_t * p_theme;
 
-        lv_task_create(label_refresher_task, 10, LV_TASK_PRIO_MID, NULL);
+        lv_task_create(refresh_task,
+                       GUI_REFRESH_PERIOD_MS,
+                       LV_TASK_PRIO_MID,
+                       NULL);
+        lv_task_create(stats_task, GUI_STATS_PERIOD_MS, LV_TASK_PRIO_LOW, NULL);
+        m_stats_start_ms = lv_tick_get();
+        m_stats_start_us = esp_timer_get_time();
+        m_idle_start_us = get_idle_time_us();
 
         lv_style_copy(&m_style, &lv_style_plain);
         m_style.body.main_color = lv_color_hsv_to_rgb(210, 11, 30);
@@ -138,26 +183,143 @@ void gui_init(void)
         lv_tabview_set_btns_pos(m_p_tabview, LV_TABVIEW_BTNS_POS_TOP);
 
         gui_views_main(m_p_tab_1);
+        gui_views_graph(m_p_tab_2);
         gui_views_profile(m_p_tab_3);
 
         gui_ctrls_main_init();
+        gui_ctrls_graph_init();
         gui_ctrls_profile_init();
 }
 
+/*!
+ * @brief Account a display refresh, to be set as `monitor_cb` of the display
+ *        driver
+ *
+ * @param[in]           p_driver            Display driver, not used
+ * @param[in]           time_ms             Time taken to draw and send the
+ *                                          refreshed areas
+ * @param[in]           pixel_count         Number of pixels refreshed
+ *
+ * @return              -                   -
+ */
+void gui_monitor_cb(lv_disp_drv_t * p_driver,
+                    uint32_t time_ms,
+                    uint32_t pixel_count)
+{
+        (void)p_driver;
+
+        m_pixel_count += pixel_count;
+        m_refresh_count++;
+        m_refresh_ms += time_ms;
+}
+
+/*!
+ * @brief Get the display refresh statistics of the last period
+ *
+ * Updated every `GUI_STATS_PERIOD_MS`, all zero before.
+ *
+ * @param[out]          p_stats             Pointer where to store them
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool gui_get_refresh_stats(gui_refresh_stats_t * const p_stats)
+{
+        bool const success = (NULL != p_stats);
+
+        if (success) {
+                *p_stats = m_stats;
+        }
+
+        return success;
+}
+
 /*
  *******************************************************************************
  * Private Function Bodies                                                     *
  *******************************************************************************
  */
 
+/*!
+ * @brief Get the time the idle task of the calling core has run for
+ *
+ * @param               -                   -
+ *
+ * @return              uint32_t            Idle time in microseconds, wrapping
+ *                                          around, always 0 if FreeRTOS run
+ *                                          time stats are disabled
+ */
+static uint32_t get_idle_time_us(void)
+{
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        return ulTaskGetIdleRunTimeCounter();
+#else
+        return 0;
+#endif // #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+}
+
 /*
  *******************************************************************************
  * Interrupt Service Routines / Tasks / Thread Main Functions                  *
  *******************************************************************************
  */
 
-static void label_refresher_task(void * p_parameters)
+/*!
+ * @brief Show new temperature samples on the main and graph tabs
+ *
+ * @param               p_task              Not used
+ *
+ * @return              -                   -
+ */
+static void refresh_task(lv_task_t * p_task)
 {
+        (void)p_task;
+
         //TODO: if in tab main, then
         gui_ctrls_main_refresh();
-}
\ No newline at end of file
+        gui_ctrls_graph_refresh();
+}
+
+/*!
+ * @brief Compute the display refresh statistics of the period ended
+ *
+ * @param               p_task              Not used
+ *
+ * @return              -                   -
+ */
+static void stats_task(lv_task_t * p_task)
+{
+        uint32_t const elapsed_ms = lv_tick_elaps(m_stats_start_ms);
+        int64_t const now_us = esp_timer_get_time();
+        uint32_t const idle_us = get_idle_time_us();
+        uint32_t const elapsed_us = (uint32_t)(now_us - m_stats_start_us);
+
+        (void)p_task;
+
+        if (0 != elapsed_us) {
+                m_stats.idle_percent = (uint8_t)(((uint64_t)(idle_us - m_idle_start_us) * 100) /
+                                                 elapsed_us);
+        }
+
+        if (0 != elapsed_ms) {
+                m_stats.pixels_per_s = (uint32_t)(((uint64_t)m_pixel_count * 1000) /
+                                                  elapsed_ms);
+                m_stats.refreshes_per_s = ((m_refresh_count * 1000) / elapsed_ms);
+                m_stats.busy_percent = (uint8_t)((m_refresh_ms * 100) / elapsed_ms);
+
+                ESP_LOGD(TAG, "Display refresh: %u px/s, %u refreshes/s, %u%% busy, "
+                         "%u%% idle",
+                         m_stats.pixels_per_s,
+                         m_stats.refreshes_per_s,
+                         m_stats.busy_percent,
+                         m_stats.idle_percent);
+        }
+
+        m_pixel_count = 0;
+        m_refresh_count = 0;
+        m_refresh_ms = 0;
+        m_stats_start_ms = lv_tick_get();
+        m_stats_start_us = now_us;
+        m_idle_start_us = idle_us;
+}
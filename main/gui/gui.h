@@ -30,6 +30,22 @@
  *******************************************************************************
  */
 
+//! @brief Display refresh statistics over a period
+typedef struct {
+        //! @brief Pixels drawn and sent to the display per second
+        uint32_t pixels_per_s;
+
+        //! @brief Refreshes sending anything to the display per second
+        uint32_t refreshes_per_s;
+
+        //! @brief Share of the time spent drawing and sending them
+        uint8_t busy_percent;
+
+        //! @brief Share of the time the core running the GUI was idle, 0 if
+        //!        FreeRTOS run time stats are disabled
+        uint8_t idle_percent;
+} gui_refresh_stats_t;
+
 /*
  *******************************************************************************
  * Public Constants                                                            *
@@ -50,4 +66,13 @@ lv_style_t m_style_tv_btn_pr;
 
 void gui_init(void);
 
+//! @brief Account a display refresh, to be set as `monitor_cb` of the display
+//!        driver
+void gui_monitor_cb(lv_disp_drv_t * p_driver,
+                    uint32_t time_ms,
+                    uint32_t pixel_count);
+
+//! @brief Get the display refresh statistics of the last period
+bool gui_get_refresh_stats(gui_refresh_stats_t * const p_stats);
+
 #endif //GUI_H
\ No newline at end of file
@@ -0,0 +1,312 @@
+/*!
+ *******************************************************************************
+ * @file gui_chart_decimator.c
+ *
+ * @brief Min/max decimation of a chart series, computed as samples arrive
+ *
+ * A run of 10 minutes at 4 Hz is 2400 samples, for a chart some hundred
+ * pixels wide. Drawing one sample per column drops the rest, and a peak
+ * lasting one sample is lost or shows depending on where it falls. Drawing
+ * all of them costs as many lines as samples.
+ *
+ * Instead, the positions of the samples (e.g. their run time) are split in a
+ * fixed number of buckets, and each bucket keeps the lowest and highest
+ * sample falling in it. They are drawn as two chart points per bucket, in the
+ * order they were reached, so every peak shows and the series is drawn in a
+ * number of lines that only depends on the chart width.
+ *
+ * Adding a sample only updates its bucket. When a sample falls past the last
+ * bucket, buckets are merged in pairs, which doubles the positions each one
+ * spans: the whole series then has to be redrawn, but only once every time
+ * the history doubles.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "gui/gui_chart_decimator.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Merge the buckets in pairs, doubling the positions each one spans
+static void compact(gui_chart_decimator_t * const p_decimator);
+
+//! @brief Merge two consecutive buckets
+static void merge(gui_chart_decimator_bucket_t const * const p_earlier,
+                  gui_chart_decimator_bucket_t const * const p_later,
+                  gui_chart_decimator_bucket_t * const p_merged);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Empty a decimator
+ *
+ * @param[out]          p_decimator         Pointer to the decimator
+ * @param[in]           bucket_count        Number of buckets, half the number
+ *                                          of points of the chart series
+ * @param[in]           bucket_span         Number of positions each bucket
+ *                                          spans at first
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null, there are no
+ *                                          buckets or too many, or they span
+ *                                          nothing
+ */
+bool gui_chart_decimator_init(gui_chart_decimator_t * const p_decimator,
+                              uint16_t const bucket_count,
+                              uint32_t const bucket_span)
+{
+        bool const success = ((NULL != p_decimator) &&
+                              (0 != bucket_count) &&
+                              (GUI_CHART_DECIMATOR_BUCKETS_MAX >= bucket_count) &&
+                              (0 != bucket_span));
+
+        if (success) {
+                memset(p_decimator, 0, sizeof(*p_decimator));
+                p_decimator->bucket_count = bucket_count;
+                p_decimator->bucket_span = bucket_span;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Add a sample, and tell which buckets changed
+ *
+ * Buckets skipped since the last sample take its value, so the series has no
+ * gaps.
+ *
+ * @param[in,out]       p_decimator         Pointer to the decimator
+ * @param[in]           position            Position of the sample, from 0
+ * @param[in]           value               Value of the sample
+ * @param[out]          p_change            Pointer where to store which
+ *                                          buckets changed
+ * @param[out]          p_first_bucket      Pointer where to store the first
+ *                                          bucket changed, 0 if all of them
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null or the
+ *                                          decimator is not initialized
+ */
+bool gui_chart_decimator_add(gui_chart_decimator_t * const p_decimator,
+                             uint32_t const position,
+                             int16_t const value,
+                             gui_chart_decimator_change_t * const p_change,
+                             uint16_t * const p_first_bucket)
+{
+        gui_chart_decimator_bucket_t * p_bucket;
+        uint32_t bucket = 0;
+        bool is_compacted = false;
+        bool is_changed = false;
+        bool const success = ((NULL != p_decimator) &&
+                              (NULL != p_change) &&
+                              (NULL != p_first_bucket) &&
+                              (0 != p_decimator->bucket_count) &&
+                              (0 != p_decimator->bucket_span));
+
+        if (success) {
+                while ((position / p_decimator->bucket_span) >= p_decimator->bucket_count) {
+                        compact(p_decimator);
+                        is_compacted = true;
+                }
+
+                bucket = position / p_decimator->bucket_span;
+                *p_first_bucket = (uint16_t)((p_decimator->filled_count > bucket) ?
+                                             bucket : p_decimator->filled_count);
+
+                while (p_decimator->filled_count <= bucket) {
+                        p_bucket = &p_decimator->buckets[p_decimator->filled_count++];
+                        p_bucket->min = value;
+                        p_bucket->max = value;
+                        p_bucket->is_min_first = true;
+                        is_changed = true;
+                }
+
+                p_bucket = &p_decimator->buckets[bucket];
+
+                // The extreme reached last goes second
+                if (value > p_bucket->max) {
+                        p_bucket->max = value;
+                        p_bucket->is_min_first = true;
+                        is_changed = true;
+                } else if (value < p_bucket->min) {
+                        p_bucket->min = value;
+                        p_bucket->is_min_first = false;
+                        is_changed = true;
+                }
+
+                if (is_compacted) {
+                        *p_change = GUI_CHART_DECIMATOR_CHANGE_ALL;
+                        *p_first_bucket = 0;
+                } else if (is_changed) {
+                        *p_change = GUI_CHART_DECIMATOR_CHANGE_FROM;
+                } else {
+                        *p_change = GUI_CHART_DECIMATOR_CHANGE_NONE;
+                }
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the two chart points of a bucket, in the order they were reached
+ *
+ * @param[in]           p_decimator         Pointer to the decimator
+ * @param[in]           bucket              Index of the bucket
+ * @param[out]          p_first             Pointer where to store the extreme
+ *                                          reached first
+ * @param[out]          p_second            Pointer where to store the extreme
+ *                                          reached last
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null or the bucket
+ *                                          holds no samples
+ */
+bool gui_chart_decimator_get_points(gui_chart_decimator_t const * const p_decimator,
+                                    uint16_t const bucket,
+                                    int16_t * const p_first,
+                                    int16_t * const p_second)
+{
+        gui_chart_decimator_bucket_t const * p_bucket;
+        bool const success = ((NULL != p_decimator) &&
+                              (NULL != p_first) &&
+                              (NULL != p_second) &&
+                              (p_decimator->filled_count > bucket));
+
+        if (success) {
+                p_bucket = &p_decimator->buckets[bucket];
+
+                *p_first = (p_bucket->is_min_first ? p_bucket->min : p_bucket->max);
+                *p_second = (p_bucket->is_min_first ? p_bucket->max : p_bucket->min);
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Merge the buckets in pairs, doubling the positions each one spans
+ *
+ * @param[in,out]       p_decimator         Pointer to the decimator
+ *
+ * @return              -                   -
+ */
+static void compact(gui_chart_decimator_t * const p_decimator)
+{
+        uint16_t const filled_count = p_decimator->filled_count;
+        uint16_t i;
+
+        for (i = 0; filled_count > (2 * i); i++) {
+                if (filled_count > ((2 * i) + 1)) {
+                        merge(&p_decimator->buckets[2 * i],
+                              &p_decimator->buckets[(2 * i) + 1],
+                              &p_decimator->buckets[i]);
+                } else {
+                        p_decimator->buckets[i] = p_decimator->buckets[2 * i];
+                }
+        }
+
+        p_decimator->filled_count = i;
+        p_decimator->bucket_span *= 2;
+}
+
+/*!
+ * @brief Merge two consecutive buckets
+ *
+ * @param[in]           p_earlier           Pointer to the earlier bucket
+ * @param[in]           p_later             Pointer to the later bucket
+ * @param[out]          p_merged            Pointer where to store the merged
+ *                                          bucket, can be the earlier one
+ *
+ * @return              -                   -
+ */
+static void merge(gui_chart_decimator_bucket_t const * const p_earlier,
+                  gui_chart_decimator_bucket_t const * const p_later,
+                  gui_chart_decimator_bucket_t * const p_merged)
+{
+        bool const is_min_earlier = (p_earlier->min <= p_later->min);
+        bool const is_max_earlier = (p_earlier->max >= p_later->max);
+        gui_chart_decimator_bucket_t merged;
+
+        merged.min = (is_min_earlier ? p_earlier->min : p_later->min);
+        merged.max = (is_max_earlier ? p_earlier->max : p_later->max);
+
+        if (is_min_earlier == is_max_earlier) {
+                // Both extremes come from the same bucket, and keep its order
+                merged.is_min_first = (is_min_earlier ?
+                                       p_earlier->is_min_first :
+                                       p_later->is_min_first);
+        } else {
+                merged.is_min_first = is_min_earlier;
+        }
+
+        *p_merged = merged;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
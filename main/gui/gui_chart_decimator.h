@@ -0,0 +1,109 @@
+/*!
+ *******************************************************************************
+ * @file gui_chart_decimator.h
+ *
+ * @brief Min/max decimation of a chart series, computed as samples arrive
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef GUI_CHART_DECIMATOR_H
+#define GUI_CHART_DECIMATOR_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Number of buckets a decimator can hold at most
+#define GUI_CHART_DECIMATOR_BUCKETS_MAX                 (160)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Buckets changed by a sample
+typedef enum {
+        //! @brief None, the sample was within the extremes of its bucket
+        GUI_CHART_DECIMATOR_CHANGE_NONE = 0,
+
+        //! @brief The buckets from the one given to the last filled one
+        GUI_CHART_DECIMATOR_CHANGE_FROM,
+
+        //! @brief All of them, the buckets were merged to make room
+        GUI_CHART_DECIMATOR_CHANGE_ALL,
+} gui_chart_decimator_change_t;
+
+//! @brief Extremes of the samples falling in a bucket
+typedef struct {
+        int16_t min;
+        int16_t max;
+
+        //! @brief Whether the minimum was reached before the maximum
+        bool is_min_first;
+} gui_chart_decimator_bucket_t;
+
+//! @brief Decimator of a series
+typedef struct {
+        gui_chart_decimator_bucket_t buckets[GUI_CHART_DECIMATOR_BUCKETS_MAX];
+
+        //! @brief Number of buckets of the chart
+        uint16_t bucket_count;
+
+        //! @brief Number of buckets holding samples, from the first one
+        uint16_t filled_count;
+
+        //! @brief Number of positions each bucket spans
+        uint32_t bucket_span;
+} gui_chart_decimator_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Empty a decimator
+bool gui_chart_decimator_init(gui_chart_decimator_t * const p_decimator,
+                              uint16_t const bucket_count,
+                              uint32_t const bucket_span);
+
+//! @brief Add a sample, and tell which buckets changed
+bool gui_chart_decimator_add(gui_chart_decimator_t * const p_decimator,
+                             uint32_t const position,
+                             int16_t const value,
+                             gui_chart_decimator_change_t * const p_change,
+                             uint16_t * const p_first_bucket);
+
+//! @brief Get the two chart points of a bucket, in the order they were reached
+bool gui_chart_decimator_get_points(gui_chart_decimator_t const * const p_decimator,
+                                    uint16_t const bucket,
+                                    int16_t * const p_first,
+                                    int16_t * const p_second);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //GUI_CHART_DECIMATOR_H
@@ -0,0 +1,311 @@
+/*!
+ *******************************************************************************
+ * @file gui_ctrls_graph.c
+ *
+ * @brief Graph tab controller, streams the temperature of the run to the chart
+ *
+ * The chart spans the trajectory of the run, with some room left for it to
+ * run late, split in `GUI_GRAPH_BUCKET_COUNT` time buckets of two points each.
+ * When a run starts, the target of each point is looked up in the trajectory
+ * and the chart is redrawn once.
+ *
+ * Every temperature sample goes through a min/max decimator (see
+ * `gui_chart_decimator`), which keeps the lowest and highest sample of each
+ * bucket, so no peak is lost however many samples fall in one. Only the
+ * points of the buckets changed by a sample are written in place, and only
+ * the lines around them are redrawn and sent to the display. Runs longer than
+ * the chart have their buckets merged in pairs, and the chart is redrawn at
+ * half the time resolution.
+ *
+ * @note The areas invalidated while the tab is hidden are out of the screen,
+ *       and cost nothing to refresh
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+#include "reflow_profile.h"
+#include "reflow_program.h"
+#include "reflow_trajectory.h"
+#include "state_machine/states/state_machine_states.h"
+#include "state_machine/state_machine.h"
+#include "thermocouple.h"
+#include "gui/gui_chart_decimator.h"
+#include "gui/gui_views/gui_views_graph.h"
+#include "gui/gui_ctrls/gui_ctrls_graph.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Room left past the end of the trajectory, as a fraction of it
+#define GRAPH_LATE_FRACTION                 (8)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+static bool start_run(void);
+
+static void add_sample(uint32_t const run_time_ms, uint16_t const temperature);
+
+static void draw_target(void);
+
+static void draw_bucket(uint16_t const bucket);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Time of the last temperature sample drawn
+static uint32_t m_sample_time_ms = 0;
+
+//! @brief Whether any temperature sample was drawn yet
+static bool m_is_sample_shown = false;
+
+//! @brief Whether the chart was set up for the run in progress
+static bool m_is_run_started = false;
+
+//! @brief Temperature samples of the run in progress, in buckets
+static gui_chart_decimator_t m_decimator;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+void gui_ctrls_graph_init(void)
+{
+        m_is_sample_shown = false;
+        m_is_run_started = false;
+}
+
+/*!
+ * @brief Draw the last temperature sample of the run on the chart
+ *
+ * Does nothing until a new sample is taken. The last run stays on the chart
+ * until the next one starts.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+void gui_ctrls_graph_refresh(void)
+{
+        uint32_t sample_time_ms;
+        uint32_t run_time_ms;
+        uint16_t temperature;
+        bool success;
+
+        success = thermocouple_get_last_update_time(&sample_time_ms);
+
+        if (success) {
+                success = ((!m_is_sample_shown) ||
+                           (sample_time_ms != m_sample_time_ms));
+        }
+
+        if (success) {
+                m_sample_time_ms = sample_time_ms;
+                m_is_sample_shown = true;
+
+                // No run time outside of a run
+                success = state_machine_states_get_run_time(&run_time_ms);
+
+                if (!success) {
+                        m_is_run_started = false;
+                }
+        }
+
+        if ((success) && (!m_is_run_started)) {
+                success = start_run();
+        }
+
+        if (success) {
+                success = thermocouple_get_avg_temperature(&temperature);
+        }
+
+        if (success) {
+                add_sample(run_time_ms, temperature);
+        }
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Set the chart up for the run in progress
+ *
+ * Draws the target of the run and clears its temperature.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Couldn't get the trajectory
+ */
+static bool start_run(void)
+{
+        reflow_trajectory_t const * p_trajectory;
+        uint32_t span_ms = 0;
+        bool success = state_machine_states_get_trajectory(&p_trajectory);
+
+        if (success) {
+                span_ms = p_trajectory->duration_ms +
+                          (p_trajectory->duration_ms / GRAPH_LATE_FRACTION);
+
+                success = gui_chart_decimator_init(&m_decimator,
+                                                   GUI_GRAPH_BUCKET_COUNT,
+                                                   (span_ms / GUI_GRAPH_BUCKET_COUNT) + 1);
+        }
+
+        if (success) {
+                draw_target();
+                lv_chart_clear_serie(p_graph_chart, p_graph_temperature_series);
+
+                // The only time the whole chart is redrawn during a run,
+                // unless it runs past its end
+                lv_chart_refresh(p_graph_chart);
+
+                m_is_run_started = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Draw a temperature sample of the run
+ *
+ * @param[in]           run_time_ms         Run time of the sample
+ * @param[in]           temperature         Temperature of the sample
+ *
+ * @return              -                   -
+ */
+static void add_sample(uint32_t const run_time_ms, uint16_t const temperature)
+{
+        gui_chart_decimator_change_t change = GUI_CHART_DECIMATOR_CHANGE_NONE;
+        uint16_t first_bucket = 0;
+        uint16_t i;
+
+        (void)gui_chart_decimator_add(&m_decimator,
+                                      run_time_ms,
+                                      (int16_t)temperature,
+                                      &change,
+                                      &first_bucket);
+
+        if (GUI_CHART_DECIMATOR_CHANGE_ALL == change) {
+                // Buckets span twice as long now, and so do the points. Half
+                // of them are left, the ones past them are emptied
+                draw_target();
+                lv_chart_clear_serie(p_graph_chart, p_graph_temperature_series);
+
+                for (i = 0; m_decimator.filled_count > i; i++) {
+                        draw_bucket(i);
+                }
+
+                lv_chart_refresh(p_graph_chart);
+        } else if (GUI_CHART_DECIMATOR_CHANGE_FROM == change) {
+                for (i = first_bucket; m_decimator.filled_count > i; i++) {
+                        draw_bucket(i);
+                }
+        }
+}
+
+/*!
+ * @brief Look the target of each point of the chart up in the trajectory
+ *
+ * The chart is not redrawn.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void draw_target(void)
+{
+        reflow_trajectory_t const * p_trajectory;
+        uint32_t const point_ms = m_decimator.bucket_span / 2;
+        uint16_t setpoint = 0;
+        uint16_t i;
+
+        if (state_machine_states_get_trajectory(&p_trajectory)) {
+                for (i = 0; GUI_GRAPH_POINT_COUNT > i; i++) {
+                        (void)reflow_trajectory_get_setpoint(p_trajectory,
+                                                             i * point_ms,
+                                                             &setpoint);
+                        p_graph_target_series->points[i] = (lv_coord_t)setpoint;
+                }
+        }
+}
+
+/*!
+ * @brief Write the two points of a bucket in the temperature series
+ *
+ * Only the lines around them are redrawn.
+ *
+ * @param[in]           bucket              Index of the bucket
+ *
+ * @return              -                   -
+ */
+static void draw_bucket(uint16_t const bucket)
+{
+        int16_t first = 0;
+        int16_t second = 0;
+
+        if (gui_chart_decimator_get_points(&m_decimator, bucket, &first, &second)) {
+                lv_chart_set_point_id(p_graph_chart,
+                                      p_graph_temperature_series,
+                                      (lv_coord_t)first,
+                                      2 * bucket);
+                lv_chart_set_point_id(p_graph_chart,
+                                      p_graph_temperature_series,
+                                      (lv_coord_t)second,
+                                      (2 * bucket) + 1);
+        }
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,49 @@
+/*!
+ *******************************************************************************
+ * @file gui_ctrls_graph.h
+ *
+ * @brief Graph tab controller, streams the temperature of the run to the chart
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef GUI_CTRLS_GRAPH_H
+#define GUI_CTRLS_GRAPH_H
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+void gui_ctrls_graph_init(void);
+
+void gui_ctrls_graph_refresh(void);
+
+#endif //GUI_CTRLS_GRAPH_H
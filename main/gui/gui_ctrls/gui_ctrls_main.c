@@ -19,6 +19,7 @@
  *******************************************************************************
  */
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -29,6 +30,7 @@
 #include "state_machine/states/state_machine_states.h"
 #include "state_machine/state_machine.h"
 #include "thermocouple.h"
+#include "gui/gui_main_cache.h"
 #include "gui/gui_views/gui_views_main.h"
 #include "gui/gui_ctrls/gui_ctrls_main.h"
 
@@ -42,6 +44,12 @@
 
 #define BUTTON_TEXT_START                   "Start"
 #define BUTTON_TEXT_STOP                    "Stop"
+#define BUTTON_TEXT_PAUSE                   "Pause"
+#define BUTTON_TEXT_RESUME                  "Resume"
+
+#define STATE_TEXT_RAMP                     "Ramp"
+#define STATE_TEXT_HOLD                     "Hold"
+#define STATE_TEXT_LEN_MAX                  (16)
 
 /*
  *******************************************************************************
@@ -67,6 +75,21 @@
  *******************************************************************************
  */
 
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Values shown on the main screen
+static gui_main_cache_t m_cache;
+
+//! @brief Time of the temperature sample shown
+static uint32_t m_sample_time_ms = 0;
+
+//! @brief Whether any temperature sample was shown yet
+static bool m_is_sample_shown = false;
+
 /*
  *******************************************************************************
  * Public Function Bodies                                                      *
@@ -75,45 +98,90 @@
 
 void gui_ctrls_main_init(void)
 {
-        reflow_profile_t profile;
+        reflow_trajectory_t const * p_trajectory;
         int16_t meter_value_max;
-        bool success = reflow_profile_get_current(&profile);
+        bool success = reflow_profile_get_current_trajectory(&p_trajectory);
 
         if (!success) {
                 assert(0);
         }
 
-        meter_value_max = (int16_t)profile.reflow_temperature;
+        meter_value_max = (int16_t)p_trajectory->peak_temperature;
 
         lv_lmeter_set_range(p_lmeter, 0, meter_value_max);
 
+        (void)gui_main_cache_init(&m_cache);
+        m_is_sample_shown = false;
+
         gui_ctrls_main_update_buttons(STATE_MACHINE_STATE_IDLE);
 }
 
+/*!
+ * @brief Show the last temperature sample on the main screen
+ *
+ * Does nothing until a new sample is taken, and then only sets the widgets
+ * whose value changed: every widget set is redrawn and sent to the display.
+ * A change of profile shows with the next sample.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
 void gui_ctrls_main_refresh(void)
 {
         char temperature_str[10];
         char const * profile_name;
         uint16_t temperature;
+        uint32_t sample_time_ms;
+        uint8_t changes = GUI_MAIN_CACHE_CHANGE_NONE;
         bool success;
         int16_t meter_value_max;
-        reflow_profile_t reflow_profile;
+        reflow_trajectory_t const * p_trajectory;
 
-        success = thermocouple_get_avg_temperature(&temperature);
+        success = thermocouple_get_last_update_time(&sample_time_ms);
 
         if (success) {
-                success = reflow_profile_get_current(&reflow_profile);
+                success = ((!m_is_sample_shown) ||
+                           (sample_time_ms != m_sample_time_ms));
         }
 
         if (success) {
-                meter_value_max = (int16_t)reflow_profile.reflow_temperature;
-                profile_name = reflow_profile.name;
+                success = thermocouple_get_avg_temperature(&temperature);
+        }
+
+        if (success) {
+                success = reflow_profile_get_current_name(&profile_name);
+        }
+
+        if (success) {
+                success = reflow_profile_get_current_trajectory(&p_trajectory);
+        }
+
+        if (success) {
+                meter_value_max = (int16_t)p_trajectory->peak_temperature;
+
+                m_sample_time_ms = sample_time_ms;
+                m_is_sample_shown = true;
+
+                changes = gui_main_cache_update(&m_cache,
+                                                temperature,
+                                                meter_value_max,
+                                                profile_name);
+        }
+
+        // The range goes first, as the meter value is clipped to it
+        if (0 != (changes & GUI_MAIN_CACHE_CHANGE_METER_RANGE)) {
+                lv_lmeter_set_range(p_lmeter, 0, meter_value_max);
+        }
 
+        if (0 != (changes & GUI_MAIN_CACHE_CHANGE_TEMPERATURE)) {
                 snprintf(temperature_str, 9, "%dº", temperature);
                 lv_label_set_text(p_temp_label, temperature_str);
-                lv_label_set_text(p_profile_label, profile_name);
                 lv_lmeter_set_value(p_lmeter, temperature);
-                lv_lmeter_set_range(p_lmeter, 0, meter_value_max);
+        }
+
+        if (0 != (changes & GUI_MAIN_CACHE_CHANGE_PROFILE_NAME)) {
+                lv_label_set_text(p_profile_label, profile_name);
         }
 }
 
@@ -143,10 +211,8 @@ void gui_ctrls_main_button_event_cb(lv_obj_t * p_object, lv_event_t event)
                         break;
 
                         // Intentionally fall-through
-                case STATE_MACHINE_STATE_HEATING:
-                case STATE_MACHINE_STATE_SOAKING:
-                case STATE_MACHINE_STATE_REFLOW:
-                case STATE_MACHINE_STATE_DWELL:
+                case STATE_MACHINE_STATE_SEGMENT:
+                case STATE_MACHINE_STATE_PAUSED:
                         state_machine_event_data.user_action = STATE_MACHINE_ACTION_ABORT;
                         break;
 
@@ -154,6 +220,15 @@ void gui_ctrls_main_button_event_cb(lv_obj_t * p_object, lv_event_t event)
                         return;
                 }
 
+                (void)state_machine_send_event(STATE_MACHINE_EVENT_TYPE_ACTION,
+                                               state_machine_event_data,
+                                               portMAX_DELAY);
+        } else if (p_pause_button == p_object) {
+                ESP_LOGI(TAG, "Pause button pressed");
+
+                // The state machine ignores it at the states that can't pause
+                state_machine_event_data.user_action = STATE_MACHINE_ACTION_PAUSE;
+
                 (void)state_machine_send_event(STATE_MACHINE_EVENT_TYPE_ACTION,
                                                state_machine_event_data,
                                                portMAX_DELAY);
@@ -162,7 +237,11 @@ void gui_ctrls_main_button_event_cb(lv_obj_t * p_object, lv_event_t event)
 
 void gui_ctrls_main_update_buttons(state_machine_state_text_t const state)
 {
-        char const * const p_state_str = state_machine_get_state_string(state);
+        char const * p_state_str = state_machine_get_state_string(state);
+        char segment_str[STATE_TEXT_LEN_MAX];
+        reflow_program_t const * p_program;
+        bool is_holding;
+        uint8_t index;
 
         if (NULL == p_state_str) {
                 // Code style exception for readability
@@ -170,34 +249,39 @@ void gui_ctrls_main_update_buttons(state_machine_state_text_t const state)
         }
 
         switch (state) {
-        // Intentionally fall through
-        case STATE_MACHINE_STATE_HEATING:
-        case STATE_MACHINE_STATE_SOAKING:
-        case STATE_MACHINE_STATE_REFLOW:
-        case STATE_MACHINE_STATE_DWELL:
+        case STATE_MACHINE_STATE_SEGMENT:
+                if ((state_machine_states_get_segment(&index, &is_holding)) &&
+                    (state_machine_states_get_program(&p_program))) {
+                        snprintf(segment_str, sizeof(segment_str), "%s %d/%d",
+                                 is_holding ? STATE_TEXT_HOLD : STATE_TEXT_RAMP,
+                                 index + 1, p_program->segment_count);
+                        p_state_str = segment_str;
+                }
+
+                lv_label_set_text(p_start_button_label, LV_SYMBOL_STOP BUTTON_TEXT_STOP);
+                lv_label_set_text(p_pause_button_label, LV_SYMBOL_PAUSE BUTTON_TEXT_PAUSE);
+                lv_obj_set_hidden(p_pause_button, false);
+                break;
+        case STATE_MACHINE_STATE_PAUSED:
                 lv_label_set_text(p_start_button_label, LV_SYMBOL_STOP BUTTON_TEXT_STOP);
+                lv_label_set_text(p_pause_button_label, LV_SYMBOL_PLAY BUTTON_TEXT_RESUME);
+                lv_obj_set_hidden(p_pause_button, false);
                 break;
         case STATE_MACHINE_STATE_IDLE:
                 lv_label_set_text(p_start_button_label, LV_SYMBOL_PLAY BUTTON_TEXT_START);
+                lv_obj_set_hidden(p_pause_button, true);
                 break;
         case STATE_MACHINE_STATE_COOLING:
+                lv_obj_set_hidden(p_pause_button, true);
                 break;
         default:
+                lv_obj_set_hidden(p_pause_button, true);
                 break;
         }
 
         lv_label_set_text(p_state_label, p_state_str);
 }
 
-
-/*
- *******************************************************************************
- * Static Data Declarations                                                    *
- *******************************************************************************
- */
-
-
-
 /*
  *******************************************************************************
  * Private Function Bodies                                                     *
@@ -23,7 +23,10 @@
 #include "lvgl.h"
 #include "freertos/FreeRTOS.h"
 #include "gui/gui_views/gui_views_profile.h"
+#include "configuration.h"
 #include "reflow_profile.h"
+#include "reflow_program.h"
+#include "reflow_trajectory.h"
 #include "gui/gui.h"
 #include "gui/gui_ctrls/gui_ctrls_profile.h"
 
@@ -38,6 +41,16 @@
 #define CONTAINER_LABEL_NAME_REFLOW_TEMP    "Reflow temp"
 #define CONTAINER_LABEL_NAME_DWELL_TIME     "Dwell time"
 
+//! @brief Number of points of the preview chart, one every 4 pixels
+#define PREVIEW_POINT_COUNT                 (71)
+
+//! @brief Top of the temperature axis of the preview, in Celsius
+#define PREVIEW_TEMPERATURE_MAX             (300)
+
+//! @brief Shortest time between two redraws of the preview. Slider changes
+//!        in between are drawn at once
+#define PREVIEW_PERIOD_MS                   (100)
+
 /*
  *******************************************************************************
  * Data types                                                                  *
@@ -79,15 +92,6 @@ static uint8_t get_slider_index_from_pointer(lv_obj_t const * const p_object);
 static void delete_profile_msb_box_button_event_cb(lv_obj_t * const p_object,
                                                    lv_event_t const event);
 
-static bool helper_get_list_len(char const * const p_profiles_list, uint32_t * const p_len);
-
-static bool helper_get_position_at_list(char const * const p_profiles_list,
-                                        char const * const p_name,
-                                        uint32_t * const p_selected);
-
-static bool helper_get_first_name(char const * const p_profiles_list,
-                                  char * const p_first_name);
-
 static void update_profiles_dropdown(void);
 
 static void keyboard_cb(lv_obj_t * p_object, lv_event_t const event);
@@ -97,6 +101,13 @@ static void textfield_cb(lv_obj_t * const p_object, lv_event_t const event);
 static void profile_slider_changed_cb(lv_obj_t * const p_object,
                                       lv_event_t const event);
 
+static void create_preview(lv_obj_t * const p_window,
+                           lv_obj_t const * const p_previous_object);
+
+static void preview_chart_cb(lv_obj_t * const p_object, lv_event_t const event);
+
+static void preview_task(lv_task_t * p_task);
+
 /*
  *******************************************************************************
  * Public Data Declarations                                                    *
@@ -155,6 +166,16 @@ static char m_profile_name_buffer[16];
 
 static lv_obj_t * m_window_close_button;
 
+//! @brief Preview of the profile being edited, and its temperature series
+static lv_obj_t * m_p_preview_chart = NULL;
+static lv_chart_series_t * m_p_preview_series = NULL;
+
+//! @brief Task redrawing the preview, only ready while a change is pending
+static lv_task_t * m_p_preview_task = NULL;
+
+//! @brief Trajectory of the profile being edited, too large for the stack
+static reflow_trajectory_t m_preview_trajectory;
+
 /*
  *******************************************************************************
  * Public Function Bodies                                                      *
@@ -266,6 +287,8 @@ void gui_ctrls_profile_edit_button_event(lv_obj_t * const p_object,
                 lv_label_set_text(m_slider_container_list[i].value_label, buf);
 
         }
+
+        create_preview(window, m_slider_container_list[edit_prof_cont_list_len - 1].container);
 }
 
 void gui_ctrls_profile_delete_button_event(lv_obj_t * const p_object,
@@ -452,7 +475,7 @@ static void profile_slider_changed_cb(lv_obj_t * const p_object,
                 slider_index = get_slider_index_from_pointer(p_object);
                 container = m_slider_container_list[slider_index];
                 offset = container.offset;
-                *(((uint8_t *)&m_buffer_profile) + offset) = slider_value;
+                *((uint16_t *)((uint8_t *)(&m_buffer_profile) + offset)) = (uint16_t)slider_value;
 
                 snprintf(buf, 4, "%u", slider_value);
 
@@ -460,18 +483,84 @@ static void profile_slider_changed_cb(lv_obj_t * const p_object,
 
                         lv_label_set_text(container.value_label, buf);
                 }
+
+                // A drag sends an event per step: they are drawn together,
+                // at most once every period
+                if ((NULL != m_p_preview_task) &&
+                    (LV_TASK_PRIO_OFF == m_p_preview_task->prio)) {
+                        lv_task_reset(m_p_preview_task);
+                        lv_task_set_prio(m_p_preview_task, LV_TASK_PRIO_LOW);
+                }
         }
 
 }
 
+/*!
+ * @brief Create the preview chart of the profile being edited
+ *
+ * The chart and its task are created once per window, and deleted with it.
+ *
+ * @param[in]           p_window            Profile editor window
+ * @param[in]           p_previous_object   Object to place the preview below
+ *
+ * @return              -                   -
+ */
+static void create_preview(lv_obj_t * const p_window,
+                           lv_obj_t const * const p_previous_object)
+{
+        lv_obj_t * p_label;
+
+        p_label = lv_label_create(p_window, NULL);
+        lv_label_set_text(p_label, "Preview");
+        lv_obj_align(p_label, p_previous_object, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 0);
+
+        m_p_preview_chart = lv_chart_create(p_window, NULL);
+        lv_obj_set_size(m_p_preview_chart, 280, 100);
+        lv_obj_align(m_p_preview_chart, p_label, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 0);
+        lv_chart_set_type(m_p_preview_chart, LV_CHART_TYPE_LINE);
+        lv_chart_set_point_count(m_p_preview_chart, PREVIEW_POINT_COUNT);
+        lv_chart_set_range(m_p_preview_chart, 0, PREVIEW_TEMPERATURE_MAX);
+        lv_chart_set_div_line_count(m_p_preview_chart, 2, 0);
+        lv_chart_set_series_width(m_p_preview_chart, 2);
+        lv_obj_set_event_cb(m_p_preview_chart, preview_chart_cb);
+
+        m_p_preview_series = lv_chart_add_series(m_p_preview_chart, LV_COLOR_RED);
+
+        // Drawn once now, then only after the sliders move
+        m_p_preview_task = lv_task_create(preview_task,
+                                          PREVIEW_PERIOD_MS,
+                                          LV_TASK_PRIO_OFF,
+                                          NULL);
+        preview_task(m_p_preview_task);
+}
+
+/*!
+ * @brief Preview chart event callback, stops the preview when deleted
+ *
+ * @param[in]           p_object            Preview chart
+ * @param[in]           event               Event to handle
+ *
+ * @return              -                   -
+ */
+static void preview_chart_cb(lv_obj_t * const p_object, lv_event_t const event)
+{
+        if ((LV_EVENT_DELETE == event) && (m_p_preview_chart == p_object)) {
+                if (NULL != m_p_preview_task) {
+                        lv_task_del(m_p_preview_task);
+                }
+
+                m_p_preview_task = NULL;
+                m_p_preview_series = NULL;
+                m_p_preview_chart = NULL;
+        }
+}
+
 static void delete_profile_msb_box_button_event_cb(lv_obj_t * const p_object,
                                                    lv_event_t const event)
 {
         char buffer[16];
         bool success;
-        char * p_profiles_list = NULL;
-        char p_first_name[REFLOW_PROFILE_NAME_LEN_MAX];
-        size_t profiles_list_size;
+        char p_first_name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
         size_t buffer_size = sizeof(buffer);
 
         if (event == LV_EVENT_VALUE_CHANGED) {
@@ -484,13 +573,8 @@ static void delete_profile_msb_box_button_event_cb(lv_obj_t * const p_object,
                         success = reflow_profile_delete(buffer);
 
                         if (success) {
-                                success = reflow_profile_get_profiles_list(
-                                         &p_profiles_list, &profiles_list_size);
-                        }
-
-                        if (success) {
-                                success = helper_get_first_name(
-                                                 p_profiles_list, p_first_name);
+                                success = reflow_profile_get_name_at(
+                                                 0, p_first_name);
                         }
 
                         if (success) {
@@ -506,152 +590,29 @@ static void delete_profile_msb_box_button_event_cb(lv_obj_t * const p_object,
         }
 }
 
-static bool helper_get_list_len(char const * const p_profiles_list,
-                                uint32_t * const p_len)
-{
-        bool success = (NULL != p_profiles_list) && (NULL != p_len);
-        bool needs_free = false;
-        uint32_t list_len = 0;
-        char * p_buffer_list = NULL;
-        char * ptr = NULL;
-        size_t const profiles_list_size = sizeof(char) *
-                (strlen(p_profiles_list) + 1);
-
-        if (success) {
-                p_buffer_list = pvPortMalloc(profiles_list_size);
-
-                success = (NULL != p_buffer_list);
-        }
-
-        if (success) {
-                needs_free = true;
-
-                strncpy(p_buffer_list, p_profiles_list, profiles_list_size);
-                ptr = strtok(p_buffer_list, "\n");
-
-                while (ptr != NULL) {
-                        list_len++;
-                        ptr = strtok(NULL, "\n");
-                }
-
-                *p_len = list_len;
-        }
-
-        if (needs_free) {
-                vPortFree(p_buffer_list);
-                p_buffer_list = NULL;
-        }
-
-        return success;
-}
-
-
-static bool helper_get_first_name(char const * const p_profiles_list,
-                                  char * const p_first_name)
-{
-        bool success = (NULL != p_profiles_list);
-        bool needs_free = false;
-        char * p_buffer_list = NULL;
-        char * ptr = NULL;
-        size_t const profiles_list_size = sizeof(char) *
-                                          (strlen(p_profiles_list) + 1);
-
-        if (success) {
-                p_buffer_list = pvPortMalloc(profiles_list_size);
-
-                success = (NULL != p_buffer_list);
-        }
-
-        if (success) {
-                needs_free = true;
-
-                strncpy(p_buffer_list, p_profiles_list, profiles_list_size);
-                ptr = strtok(p_buffer_list, "\n");
-
-                strncpy(p_first_name, ptr, REFLOW_PROFILE_NAME_LEN_MAX);
-        }
-
-        if (needs_free) {
-                vPortFree(p_buffer_list);
-                p_buffer_list = NULL;
-        }
-
-        return success;
-}
-
-static bool helper_get_position_at_list(char const * const p_profiles_list,
-                                        char const * const p_name,
-                                        uint32_t * const p_selected)
-{
-        bool success = ((NULL != p_profiles_list) && (NULL != p_name) &&
-                        (NULL != p_selected));
-        bool found = false;
-        bool needs_free = false;
-        char * p_buffer_list = NULL;
-        char * ptr = NULL;
-        uint32_t i = 0;
-        size_t const profiles_list_size = sizeof(char) *
-                                          (strlen(p_profiles_list) + 1);
-
-        if (success) {
-                p_buffer_list = pvPortMalloc(profiles_list_size);
-
-                success = (NULL != p_buffer_list);
-        }
-
-        if (success) {
-                needs_free = true;
-                strncpy(p_buffer_list, p_profiles_list, profiles_list_size);
-
-                ptr = strtok(p_buffer_list, "\n");
-
-                while ((NULL != ptr) && (!found)) {
-
-                        if (0 == strcmp(p_name,ptr)) {
-                                found = true;
-                                *p_selected = i;
-                        }
-
-                        i++;
-                        ptr = strtok(NULL, "\n");
-                }
-                success = found;
-        }
-
-        if (needs_free) {
-                vPortFree(p_buffer_list);
-                p_buffer_list = NULL;
-        }
-
-        return success;
-}
-
 static void update_profiles_dropdown(void)
 {
-        char * p_profiles_list = NULL;
-        bool needs_free = false;
-        uint32_t selected_item;
-        uint32_t counter;
+        char const * p_profiles_list = NULL;
+        uint8_t selected_item;
+        uint8_t counter;
         size_t profiles_size;
         reflow_profile_t current_reflow_profile;
         bool success = reflow_profile_get_profiles_list(&p_profiles_list,
                                                         &profiles_size);
         if (success) {
-                needs_free = true;
                 lv_ddlist_set_options(p_dropdown, p_profiles_list);
 
                 success = reflow_profile_get_current(&current_reflow_profile);
         }
 
         if (success) {
-                success = helper_get_position_at_list(p_profiles_list,
-                                                      current_reflow_profile.name,
+                success = reflow_profile_get_position(current_reflow_profile.name,
                                                       &selected_item);
         }
 
         if (success) {
                 lv_ddlist_set_selected(p_dropdown, selected_item);
-                success = helper_get_list_len(p_profiles_list, &counter);
+                success = reflow_profile_get_profiles_count(&counter);
         }
 
         if (success) {
@@ -668,11 +629,6 @@ static void update_profiles_dropdown(void)
                         lv_btn_set_state(p_new_button, LV_BTN_STATE_REL);
                 }
         }
-
-        if (needs_free) {
-                vPortFree(p_profiles_list);
-                p_profiles_list = NULL;
-        }
 }
 
 /*
@@ -680,3 +636,54 @@ static void update_profiles_dropdown(void)
  * Interrupt Service Routines / Tasks / Thread Main Functions                  *
  *******************************************************************************
  */
+
+/*!
+ * @brief Redraw the preview of the profile being edited
+ *
+ * The trajectory of the profile is compiled as a run would, and sampled at
+ * each point of the chart across its whole length. Only the points whose
+ * temperature moved are written, so only the lines around them are redrawn.
+ * The task then goes back to sleep until the next slider change.
+ *
+ * @param               p_task              Preview task
+ *
+ * @return              -                   -
+ */
+static void preview_task(lv_task_t * p_task)
+{
+        reflow_program_t program;
+        uint32_t duration_ms = 0;
+        uint16_t setpoint = 0;
+        uint16_t i;
+        bool success = ((NULL != m_p_preview_chart) &&
+                        (NULL != m_p_preview_series));
+
+        lv_task_set_prio(p_task, LV_TASK_PRIO_OFF);
+
+        if (success) {
+                success = reflow_program_from_profile(&m_buffer_profile, &program);
+        }
+
+        if (success) {
+                success = reflow_trajectory_compile(&program,
+                                                    CONFIGURATION_AMBIENT_TEMPERATURE_C,
+                                                    &m_preview_trajectory);
+        }
+
+        if (success) {
+                duration_ms = m_preview_trajectory.duration_ms;
+
+                for (i = 0; PREVIEW_POINT_COUNT > i; i++) {
+                        (void)reflow_trajectory_get_setpoint(&m_preview_trajectory,
+                                                             (duration_ms / (PREVIEW_POINT_COUNT - 1)) * i,
+                                                             &setpoint);
+
+                        if ((lv_coord_t)setpoint != m_p_preview_series->points[i]) {
+                                lv_chart_set_point_id(m_p_preview_chart,
+                                                      m_p_preview_series,
+                                                      (lv_coord_t)setpoint,
+                                                      i);
+                        }
+                }
+        }
+}
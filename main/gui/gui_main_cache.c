@@ -0,0 +1,160 @@
+/*!
+ *******************************************************************************
+ * @file gui_main_cache.c
+ *
+ * @brief Values shown on the main screen, to only redraw the ones changing
+ *
+ * Setting the text of a label invalidates its area even when the text is the
+ * same, and the area is then redrawn and sent to the display. The main screen
+ * keeps the values it shows here, and only sets the widgets whose value
+ * changed.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "gui/gui_main_cache.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Forget the values shown, so all of them are redrawn next
+ *
+ * @param[out]          p_cache             Pointer to the cache
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool gui_main_cache_init(gui_main_cache_t * const p_cache)
+{
+        bool const success = (NULL != p_cache);
+
+        if (success) {
+                memset(p_cache, 0, sizeof(*p_cache));
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Store the values to show, and tell which of them changed
+ *
+ * Everything changed on the first call after `gui_main_cache_init`.
+ *
+ * @param[in,out]       p_cache             Pointer to the cache
+ * @param[in]           temperature         Temperature to show, in Celsius
+ * @param[in]           meter_max           Top of the meter range, in Celsius
+ * @param[in]           p_profile_name      Name of the profile to show, cut to
+ *                                          `GUI_MAIN_CACHE_NAME_SIZE` - 1
+ *                                          characters
+ *
+ * @return              uint8_t             Mask of `gui_main_cache_change_t`
+ *                                          of the widgets to set, none if a
+ *                                          pointer is null
+ */
+uint8_t gui_main_cache_update(gui_main_cache_t * const p_cache,
+                              uint16_t const temperature,
+                              int16_t const meter_max,
+                              char const * const p_profile_name)
+{
+        uint8_t changes = GUI_MAIN_CACHE_CHANGE_NONE;
+
+        if ((NULL == p_cache) || (NULL == p_profile_name)) {
+                // Code style exception for readability
+                return changes;
+        }
+
+        if ((!p_cache->is_valid) || (temperature != p_cache->temperature)) {
+                p_cache->temperature = temperature;
+                changes |= GUI_MAIN_CACHE_CHANGE_TEMPERATURE;
+        }
+
+        if ((!p_cache->is_valid) || (meter_max != p_cache->meter_max)) {
+                p_cache->meter_max = meter_max;
+                changes |= GUI_MAIN_CACHE_CHANGE_METER_RANGE;
+        }
+
+        if ((!p_cache->is_valid) ||
+            (0 != strncmp(p_profile_name,
+                          p_cache->profile_name,
+                          GUI_MAIN_CACHE_NAME_SIZE - 1))) {
+                (void)strncpy(p_cache->profile_name,
+                              p_profile_name,
+                              GUI_MAIN_CACHE_NAME_SIZE - 1);
+                p_cache->profile_name[GUI_MAIN_CACHE_NAME_SIZE - 1] = '\0';
+                changes |= GUI_MAIN_CACHE_CHANGE_PROFILE_NAME;
+        }
+
+        p_cache->is_valid = true;
+
+        return changes;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,88 @@
+/*!
+ *******************************************************************************
+ * @file gui_main_cache.h
+ *
+ * @brief Values shown on the main screen, to only redraw the ones changing
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef GUI_MAIN_CACHE_H
+#define GUI_MAIN_CACHE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Size of the profile name kept, terminator included
+#define GUI_MAIN_CACHE_NAME_SIZE                        (16)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Widgets of the main screen to redraw, as a mask
+typedef enum {
+        GUI_MAIN_CACHE_CHANGE_NONE = 0x00,
+        GUI_MAIN_CACHE_CHANGE_TEMPERATURE = 0x01,
+        GUI_MAIN_CACHE_CHANGE_PROFILE_NAME = 0x02,
+        GUI_MAIN_CACHE_CHANGE_METER_RANGE = 0x04,
+} gui_main_cache_change_t;
+
+//! @brief Values last shown on the main screen
+typedef struct {
+        //! @brief Temperature label and meter value, in Celsius
+        uint16_t temperature;
+
+        //! @brief Top of the meter range, in Celsius
+        int16_t meter_max;
+
+        //! @brief Profile label
+        char profile_name[GUI_MAIN_CACHE_NAME_SIZE];
+
+        //! @brief Whether anything was shown yet
+        bool is_valid;
+} gui_main_cache_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Forget the values shown, so all of them are redrawn next
+bool gui_main_cache_init(gui_main_cache_t * const p_cache);
+
+//! @brief Store the values to show, and tell which of them changed
+uint8_t gui_main_cache_update(gui_main_cache_t * const p_cache,
+                              uint16_t const temperature,
+                              int16_t const meter_max,
+                              char const * const p_profile_name);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //GUI_MAIN_CACHE_H
@@ -0,0 +1,117 @@
+/*!
+ *******************************************************************************
+ * @file gui_views_graph.c
+ *
+ * @brief Graph tab, temperature of the run against its target
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+#include "gui/gui.h"
+#include "gui/gui_views/gui_views_graph.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+#define GRAPH_Y_TICK_TEXTS                  "300\n200\n100\n0"
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+void gui_views_graph(lv_obj_t * const p_parent)
+{
+        lv_coord_t const chart_width = GUI_GRAPH_POINT_COUNT;
+        lv_coord_t const chart_height = 150;
+        uint16_t const chart_margin = 30;
+
+        if (NULL == p_parent) {
+                assert(0);
+        }
+
+        p_graph_chart = lv_chart_create(p_parent, NULL);
+        lv_obj_set_size(p_graph_chart, chart_width, chart_height);
+        lv_obj_align(p_graph_chart, p_parent, LV_ALIGN_IN_TOP_RIGHT, -10, 10);
+
+        lv_chart_set_type(p_graph_chart, LV_CHART_TYPE_LINE);
+        lv_chart_set_point_count(p_graph_chart, GUI_GRAPH_POINT_COUNT);
+        lv_chart_set_range(p_graph_chart, 0, GUI_GRAPH_TEMPERATURE_MAX);
+        lv_chart_set_div_line_count(p_graph_chart, 2, 5);
+        lv_chart_set_series_width(p_graph_chart, 2);
+
+        // Each point is written in place, and only the lines around it are
+        // redrawn, instead of shifting and redrawing the whole chart
+        lv_chart_set_update_mode(p_graph_chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+
+        lv_chart_set_margin(p_graph_chart, chart_margin);
+        lv_chart_set_y_tick_texts(p_graph_chart, GRAPH_Y_TICK_TEXTS, 0,
+                                  LV_CHART_AXIS_DRAW_LAST_TICK);
+
+        // Series added last are drawn last, so the temperature is on top
+        p_graph_target_series = lv_chart_add_series(p_graph_chart, LV_COLOR_GRAY);
+        p_graph_temperature_series = lv_chart_add_series(p_graph_chart, LV_COLOR_RED);
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
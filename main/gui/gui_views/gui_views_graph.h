@@ -0,0 +1,58 @@
+/*!
+ *******************************************************************************
+ * @file gui_views_graph.h
+ *
+ * @brief Graph tab, temperature of the run against its target
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef GUI_VIEWS_GRAPH_H
+#define GUI_VIEWS_GRAPH_H
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Number of time buckets of the chart, drawn as two points each
+#define GUI_GRAPH_BUCKET_COUNT              (130)
+
+//! @brief Number of points of the chart, one every pixel
+#define GUI_GRAPH_POINT_COUNT               (2 * GUI_GRAPH_BUCKET_COUNT)
+
+//! @brief Top of the temperature axis, in Celsius
+#define GUI_GRAPH_TEMPERATURE_MAX           (300)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+lv_obj_t * p_graph_chart;
+lv_chart_series_t * p_graph_target_series;
+lv_chart_series_t * p_graph_temperature_series;
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+void gui_views_graph(lv_obj_t * const p_parent);
+
+#endif //GUI_VIEWS_GRAPH_H
@@ -19,6 +19,7 @@
  *******************************************************************************
  */
 
+#include <assert.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include "freertos/FreeRTOS.h"
@@ -41,6 +42,7 @@
  */
 
 #define GUI_RUN_TEXT                        "Run"
+#define GUI_PAUSE_TEXT                      "Pause"
 #define GUI_DEFAULT_PROFILE_TEXT            "Default Profile"
 
 /*
@@ -84,6 +86,12 @@ void gui_views_main(lv_obj_t * const p_parent)
         lv_obj_set_size(p_start_button, 100, 100);
         lv_obj_set_event_cb(p_start_button, gui_ctrls_main_button_event_cb);
 
+        // Pause button
+
+        p_pause_button = lv_btn_create(p_parent, NULL);
+        lv_obj_set_size(p_pause_button, 100, 40);
+        lv_obj_set_event_cb(p_pause_button, gui_ctrls_main_button_event_cb);
+
         // Labels
 
         p_profile_label = lv_label_create(p_parent, NULL);
@@ -96,6 +104,9 @@ void gui_views_main(lv_obj_t * const p_parent)
         p_start_button_label = lv_label_create(p_start_button, NULL);
         lv_label_set_text(p_start_button_label, LV_SYMBOL_PLAY GUI_RUN_TEXT);
 
+        p_pause_button_label = lv_label_create(p_pause_button, NULL);
+        lv_label_set_text(p_pause_button_label, LV_SYMBOL_PAUSE GUI_PAUSE_TEXT);
+
         p_temp_label = lv_label_create(p_parent, NULL);
         lv_label_set_align(p_temp_label, LV_LABEL_ALIGN_CENTER);
         lv_label_set_style(p_temp_label, LV_LABEL_STYLE_MAIN, &m_big_style);
@@ -109,6 +120,7 @@ void gui_views_main(lv_obj_t * const p_parent)
 
         lv_obj_align(p_profile_label, p_start_button, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 20);
         lv_obj_align(p_state_label, p_profile_label, LV_ALIGN_OUT_RIGHT_MID, 10, 0);
+        lv_obj_align(p_pause_button, p_profile_label, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 10);
 
         lv_obj_align(p_temp_label, p_lmeter, LV_ALIGN_CENTER, 0, 0);
 
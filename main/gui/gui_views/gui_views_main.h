@@ -35,6 +35,8 @@ lv_obj_t * p_temp_label;
 lv_obj_t * p_lmeter;
 lv_obj_t * p_state_label;
 lv_obj_t * p_start_button_label;
+lv_obj_t * p_pause_button;
+lv_obj_t * p_pause_button_label;
 
 /*
  *******************************************************************************
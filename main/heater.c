@@ -99,6 +99,20 @@ static bool m_is_initialized = false;
 //! @brief Whether heater control is activeor not
 static bool m_heater_running = false;
 
+//! @brief Whether the heater is physically powered or not
+static volatile bool m_is_powered = false;
+
+/*!
+ * @brief Whether the power was cut by an emergency stop. It is latched until
+ *        a new run re-arms the heater, so neither a message already queued to
+ *        the heater task nor the heater control started again by the run
+ *        being cut can power the heater back on
+ */
+static volatile bool m_is_power_cut = false;
+
+//! @brief Spinlock making the power cut and powering the heater on exclusive
+static portMUX_TYPE m_power_mux = portMUX_INITIALIZER_UNLOCKED;
+
 //! @brief Maximum allowed heater target in degrees celsius
 static int16_t m_target_max_degrees = 270;
 
@@ -108,6 +122,12 @@ static int16_t m_target_min_degrees = 0;
 //! @brief Current heater target in degrees celsius
 static uint16_t m_target_temperature = 0;
 
+//! @brief Number of control cycles run by the heater task
+static volatile uint32_t m_cycle_count = 0;
+
+//! @brief Number of control cycles that left the heater powered
+static volatile uint32_t m_powered_cycle_count = 0;
+
 //! @brief Heater task handle
 static TaskHandle_t heater_task_h = NULL;
 
@@ -151,6 +171,7 @@ heater_error_t heater_init(heater_temp_getter_t const p_f_temp_getter)
         } else {
                 m_target_temperature = 0;
                 m_heater_running = false;
+                m_is_power_cut = false;
                 m_pf_temperature_getter = p_f_temp_getter;
 
                 m_heater_queue_h = xQueueCreate(3, sizeof(heater_msg_t *));
@@ -253,6 +274,43 @@ heater_error_t heater_get_target(uint16_t * const p_degrees)
         return success;
 }
 
+/*!
+ * @brief Get the number of control cycles run, and of those powered
+ *
+ * Counts only grow, wrapping around. The duty of the heater over a period of
+ * time is the ratio of the differences of both counts over it.
+ *
+ * @param[out]          p_powered_count     Pointer to retrieve the number of
+ *                                          cycles that left the heater powered
+ * @param[out]          p_cycle_count       Pointer to retrieve the number of
+ *                                          cycles run
+ *
+ * @return              heater_error_t      Result of the operation
+ * @retval              HEATER_ERROR_SUCCESS
+ *                                          Everything when well
+ * @retval              HEATER_ERROR_NOT_INITIALIZED
+ *                                          Module was not initialized
+ * @retval              HEATER_ERROR_BAD_PARAMETER
+ *                                          A pointer was null
+ */
+heater_error_t heater_get_cycle_counts(uint32_t * const p_powered_count,
+                                       uint32_t * const p_cycle_count)
+{
+        heater_error_t success = HEATER_ERROR_SUCCESS;
+
+        if (!m_is_initialized) {
+                success = HEATER_ERROR_NOT_INITIALIZED;
+        } else if ((NULL == p_powered_count) || (NULL == p_cycle_count)) {
+                success = HEATER_ERROR_BAD_PARAMETER;
+        } else {
+                // Read in the reverse order they grow, so powered <= cycles
+                *p_powered_count = m_powered_cycle_count;
+                *p_cycle_count = m_cycle_count;
+        }
+
+        return success;
+}
+
 /*!
  * @brief Start the heater control
  *
@@ -275,7 +333,6 @@ heater_error_t heater_start(void)
         if (!m_is_initialized) {
                 success = HEATER_ERROR_NOT_INITIALIZED;
         } else {
-
                 message.target = m_target_temperature;
                 message.heater_control_active = true;
 
@@ -316,10 +373,54 @@ heater_error_t heater_start(void)
         return success;
 }
 
+/*!
+ * @brief Cut the heater power immediately
+ *
+ * The heater GPIO is driven low from the calling context, without going
+ * through the heater task, so the time to cut the power is bounded by a couple
+ * of memory writes and a GPIO write. The heater stays off until it is
+ * re-armed with `heater_rearm`.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
 void heater_emergency_stop(void)
 {
+        taskENTER_CRITICAL(&m_power_mux);
+        m_is_power_cut = true;
         m_heater_running = false;
         heater_power_off();
+        taskEXIT_CRITICAL(&m_power_mux);
+}
+
+/*!
+ * @brief Allow the heater to be powered again after an emergency stop
+ *
+ * Meant to be called only when a new run starts, the heater control being
+ * started again doesn't lift the power cut.
+ *
+ * @param               -                   -
+ *
+ * @return              heater_error_t      Result of the operation
+ * @retval              HEATER_ERROR_SUCCESS
+ *                                          Everything went well
+ * @retval              HEATER_ERROR_NOT_INITIALIZED
+ *                                          Module was not initialized
+ */
+heater_error_t heater_rearm(void)
+{
+        heater_error_t success = HEATER_ERROR_SUCCESS;
+
+        if (!m_is_initialized) {
+                success = HEATER_ERROR_NOT_INITIALIZED;
+        } else {
+                taskENTER_CRITICAL(&m_power_mux);
+                m_is_power_cut = false;
+                taskEXIT_CRITICAL(&m_power_mux);
+        }
+
+        return success;
 }
 
 /*!
@@ -348,6 +449,7 @@ heater_error_t heater_deinit(void)
 
                 m_target_temperature = 0;
                 m_heater_running = false;
+                m_is_power_cut = false;
                 m_is_initialized = false;
 
                 if (NULL != m_heater_queue_h) {
@@ -381,6 +483,18 @@ bool heater_is_running(void)
         return m_heater_running;
 }
 
+/*!
+ * @brief Query whether the heater is physically powered
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the query
+ */
+bool heater_is_powered(void)
+{
+        return m_is_powered;
+}
+
 /*
  *******************************************************************************
  * Private Function Bodies                                                     *
@@ -390,13 +504,23 @@ bool heater_is_running(void)
 /*!
  * @brief Power on the heater at hardware level
  *
+ * The power cut is checked in the same critical section as the GPIO is set,
+ * so an emergency stop from the other core can't be undone in between.
+ *
  * @param               -                   -
  *
  * @result              -                   -
  */
 static void heater_power_on(void)
 {
-        (void)gpio_set_level(HEATER_ACTIVE_HIGH_GPIO_PIN, 1);
+        taskENTER_CRITICAL(&m_power_mux);
+
+        if (!m_is_power_cut) {
+                (void)gpio_set_level(HEATER_ACTIVE_HIGH_GPIO_PIN, 1);
+                m_is_powered = true;
+        }
+
+        taskEXIT_CRITICAL(&m_power_mux);
 }
 
 /*!
@@ -409,6 +533,7 @@ static void heater_power_on(void)
 static void heater_power_off(void)
 {
         (void)gpio_set_level(HEATER_ACTIVE_HIGH_GPIO_PIN, 0);
+        m_is_powered = false;
 }
 
 /*!
@@ -508,6 +633,13 @@ static void heater_task(void * pvParameters)
                         }
                 }
 
+                // Counted before the powered ones, see heater_get_cycle_counts
+                m_cycle_count++;
+
+                if (m_is_powered) {
+                        m_powered_cycle_count++;
+                }
+
                 if ((!success) || (!wdt_kick())) {
                         // Code style exception for readability
                         panic("General failure at heater_task ", __FILE__, __LINE__);
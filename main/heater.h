@@ -102,6 +102,10 @@ heater_error_t heater_set_target(uint16_t const degrees);
 //! @brief Get actual heater target temperature
 heater_error_t heater_get_target(uint16_t * const p_degrees);
 
+//! @brief Get the number of control cycles run, and of those powered
+heater_error_t heater_get_cycle_counts(uint32_t * const p_powered_count,
+                                       uint32_t * const p_cycle_count);
+
 //! @brief Start the heater control
 heater_error_t heater_start(void);
 
@@ -114,7 +118,14 @@ heater_error_t heater_deinit(void);
 //! @brief Query whether the heater is running
 bool heater_is_running(void);
 
+//! @brief Query whether the heater is physically powered
+bool heater_is_powered(void);
+
+//! @brief Cut the heater power immediately
 void heater_emergency_stop(void);
+
+//! @brief Allow the heater to be powered again after an emergency stop
+heater_error_t heater_rearm(void);
 #ifdef __cplusplus
 }
 #endif // #ifdef __cplusplus
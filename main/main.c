@@ -39,8 +39,14 @@
 #include "tp_spi.h"
 #include "xpt2046.h"
 #include "freertos/timers.h"
+#include "deferred_log.h"
 #include "heater.h"
+#include "supervisor.h"
 #include "reflow_profile.h"
+#include "profile_console.h"
+#include "run_logger.h"
+#include "run_report.h"
+#include "telemetry.h"
 #include "state_machine/states/state_machine_states.h"
 #include "state_machine/state_machine.h"
 #include "gui/gui.h"
@@ -112,6 +118,8 @@ void app_main()
         // @note: failing to initialize hardware will assert
         success = hardware_init();
 
+        success = success && deferred_log_init();
+
         success = success && wdt_init(WDT_TIMEOUT_S);
 
         success = success && display_init();
@@ -120,6 +128,14 @@ void app_main()
 
         success = success && reflow_profile_init();
 
+        success = success && profile_console_init();
+
+        success = success && telemetry_init();
+
+        success = success && run_logger_init();
+
+        success = success && run_report_init();
+
         gui_init();
 
         success = success && state_machine_init();
@@ -128,6 +144,8 @@ void app_main()
 
         success = success && (HEATER_ERROR_SUCCESS == heater_init(thermocouple_get_avg_temperature));
 
+        success = success && supervisor_init();
+
         if (!success) {
                 assert(0);
         }
@@ -135,6 +153,8 @@ void app_main()
         while (1) {
                 vTaskDelay(1);
                 lv_task_handler();
+                (void)profile_console_poll();
+                (void)reflow_profile_poll();
         }
 }
 
@@ -212,6 +232,8 @@ static bool display_init(void)
 
         lv_disp_drv_init(&display_driver);
         display_driver.flush_cb = ili9341_flush;
+        display_driver.wait_cb = ili9341_wait;
+        display_driver.monitor_cb = gui_monitor_cb;
         display_driver.buffer = &display_buffer;
         p_display = lv_disp_drv_register(&display_driver);
 
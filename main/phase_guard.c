@@ -0,0 +1,279 @@
+/*!
+ *******************************************************************************
+ * @file phase_guard.c
+ *
+ * @brief Deadlines and stall detection for the temperature driven phases of a
+ *        reflow run
+ *
+ * The heating phases (preheat and reflow) only end when the target temperature
+ * is reached, so a dead heater or an open oven door would keep the run waiting
+ * forever. The phase guard gives every heating phase a deadline derived from
+ * the profile ramp speed and the temperature delta, and checks along fixed
+ * windows that the temperature keeps rising at a minimum speed.
+ *
+ * The module has no dependencies on the RTOS, the caller provides the time on
+ * each call.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "phase_guard.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Compute the deadline of a heating phase
+ *
+ * The nominal heating time is the temperature delta over the ramp speed. The
+ * deadline is that time scaled by `PHASE_GUARD_DEADLINE_FACTOR` plus
+ * `PHASE_GUARD_DEADLINE_MARGIN_S`, to tolerate ovens slower than the profile.
+ *
+ * @param[in]           start_temperature   Temperature at the phase start
+ * @param[in]           target_temperature  Temperature to reach
+ * @param[in]           ramp_speed          Heating speed in Celsius per second
+ * @param[out]          p_deadline_ms       Pointer where to store the deadline
+ *                                          in milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer or null ramp speed
+ */
+bool phase_guard_get_heating_deadline(uint16_t const start_temperature,
+                                      uint16_t const target_temperature,
+                                      uint16_t const ramp_speed,
+                                      uint32_t * const p_deadline_ms)
+{
+        bool success = ((NULL != p_deadline_ms) && (0 != ramp_speed));
+        uint32_t delta = 0;
+        uint32_t nominal_s;
+
+        if (success) {
+                if (target_temperature > start_temperature) {
+                        delta = target_temperature - start_temperature;
+                }
+
+                // Round up, so a small delta doesn't get a null nominal time
+                nominal_s = (delta + ramp_speed - 1) / ramp_speed;
+
+                *p_deadline_ms = ((nominal_s * PHASE_GUARD_DEADLINE_FACTOR) +
+                                  PHASE_GUARD_DEADLINE_MARGIN_S) * 1000;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Start guarding a heating phase
+ *
+ * @param[out]          p_guard             Pointer to the guard object
+ * @param[in]           now_ms              Current time in milliseconds
+ * @param[in]           temperature         Current temperature in Celsius
+ * @param[in]           target_temperature  Temperature to reach in Celsius
+ * @param[in]           ramp_speed          Heating speed in Celsius per second
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer or null ramp speed
+ */
+bool phase_guard_start_heating(phase_guard_t * const p_guard,
+                               uint32_t const now_ms,
+                               uint16_t const temperature,
+                               uint16_t const target_temperature,
+                               uint16_t const ramp_speed)
+{
+        uint32_t deadline_ms = 0;
+        uint32_t min_rise;
+        bool success = (NULL != p_guard);
+
+        if (success) {
+                success = phase_guard_get_heating_deadline(temperature,
+                                                           target_temperature,
+                                                           ramp_speed,
+                                                           &deadline_ms);
+        }
+
+        if (success) {
+                min_rise = ((PHASE_GUARD_STALL_WINDOW_MS / 1000) * ramp_speed) /
+                           PHASE_GUARD_STALL_RAMP_DIVIDER;
+
+                if (0 == min_rise) {
+                        min_rise = 1;
+                }
+
+                p_guard->start_ms = now_ms;
+                p_guard->deadline_ms = deadline_ms;
+                p_guard->window_start_ms = now_ms;
+                p_guard->window_start_temperature = temperature;
+                p_guard->window_min_rise = (uint16_t)min_rise;
+                p_guard->is_stall_check_enabled = true;
+                p_guard->is_active = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Start guarding a phase with a fixed deadline and no stall detection
+ *
+ * @param[out]          p_guard             Pointer to the guard object
+ * @param[in]           now_ms              Current time in milliseconds
+ * @param[in]           deadline_ms         Maximum phase duration in
+ *                                          milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool phase_guard_start_timed(phase_guard_t * const p_guard,
+                             uint32_t const now_ms,
+                             uint32_t const deadline_ms)
+{
+        bool success = (NULL != p_guard);
+
+        if (success) {
+                p_guard->start_ms = now_ms;
+                p_guard->deadline_ms = deadline_ms;
+                p_guard->window_start_ms = now_ms;
+                p_guard->window_start_temperature = 0;
+                p_guard->window_min_rise = 0;
+                p_guard->is_stall_check_enabled = false;
+                p_guard->is_active = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Stop guarding the current phase
+ *
+ * @param[out]          p_guard             Pointer to the guard object
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool phase_guard_stop(phase_guard_t * const p_guard)
+{
+        bool success = (NULL != p_guard);
+
+        if (success) {
+                p_guard->is_active = false;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Check the progress of the guarded phase with a new sample
+ *
+ * The stall check is done at the end of every window: if the temperature rose
+ * less than the minimum, the phase is too slow. Otherwise a new window starts.
+ *
+ * @param[in,out]       p_guard             Pointer to the guard object
+ * @param[in]           now_ms              Current time in milliseconds
+ * @param[in]           temperature         Current temperature in Celsius
+ *
+ * @return              phase_guard_result_t
+ *                                          Check result. Always
+ *                                          PHASE_GUARD_RESULT_OK if no phase is
+ *                                          being guarded or null pointer passed
+ */
+phase_guard_result_t phase_guard_check(phase_guard_t * const p_guard,
+                                       uint32_t const now_ms,
+                                       uint16_t const temperature)
+{
+        phase_guard_result_t result = PHASE_GUARD_RESULT_OK;
+        uint16_t min_temperature;
+
+        if ((NULL == p_guard) || (!p_guard->is_active)) {
+                // Code style exception for readability
+                return PHASE_GUARD_RESULT_OK;
+        }
+
+        if ((now_ms - p_guard->start_ms) > p_guard->deadline_ms) {
+                result = PHASE_GUARD_RESULT_TIMEOUT;
+        } else if ((p_guard->is_stall_check_enabled) &&
+                   ((now_ms - p_guard->window_start_ms) >=
+                    PHASE_GUARD_STALL_WINDOW_MS)) {
+
+                min_temperature = p_guard->window_start_temperature +
+                                  p_guard->window_min_rise;
+
+                if (temperature < min_temperature) {
+                        result = PHASE_GUARD_RESULT_TOO_SLOW;
+                } else {
+                        p_guard->window_start_ms = now_ms;
+                        p_guard->window_start_temperature = temperature;
+                }
+        }
+
+        return result;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
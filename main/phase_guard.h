@@ -0,0 +1,137 @@
+/*!
+ *******************************************************************************
+ * @file phase_guard.h
+ *
+ * @brief Deadlines and stall detection for the temperature driven phases of a
+ *        reflow run
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef PHASE_GUARD_H
+#define PHASE_GUARD_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Factor applied to the nominal heating time (temperature delta over
+ *        ramp speed) to get the phase deadline
+ */
+#define PHASE_GUARD_DEADLINE_FACTOR                  (4)
+
+//! @brief Time in seconds added to every heating phase deadline
+#define PHASE_GUARD_DEADLINE_MARGIN_S                (180)
+
+//! @brief Length in milliseconds of the stall detection window
+#define PHASE_GUARD_STALL_WINDOW_MS                  (30 * 1000)
+
+/*!
+ * @brief Divider applied to the ramp speed to get the minimum heating speed.
+ *        Heating slower than that along a whole window is a stall
+ */
+#define PHASE_GUARD_STALL_RAMP_DIVIDER               (20)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Phase guard check results
+typedef enum {
+        //! @brief Phase progressing as expected
+        PHASE_GUARD_RESULT_OK = 0,
+
+        //! @brief Phase deadline expired
+        PHASE_GUARD_RESULT_TIMEOUT,
+
+        //! @brief Temperature not rising fast enough
+        PHASE_GUARD_RESULT_TOO_SLOW,
+
+        //! @brief Fence member
+        PHASE_GUARD_RESULT_COUNT
+} phase_guard_result_t;
+
+//! @brief Phase guard object
+typedef struct {
+        //! @brief Time in milliseconds at which the phase started
+        uint32_t start_ms;
+
+        //! @brief Maximum duration of the phase in milliseconds
+        uint32_t deadline_ms;
+
+        //! @brief Time in milliseconds at which the stall window started
+        uint32_t window_start_ms;
+
+        //! @brief Temperature in Celsius at the start of the stall window
+        uint16_t window_start_temperature;
+
+        //! @brief Minimum temperature rise in Celsius along a stall window
+        uint16_t window_min_rise;
+
+        //! @brief Whether the stall detection is enabled for the phase
+        bool is_stall_check_enabled;
+
+        //! @brief Whether a phase is being guarded
+        bool is_active;
+} phase_guard_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Compute the deadline of a heating phase
+bool phase_guard_get_heating_deadline(uint16_t const start_temperature,
+                                      uint16_t const target_temperature,
+                                      uint16_t const ramp_speed,
+                                      uint32_t * const p_deadline_ms);
+
+//! @brief Start guarding a heating phase
+bool phase_guard_start_heating(phase_guard_t * const p_guard,
+                               uint32_t const now_ms,
+                               uint16_t const temperature,
+                               uint16_t const target_temperature,
+                               uint16_t const ramp_speed);
+
+//! @brief Start guarding a phase with a fixed deadline and no stall detection
+bool phase_guard_start_timed(phase_guard_t * const p_guard,
+                             uint32_t const now_ms,
+                             uint32_t const deadline_ms);
+
+//! @brief Stop guarding the current phase
+bool phase_guard_stop(phase_guard_t * const p_guard);
+
+//! @brief Check the progress of the guarded phase with a new sample
+phase_guard_result_t phase_guard_check(phase_guard_t * const p_guard,
+                                       uint32_t const now_ms,
+                                       uint16_t const temperature);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //PHASE_GUARD_H
@@ -0,0 +1,397 @@
+/*!
+ *******************************************************************************
+ * @file profile_console.c
+ *
+ * @brief Import and export of the reflow profiles over the UART console
+ *
+ * Requests in the format of `reflow_profile_serial.h` are read from the console
+ * UART, and each of them is answered with the profiles it asks for, if any,
+ * followed by a status line:
+ *
+ *      OK <number of profiles sent or changed>
+ *      ERR <reason>
+ *
+ * Saved profiles are checked against their limits, and against the time the
+ * program they make spends above liquidus, by `reflow_profile_save`, and
+ * written to NVS along with the rest of the pending changes, so a whole
+ * catalogue sent back to back takes a single write. `SYNC` forces it.
+ *
+ * Requests are handled from the task polling the module, the same one using
+ * the rest of `reflow_profile`, so no locking is needed. The UART driver
+ * buffers are big enough to queue a whole catalogue in either direction.
+ *
+ * `TELEMETRY` starts or stops the binary telemetry stream (see `telemetry.c`).
+ *
+ * @note The console is shared with the logs and the telemetry frames, which go
+ *       through the UART driver too so they don't get mixed with the answers.
+ *       Hosts should ignore the lines not starting as an answer.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "driver/uart.h"
+#include "esp_vfs_dev.h"
+#include "esp_log.h"
+#include "configuration.h"
+#include "reflow_profile.h"
+#include "reflow_profile_serial.h"
+#include "state_machine/states/state_machine_states.h"
+#include "telemetry.h"
+#include "profile_console.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+#define TAG                                 __FILENAME__
+
+//! @brief UART the console runs on
+#define CONSOLE_UART_NUM                    (CONFIG_ESP_CONSOLE_UART_NUM)
+
+//! @brief Size of the chunks read from the UART on each poll
+#define RX_CHUNK_SIZE                       (128)
+
+//! @brief Maximum length of a status line
+#define STATUS_LINE_SIZE                    (16)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Handle a parsed request
+static void handle_request(reflow_profile_serial_request_t const * const p_request);
+
+//! @brief Send the `LIST` answer
+static void send_list(void);
+
+//! @brief Send a profile as a `PROFILE` line
+static bool send_profile(char const * const p_name);
+
+//! @brief Send an `OK` status line
+static void send_ok(uint8_t const count);
+
+//! @brief Send an `ERR` status line
+static void send_error(char const * const p_reason);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Whether the module is initialized
+static bool m_is_initialized = false;
+
+//! @brief Parser of the received requests
+static reflow_profile_serial_parser_t m_parser;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize the profile console
+ *
+ * Installs the UART driver on the console UART, and routes the standard
+ * output through it.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If the UART driver couldn't be
+ *                                          installed
+ */
+bool profile_console_init(void)
+{
+        bool success = reflow_profile_serial_init(&m_parser);
+
+        if (success) {
+                success = (ESP_OK == uart_driver_install(CONSOLE_UART_NUM,
+                                                         CONFIGURATION_PROFILE_CONSOLE_RX_BUFFER_SIZE,
+                                                         CONFIGURATION_PROFILE_CONSOLE_TX_BUFFER_SIZE,
+                                                         0,
+                                                         NULL,
+                                                         0));
+        }
+
+        if (success) {
+                esp_vfs_dev_uart_use_driver(CONSOLE_UART_NUM);
+                m_is_initialized = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Handle the requests received on the console
+ *
+ * Reads what was received without blocking, and answers every request
+ * completed by it.
+ *
+ * @note This function is to be called periodically from the task using the
+ *       `reflow_profile` module
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If module is not initialized or
+ *                                          the UART couldn't be read
+ */
+bool profile_console_poll(void)
+{
+        bool success = m_is_initialized;
+        char buffer[RX_CHUNK_SIZE];
+        reflow_profile_serial_request_t request;
+        reflow_profile_serial_error_t result;
+        size_t offset = 0;
+        size_t consumed;
+        int received = 0;
+
+        if (success) {
+                received = uart_read_bytes(CONSOLE_UART_NUM,
+                                           (uint8_t *)buffer,
+                                           sizeof(buffer),
+                                           0);
+
+                success = (0 <= received);
+        }
+
+        while ((success) && ((size_t)received > offset)) {
+                result = reflow_profile_serial_feed(&m_parser,
+                                                    &buffer[offset],
+                                                    (size_t)received - offset,
+                                                    &consumed,
+                                                    &request);
+                offset += consumed;
+
+                if (REFLOW_PROFILE_SERIAL_ERROR_SUCCESS == result) {
+                        handle_request(&request);
+                } else if (REFLOW_PROFILE_SERIAL_ERROR_SYNTAX == result) {
+                        send_error("syntax");
+                } else if (REFLOW_PROFILE_SERIAL_ERROR_TOO_LONG == result) {
+                        send_error("too_long");
+                } else if (REFLOW_PROFILE_SERIAL_ERROR_PENDING != result) {
+                        success = false;
+                }
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Handle a parsed request
+ *
+ * @param[in]           p_request           Pointer to the request
+ *
+ * @return              -                   -
+ */
+static void handle_request(reflow_profile_serial_request_t const * const p_request)
+{
+        char const * p_current_name = NULL;
+        uint8_t position;
+        bool success;
+
+        switch (p_request->command) {
+        case REFLOW_PROFILE_SERIAL_COMMAND_LIST:
+                send_list();
+                break;
+
+        case REFLOW_PROFILE_SERIAL_COMMAND_GET:
+                if (send_profile(p_request->profile.name)) {
+                        send_ok(1);
+                } else {
+                        send_error("not_found");
+                }
+                break;
+
+        case REFLOW_PROFILE_SERIAL_COMMAND_PUT:
+                success = reflow_profile_save(&p_request->profile);
+
+                // Replacing the profile in use takes effect right away
+                if ((success) &&
+                    (reflow_profile_get_current_name(&p_current_name)) &&
+                    (0 == strcmp(p_current_name, p_request->profile.name))) {
+                        success = reflow_profile_use(p_request->profile.name);
+                }
+
+                if (success) {
+                        send_ok(1);
+                } else {
+                        send_error("rejected");
+                }
+                break;
+
+        case REFLOW_PROFILE_SERIAL_COMMAND_DELETE:
+                // The last profile can't be deleted, there must be one to use
+                if (!reflow_profile_get_position(p_request->profile.name,
+                                                 &position)) {
+                        send_error("not_found");
+                } else if (reflow_profile_delete(p_request->profile.name)) {
+                        send_ok(1);
+                } else {
+                        send_error("rejected");
+                }
+                break;
+
+        case REFLOW_PROFILE_SERIAL_COMMAND_SYNC:
+                if (reflow_profile_flush()) {
+                        send_ok(0);
+                } else {
+                        send_error("io");
+                }
+                break;
+
+        case REFLOW_PROFILE_SERIAL_COMMAND_TELEMETRY:
+                if (telemetry_set_period(p_request->telemetry_period_ms)) {
+                        send_ok(0);
+                } else {
+                        send_error("io");
+                }
+                break;
+
+        default:
+                send_error("syntax");
+                break;
+        }
+}
+
+/*!
+ * @brief Send the `LIST` answer
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void send_list(void)
+{
+        char name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+        uint8_t count = 0;
+        uint8_t i;
+        bool success = reflow_profile_get_profiles_count(&count);
+
+        for (i = 0; (success) && (count > i); i++) {
+                success = ((reflow_profile_get_name_at(i, name)) &&
+                           (send_profile(name)));
+        }
+
+        if (success) {
+                send_ok(count);
+        } else {
+                send_error("io");
+        }
+}
+
+/*!
+ * @brief Send a profile as a `PROFILE` line
+ *
+ * @param[in]           p_name              Name of the profile
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If the profile was not found
+ */
+static bool send_profile(char const * const p_name)
+{
+        char line[REFLOW_PROFILE_SERIAL_PROFILE_LINE_SIZE];
+        reflow_profile_t reflow_profile;
+        size_t length = 0;
+        bool success = reflow_profile_load(p_name, &reflow_profile);
+
+        if (success) {
+                success = reflow_profile_serial_format(&reflow_profile,
+                                                       line,
+                                                       sizeof(line),
+                                                       &length);
+        }
+
+        if (success) {
+                (void)uart_write_bytes(CONSOLE_UART_NUM, line, length);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Send an `OK` status line
+ *
+ * @param[in]           count               Number of profiles sent or changed
+ *
+ * @return              -                   -
+ */
+static void send_ok(uint8_t const count)
+{
+        char line[STATUS_LINE_SIZE];
+        int const length = snprintf(line, sizeof(line), "OK %u\n", count);
+
+        (void)uart_write_bytes(CONSOLE_UART_NUM, line, (size_t)length);
+}
+
+/*!
+ * @brief Send an `ERR` status line
+ *
+ * @param[in]           p_reason            Short reason of the error
+ *
+ * @return              -                   -
+ */
+static void send_error(char const * const p_reason)
+{
+        char line[STATUS_LINE_SIZE];
+        int const length = snprintf(line, sizeof(line), "ERR %s\n", p_reason);
+
+        ESP_LOGW(TAG, "Request failed: %s", p_reason);
+        (void)uart_write_bytes(CONSOLE_UART_NUM, line, (size_t)length);
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
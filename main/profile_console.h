@@ -0,0 +1,60 @@
+/*!
+ *******************************************************************************
+ * @file profile_console.h
+ *
+ * @brief Import and export of the reflow profiles over the UART console
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef PROFILE_CONSOLE_H
+#define PROFILE_CONSOLE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize the profile console
+bool profile_console_init(void);
+
+//! @brief Handle the requests received on the console
+bool profile_console_poll(void);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //PROFILE_CONSOLE_H
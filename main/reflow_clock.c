@@ -0,0 +1,271 @@
+/*!
+ *******************************************************************************
+ * @file reflow_clock.c
+ *
+ * @brief Pausable monotonic clock used to measure the progress of a reflow
+ *        run or of one of its phases, excluding the time spent paused
+ *
+ * The module doesn't read any time source by itself, the caller provides the
+ * current time on each call. This keeps it usable from both the RTOS tasks
+ * and the host simulation.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "reflow_clock.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Start (or restart) the clock
+ *
+ * @param[out]          p_clock             Pointer to the clock to start
+ * @param[in]           now_ms              Current time in milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_clock_start(reflow_clock_t * const p_clock, uint32_t const now_ms)
+{
+        bool success = (NULL != p_clock);
+
+        if (success) {
+                p_clock->start_ms = now_ms;
+                p_clock->paused_at_ms = now_ms;
+                p_clock->paused_total_ms = 0;
+                p_clock->is_running = true;
+                p_clock->is_paused = false;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Stop the clock
+ *
+ * @param[out]          p_clock             Pointer to the clock to stop
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_clock_stop(reflow_clock_t * const p_clock)
+{
+        bool success = (NULL != p_clock);
+
+        if (success) {
+                p_clock->is_running = false;
+                p_clock->is_paused = false;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Freeze the clock
+ *
+ * While paused, the elapsed time reported by the clock doesn't increase.
+ *
+ * @param[out]          p_clock             Pointer to the clock to pause
+ * @param[in]           now_ms              Current time in milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, clock not
+ *                                          running or already paused
+ */
+bool reflow_clock_pause(reflow_clock_t * const p_clock, uint32_t const now_ms)
+{
+        bool success = ((NULL != p_clock) &&
+                        (p_clock->is_running) &&
+                        (!p_clock->is_paused));
+
+        if (success) {
+                p_clock->paused_at_ms = now_ms;
+                p_clock->is_paused = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Continue counting from the point where the clock was frozen
+ *
+ * @param[out]          p_clock             Pointer to the clock to resume
+ * @param[in]           now_ms              Current time in milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or clock not
+ *                                          paused
+ */
+bool reflow_clock_resume(reflow_clock_t * const p_clock, uint32_t const now_ms)
+{
+        bool success = ((NULL != p_clock) && (p_clock->is_paused));
+
+        if (success) {
+                p_clock->paused_total_ms += (now_ms - p_clock->paused_at_ms);
+                p_clock->is_paused = false;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the time elapsed since the clock started, excluding pauses
+ *
+ * @note Unsigned arithmetic is used all along, so the result is correct across
+ *       a wrap around of the time source
+ *
+ * @param[in]           p_clock             Pointer to the clock to query
+ * @param[in]           now_ms              Current time in milliseconds
+ * @param[out]          p_elapsed_ms        Pointer where to store the elapsed
+ *                                          time in milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or clock not
+ *                                          running
+ */
+bool reflow_clock_get_elapsed(reflow_clock_t const * const p_clock,
+                              uint32_t const now_ms,
+                              uint32_t * const p_elapsed_ms)
+{
+        bool success = ((NULL != p_clock) &&
+                        (NULL != p_elapsed_ms) &&
+                        (p_clock->is_running));
+        uint32_t reference_ms;
+
+        if (success) {
+                reference_ms = now_ms;
+
+                if (p_clock->is_paused) {
+                        reference_ms = p_clock->paused_at_ms;
+                }
+
+                *p_elapsed_ms = reference_ms - p_clock->start_ms -
+                                p_clock->paused_total_ms;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the time left until a given period elapses, excluding pauses
+ *
+ * @param[in]           p_clock             Pointer to the clock to query
+ * @param[in]           now_ms              Current time in milliseconds
+ * @param[in]           period_ms           Period to measure against
+ * @param[out]          p_remaining_ms      Pointer where to store the
+ *                                          remaining time in milliseconds. It
+ *                                          saturates at 0 once the period
+ *                                          elapsed
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or clock not
+ *                                          running
+ */
+bool reflow_clock_get_remaining(reflow_clock_t const * const p_clock,
+                                uint32_t const now_ms,
+                                uint32_t const period_ms,
+                                uint32_t * const p_remaining_ms)
+{
+        uint32_t elapsed_ms = 0;
+        bool success = (NULL != p_remaining_ms);
+
+        if (success) {
+                success = reflow_clock_get_elapsed(p_clock, now_ms, &elapsed_ms);
+        }
+
+        if (success) {
+                *p_remaining_ms = 0;
+
+                if (period_ms > elapsed_ms) {
+                        *p_remaining_ms = period_ms - elapsed_ms;
+                }
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Query whether the clock is paused
+ *
+ * @param[in]           p_clock             Pointer to the clock to query
+ *
+ * @return              bool                Result of the query
+ */
+bool reflow_clock_is_paused(reflow_clock_t const * const p_clock)
+{
+        return ((NULL != p_clock) && (p_clock->is_paused));
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
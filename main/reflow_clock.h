@@ -0,0 +1,99 @@
+/*!
+ *******************************************************************************
+ * @file reflow_clock.h
+ *
+ * @brief Pausable monotonic clock used to measure the progress of a reflow
+ *        run or of one of its phases, excluding the time spent paused
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef REFLOW_CLOCK_H
+#define REFLOW_CLOCK_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Pausable clock object
+typedef struct {
+        //! @brief Time in milliseconds at which the clock was started
+        uint32_t start_ms;
+
+        //! @brief Time in milliseconds at which the clock was last paused
+        uint32_t paused_at_ms;
+
+        //! @brief Accumulated time in milliseconds spent paused
+        uint32_t paused_total_ms;
+
+        //! @brief Whether the clock was started
+        bool is_running;
+
+        //! @brief Whether the clock is currently paused
+        bool is_paused;
+} reflow_clock_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Start (or restart) the clock
+bool reflow_clock_start(reflow_clock_t * const p_clock, uint32_t const now_ms);
+
+//! @brief Stop the clock
+bool reflow_clock_stop(reflow_clock_t * const p_clock);
+
+//! @brief Freeze the clock
+bool reflow_clock_pause(reflow_clock_t * const p_clock, uint32_t const now_ms);
+
+//! @brief Continue counting from the point where the clock was frozen
+bool reflow_clock_resume(reflow_clock_t * const p_clock, uint32_t const now_ms);
+
+//! @brief Get the time elapsed since the clock started, excluding pauses
+bool reflow_clock_get_elapsed(reflow_clock_t const * const p_clock,
+                              uint32_t const now_ms,
+                              uint32_t * const p_elapsed_ms);
+
+//! @brief Get the time left until a given period elapses, excluding pauses
+bool reflow_clock_get_remaining(reflow_clock_t const * const p_clock,
+                                uint32_t const now_ms,
+                                uint32_t const period_ms,
+                                uint32_t * const p_remaining_ms);
+
+//! @brief Query whether the clock is paused
+bool reflow_clock_is_paused(reflow_clock_t const * const p_clock);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //REFLOW_CLOCK_H
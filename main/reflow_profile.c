@@ -23,13 +23,18 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <assert.h>
 #include "esp_log.h"
-#include <lvgl/src/lv_core/lv_style.h>
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 #include "nvs.h"
 #include "nvs_flash.h"
+#include "configuration.h"
 #include "reflow_profile.h"
+#include "reflow_profile_catalogue.h"
+#include "reflow_profile_codec.h"
+#include "reflow_profile_store.h"
 
 /*
  *******************************************************************************
@@ -41,6 +46,9 @@
 
 #define REFLOW_PROFILE_NVS_NAMESPACE                    "reflow_profile"
 #define REFLOW_PROFILE_NVS_NAMESPACE_INIT               "init"
+#define REFLOW_PROFILE_NVS_NAMESPACE_PROGRAM            "reflow_program"
+#define REFLOW_PROFILE_NVS_NAMESPACE_STORE              "profile_store"
+#define REFLOW_PROFILE_NVS_SNAPSHOT                     "catalogue"
 #define REFLOW_PROFILE_NVS_INITIALIZED                  "initialized"
 #define REFLOW_PROFILE_NVS_DEFAULT_PROFILE_NAME         "default_profile"
 
@@ -77,11 +85,35 @@ static bool is_valid_reflow_profile(reflow_profile_t const * const p_reflow_prof
 //! @brief Check whether the profile NVS section is initialized
 static bool is_profile_nvs_initialized(void);
 
-//! @brief Initialize NVS
-static bool initialize_profile_nvs(void);
+//! @brief Fill the catalogue for a device without stored profiles
+static bool load_factory_catalogue(void);
 
-//! @brief Print contents of the provided namespace
-static void print_namespace_contents(char const * const p_namespace);
+//! @brief Set the program of the current profile, and compile its trajectory
+static bool load_current_program(void);
+
+//! @brief Use the first profile that can be run, the factory one if none can
+static bool use_first_runnable_profile(void);
+
+//! @brief Fill the catalogue with the profiles and programs stored one per key
+static bool load_legacy_catalogue(void);
+
+//! @brief Read from NVS the name of the default profile stored on its own key
+static bool load_legacy_default_name(void);
+
+//! @brief Erase the namespaces where profiles were stored one per key
+static bool erase_legacy_namespaces(void);
+
+//! @brief Fill the catalogue from the snapshot stored in NVS
+static reflow_profile_store_error_t load_snapshot(uint8_t * const p_version);
+
+//! @brief Write the catalogue snapshot to NVS
+static bool write_snapshot(void);
+
+//! @brief Record a change of the catalogue to be written to NVS
+static void mark_dirty(void);
+
+//! @brief Get the current time in milliseconds
+static uint32_t get_time_ms(void);
 
 /*
  *******************************************************************************
@@ -102,6 +134,28 @@ static bool m_is_initialized = false;
 //! @brief Current reflow profile being used
 static reflow_profile_t m_reflow_profile;
 
+//! @brief Program run for the current reflow profile
+static reflow_program_t m_reflow_program;
+
+//! @brief Trajectory of the program run for the current reflow profile
+static reflow_trajectory_t m_reflow_trajectory;
+
+//! @brief Copy of the profiles and programs stored in NVS
+static reflow_profile_catalogue_t m_catalogue;
+
+//! @brief Copy of the default profile name stored in NVS
+static char m_default_name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+
+//! @brief Write-behind state of the catalogue
+static reflow_profile_store_t m_store;
+
+//! @brief Whether the stored snapshot is not to be written, as it was written
+//!        by a newer firmware in a format this one can't read
+static bool m_is_store_read_only = false;
+
+//! @brief Buffer to encode or decode the catalogue snapshot
+static uint8_t m_snapshot[REFLOW_PROFILE_STORE_SNAPSHOT_SIZE_MAX];
+
 //! @brief Reflow profile used for default or new profiles
 static reflow_profile_t const m_reflow_profile_factory = {
         REFLOW_PROFILE_DEFAULT_NAME,
@@ -136,19 +190,61 @@ static bool add_fake_profiles(void);
 bool reflow_profile_init(void)
 {
         bool success = !m_is_initialized;
+        bool has_legacy = false;
+        reflow_profile_store_error_t load_result = REFLOW_PROFILE_STORE_ERROR_SUCCESS;
+        uint8_t version = REFLOW_PROFILE_STORE_SNAPSHOT_VERSION;
         char default_name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
 
         if (success) {
-                // TODO: check for NVS initialized
+                success = reflow_profile_store_init(&m_store,
+                                                    CONFIGURATION_PROFILE_FLUSH_IDLE_MS,
+                                                    CONFIGURATION_PROFILE_FLUSH_MAX_DELAY_MS);
+        }
+
+        // From here on NVS is only touched to write the catalogue snapshot
+        if (success) {
+                has_legacy = is_profile_nvs_initialized();
+        }
+
+        if (success) {
+                load_result = load_snapshot(&version);
+        }
+
+        if ((success) && (REFLOW_PROFILE_STORE_ERROR_UNSUPPORTED == load_result)) {
+                // Don't lose the profiles of a newer firmware by overwriting
+                // them, run on the factory profile until it is installed back
+                ESP_LOGW(TAG, "Profiles written by a newer firmware, not used");
+                m_is_store_read_only = true;
+                success = load_factory_catalogue();
+        } else if ((success) && (REFLOW_PROFILE_STORE_ERROR_SUCCESS == load_result)) {
+                // Snapshots of an older format are written again in the
+                // current one
+                if (REFLOW_PROFILE_STORE_SNAPSHOT_VERSION > version) {
+                        mark_dirty();
+                        success = write_snapshot();
+                }
+        } else if (success) {
+                // Profiles stored one per key by a previous firmware are
+                // migrated to the snapshot, otherwise it is the first boot
+                if (has_legacy) {
+                        success = load_legacy_catalogue();
+
+                        if (success) {
+                                success = load_legacy_default_name();
+                        }
+                } else {
+                        success = load_factory_catalogue();
+                }
 
-                if (!is_profile_nvs_initialized()) {
-                        success = initialize_profile_nvs();
+                if (success) {
+                        mark_dirty();
+                        success = write_snapshot();
                 }
         }
 
-        // TODO: surround with debug macro
-        print_namespace_contents(REFLOW_PROFILE_NVS_NAMESPACE_INIT);
-        print_namespace_contents(REFLOW_PROFILE_NVS_NAMESPACE);
+        if ((success) && (has_legacy) && (!m_is_store_read_only)) {
+                success = erase_legacy_namespaces();
+        }
 
         if (success) {
                 m_is_initialized = true;
@@ -161,6 +257,16 @@ bool reflow_profile_init(void)
                                               &m_reflow_profile);
         }
 
+        if (success) {
+                success = load_current_program();
+        }
+
+        // Don't stop booting on a stored profile that can't be run
+        if ((m_is_initialized) && (!success)) {
+                ESP_LOGW(TAG, "Profile %s can't be run", default_name);
+                success = use_first_runnable_profile();
+        }
+
         return success;
 }
 
@@ -200,10 +306,10 @@ bool reflow_profile_are_equal(reflow_profile_t const * const p_reflow_profile_1,
  * @brief Save profile to NVS
  *
  * The function will take a pointer to the profile and validate it. If is valid,
- * it will try to save it to the NVS profile section
+ * it will save it to the catalogue, to be written to the NVS profile section
+ * later on.
  *
- * @warning This function is not checking for the amount of already saved
- *          profiles. This is caller responsibility.
+ * @note The NVS write is deferred, @see `reflow_profile_poll`
  *
  * @param[in]       p_reflow_profile        pointer to the `reflow_profile_t`
  *                                          to save
@@ -212,46 +318,39 @@ bool reflow_profile_are_equal(reflow_profile_t const * const p_reflow_profile_1,
  * @retval          true                    If everything went well
  * @retval          false                   If pointer was invalid, module not
  *                                          initialized, profile was invalid or
- *                                          couldn't be saved due to I/O failure
+ *                                          there is no room for a new profile
  */
 bool reflow_profile_save(reflow_profile_t const * const p_reflow_profile)
 {
         bool success = ((NULL != p_reflow_profile) && (m_is_initialized));
-        bool needs_close = false;
-        size_t const required_size = sizeof(reflow_profile_t);
-        esp_err_t result;
+        uint8_t slot;
 
         if (success) {
                 success = is_valid_reflow_profile(p_reflow_profile);
         }
 
-        if (success) {
-                result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE,
-                                  NVS_READWRITE,
-                                  &m_nvs_h);
-
-                success = (ESP_OK == result);
+        if ((success) &&
+            (!reflow_profile_catalogue_find(&m_catalogue,
+                                            p_reflow_profile->name,
+                                            &slot))) {
+                success = (REFLOW_PROFILES_MAX_PROFILES_CNT > m_catalogue.count);
         }
 
         if (success) {
-                needs_close = true;
-                result = nvs_set_blob(m_nvs_h,
-                                      p_reflow_profile->name,
-                                      p_reflow_profile,
-                                      required_size);
-
-                success = (ESP_OK == result);
+                success = reflow_profile_catalogue_put(&m_catalogue,
+                                                       p_reflow_profile);
         }
 
+        // A program stored for the profile would shadow the saved fields
         if (success) {
-                result = nvs_commit(m_nvs_h);
-
-                success = (ESP_OK == result);
-                ESP_LOGI(TAG, "Profile %s was saved", p_reflow_profile->name);
+                success = reflow_profile_catalogue_set_program(&m_catalogue,
+                                                               p_reflow_profile->name,
+                                                               NULL);
         }
 
-        if (needs_close) {
-                nvs_close(m_nvs_h);
+        if (success) {
+                mark_dirty();
+                ESP_LOGI(TAG, "Profile %s was saved", p_reflow_profile->name);
         }
 
         return success;
@@ -264,6 +363,9 @@ bool reflow_profile_save(reflow_profile_t const * const p_reflow_profile)
  *       it's not set as the current or default profile.
  *       @see `reflow_profile_use` and ``
  *
+ * @note Profiles are read from NVS once at initialization, this function
+ *       only copies them from the catalogue
+ *
  * @param[in]       p_name              Name of the profile to load
  * @param[out]      p_reflow_profile    Pointer to object where to store the
  *                                      profile at
@@ -271,54 +373,17 @@ bool reflow_profile_save(reflow_profile_t const * const p_reflow_profile)
  * @return          bool                Result of the operation
  * @retval          true                If everything went well
  * @retval          false               If a pointer was invalid, module not
- *                                      initialized, retrieved profile was
- *                                      invalid or couldn't be loaded due to an
- *                                      I/O failure
+ *                                      initialized or profile not found
  */
 bool reflow_profile_load(char const * const p_name,
                          reflow_profile_t * const p_reflow_profile)
 {
-        size_t required_size = sizeof(reflow_profile_t);
         bool success = m_is_initialized;
-        bool needs_close = false;
-        nvs_handle_t nvs_handle;
-        esp_err_t result;
-        reflow_profile_t reflow_profile_buffer;
-
-        if (success) {
-                success = (NULL != p_reflow_profile) && (NULL != p_name);
-        }
-
-        if (success) {
-                result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE,
-                                  NVS_READONLY,
-                                  &nvs_handle);
-
-                success = (ESP_OK == result);
-        }
-
-        if (success) {
-                needs_close = true;
-                result = nvs_get_blob(nvs_handle,
-                                      p_name,
-                                      &reflow_profile_buffer,
-                                      &required_size);
-
-                success = ((ESP_OK == result) &&
-                           (sizeof(reflow_profile_t) == required_size));
-        }
-
-        if (success) {
-                success = is_valid_reflow_profile(&reflow_profile_buffer);
-        }
 
         if (success) {
-                *p_reflow_profile = reflow_profile_buffer;
-                ESP_LOGI(TAG, "Profile %s was loaded", reflow_profile_buffer.name);
-        }
-
-        if (needs_close) {
-                nvs_close(nvs_handle);
+                success = reflow_profile_catalogue_get(&m_catalogue,
+                                                       p_name,
+                                                       p_reflow_profile);
         }
 
         return success;
@@ -327,8 +392,13 @@ bool reflow_profile_load(char const * const p_name,
 /*!
  * @brief Delete a `reflow_profile_t` from the NVS
  *
- * The function will search on the NVS for a key with the given name and delete
- * it if found
+ * The function will search on the catalogue for a profile with the given name
+ * and delete it if found, to be erased from the NVS later on. Deleting the
+ * default profile uses the first one left instead, so the device always boots
+ * on an existing profile. For the same reason, the last profile is never
+ * deleted
+ *
+ * @note The NVS write is deferred, @see `reflow_profile_poll`
  *
  * @param[in]       p_name                  pointer to a string containing the
  *                                          name of the `reflow_profile_t` to
@@ -338,39 +408,33 @@ bool reflow_profile_load(char const * const p_name,
  * @retval          true                    If everything went well
  * @retval          false                   If pointer was invalid, module not
  *                                          initialized, profile was not found
- *                                          or couldn't be deleted due to I/O
- *                                          failure
+ *                                          or is the last one
  */
 bool reflow_profile_delete(char const * const p_name)
 {
-        bool success = (m_is_initialized) && (NULL != p_name);
-        bool needs_close = false;
-        nvs_handle_t nvs_handle;
-        esp_err_t result;
+        bool success = (m_is_initialized) && (NULL != p_name) &&
+                       (1 < m_catalogue.count);
+        bool is_default = false;
+        char first_name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
 
         if (success) {
-                result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE,
-                                  NVS_READWRITE,
-                                  &nvs_handle);
-
-                success = (ESP_OK == result);
+                is_default = (0 == strcmp(m_default_name, p_name));
+                success = reflow_profile_catalogue_remove(&m_catalogue, p_name);
         }
 
         if (success) {
-                needs_close = true;
-                result = nvs_erase_key(nvs_handle, p_name);
+                mark_dirty();
+                ESP_LOGI(TAG, "Profile %s was deleted", p_name);
+        }
 
-                success = (ESP_OK == result);
+        if ((success) && (is_default)) {
+                success = reflow_profile_get_name_at(0, first_name);
 
                 if (success) {
-                        ESP_LOGI(TAG, "Profile %s was deleted", p_name);
+                        success = reflow_profile_use(first_name);
                 }
         }
 
-        if (needs_close) {
-                nvs_close(nvs_handle);
-        }
-
         return success;
 }
 
@@ -380,22 +444,24 @@ bool reflow_profile_delete(char const * const p_name)
  * This function will load a profile from a given `p_name` and will set it as
  * default in the NVS so it is used next time the device boots
  *
+ * @note The NVS write is deferred, @see `reflow_profile_poll`
+ *
  * @param               p_name              pointer to string holding the
  *                                          p_name of the profile to load
  *
  * @return              bool                Result of the operation
  * @retval              True                If everything went well
  * @retval              False               If pointer is null, module is not
- *                                          initialized, or there was a I/O
- *                                          error
+ *                                          initialized, profile was not found
+ *                                          or doesn't make a valid program, in
+ *                                          which case the current profile is
+ *                                          kept
  */
 bool reflow_profile_use(char const * p_name)
 {
         bool success = ((NULL != p_name) && (m_is_initialized));
-        bool needs_close = false;
-
         reflow_profile_t buffer_profile;
-        esp_err_t result;
+        reflow_profile_t previous_profile = m_reflow_profile;
 
         if (success) {
                 success = reflow_profile_load(p_name, &buffer_profile);
@@ -404,41 +470,33 @@ bool reflow_profile_use(char const * p_name)
         if (success) {
                 m_reflow_profile = buffer_profile;
 
-                result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_INIT,
-                                  NVS_READWRITE, &m_nvs_h);
-
-                success = (ESP_OK == result);
-        }
-
-        if (success) {
-                needs_close = true;
-                result = nvs_set_str(m_nvs_h,
-                                     REFLOW_PROFILE_NVS_DEFAULT_PROFILE_NAME,
-                                     m_reflow_profile.name);
+                success = load_current_program();
 
-                success = (ESP_OK == result);
+                // Profile, program and trajectory must keep matching
+                if (!success) {
+                        m_reflow_profile = previous_profile;
+                        (void)load_current_program();
+                        ESP_LOGE(TAG, "Profile %s can't be run", p_name);
+                }
         }
 
-        if (success) {
+        // Only write the default name if it changes
+        if ((success) && (0 != strcmp(m_default_name, m_reflow_profile.name))) {
+                strcpy(m_default_name, m_reflow_profile.name);
+                mark_dirty();
                 ESP_LOGI(TAG, "Profile %s is being used and set to default", m_reflow_profile.name);
-
-                result = nvs_commit(m_nvs_h);
-
-                success = (ESP_OK == result);
         }
 
-        if (needs_close) {
-                nvs_close(m_nvs_h);
-        }
-
-        printf("p_name %s\n", m_reflow_profile.name);
-        printf("preheat_temperature %d\n", m_reflow_profile.preheat_temperature);
-        printf("soak_time_s %d\n", m_reflow_profile.soak_time_s);
-        printf("reflow_temperature %d\n", m_reflow_profile.reflow_temperature);
-        printf("dwell_time_s %d\n", m_reflow_profile.dwell_time_s);
-        printf("cooling_temperature %d\n", m_reflow_profile.cooling_temperature);
-        printf("cooling_time_s %d\n", m_reflow_profile.cooling_time_s);
-        printf("ramp_speed %d\n", m_reflow_profile.ramp_speed);
+        ESP_LOGD(TAG, "Profile %s: preheat %d C, soak %d s, reflow %d C, "
+                 "dwell %d s, cooling %d C in %d s, ramp %d C/s",
+                 m_reflow_profile.name,
+                 m_reflow_profile.preheat_temperature,
+                 m_reflow_profile.soak_time_s,
+                 m_reflow_profile.reflow_temperature,
+                 m_reflow_profile.dwell_time_s,
+                 m_reflow_profile.cooling_temperature,
+                 m_reflow_profile.cooling_time_s,
+                 m_reflow_profile.ramp_speed);
 
         return success;
 }
@@ -449,52 +507,23 @@ bool reflow_profile_use(char const * p_name)
  * This function reads on the specific NVS section which profile is currently
  * being used at the time, or was being used last time that the device went off
  *
- * @param[in]           p_name              pointer to a string where to store
+ * @note The name is read from NVS once at initialization, and kept up to date
+ *       by `reflow_profile_use`
+ *
+ * @param[out]          p_name              pointer to a string where to store
  *                                          the default profile name to
  *
  * @return              bool                Result of the operation
  * @retval              True                If everything went well
- * @retval              False               If pointer is null, module is not
- *                                          initialized, or there was a I/O
- *                                          error
+ * @retval              False               If pointer is null or module is not
+ *                                          initialized
  */
-bool reflow_profile_get_default(char const * p_name)
+bool reflow_profile_get_default(char * const p_name)
 {
-
         bool success = ((NULL != p_name) && (m_is_initialized));
-        bool needs_close = false;
-        esp_err_t result;
-        size_t name_len = REFLOW_PROFILE_NAME_LEN_MAX;
-
-        if (success) {
-                result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_INIT,
-                                  NVS_READWRITE,
-                                  &m_nvs_h);
-
-                success = (ESP_OK == result);
-        }
-
-        if (success) {
-                needs_close = true;
-
-                result = nvs_get_str(m_nvs_h,
-                                     REFLOW_PROFILE_NVS_DEFAULT_PROFILE_NAME,
-                                     p_name,
-                                     &name_len);
-
-                success = (ESP_OK == result);
-        }
 
         if (success) {
-
-                ESP_LOGI(TAG, "Default profile is %s", p_name);
-                result = nvs_commit(m_nvs_h);
-
-                success = (ESP_OK == result);
-        }
-
-        if (needs_close) {
-                nvs_close(m_nvs_h);
+                strcpy(p_name, m_default_name);
         }
 
         return success;
@@ -526,189 +555,458 @@ bool reflow_profile_get_current(reflow_profile_t * const p_reflow_profile)
 }
 
 /*!
- * @brief Get a string with all the profile names stored in the NVS
+ * @brief Get the program run for the profile being used right now
  *
- * @warning This function allocates memory for providing the string object.
- *          Memory is only freed by the function if it was allocated and then a
- *          failure occured afterwards. Otherwise, its caller responsibility to
- *          free it
+ * It is the program stored for the profile, or if there is none, the program
+ * imported from the profile phases.
  *
- * @param[out]          p_profiles          Double pointer to store the pointer
- *                                          of the allocated list to.
- * @param[out]          p_size              Pointer to return the size of the
- *                                          allocated list.
+ * @param[out]          p_program           Pointer where to store the program
  *
  * @return              bool                Result of the operation
  * @retval              True                If everything went well
- * @retval              False               If a pointer is null, module is not
- *                                          initialized or allocation failed
+ * @retval              False               If pointer is null or module is not
+ *                                          initialized
  */
-bool reflow_profile_get_profiles_list(char ** p_profiles, size_t * const p_size)
+bool reflow_profile_get_current_program(reflow_program_t * const p_program)
 {
-        bool success = ((NULL != p_profiles) && (NULL != p_size));
-        char * buffer = NULL;
-        size_t counter = 0;
-        nvs_iterator_t iterator = nvs_entry_find("nvs",
-                                                 REFLOW_PROFILE_NVS_NAMESPACE,
-                                                 NVS_TYPE_ANY);
-        nvs_entry_info_t info;
-
-
-        while ((NULL != iterator) && (success)) {
-                nvs_entry_info(iterator, &info);
-                iterator = nvs_entry_next(iterator);
-                // adding space for the name but also for the \n character
-                counter += strlen(info.key) + 1;
-        }
-
-        if (success) {
-
-                iterator = nvs_entry_find("nvs",
-                                          REFLOW_PROFILE_NVS_NAMESPACE,
-                                          NVS_TYPE_ANY);
-
-                // adding space for the \0 terminator
-                buffer = pvPortMalloc(counter + 1);
-
-                success = (NULL != buffer);
-        }
-
-        if (success) {
-                strcpy(buffer, "");
-
-                while (NULL != iterator) {
-                        nvs_entry_info(iterator, &info);
-                        iterator = nvs_entry_next(iterator);
-                        strcat(buffer, info.key);
-                        strcat(buffer, "\n");
-                }
-        }
-
-        if (!success || (0 == strlen(buffer))) {
-                *p_size = 0;
-                success = false;
-                vPortFree(buffer);
-                buffer = NULL;
-        }
+        bool success = ((NULL != p_program) && (m_is_initialized));
 
         if (success) {
-                *p_profiles = buffer;
-                *p_size = counter;
-                ESP_LOGI(TAG, "Profiles list %s", buffer);
+                *p_program = m_reflow_program;
         }
 
         return success;
 }
 
 /*!
- * @brief Get default factory `reflow_profile_t` object
+ * @brief Get the name of the profile being used right now
  *
- * @param[out]          p_reflow_profile    Pointer to the object where to store
- *                                          the profile at
+ * @param[out]          pp_name             Pointer where to store the pointer
+ *                                          to the name. It is owned by the
+ *                                          module and valid until another
+ *                                          profile is used
  *
  * @return              bool                Result of the operation
  * @retval              True                If everything went well
- * @retval              False               If pointer is null
+ * @retval              False               If pointer is null or module is not
+ *                                          initialized
  */
-bool reflow_profile_get_factory_profile(reflow_profile_t * const p_reflow_profile)
+bool reflow_profile_get_current_name(char const ** const pp_name)
 {
-        bool success = (NULL != p_reflow_profile);
+        bool success = ((NULL != pp_name) && (m_is_initialized));
 
         if (success) {
-                *p_reflow_profile = m_reflow_profile_factory;
+                *pp_name = m_reflow_profile.name;
         }
 
         return success;
 }
 
-/*
- *******************************************************************************
- * Private Function Bodies                                                     *
- *******************************************************************************
- */
-
 /*!
- * @brief Validate given `reflow_profile_t` object
+ * @brief Get the intended trajectory of the profile being used right now
  *
- * The function will check that the profile fields are within the established
- * maximum and minimum values
+ * The trajectory is compiled once each time the profile or its program
+ * change, so consumers can look up the setpoint and phase at any time without
+ * copying the profile. It starts at `CONFIGURATION_AMBIENT_TEMPERATURE_C`.
  *
- * @param[in]           p_reflow_profile    Pointer to the object to validate
+ * @param[out]          pp_trajectory       Pointer where to store the pointer
+ *                                          to the trajectory. It is owned by
+ *                                          the module and valid until another
+ *                                          profile is used
  *
  * @return              bool                Result of the operation
- * @retval              True                If profile is valid
- * @retval              False               If pointer is null, or profile is
- *                                          invalid
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null or module is not
+ *                                          initialized
  */
-static bool is_valid_reflow_profile(reflow_profile_t const * const p_reflow_profile)
+bool reflow_profile_get_current_trajectory(reflow_trajectory_t const ** const pp_trajectory)
 {
-        bool success = (NULL != p_reflow_profile);
+        bool success = ((NULL != pp_trajectory) && (m_is_initialized));
 
-        if ((REFLOW_PROFILE_REFLOW_TEMP_MAX_C >=
-                                    p_reflow_profile->reflow_temperature) &&
-            (REFLOW_PROFILE_REFLOW_TEMP_MIN_C <=
-                                    p_reflow_profile->reflow_temperature) &&
-            (REFLOW_PROFILE_PREHEAT_TEMP_MAX_C >=
-                                   p_reflow_profile->preheat_temperature) &&
-            (REFLOW_PROFILE_REFLOW_TEMP_MIN_C <=
-                                   p_reflow_profile->preheat_temperature) &&
-            (REFLOW_PROFILE_COOLING_TEMP_MAX_C >=
-                                   p_reflow_profile->cooling_temperature) &&
-            (REFLOW_PROFILE_COOLING_TEMP_MIN_C <=
-                                   p_reflow_profile->cooling_temperature) &&
-            (REFLOW_PROFILE_DWELL_TIME_MAX_S >=
-                                         p_reflow_profile->dwell_time_s) &&
-            (REFLOW_PROFILE_DWELL_TIME_MIN_S <=
-                                         p_reflow_profile->dwell_time_s) &&
-            (REFLOW_PROFILE_SOAK_TIME_MAX_S >=
-                                          p_reflow_profile->soak_time_s) &&
-            (REFLOW_PROFILE_SOAK_TIME_MIN_S <=
-                                          p_reflow_profile->soak_time_s) &&
-            (REFLOW_PROFILE_COOLING_TIME_MAX_S >=
-                                          p_reflow_profile->cooling_time_s) &&
-            (REFLOW_PROFILE_COOLING_TIME_MIN_S <=
-                                          p_reflow_profile->cooling_time_s) &&
-            (REFLOW_PROFILE_RAMP_SPEED_MAX_CS >=
-                                          p_reflow_profile->ramp_speed) &&
-            (REFLOW_PROFILE_RAMP_SPEED_MIN_CS <=
-                                              p_reflow_profile->ramp_speed) &&
-            (REFLOW_PROFILE_NAME_LEN_MAX >= strlen(p_reflow_profile->name)))
-        {
-                success = true;
+        if (success) {
+                *pp_trajectory = &m_reflow_trajectory;
         }
+
         return success;
 }
 
 /*!
- * @brief Check whether the profile NVS section is initialized
+ * @brief Save to NVS the program to run for an existing profile
  *
- * The function will check that the profile fields are within the established
- * maximum and minimum values
+ * The program is stored in its compact encoding. It replaces the phases of
+ * the profile when running it, until the profile is saved again.
  *
- * @param               -                   -
+ * @note The NVS write is deferred, @see `reflow_profile_poll`
+ *
+ * @param[in]           p_name              Name of the profile
+ * @param[in]           p_program           Pointer to the program to save
  *
  * @return              bool                Result of the operation
- * @retval              True                If nvs section is initialized
- * @retval              False               If I/O error happened or nvs section
- *                                          is not initialized
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, module is not
+ *                                          initialized, the profile doesn't
+ *                                          exist or the program is invalid
  */
-static bool is_profile_nvs_initialized(void)
+bool reflow_profile_save_program(char const * const p_name,
+                                 reflow_program_t const * const p_program)
 {
-        uint8_t initialized = 0;
-        bool needs_close = false;
-        esp_err_t result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_INIT,
-                                            NVS_READWRITE,
-                                            &m_nvs_h);
-
-        bool success = (ESP_OK == result);
+        bool success = ((NULL != p_name) && (m_is_initialized));
 
         if (success) {
-                needs_close = true;
-
-                result = nvs_get_u8(m_nvs_h,
-                            REFLOW_PROFILE_NVS_INITIALIZED,
-                            &initialized);
-
+                success = reflow_program_is_valid(p_program);
+        }
+
+        if (success) {
+                success = reflow_profile_catalogue_set_program(&m_catalogue,
+                                                               p_name,
+                                                               p_program);
+        }
+
+        if (success) {
+                mark_dirty();
+                ESP_LOGI(TAG, "Program for %s was saved, %d segments", p_name,
+                         p_program->segment_count);
+        }
+
+        if ((success) && (0 == strcmp(p_name, m_reflow_profile.name))) {
+                success = load_current_program();
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Load from NVS the program stored for a profile
+ *
+ * @param[in]           p_name              Name of the profile
+ * @param[out]          p_program           Pointer where to store the program
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, module is not
+ *                                          initialized or there is no program
+ *                                          stored for the profile
+ */
+bool reflow_profile_load_program(char const * const p_name,
+                                 reflow_program_t * const p_program)
+{
+        bool success = ((NULL != p_name) && (m_is_initialized));
+
+        if (success) {
+                success = reflow_profile_catalogue_get_program(&m_catalogue,
+                                                               p_name,
+                                                               p_program);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get a string with all the profile names stored in the NVS
+ *
+ * Names are separated with `\n`, as `lv_ddlist_set_options` expects them.
+ *
+ * @note The list is owned by the module, and is valid until a profile is
+ *       saved or deleted
+ *
+ * @param[out]          pp_profiles         Pointer where to store the pointer
+ *                                          to the list
+ * @param[out]          p_size              Pointer to return the length of the
+ *                                          list
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, module is not
+ *                                          initialized or there are no profiles
+ */
+bool reflow_profile_get_profiles_list(char const ** const pp_profiles,
+                                      size_t * const p_size)
+{
+        bool success = m_is_initialized;
+
+        if (success) {
+                success = reflow_profile_catalogue_get_list(&m_catalogue,
+                                                            pp_profiles,
+                                                            p_size);
+        }
+
+        if (success) {
+                success = (0 < *p_size);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the number of profiles stored in the NVS
+ *
+ * @param[out]          p_count             Pointer where to store the count
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null or module is not
+ *                                          initialized
+ */
+bool reflow_profile_get_profiles_count(uint8_t * const p_count)
+{
+        bool success = ((NULL != p_count) && (m_is_initialized));
+
+        if (success) {
+                *p_count = m_catalogue.count;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the position of a profile in the profiles list
+ *
+ * @param[in]           p_name              Name of the profile
+ * @param[out]          p_position          Pointer where to store the position
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, module is not
+ *                                          initialized or profile not found
+ */
+bool reflow_profile_get_position(char const * const p_name,
+                                 uint8_t * const p_position)
+{
+        bool success = m_is_initialized;
+
+        if (success) {
+                success = reflow_profile_catalogue_find(&m_catalogue,
+                                                        p_name,
+                                                        p_position);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the name of the profile at a position of the profiles list
+ *
+ * @param[in]           position            Position in the list
+ * @param[out]          p_name              Pointer to a string where to store
+ *                                          the name to
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null, module is not
+ *                                          initialized or position is out of
+ *                                          the list
+ */
+bool reflow_profile_get_name_at(uint8_t const position, char * const p_name)
+{
+        bool success = ((NULL != p_name) &&
+                        (m_is_initialized) &&
+                        (m_catalogue.count > position));
+
+        if (success) {
+                strcpy(p_name, m_catalogue.slots[position].profile.name);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Write to NVS the pending changes to the profiles, if any
+ *
+ * All the changes done since the last write are written at once.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If module is not initialized or
+ *                                          there was an I/O error
+ */
+bool reflow_profile_flush(void)
+{
+        bool success = m_is_initialized;
+
+        if ((success) && (m_store.is_dirty)) {
+                success = write_snapshot();
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Write to NVS the pending changes to the profiles, once due
+ *
+ * Changes are written once none came for
+ * `CONFIGURATION_PROFILE_FLUSH_IDLE_MS`, or once the oldest of them waited for
+ * `CONFIGURATION_PROFILE_FLUSH_MAX_DELAY_MS`. A power loss before that loses
+ * them, but never leaves the stored profiles half written.
+ *
+ * @note This function is to be called periodically from the task using the
+ *       rest of the module
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If nothing was due or everything
+ *                                          went well
+ * @retval              False               If module is not initialized or
+ *                                          there was an I/O error
+ */
+bool reflow_profile_poll(void)
+{
+        bool success = m_is_initialized;
+
+        if ((success) &&
+            (reflow_profile_store_is_flush_due(&m_store, get_time_ms()))) {
+                success = write_snapshot();
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the number of NVS writes and erases done by the module
+ *
+ * @param[out]          p_write_count       Pointer where to store the number of
+ *                                          values written
+ * @param[out]          p_erase_count       Pointer where to store the number of
+ *                                          values or namespaces erased
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null
+ */
+bool reflow_profile_get_nvs_stats(uint32_t * const p_write_count,
+                                  uint32_t * const p_erase_count)
+{
+        bool success = ((NULL != p_write_count) && (NULL != p_erase_count));
+
+        if (success) {
+                *p_write_count = m_store.stats.write_count;
+                *p_erase_count = m_store.stats.erase_count;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get default factory `reflow_profile_t` object
+ *
+ * @param[out]          p_reflow_profile    Pointer to the object where to store
+ *                                          the profile at
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool reflow_profile_get_factory_profile(reflow_profile_t * const p_reflow_profile)
+{
+        bool success = (NULL != p_reflow_profile);
+
+        if (success) {
+                *p_reflow_profile = m_reflow_profile_factory;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Validate given `reflow_profile_t` object
+ *
+ * The function will check that the profile fields are within the established
+ * maximum and minimum values, and that the profile makes a valid program, so
+ * it can be run
+ *
+ * @param[in]           p_reflow_profile    Pointer to the object to validate
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If profile is valid
+ * @retval              False               If pointer is null, or profile is
+ *                                          invalid
+ */
+static bool is_valid_reflow_profile(reflow_profile_t const * const p_reflow_profile)
+{
+        reflow_program_t program;
+        bool success = false;
+
+        if ((NULL != p_reflow_profile) &&
+            (REFLOW_PROFILE_REFLOW_TEMP_MAX_C >=
+                                    p_reflow_profile->reflow_temperature) &&
+            (REFLOW_PROFILE_REFLOW_TEMP_MIN_C <=
+                                    p_reflow_profile->reflow_temperature) &&
+            (REFLOW_PROFILE_PREHEAT_TEMP_MAX_C >=
+                                   p_reflow_profile->preheat_temperature) &&
+            (REFLOW_PROFILE_PREHEAT_TEMP_MIN_C <=
+                                   p_reflow_profile->preheat_temperature) &&
+            (REFLOW_PROFILE_COOLING_TEMP_MAX_C >=
+                                   p_reflow_profile->cooling_temperature) &&
+            (REFLOW_PROFILE_COOLING_TEMP_MIN_C <=
+                                   p_reflow_profile->cooling_temperature) &&
+            (REFLOW_PROFILE_DWELL_TIME_MAX_S >=
+                                         p_reflow_profile->dwell_time_s) &&
+            (REFLOW_PROFILE_DWELL_TIME_MIN_S <=
+                                         p_reflow_profile->dwell_time_s) &&
+            (REFLOW_PROFILE_SOAK_TIME_MAX_S >=
+                                          p_reflow_profile->soak_time_s) &&
+            (REFLOW_PROFILE_SOAK_TIME_MIN_S <=
+                                          p_reflow_profile->soak_time_s) &&
+            (REFLOW_PROFILE_COOLING_TIME_MAX_S >=
+                                          p_reflow_profile->cooling_time_s) &&
+            (REFLOW_PROFILE_COOLING_TIME_MIN_S <=
+                                          p_reflow_profile->cooling_time_s) &&
+            (REFLOW_PROFILE_RAMP_SPEED_MAX_CS >=
+                                          p_reflow_profile->ramp_speed) &&
+            (REFLOW_PROFILE_RAMP_SPEED_MIN_CS <=
+                                              p_reflow_profile->ramp_speed) &&
+            (0 < strlen(p_reflow_profile->name)) &&
+            (REFLOW_PROFILE_NAME_LEN_MAX >= strlen(p_reflow_profile->name)))
+        {
+                success = true;
+        }
+
+        // Fields within limits can still add up to too long above liquidus
+        if (success) {
+                success = reflow_program_from_profile(p_reflow_profile, &program);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Check whether the profile NVS section is initialized
+ *
+ * The function will check that the profile fields are within the established
+ * maximum and minimum values
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If nvs section is initialized
+ * @retval              False               If I/O error happened or nvs section
+ *                                          is not initialized
+ */
+static bool is_profile_nvs_initialized(void)
+{
+        uint8_t initialized = 0;
+        bool needs_close = false;
+        esp_err_t result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_INIT,
+                                            NVS_READONLY,
+                                            &m_nvs_h);
+
+        bool success = (ESP_OK == result);
+
+        if (success) {
+                needs_close = true;
+
+                result = nvs_get_u8(m_nvs_h,
+                            REFLOW_PROFILE_NVS_INITIALIZED,
+                            &initialized);
+
         }
 
         if ((ESP_OK == result) && (1 == initialized)) {
@@ -727,82 +1025,426 @@ static bool is_profile_nvs_initialized(void)
 }
 
 /*!
- * @brief Initialize NVS
+ * @brief Fill the catalogue for a device without stored profiles
  *
- * The function will save default values to both INIT and PROFILE NVS
+ * The catalogue holds the factory profile, which is also the default one
  *
  * @param               -                   -
  *
  * @return              bool                Result of the operation
- * @retval              True                If nvs section is initialized
- * @retval              False               If I/O error occurred
+ * @retval              True                If everything went well
+ * @retval              False               If the catalogue couldn't be filled
  */
-static bool initialize_profile_nvs(void)
+static bool load_factory_catalogue(void)
 {
-        bool needs_close = false;
-        size_t const profile_size = sizeof(m_reflow_profile_factory);
-        esp_err_t result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_INIT,
-                                    NVS_READWRITE,
-                                    &m_nvs_h);
+        bool success = reflow_profile_catalogue_init(&m_catalogue);
+
+        if (success) {
+                success = reflow_profile_catalogue_put(&m_catalogue,
+                                                       &m_reflow_profile_factory);
+        }
 
-        bool success;
+        if (success) {
+                strcpy(m_default_name, m_reflow_profile_factory.name);
+        }
 
-        success = (ESP_OK == result);
+        return success;
+}
+
+/*!
+ * @brief Set the program of the current profile, and compile its trajectory
+ *
+ * The program stored for the profile is used if there is one, otherwise the
+ * program is imported from the profile phases.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If the current profile can't be
+ *                                          imported as a valid program
+ */
+static bool load_current_program(void)
+{
+        bool success = reflow_profile_load_program(m_reflow_profile.name,
+                                                   &m_reflow_program);
+
+        if (!success) {
+                success = reflow_program_from_profile(&m_reflow_profile,
+                                                      &m_reflow_program);
+        }
 
         if (success) {
-                needs_close = true;
-                result = nvs_set_u8(m_nvs_h,
-                                    REFLOW_PROFILE_NVS_INITIALIZED,
-                                    1);
-                success = (ESP_OK == result);
+                success = reflow_trajectory_compile(&m_reflow_program,
+                                                    CONFIGURATION_AMBIENT_TEMPERATURE_C,
+                                                    &m_reflow_trajectory);
         }
 
+        return success;
+}
+
+/*!
+ * @brief Use the first profile that can be run, the factory one if none can
+ *
+ * Profiles stored by an older firmware may no longer make a valid program.
+ * The factory profile is added to the catalogue if none of them does, and is
+ * only run without being stored if there is no room for it.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If not even the factory profile
+ *                                          could be run
+ */
+static bool use_first_runnable_profile(void)
+{
+        char name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+        bool success = false;
+        uint8_t i;
+
+        for (i = 0; (!success) && (m_catalogue.count > i); i++) {
+                success = ((reflow_profile_get_name_at(i, name)) &&
+                           (reflow_profile_use(name)));
+        }
+
+        if (!success) {
+                success = ((reflow_profile_save(&m_reflow_profile_factory)) &&
+                           (reflow_profile_use(m_reflow_profile_factory.name)));
+        }
+
+        if (!success) {
+                m_reflow_profile = m_reflow_profile_factory;
+                success = load_current_program();
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Read from NVS the name of the default profile stored on its own key
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If there was a I/O error
+ */
+static bool load_legacy_default_name(void)
+{
+        bool needs_close = false;
+        size_t name_len = sizeof(m_default_name);
+        esp_err_t result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_INIT,
+                                    NVS_READONLY,
+                                    &m_nvs_h);
+        bool success = (ESP_OK == result);
+
         if (success) {
-                result = nvs_set_str(m_nvs_h,
+                needs_close = true;
+
+                result = nvs_get_str(m_nvs_h,
                                      REFLOW_PROFILE_NVS_DEFAULT_PROFILE_NAME,
-                                     REFLOW_PROFILE_DEFAULT_NAME);
+                                     m_default_name,
+                                     &name_len);
 
                 success = (ESP_OK == result);
         }
 
         if (success) {
-                result = nvs_commit(m_nvs_h);
-                success = (ESP_OK == result);
+                ESP_LOGI(TAG, "Default profile is %s", m_default_name);
         }
 
         if (needs_close) {
                 nvs_close(m_nvs_h);
-                needs_close = false;
         }
 
+        return success;
+}
+
+/*!
+ * @brief Fill the catalogue with the profiles and programs stored one per key
+ *
+ * Entries which can't be read or are invalid are skipped, as they would have
+ * been refused when loading them.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If the profiles namespace couldn't
+ *                                          be opened
+ */
+static bool load_legacy_catalogue(void)
+{
+        reflow_profile_t reflow_profile;
+        reflow_program_t program;
+        uint8_t encoded_profile[REFLOW_PROFILE_CODEC_LEGACY_SIZE];
+        uint8_t encoded[REFLOW_PROGRAM_ENCODED_SIZE_MAX];
+        size_t required_size;
+        nvs_handle_t nvs_handle;
+        nvs_entry_info_t info;
+        nvs_iterator_t iterator;
+        esp_err_t result;
+        bool success = reflow_profile_catalogue_init(&m_catalogue);
+
         if (success) {
                 result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE,
-                                  NVS_READWRITE, &m_nvs_h);
+                                  NVS_READONLY,
+                                  &nvs_handle);
+
+                success = (ESP_OK == result);
+        }
+
+        if (success) {
+                iterator = nvs_entry_find(NVS_DEFAULT_PART_NAME,
+                                          REFLOW_PROFILE_NVS_NAMESPACE,
+                                          NVS_TYPE_ANY);
+
+                while (NULL != iterator) {
+                        nvs_entry_info(iterator, &info);
+                        iterator = nvs_entry_next(iterator);
+                        required_size = sizeof(encoded_profile);
+
+                        result = nvs_get_blob(nvs_handle,
+                                              info.key,
+                                              encoded_profile,
+                                              &required_size);
+
+                        if ((ESP_OK == result) &&
+                            (reflow_profile_codec_decode_legacy(encoded_profile,
+                                                                required_size,
+                                                                &reflow_profile)) &&
+                            (is_valid_reflow_profile(&reflow_profile))) {
+                                (void)reflow_profile_catalogue_put(&m_catalogue,
+                                                                   &reflow_profile);
+                        } else {
+                                ESP_LOGW(TAG, "Profile %s skipped", info.key);
+                        }
+                }
+
+                nvs_close(nvs_handle);
+        }
+
+        // The namespace doesn't exist until a program is saved
+        if ((success) &&
+            (ESP_OK == nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_PROGRAM,
+                                NVS_READONLY,
+                                &nvs_handle))) {
+                iterator = nvs_entry_find(NVS_DEFAULT_PART_NAME,
+                                          REFLOW_PROFILE_NVS_NAMESPACE_PROGRAM,
+                                          NVS_TYPE_ANY);
+
+                while (NULL != iterator) {
+                        nvs_entry_info(iterator, &info);
+                        iterator = nvs_entry_next(iterator);
+                        required_size = sizeof(encoded);
+
+                        result = nvs_get_blob(nvs_handle,
+                                              info.key,
+                                              encoded,
+                                              &required_size);
+
+                        if ((ESP_OK == result) &&
+                            (reflow_program_decode(encoded, required_size, &program))) {
+                                (void)reflow_profile_catalogue_set_program(&m_catalogue,
+                                                                           info.key,
+                                                                           &program);
+                        }
+                }
+
+                nvs_close(nvs_handle);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Erase the namespaces where profiles were stored one per key
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If there was an I/O error
+ */
+static bool erase_legacy_namespaces(void)
+{
+        char const * const namespaces[] = {
+                REFLOW_PROFILE_NVS_NAMESPACE,
+                REFLOW_PROFILE_NVS_NAMESPACE_PROGRAM,
+                REFLOW_PROFILE_NVS_NAMESPACE_INIT,
+        };
+        nvs_handle_t nvs_handle;
+        esp_err_t result = ESP_OK;
+        size_t i;
+
+        for (i = 0; (ESP_OK == result) && ((sizeof(namespaces) / sizeof(namespaces[0])) > i); i++) {
+                result = nvs_open(namespaces[i], NVS_READWRITE, &nvs_handle);
+
+                if (ESP_OK == result) {
+                        result = nvs_erase_all(nvs_handle);
+                        m_store.stats.erase_count++;
+
+                        if (ESP_OK == result) {
+                                result = nvs_commit(nvs_handle);
+                        }
+
+                        nvs_close(nvs_handle);
+                }
+        }
+
+        if (ESP_OK == result) {
+                ESP_LOGI(TAG, "Profiles stored one per key were migrated");
+        }
+
+        return (ESP_OK == result);
+}
+
+/*!
+ * @brief Fill the catalogue from the snapshot stored in NVS
+ *
+ * @param[out]          p_version           Pointer where to store the version
+ *                                          of the snapshot
+ *
+ * @return              reflow_profile_store_error_t
+ *                                          Result of the operation
+ * @retval              REFLOW_PROFILE_STORE_ERROR_SUCCESS
+ *                                          If everything went well
+ * @retval              REFLOW_PROFILE_STORE_ERROR_CORRUPTED
+ *                                          If there is no snapshot, it can't
+ *                                          be read or it is malformed
+ * @retval              REFLOW_PROFILE_STORE_ERROR_UNSUPPORTED
+ *                                          If the snapshot was written by a
+ *                                          newer firmware, in a format this
+ *                                          one can't read
+ */
+static reflow_profile_store_error_t load_snapshot(uint8_t * const p_version)
+{
+        reflow_profile_store_error_t load_result = REFLOW_PROFILE_STORE_ERROR_CORRUPTED;
+        size_t size = sizeof(m_snapshot);
+        bool needs_close = false;
+        nvs_handle_t nvs_handle;
+        esp_err_t result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_STORE,
+                                    NVS_READONLY,
+                                    &nvs_handle);
+
+        if (ESP_OK == result) {
+                needs_close = true;
+                result = nvs_get_blob(nvs_handle,
+                                      REFLOW_PROFILE_NVS_SNAPSHOT,
+                                      m_snapshot,
+                                      &size);
+        }
+
+        if (ESP_OK == result) {
+                load_result = reflow_profile_store_decode(m_snapshot,
+                                                          size,
+                                                          &m_catalogue,
+                                                          m_default_name,
+                                                          p_version);
+        } else if (ESP_ERR_NVS_INVALID_LENGTH == result) {
+                // Larger than any snapshot this firmware writes, so it comes
+                // from a newer one
+                load_result = REFLOW_PROFILE_STORE_ERROR_UNSUPPORTED;
+        }
+
+        if (needs_close) {
+                nvs_close(nvs_handle);
+        }
+
+        return load_result;
+}
+
+/*!
+ * @brief Write the catalogue snapshot to NVS
+ *
+ * The whole catalogue goes in a single blob, which NVS replaces atomically
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If there was an I/O error
+ */
+static bool write_snapshot(void)
+{
+        size_t size = 0;
+        bool needs_close = false;
+        nvs_handle_t nvs_handle;
+        esp_err_t result;
+        bool success = reflow_profile_store_encode(&m_catalogue,
+                                                   m_default_name,
+                                                   m_snapshot,
+                                                   sizeof(m_snapshot),
+                                                   &size);
+
+        if (success) {
+                result = nvs_open(REFLOW_PROFILE_NVS_NAMESPACE_STORE,
+                                  NVS_READWRITE,
+                                  &nvs_handle);
+
                 success = (ESP_OK == result);
         }
 
         if (success) {
                 needs_close = true;
-                result = nvs_set_blob(m_nvs_h,
-                                      m_reflow_profile_factory.name,
-                                      &m_reflow_profile_factory,
-                                      profile_size);
+                result = nvs_set_blob(nvs_handle,
+                                      REFLOW_PROFILE_NVS_SNAPSHOT,
+                                      m_snapshot,
+                                      size);
+                m_store.stats.write_count++;
 
                 success = (ESP_OK == result);
         }
 
         if (success) {
-                result = nvs_commit(m_nvs_h);
+                result = nvs_commit(nvs_handle);
+
                 success = (ESP_OK == result);
         }
 
         if (needs_close) {
-                nvs_close(m_nvs_h);
+                nvs_close(nvs_handle);
+        }
+
+        if (success) {
+                (void)reflow_profile_store_mark_flushed(&m_store);
+                ESP_LOGI(TAG, "Profiles were written, %d bytes", size);
+        } else {
+                (void)reflow_profile_store_mark_failed(&m_store, get_time_ms());
         }
 
         return success;
 }
 
+/*!
+ * @brief Record a change of the catalogue to be written to NVS
+ *
+ * Changes are only kept in RAM while the stored snapshot is read only.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void mark_dirty(void)
+{
+        if (!m_is_store_read_only) {
+                (void)reflow_profile_store_mark_dirty(&m_store, get_time_ms());
+        }
+}
+
+/*!
+ * @brief Get the current time in milliseconds
+ *
+ * @param               -                   -
+ *
+ * @return              uint32_t            Current time in milliseconds
+ */
+static uint32_t get_time_ms(void)
+{
+        return pdTICKS_TO_MS(xTaskGetTickCount());
+}
+
 //TODO: remove after development done
 static bool add_fake_profiles(void)
 {
@@ -819,27 +1461,6 @@ static bool add_fake_profiles(void)
 
         return success;
 }
-/*!
- * @brief Print contents of the provided namespace
- *
- * @param               p_namespace         Pointer to the namespace string to
- *                                          print the contents from
- *
- * @return              -                   -
- */
-static void print_namespace_contents(char const * const p_namespace)
-{
-        nvs_entry_info_t info;
-        nvs_iterator_t iterator = nvs_entry_find("nvs",
-                                                 p_namespace,
-                                                 NVS_TYPE_ANY);
-        while (NULL != iterator) {
-                nvs_entry_info(iterator, &info);
-                iterator = nvs_entry_next(iterator);
-                printf("key '%s', type '%d' \n", info.key, info.type);
-        }
-
-}
 
 /*
  *******************************************************************************
@@ -87,6 +87,10 @@ typedef struct {
         uint16_t ramp_speed;
 } reflow_profile_t;
 
+// Programs are built from profiles, so they are declared after them
+#include "reflow_program.h"
+#include "reflow_trajectory.h"
+
 /*
  *******************************************************************************
  * Public Constants                                                            *
@@ -118,15 +122,52 @@ bool reflow_profile_use(char const * p_name);
 //! @brief Get from module variable a `reflow_profile_t` object being used right
 bool reflow_profile_get_current(reflow_profile_t * const p_reflow_profile);
 
+//! @brief Get the program run for the profile being used right now
+bool reflow_profile_get_current_program(reflow_program_t * const p_program);
+
+//! @brief Get the name of the profile being used right now
+bool reflow_profile_get_current_name(char const ** const pp_name);
+
+//! @brief Get the intended trajectory of the profile being used right now
+bool reflow_profile_get_current_trajectory(reflow_trajectory_t const ** const pp_trajectory);
+
+//! @brief Save to NVS the program to run for an existing profile
+bool reflow_profile_save_program(char const * const p_name,
+                                 reflow_program_t const * const p_program);
+
+//! @brief Load from NVS the program stored for a profile
+bool reflow_profile_load_program(char const * const p_name,
+                                 reflow_program_t * const p_program);
+
 //! @brief Get a string with all the profile names stored in the NVS
-bool reflow_profile_get_profiles_list(char ** p_profiles,
+bool reflow_profile_get_profiles_list(char const ** const pp_profiles,
                                       size_t * const p_size);
 
+//! @brief Get the number of profiles stored in the NVS
+bool reflow_profile_get_profiles_count(uint8_t * const p_count);
+
+//! @brief Get the position of a profile in the profiles list
+bool reflow_profile_get_position(char const * const p_name,
+                                 uint8_t * const p_position);
+
+//! @brief Get the name of the profile at a position of the profiles list
+bool reflow_profile_get_name_at(uint8_t const position, char * const p_name);
+
+//! @brief Write to NVS the pending changes to the profiles, if any
+bool reflow_profile_flush(void);
+
+//! @brief Write to NVS the pending changes to the profiles, once due
+bool reflow_profile_poll(void);
+
+//! @brief Get the number of NVS writes and erases done by the module
+bool reflow_profile_get_nvs_stats(uint32_t * const p_write_count,
+                                  uint32_t * const p_erase_count);
+
 //! @brief Get default factory `reflow_profile_t` object
 bool reflow_profile_get_factory_profile(reflow_profile_t * const p_reflow_profile);
 
 //! @brief Get from NVS the default profile to be used
-bool reflow_profile_get_default(char const * p_name);
+bool reflow_profile_get_default(char * const p_name);
 
 //! @brief Determine whether two profiles are identical
 bool reflow_profile_are_equal(reflow_profile_t const * const p_reflow_profile_1,
@@ -0,0 +1,392 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_catalogue.c
+ *
+ * @brief In-RAM catalogue of the reflow profiles stored in the NVS, with
+ *        their programs and the list of their names, so that the NVS is only
+ *        read once and then touched on writes only
+ *
+ * The catalogue doesn't access the NVS by itself, the owner mirrors on it
+ * every write done to the NVS. Slots are kept packed and in the order of the
+ * names list, so the slot of a profile is also its position on the dropdown.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "reflow_profile_catalogue.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Build the names list again from the slots
+static void build_list(reflow_profile_catalogue_t * const p_catalogue);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Empty the catalogue
+ *
+ * @param[out]          p_catalogue         Pointer to the catalogue
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_profile_catalogue_init(reflow_profile_catalogue_t * const p_catalogue)
+{
+        bool success = (NULL != p_catalogue);
+
+        if (success) {
+                p_catalogue->count = 0;
+                p_catalogue->list[0] = '\0';
+                p_catalogue->list_len = 0;
+                p_catalogue->is_list_dirty = false;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the slot holding the profile with the given name
+ *
+ * @param[in]           p_catalogue         Pointer to the catalogue
+ * @param[in]           p_name              Name of the profile
+ * @param[out]          p_slot              Pointer where to store the slot,
+ *                                          which is also the position of the
+ *                                          profile in the names list
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or profile not
+ *                                          found
+ */
+bool reflow_profile_catalogue_find(reflow_profile_catalogue_t const * const p_catalogue,
+                                   char const * const p_name,
+                                   uint8_t * const p_slot)
+{
+        bool success = ((NULL != p_catalogue) &&
+                        (NULL != p_name) &&
+                        (NULL != p_slot));
+        bool found = false;
+        uint8_t i;
+
+        // There are a handful of slots at most, a linear scan beats any index
+        for (i = 0; (success) && (!found) && (p_catalogue->count > i); i++) {
+                found = (0 == strcmp(p_catalogue->slots[i].profile.name, p_name));
+
+                if (found) {
+                        *p_slot = i;
+                }
+        }
+
+        return found;
+}
+
+/*!
+ * @brief Get a copy of the profile with the given name
+ *
+ * @param[in]           p_catalogue         Pointer to the catalogue
+ * @param[in]           p_name              Name of the profile
+ * @param[out]          p_reflow_profile    Pointer where to store the profile
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or profile not
+ *                                          found
+ */
+bool reflow_profile_catalogue_get(reflow_profile_catalogue_t const * const p_catalogue,
+                                  char const * const p_name,
+                                  reflow_profile_t * const p_reflow_profile)
+{
+        uint8_t slot = 0;
+        bool success = (NULL != p_reflow_profile);
+
+        if (success) {
+                success = reflow_profile_catalogue_find(p_catalogue, p_name, &slot);
+        }
+
+        if (success) {
+                *p_reflow_profile = p_catalogue->slots[slot].profile;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Add a profile, or replace the one with the same name
+ *
+ * A replaced profile keeps its slot, and its program if any. New profiles
+ * are appended at the end of the names list.
+ *
+ * @param[in,out]       p_catalogue         Pointer to the catalogue
+ * @param[in]           p_reflow_profile    Pointer to the profile to add
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or catalogue
+ *                                          full
+ */
+bool reflow_profile_catalogue_put(reflow_profile_catalogue_t * const p_catalogue,
+                                  reflow_profile_t const * const p_reflow_profile)
+{
+        bool success = ((NULL != p_catalogue) && (NULL != p_reflow_profile));
+        bool is_new = false;
+        uint8_t slot = 0;
+
+        if (success) {
+                is_new = !reflow_profile_catalogue_find(p_catalogue,
+                                                        p_reflow_profile->name,
+                                                        &slot);
+        }
+
+        if ((success) && (is_new)) {
+                success = (REFLOW_PROFILE_CATALOGUE_SLOTS_CNT > p_catalogue->count);
+                slot = p_catalogue->count;
+        }
+
+        if (success) {
+                p_catalogue->slots[slot].profile = *p_reflow_profile;
+
+                if (is_new) {
+                        p_catalogue->slots[slot].has_program = false;
+                        p_catalogue->count++;
+                        p_catalogue->is_list_dirty = true;
+                }
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Remove the profile with the given name
+ *
+ * The following slots are moved one position back, so the names list keeps
+ * its order.
+ *
+ * @param[in,out]       p_catalogue         Pointer to the catalogue
+ * @param[in]           p_name              Name of the profile to remove
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or profile not
+ *                                          found
+ */
+bool reflow_profile_catalogue_remove(reflow_profile_catalogue_t * const p_catalogue,
+                                     char const * const p_name)
+{
+        uint8_t slot = 0;
+        bool success = reflow_profile_catalogue_find(p_catalogue, p_name, &slot);
+
+        if (success) {
+                p_catalogue->count--;
+
+                memmove(&p_catalogue->slots[slot],
+                        &p_catalogue->slots[slot + 1],
+                        (p_catalogue->count - slot) * sizeof(p_catalogue->slots[0]));
+
+                p_catalogue->is_list_dirty = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Set or clear the program stored for a profile
+ *
+ * @param[in,out]       p_catalogue         Pointer to the catalogue
+ * @param[in]           p_name              Name of the profile
+ * @param[in]           p_program           Pointer to the program, or NULL if
+ *                                          there is no program stored anymore
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or profile not
+ *                                          found
+ */
+bool reflow_profile_catalogue_set_program(reflow_profile_catalogue_t * const p_catalogue,
+                                          char const * const p_name,
+                                          reflow_program_t const * const p_program)
+{
+        uint8_t slot = 0;
+        bool success = reflow_profile_catalogue_find(p_catalogue, p_name, &slot);
+
+        if (success) {
+                p_catalogue->slots[slot].has_program = (NULL != p_program);
+
+                if (NULL != p_program) {
+                        p_catalogue->slots[slot].program = *p_program;
+                }
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the program stored for a profile
+ *
+ * @param[in]           p_catalogue         Pointer to the catalogue
+ * @param[in]           p_name              Name of the profile
+ * @param[out]          p_program           Pointer where to store the program
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, profile not
+ *                                          found or no program stored for it
+ */
+bool reflow_profile_catalogue_get_program(reflow_profile_catalogue_t const * const p_catalogue,
+                                          char const * const p_name,
+                                          reflow_program_t * const p_program)
+{
+        uint8_t slot = 0;
+        bool success = (NULL != p_program);
+
+        if (success) {
+                success = reflow_profile_catalogue_find(p_catalogue, p_name, &slot);
+        }
+
+        if (success) {
+                success = p_catalogue->slots[slot].has_program;
+        }
+
+        if (success) {
+                *p_program = p_catalogue->slots[slot].program;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the names of all the profiles, separated with `\n`
+ *
+ * The list is only built again after a profile was added or removed.
+ *
+ * @param[in,out]       p_catalogue         Pointer to the catalogue
+ * @param[out]          pp_list             Pointer where to store the pointer
+ *                                          to the list. It is owned by the
+ *                                          catalogue and valid until the next
+ *                                          change to it
+ * @param[out]          p_size              Pointer where to store the length
+ *                                          of the list
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_profile_catalogue_get_list(reflow_profile_catalogue_t * const p_catalogue,
+                                       char const ** const pp_list,
+                                       size_t * const p_size)
+{
+        bool success = ((NULL != p_catalogue) &&
+                        (NULL != pp_list) &&
+                        (NULL != p_size));
+
+        if ((success) && (p_catalogue->is_list_dirty)) {
+                build_list(p_catalogue);
+        }
+
+        if (success) {
+                *pp_list = p_catalogue->list;
+                *p_size = p_catalogue->list_len;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Build the names list again from the slots
+ *
+ * Names are appended at a running offset, so building the list is linear on
+ * its length.
+ *
+ * @param[in,out]       p_catalogue         Pointer to the catalogue
+ *
+ * @return              -                   -
+ */
+static void build_list(reflow_profile_catalogue_t * const p_catalogue)
+{
+        size_t offset = 0;
+        size_t name_len;
+        uint8_t i;
+
+        for (i = 0; p_catalogue->count > i; i++) {
+                name_len = strnlen(p_catalogue->slots[i].profile.name,
+                                   REFLOW_PROFILE_NAME_LEN_MAX);
+
+                memcpy(&p_catalogue->list[offset],
+                       p_catalogue->slots[i].profile.name,
+                       name_len);
+                offset += name_len;
+                p_catalogue->list[offset] = '\n';
+                offset++;
+        }
+
+        p_catalogue->list[offset] = '\0';
+        p_catalogue->list_len = offset;
+        p_catalogue->is_list_dirty = false;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
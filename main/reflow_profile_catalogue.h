@@ -0,0 +1,131 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_catalogue.h
+ *
+ * @brief In-RAM catalogue of the reflow profiles stored in the NVS, with
+ *        their programs and the list of their names, so that the NVS is only
+ *        read once and then touched on writes only
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef REFLOW_PROFILE_CATALOGUE_H
+#define REFLOW_PROFILE_CATALOGUE_H
+
+#include "reflow_profile.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Number of profiles the catalogue can hold
+#define REFLOW_PROFILE_CATALOGUE_SLOTS_CNT      REFLOW_PROFILES_MAX_PROFILES_CNT
+
+//! @brief Size of the names list: every name with its `\n`, and the terminator
+#define REFLOW_PROFILE_CATALOGUE_LIST_SIZE                              \
+        ((REFLOW_PROFILE_CATALOGUE_SLOTS_CNT *                          \
+          (REFLOW_PROFILE_NAME_LEN_MAX + 1)) + 1)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Catalogue entry
+typedef struct {
+        //! @brief Profile, as stored in the NVS
+        reflow_profile_t profile;
+
+        //! @brief Program stored for the profile, only valid if `has_program`
+        reflow_program_t program;
+
+        //! @brief Whether a program is stored for the profile
+        bool has_program;
+} reflow_profile_catalogue_slot_t;
+
+//! @brief Catalogue object
+typedef struct {
+        //! @brief Entries, in the order of the names list
+        reflow_profile_catalogue_slot_t slots[REFLOW_PROFILE_CATALOGUE_SLOTS_CNT];
+
+        //! @brief Number of used slots
+        uint8_t count;
+
+        //! @brief Names of the profiles, separated with `\n` as `lv_ddlist` wants
+        char list[REFLOW_PROFILE_CATALOGUE_LIST_SIZE];
+
+        //! @brief Length of `list`, without the terminator
+        size_t list_len;
+
+        //! @brief Whether `list` must be built again before handing it out
+        bool is_list_dirty;
+} reflow_profile_catalogue_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Empty the catalogue
+bool reflow_profile_catalogue_init(reflow_profile_catalogue_t * const p_catalogue);
+
+//! @brief Get the slot holding the profile with the given name
+bool reflow_profile_catalogue_find(reflow_profile_catalogue_t const * const p_catalogue,
+                                   char const * const p_name,
+                                   uint8_t * const p_slot);
+
+//! @brief Get a copy of the profile with the given name
+bool reflow_profile_catalogue_get(reflow_profile_catalogue_t const * const p_catalogue,
+                                  char const * const p_name,
+                                  reflow_profile_t * const p_reflow_profile);
+
+//! @brief Add a profile, or replace the one with the same name
+bool reflow_profile_catalogue_put(reflow_profile_catalogue_t * const p_catalogue,
+                                  reflow_profile_t const * const p_reflow_profile);
+
+//! @brief Remove the profile with the given name
+bool reflow_profile_catalogue_remove(reflow_profile_catalogue_t * const p_catalogue,
+                                     char const * const p_name);
+
+//! @brief Set or clear the program stored for a profile
+bool reflow_profile_catalogue_set_program(reflow_profile_catalogue_t * const p_catalogue,
+                                          char const * const p_name,
+                                          reflow_program_t const * const p_program);
+
+//! @brief Get the program stored for a profile
+bool reflow_profile_catalogue_get_program(reflow_profile_catalogue_t const * const p_catalogue,
+                                          char const * const p_name,
+                                          reflow_program_t * const p_program);
+
+//! @brief Get the names of all the profiles, separated with `\n`
+bool reflow_profile_catalogue_get_list(reflow_profile_catalogue_t * const p_catalogue,
+                                       char const ** const pp_list,
+                                       size_t * const p_size);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //REFLOW_PROFILE_CATALOGUE_H
@@ -0,0 +1,293 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_codec.c
+ *
+ * @brief Compact binary encoding of reflow profiles, with explicit field
+ *        widths and independent from the layout of `reflow_profile_t`
+ *
+ * Record layout, multi-byte fields are little endian:
+ *
+ *      | length | name length | name | preheat temperature (2) |
+ *      | soak time (2) | reflow temperature (2) | dwell time (2) |
+ *      | cooling temperature (2) | cooling time (2) | ramp speed (1) |
+ *
+ * `length` counts the bytes following it. New fields are only ever appended
+ * at the end of the record, so a decoder skips the fields it doesn't know
+ * about, and records written by older firmware are never shorter than the
+ * fields above.
+ *
+ * Before this encoding, profiles were stored as a copy of `reflow_profile_t`
+ * as laid out on the ESP32: the name on 16 bytes followed by seven little
+ * endian 16 bit fields, without padding. Those are still decoded, field by
+ * field, so they can be migrated.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byte_codec.h"
+#include "reflow_profile_codec.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of the name field of the legacy layout
+#define LEGACY_NAME_SIZE                    (16)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Decode the fields following the name, common to both layouts
+static void decode_fields(uint8_t const * const p_buffer,
+                          reflow_profile_t * const p_reflow_profile,
+                          bool const is_legacy);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Encode a profile in a record
+ *
+ * @param[in]           p_reflow_profile    Pointer to the profile to encode
+ * @param[out]          p_buffer            Buffer where to encode the record.
+ *                                          A `REFLOW_PROFILE_CODEC_RECORD_SIZE_MAX`
+ *                                          bytes buffer fits any profile
+ * @param[in]           size                Size of the buffer
+ * @param[out]          p_written           Pointer where to store the number
+ *                                          of bytes written
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, empty or too
+ *                                          long name, ramp speed not fitting
+ *                                          in its field, or buffer too small
+ */
+bool reflow_profile_codec_encode(reflow_profile_t const * const p_reflow_profile,
+                                 uint8_t * const p_buffer,
+                                 size_t const size,
+                                 size_t * const p_written)
+{
+        bool success = ((NULL != p_reflow_profile) &&
+                        (NULL != p_buffer) &&
+                        (NULL != p_written));
+        uint8_t * p_cursor = p_buffer;
+        size_t name_len = 0;
+
+        if (success) {
+                name_len = strnlen(p_reflow_profile->name,
+                                   sizeof(p_reflow_profile->name));
+
+                success = ((0 < name_len) &&
+                           (REFLOW_PROFILE_NAME_LEN_MAX >= name_len) &&
+                           (UINT8_MAX >= p_reflow_profile->ramp_speed) &&
+                           (REFLOW_PROFILE_CODEC_RECORD_SIZE(name_len) <= size));
+        }
+
+        if (success) {
+                p_cursor[0] = (uint8_t)(REFLOW_PROFILE_CODEC_RECORD_SIZE(name_len) - 1);
+                p_cursor[1] = (uint8_t)name_len;
+                memcpy(&p_cursor[2], p_reflow_profile->name, name_len);
+                p_cursor += 2 + name_len;
+
+                byte_codec_put_u16(&p_cursor[0], p_reflow_profile->preheat_temperature);
+                byte_codec_put_u16(&p_cursor[2], p_reflow_profile->soak_time_s);
+                byte_codec_put_u16(&p_cursor[4], p_reflow_profile->reflow_temperature);
+                byte_codec_put_u16(&p_cursor[6], p_reflow_profile->dwell_time_s);
+                byte_codec_put_u16(&p_cursor[8], p_reflow_profile->cooling_temperature);
+                byte_codec_put_u16(&p_cursor[10], p_reflow_profile->cooling_time_s);
+                p_cursor[12] = (uint8_t)p_reflow_profile->ramp_speed;
+
+                *p_written = REFLOW_PROFILE_CODEC_RECORD_SIZE(name_len);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Decode a record straight into a profile
+ *
+ * Fields are written in place, without going through an intermediate copy of
+ * the profile.
+ *
+ * @param[in]           p_buffer            Buffer holding the record
+ * @param[in]           size                Number of bytes available on the
+ *                                          buffer, which can hold more data
+ *                                          after the record
+ * @param[out]          p_reflow_profile    Pointer to the profile to decode
+ *                                          into. Its contents are undefined
+ *                                          on failure
+ * @param[out]          p_consumed          Pointer where to store the size of
+ *                                          the record, including the fields
+ *                                          skipped
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, truncated or
+ *                                          malformed record
+ */
+bool reflow_profile_codec_decode(uint8_t const * const p_buffer,
+                                 size_t const size,
+                                 reflow_profile_t * const p_reflow_profile,
+                                 size_t * const p_consumed)
+{
+        bool success = ((NULL != p_buffer) &&
+                        (NULL != p_reflow_profile) &&
+                        (NULL != p_consumed) &&
+                        (2 <= size));
+        size_t record_size = 0;
+        size_t name_len = 0;
+
+        if (success) {
+                record_size = 1 + (size_t)p_buffer[0];
+                name_len = p_buffer[1];
+
+                success = ((0 < name_len) &&
+                           (REFLOW_PROFILE_NAME_LEN_MAX >= name_len) &&
+                           (REFLOW_PROFILE_CODEC_RECORD_SIZE(name_len) <= record_size) &&
+                           (record_size <= size));
+        }
+
+        // Names with an embedded terminator would not be found by their name
+        if (success) {
+                success = (NULL == memchr(&p_buffer[2], '\0', name_len));
+        }
+
+        if (success) {
+                memcpy(p_reflow_profile->name, &p_buffer[2], name_len);
+                memset(&p_reflow_profile->name[name_len], 0,
+                       sizeof(p_reflow_profile->name) - name_len);
+
+                decode_fields(&p_buffer[2 + name_len], p_reflow_profile, false);
+
+                *p_consumed = record_size;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Decode a profile stored as a copy of its struct by older firmware
+ *
+ * @param[in]           p_buffer            Buffer holding the profile
+ * @param[in]           size                Size of the stored profile
+ * @param[out]          p_reflow_profile    Pointer to the profile to decode
+ *                                          into. Its contents are undefined
+ *                                          on failure
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, wrong size or
+ *                                          name not terminated
+ */
+bool reflow_profile_codec_decode_legacy(uint8_t const * const p_buffer,
+                                        size_t const size,
+                                        reflow_profile_t * const p_reflow_profile)
+{
+        bool success = ((NULL != p_buffer) &&
+                        (NULL != p_reflow_profile) &&
+                        (REFLOW_PROFILE_CODEC_LEGACY_SIZE == size));
+
+        if (success) {
+                success = (NULL != memchr(p_buffer, '\0', LEGACY_NAME_SIZE));
+        }
+
+        if (success) {
+                memcpy(p_reflow_profile->name, p_buffer, LEGACY_NAME_SIZE);
+                decode_fields(&p_buffer[LEGACY_NAME_SIZE], p_reflow_profile, true);
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Decode the fields following the name, common to both layouts
+ *
+ * Both layouts only differ on the width of the ramp speed, which is the last
+ * field.
+ *
+ * @param[in]           p_buffer            Buffer holding the fields
+ * @param[out]          p_reflow_profile    Pointer to the profile to decode
+ *                                          into
+ * @param[in]           is_legacy           Whether the fields come from the
+ *                                          legacy layout
+ *
+ * @return              -                   -
+ */
+static void decode_fields(uint8_t const * const p_buffer,
+                          reflow_profile_t * const p_reflow_profile,
+                          bool const is_legacy)
+{
+        p_reflow_profile->preheat_temperature = byte_codec_get_u16(&p_buffer[0]);
+        p_reflow_profile->soak_time_s = byte_codec_get_u16(&p_buffer[2]);
+        p_reflow_profile->reflow_temperature = byte_codec_get_u16(&p_buffer[4]);
+        p_reflow_profile->dwell_time_s = byte_codec_get_u16(&p_buffer[6]);
+        p_reflow_profile->cooling_temperature = byte_codec_get_u16(&p_buffer[8]);
+        p_reflow_profile->cooling_time_s = byte_codec_get_u16(&p_buffer[10]);
+
+        if (is_legacy) {
+                p_reflow_profile->ramp_speed = byte_codec_get_u16(&p_buffer[12]);
+        } else {
+                p_reflow_profile->ramp_speed = p_buffer[12];
+        }
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
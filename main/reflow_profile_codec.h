@@ -0,0 +1,87 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_codec.h
+ *
+ * @brief Compact binary encoding of reflow profiles, with explicit field
+ *        widths and independent from the layout of `reflow_profile_t`
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef REFLOW_PROFILE_CODEC_H
+#define REFLOW_PROFILE_CODEC_H
+
+#include "reflow_profile.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of the fields following the name in a record
+#define REFLOW_PROFILE_CODEC_FIELDS_SIZE                (13)
+
+//! @brief Size in bytes of a record with a name of a given length
+#define REFLOW_PROFILE_CODEC_RECORD_SIZE(name_len)      \
+        (2 + (name_len) + REFLOW_PROFILE_CODEC_FIELDS_SIZE)
+
+//! @brief Size in bytes of the largest record
+#define REFLOW_PROFILE_CODEC_RECORD_SIZE_MAX            \
+        REFLOW_PROFILE_CODEC_RECORD_SIZE(REFLOW_PROFILE_NAME_LEN_MAX)
+
+//! @brief Size in bytes of a profile stored as a copy of its struct
+#define REFLOW_PROFILE_CODEC_LEGACY_SIZE                (16 + (7 * 2))
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Encode a profile in a record
+bool reflow_profile_codec_encode(reflow_profile_t const * const p_reflow_profile,
+                                 uint8_t * const p_buffer,
+                                 size_t const size,
+                                 size_t * const p_written);
+
+//! @brief Decode a record straight into a profile
+bool reflow_profile_codec_decode(uint8_t const * const p_buffer,
+                                 size_t const size,
+                                 reflow_profile_t * const p_reflow_profile,
+                                 size_t * const p_consumed);
+
+//! @brief Decode a profile stored as a copy of its struct by older firmware
+bool reflow_profile_codec_decode_legacy(uint8_t const * const p_buffer,
+                                        size_t const size,
+                                        reflow_profile_t * const p_reflow_profile);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //REFLOW_PROFILE_CODEC_H
@@ -0,0 +1,460 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_serial.c
+ *
+ * @brief Line oriented text protocol to transfer reflow profiles over a serial
+ *        link, parsed incrementally with fixed memory
+ *
+ * Requests are lines ended by `\n`, a `\r` before it is ignored:
+ *
+ *      LIST
+ *      GET <name>
+ *      PUT <name>,<preheat>,<soak>,<reflow>,<dwell>,<cooling temp>,<cooling time>,<ramp>
+ *      DEL <name>
+ *      SYNC
+ *      TELEMETRY <period in ms>
+ *
+ * Profiles are sent back as lines in the same format as the `PUT` arguments:
+ *
+ *      PROFILE <name>,<preheat>,<soak>,<reflow>,<dwell>,<cooling temp>,<cooling time>,<ramp>
+ *
+ * Fields are plain decimal numbers, in the units of `reflow_profile_t`. Names
+ * are 1 to `REFLOW_PROFILE_NAME_LEN_MAX` printable characters other than `,`.
+ *
+ * The parser keeps a single line, and data can be fed to it in chunks of any
+ * size, down to one character at a time. Lines longer than
+ * `REFLOW_PROFILE_SERIAL_LINE_LEN_MAX` are dropped up to their end and
+ * reported, so the requests following them are still parsed.
+ *
+ * The module only parses and formats: checking the profiles against their
+ * limits and storing them is left to the caller.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "reflow_profile_serial.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Number of numeric fields of a profile
+#define PROFILE_FIELDS_CNT                  (7)
+
+//! @brief Largest value of a numeric field
+#define FIELD_VALUE_MAX                     (UINT16_MAX)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Command keyword
+typedef struct {
+        //! @brief Keyword starting the line
+        char const * p_keyword;
+
+        //! @brief Command it stands for
+        reflow_profile_serial_command_t command;
+} command_keyword_t;
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+//! @brief Keywords of the commands
+static command_keyword_t const m_keywords[] = {
+        {"LIST", REFLOW_PROFILE_SERIAL_COMMAND_LIST},
+        {"GET", REFLOW_PROFILE_SERIAL_COMMAND_GET},
+        {"PUT", REFLOW_PROFILE_SERIAL_COMMAND_PUT},
+        {"DEL", REFLOW_PROFILE_SERIAL_COMMAND_DELETE},
+        {"SYNC", REFLOW_PROFILE_SERIAL_COMMAND_SYNC},
+        {"TELEMETRY", REFLOW_PROFILE_SERIAL_COMMAND_TELEMETRY},
+};
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Parse a complete line into a request
+static bool parse_line(char const * const p_line,
+                       reflow_profile_serial_request_t * const p_request);
+
+//! @brief Parse a profile name, up to a terminator
+static bool parse_name(char const ** const pp_cursor,
+                       char const terminator,
+                       char * const p_name);
+
+//! @brief Parse a numeric field, up to a terminator
+static bool parse_field(char const ** const pp_cursor,
+                        char const terminator,
+                        uint16_t * const p_value);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize a parser
+ *
+ * @param[out]          p_parser            Pointer to the parser
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_profile_serial_init(reflow_profile_serial_parser_t * const p_parser)
+{
+        bool success = (NULL != p_parser);
+
+        if (success) {
+                memset(p_parser, 0, sizeof(*p_parser));
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Feed received data to the parser, up to the end of the next line
+ *
+ * Data is consumed up to the end of the first line completed, so the request
+ * can be handled before feeding the rest. Empty lines are skipped.
+ *
+ * @param[in,out]       p_parser            Pointer to the parser
+ * @param[in]           p_data              Received data
+ * @param[in]           size                Size of the received data
+ * @param[out]          p_consumed          Pointer where to store the number
+ *                                          of characters consumed
+ * @param[out]          p_request           Pointer where to store the request,
+ *                                          only written on success
+ *
+ * @return              reflow_profile_serial_error_t
+ *                                          Operation result
+ */
+reflow_profile_serial_error_t reflow_profile_serial_feed(reflow_profile_serial_parser_t * const p_parser,
+                                                         char const * const p_data,
+                                                         size_t const size,
+                                                         size_t * const p_consumed,
+                                                         reflow_profile_serial_request_t * const p_request)
+{
+        reflow_profile_serial_error_t result = REFLOW_PROFILE_SERIAL_ERROR_PENDING;
+        size_t consumed = 0;
+        char character;
+
+        if ((NULL == p_parser) ||
+            ((NULL == p_data) && (0 < size)) ||
+            (NULL == p_consumed) ||
+            (NULL == p_request)) {
+                result = REFLOW_PROFILE_SERIAL_ERROR_BAD_PARAMETER;
+        }
+
+        while ((REFLOW_PROFILE_SERIAL_ERROR_PENDING == result) &&
+               (size > consumed)) {
+                character = p_data[consumed++];
+
+                if ('\n' == character) {
+                        p_parser->line[p_parser->length] = '\0';
+
+                        if (p_parser->is_too_long) {
+                                result = REFLOW_PROFILE_SERIAL_ERROR_TOO_LONG;
+                        } else if (0 == p_parser->length) {
+                                // Empty line, keep going
+                        } else if (parse_line(p_parser->line, p_request)) {
+                                result = REFLOW_PROFILE_SERIAL_ERROR_SUCCESS;
+                        } else {
+                                result = REFLOW_PROFILE_SERIAL_ERROR_SYNTAX;
+                        }
+
+                        p_parser->length = 0;
+                        p_parser->is_too_long = false;
+                } else if ('\r' == character) {
+                        // Line ends sent as "\r\n" are accepted as well
+                } else if (REFLOW_PROFILE_SERIAL_LINE_LEN_MAX > p_parser->length) {
+                        p_parser->line[p_parser->length++] = character;
+                } else {
+                        p_parser->is_too_long = true;
+                }
+        }
+
+        if (REFLOW_PROFILE_SERIAL_ERROR_BAD_PARAMETER != result) {
+                *p_consumed = consumed;
+        }
+
+        return result;
+}
+
+/*!
+ * @brief Format a profile as a `PROFILE` line
+ *
+ * @param[in]           p_reflow_profile    Pointer to the profile
+ * @param[out]          p_buffer            Buffer where to write the line, with
+ *                                          its `\n` and a string terminator
+ * @param[in]           size                Size of the buffer, at least
+ *                                          `REFLOW_PROFILE_SERIAL_PROFILE_LINE_SIZE`
+ *                                          guarantees any profile fits
+ * @param[out]          p_written           Pointer where to store the length of
+ *                                          the line, string terminator excluded
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or buffer too
+ *                                          small
+ */
+bool reflow_profile_serial_format(reflow_profile_t const * const p_reflow_profile,
+                                  char * const p_buffer,
+                                  size_t const size,
+                                  size_t * const p_written)
+{
+        bool success = ((NULL != p_reflow_profile) &&
+                        (NULL != p_buffer) &&
+                        (NULL != p_written));
+        int length = 0;
+
+        if (success) {
+                length = snprintf(p_buffer, size,
+                                  "PROFILE %.*s,%u,%u,%u,%u,%u,%u,%u\n",
+                                  REFLOW_PROFILE_NAME_LEN_MAX,
+                                  p_reflow_profile->name,
+                                  p_reflow_profile->preheat_temperature,
+                                  p_reflow_profile->soak_time_s,
+                                  p_reflow_profile->reflow_temperature,
+                                  p_reflow_profile->dwell_time_s,
+                                  p_reflow_profile->cooling_temperature,
+                                  p_reflow_profile->cooling_time_s,
+                                  p_reflow_profile->ramp_speed);
+
+                success = ((0 < length) && (size > (size_t)length));
+        }
+
+        if (success) {
+                *p_written = (size_t)length;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Parse a complete line into a request
+ *
+ * @param[in]           p_line              Line, without its terminator
+ * @param[out]          p_request           Pointer where to store the request
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               The line is not a valid request
+ */
+static bool parse_line(char const * const p_line,
+                       reflow_profile_serial_request_t * const p_request)
+{
+        reflow_profile_serial_request_t request;
+        uint16_t * const p_fields[PROFILE_FIELDS_CNT] = {
+                &request.profile.preheat_temperature,
+                &request.profile.soak_time_s,
+                &request.profile.reflow_temperature,
+                &request.profile.dwell_time_s,
+                &request.profile.cooling_temperature,
+                &request.profile.cooling_time_s,
+                &request.profile.ramp_speed,
+        };
+        char const * p_cursor = p_line;
+        size_t keyword_len;
+        size_t i;
+        bool success = false;
+
+        memset(&request, 0, sizeof(request));
+
+        for (i = 0; (!success) && ((sizeof(m_keywords) / sizeof(m_keywords[0])) > i); i++) {
+                keyword_len = strlen(m_keywords[i].p_keyword);
+
+                if ((0 == strncmp(p_line, m_keywords[i].p_keyword, keyword_len)) &&
+                    ((' ' == p_line[keyword_len]) || ('\0' == p_line[keyword_len]))) {
+                        request.command = m_keywords[i].command;
+                        p_cursor = &p_line[keyword_len];
+                        success = true;
+                }
+        }
+
+        switch (request.command) {
+        case REFLOW_PROFILE_SERIAL_COMMAND_LIST:
+        case REFLOW_PROFILE_SERIAL_COMMAND_SYNC:
+                success = ('\0' == *p_cursor);
+                break;
+
+        case REFLOW_PROFILE_SERIAL_COMMAND_GET:
+        case REFLOW_PROFILE_SERIAL_COMMAND_DELETE:
+                success = ((' ' == *p_cursor++) &&
+                           (parse_name(&p_cursor, '\0', request.profile.name)));
+                break;
+
+        case REFLOW_PROFILE_SERIAL_COMMAND_PUT:
+                success = ((' ' == *p_cursor++) &&
+                           (parse_name(&p_cursor, ',', request.profile.name)));
+
+                for (i = 0; (success) && (PROFILE_FIELDS_CNT > i); i++) {
+                        success = parse_field(&p_cursor,
+                                              ((PROFILE_FIELDS_CNT - 1) > i) ? ',' : '\0',
+                                              p_fields[i]);
+                }
+                break;
+
+        case REFLOW_PROFILE_SERIAL_COMMAND_TELEMETRY:
+                success = ((' ' == *p_cursor++) &&
+                           (parse_field(&p_cursor,
+                                        '\0',
+                                        &request.telemetry_period_ms)));
+                break;
+
+        default:
+                success = false;
+                break;
+        }
+
+        if (success) {
+                *p_request = request;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Parse a profile name, up to a terminator
+ *
+ * @param[in,out]       pp_cursor           Pointer to the cursor on the line,
+ *                                          moved past the terminator
+ * @param[in]           terminator          Character ending the name
+ * @param[out]          p_name              Buffer of at least
+ *                                          `REFLOW_PROFILE_NAME_LEN_MAX + 1`
+ *                                          characters, zeroed, where to store
+ *                                          the name
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Empty or too long name, or not
+ *                                          allowed character found
+ */
+static bool parse_name(char const ** const pp_cursor,
+                       char const terminator,
+                       char * const p_name)
+{
+        char const * p_cursor = *pp_cursor;
+        size_t length = 0;
+        bool success = true;
+
+        while ((success) && (terminator != *p_cursor)) {
+                success = ((REFLOW_PROFILE_NAME_LEN_MAX > length) &&
+                           (' ' <= *p_cursor) &&
+                           ('~' >= *p_cursor) &&
+                           (',' != *p_cursor));
+
+                if (success) {
+                        p_name[length++] = *p_cursor++;
+                }
+        }
+
+        if (success) {
+                success = (0 < length);
+        }
+
+        if ((success) && ('\0' != terminator)) {
+                p_cursor++;
+        }
+
+        if (success) {
+                *pp_cursor = p_cursor;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Parse a numeric field, up to a terminator
+ *
+ * @param[in,out]       pp_cursor           Pointer to the cursor on the line,
+ *                                          moved past the terminator
+ * @param[in]           terminator          Character ending the field
+ * @param[out]          p_value             Pointer where to store the value
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Empty field, not a decimal number
+ *                                          or out of range
+ */
+static bool parse_field(char const ** const pp_cursor,
+                        char const terminator,
+                        uint16_t * const p_value)
+{
+        char const * p_cursor = *pp_cursor;
+        uint32_t value = 0;
+        bool success = (terminator != *p_cursor);
+
+        while ((success) && (terminator != *p_cursor)) {
+                success = (('0' <= *p_cursor) && ('9' >= *p_cursor));
+
+                if (success) {
+                        value = (value * 10) + (uint32_t)(*p_cursor++ - '0');
+                        success = (FIELD_VALUE_MAX >= value);
+                }
+        }
+
+        if ((success) && ('\0' != terminator)) {
+                p_cursor++;
+        }
+
+        if (success) {
+                *p_value = (uint16_t)value;
+                *pp_cursor = p_cursor;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
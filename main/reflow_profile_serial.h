@@ -0,0 +1,155 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_serial.h
+ *
+ * @brief Line oriented text protocol to transfer reflow profiles over a serial
+ *        link, parsed incrementally with fixed memory
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef REFLOW_PROFILE_SERIAL_H
+#define REFLOW_PROFILE_SERIAL_H
+
+#include "reflow_profile.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Maximum length of a line, without its terminator. Enough for the
+//!        longest request: command, longest name and seven 5 digit fields
+#define REFLOW_PROFILE_SERIAL_LINE_LEN_MAX              (63)
+
+//! @brief Maximum length of a formatted profile line, terminator included
+#define REFLOW_PROFILE_SERIAL_PROFILE_LINE_SIZE         \
+        (sizeof("PROFILE ") + REFLOW_PROFILE_NAME_LEN_MAX + (7 * 6) + 1)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Commands a request can carry
+typedef enum {
+        //! @brief No request
+        REFLOW_PROFILE_SERIAL_COMMAND_NONE = 0,
+
+        //! @brief `LIST`: send every profile
+        REFLOW_PROFILE_SERIAL_COMMAND_LIST,
+
+        //! @brief `GET <name>`: send a profile
+        REFLOW_PROFILE_SERIAL_COMMAND_GET,
+
+        //! @brief `PUT <name>,<fields>`: save a profile, replacing the one with
+        //!        the same name if any
+        REFLOW_PROFILE_SERIAL_COMMAND_PUT,
+
+        //! @brief `DEL <name>`: delete a profile
+        REFLOW_PROFILE_SERIAL_COMMAND_DELETE,
+
+        //! @brief `SYNC`: write the pending changes to NVS
+        REFLOW_PROFILE_SERIAL_COMMAND_SYNC,
+
+        //! @brief `TELEMETRY <period>`: stream telemetry every period, in
+        //!        milliseconds, or stop it with 0
+        REFLOW_PROFILE_SERIAL_COMMAND_TELEMETRY,
+
+        //! @brief Fence member
+        REFLOW_PROFILE_SERIAL_COMMAND_COUNT
+} reflow_profile_serial_command_t;
+
+//! @brief Result of feeding data to the parser
+typedef enum {
+        //! @brief A request was parsed
+        REFLOW_PROFILE_SERIAL_ERROR_SUCCESS = 0,
+
+        //! @brief Null parameter passed
+        REFLOW_PROFILE_SERIAL_ERROR_BAD_PARAMETER,
+
+        //! @brief All the data was consumed without completing a line
+        REFLOW_PROFILE_SERIAL_ERROR_PENDING,
+
+        //! @brief A line was completed, but it is not a valid request
+        REFLOW_PROFILE_SERIAL_ERROR_SYNTAX,
+
+        //! @brief A line was completed, but it was too long and got dropped
+        REFLOW_PROFILE_SERIAL_ERROR_TOO_LONG,
+
+        //! @brief Fence member
+        REFLOW_PROFILE_SERIAL_ERROR_COUNT
+} reflow_profile_serial_error_t;
+
+//! @brief Parsed request
+typedef struct {
+        //! @brief Command of the request
+        reflow_profile_serial_command_t command;
+
+        //! @brief Profile of a `PUT` request. Only its name is set on `GET`
+        //!        and `DEL` requests
+        reflow_profile_t profile;
+
+        //! @brief Period of a `TELEMETRY` request, in milliseconds
+        uint16_t telemetry_period_ms;
+} reflow_profile_serial_request_t;
+
+//! @brief Parser state, carried over the data fed to it
+typedef struct {
+        //! @brief Line being received
+        char line[REFLOW_PROFILE_SERIAL_LINE_LEN_MAX + 1];
+
+        //! @brief Number of characters received on the line
+        size_t length;
+
+        //! @brief Whether the line being received is too long and dropped
+        bool is_too_long;
+} reflow_profile_serial_parser_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize a parser
+bool reflow_profile_serial_init(reflow_profile_serial_parser_t * const p_parser);
+
+//! @brief Feed received data to the parser, up to the end of the next line
+reflow_profile_serial_error_t reflow_profile_serial_feed(reflow_profile_serial_parser_t * const p_parser,
+                                                         char const * const p_data,
+                                                         size_t const size,
+                                                         size_t * const p_consumed,
+                                                         reflow_profile_serial_request_t * const p_request);
+
+//! @brief Format a profile as a `PROFILE` line
+bool reflow_profile_serial_format(reflow_profile_t const * const p_reflow_profile,
+                                  char * const p_buffer,
+                                  size_t const size,
+                                  size_t * const p_written);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //REFLOW_PROFILE_SERIAL_H
@@ -0,0 +1,623 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_store.c
+ *
+ * @brief Write-behind policy and snapshot format used to persist the profile
+ *        catalogue to NVS in a single write
+ *
+ * Changes to the profiles are only done in RAM and marked as pending. They are
+ * flushed once no other change came for a while, or once the oldest pending
+ * change waited for too long, so an editing session ends up in a single NVS
+ * write.
+ *
+ * The whole catalogue is written as one snapshot blob. NVS keeps the previous
+ * value of a blob until the new one is completely written, so after a power
+ * loss either the old or the new snapshot is found, never a mix of both.
+ *
+ * Snapshot layout:
+ *
+ *      | version | min reader version | default name length | default name |
+ *      | count | entry 0 | ... | entry n-1 | CRC-16 (2) |
+ *
+ * and each entry:
+ *
+ *      | profile record | program size | encoded program (program size bytes) |
+ *
+ * Profiles are encoded with `reflow_profile_codec`, whose records can grow new
+ * fields without breaking older readers. A format change older firmware can't
+ * cope with raises the min reader version instead, and such snapshots are
+ * reported as unsupported rather than as corrupted, so they are not
+ * overwritten.
+ *
+ * Version 1 snapshots had no CRC, stored the default name on 16 bytes and the
+ * profiles as a copy of their struct. They are still decoded, so they can be
+ * migrated.
+ *
+ * The module doesn't access the NVS nor read any time source by itself, so it
+ * can be checked on the host.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byte_codec.h"
+#include "reflow_profile_store.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of the default name field of version 1 snapshots,
+//!        including its terminator
+#define V1_DEFAULT_NAME_SIZE                (REFLOW_PROFILE_NAME_LEN_MAX + 1)
+
+//! @brief Size in bytes of the header of version 1 snapshots
+#define V1_HEADER_SIZE                      (1 + V1_DEFAULT_NAME_SIZE + 1)
+
+//! @brief Size in bytes of the fixed part of the header: versions, default
+//!        name length
+#define FIXED_HEADER_SIZE                   (3)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Decode a version 1 snapshot
+static reflow_profile_store_error_t decode_v1(uint8_t const * const p_buffer,
+                                              size_t const size,
+                                              reflow_profile_catalogue_t * const p_catalogue,
+                                              char * const p_default_name);
+
+//! @brief Decode a snapshot of the current version, or a newer compatible one
+static reflow_profile_store_error_t decode_v2(uint8_t const * const p_buffer,
+                                              size_t const size,
+                                              reflow_profile_catalogue_t * const p_catalogue,
+                                              char * const p_default_name);
+
+//! @brief Decode the program of the entry being added and add it
+static bool add_entry(uint8_t const * const p_buffer,
+                      size_t const size,
+                      size_t * const p_offset,
+                      reflow_profile_catalogue_t * const p_catalogue);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize the write-behind state
+ *
+ * @param[out]          p_store             Pointer to the state
+ * @param[in]           idle_ms             Time in milliseconds after the last
+ *                                          change to flush
+ * @param[in]           max_delay_ms        Maximum time in milliseconds a
+ *                                          change can be kept unflushed
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_profile_store_init(reflow_profile_store_t * const p_store,
+                               uint32_t const idle_ms,
+                               uint32_t const max_delay_ms)
+{
+        bool success = (NULL != p_store);
+
+        if (success) {
+                memset(p_store, 0, sizeof(*p_store));
+                p_store->idle_ms = idle_ms;
+                p_store->max_delay_ms = max_delay_ms;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Record a change to be flushed
+ *
+ * @param[in,out]       p_store             Pointer to the state
+ * @param[in]           now_ms              Current time in milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_profile_store_mark_dirty(reflow_profile_store_t * const p_store,
+                                     uint32_t const now_ms)
+{
+        bool success = (NULL != p_store);
+
+        if ((success) && (!p_store->is_dirty)) {
+                p_store->first_change_ms = now_ms;
+                p_store->is_dirty = true;
+        }
+
+        if (success) {
+                p_store->last_change_ms = now_ms;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Query whether pending changes must be flushed now
+ *
+ * @param[in]           p_store             Pointer to the state
+ * @param[in]           now_ms              Current time in milliseconds
+ *
+ * @return              bool                Result of the query
+ */
+bool reflow_profile_store_is_flush_due(reflow_profile_store_t const * const p_store,
+                                       uint32_t const now_ms)
+{
+        return ((NULL != p_store) &&
+                (p_store->is_dirty) &&
+                (((now_ms - p_store->last_change_ms) >= p_store->idle_ms) ||
+                 ((now_ms - p_store->first_change_ms) >= p_store->max_delay_ms)));
+}
+
+/*!
+ * @brief Record that the pending changes were flushed
+ *
+ * @param[in,out]       p_store             Pointer to the state
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_profile_store_mark_flushed(reflow_profile_store_t * const p_store)
+{
+        bool success = (NULL != p_store);
+
+        if (success) {
+                p_store->is_dirty = false;
+                p_store->stats.flush_count++;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Record that flushing failed, so it is retried later
+ *
+ * The pending changes are kept, and the next attempt is done once the idle
+ * time elapses again, instead of on every poll.
+ *
+ * @param[in,out]       p_store             Pointer to the state
+ * @param[in]           now_ms              Current time in milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or no pending
+ *                                          changes
+ */
+bool reflow_profile_store_mark_failed(reflow_profile_store_t * const p_store,
+                                      uint32_t const now_ms)
+{
+        bool success = ((NULL != p_store) && (p_store->is_dirty));
+
+        if (success) {
+                p_store->first_change_ms = now_ms;
+                p_store->last_change_ms = now_ms;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Encode the catalogue and default profile name in a snapshot
+ *
+ * @param[in]           p_catalogue         Pointer to the catalogue
+ * @param[in]           p_default_name      Name of the default profile
+ * @param[out]          p_buffer            Buffer where to encode the snapshot
+ * @param[in]           size                Size of the buffer
+ * @param[out]          p_written           Pointer where to store the number
+ *                                          of bytes written
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, invalid
+ *                                          profile or program, or buffer too
+ *                                          small
+ */
+bool reflow_profile_store_encode(reflow_profile_catalogue_t const * const p_catalogue,
+                                 char const * const p_default_name,
+                                 uint8_t * const p_buffer,
+                                 size_t const size,
+                                 size_t * const p_written)
+{
+        bool success = ((NULL != p_catalogue) &&
+                        (NULL != p_default_name) &&
+                        (NULL != p_buffer) &&
+                        (NULL != p_written));
+        reflow_profile_catalogue_slot_t const * p_slot;
+        size_t name_len = 0;
+        size_t offset = 0;
+        size_t record_size;
+        size_t program_size;
+        uint8_t i;
+
+        if (success) {
+                name_len = strnlen(p_default_name, REFLOW_PROFILE_NAME_LEN_MAX + 1);
+
+                success = ((REFLOW_PROFILE_NAME_LEN_MAX >= name_len) &&
+                           ((FIXED_HEADER_SIZE + name_len + 1) <= size));
+        }
+
+        if (success) {
+                p_buffer[offset++] = REFLOW_PROFILE_STORE_SNAPSHOT_VERSION;
+                p_buffer[offset++] = REFLOW_PROFILE_STORE_SNAPSHOT_MIN_READER;
+                p_buffer[offset++] = (uint8_t)name_len;
+                memcpy(&p_buffer[offset], p_default_name, name_len);
+                offset += name_len;
+                p_buffer[offset++] = p_catalogue->count;
+        }
+
+        for (i = 0; (success) && (p_catalogue->count > i); i++) {
+                p_slot = &p_catalogue->slots[i];
+                program_size = 0;
+
+                success = reflow_profile_codec_encode(&p_slot->profile,
+                                                      &p_buffer[offset],
+                                                      size - offset,
+                                                      &record_size);
+
+                if (success) {
+                        offset += record_size;
+                        success = (offset < size);
+                }
+
+                if ((success) && (p_slot->has_program)) {
+                        success = reflow_program_encode(&p_slot->program,
+                                                        &p_buffer[offset + 1],
+                                                        size - offset - 1,
+                                                        &program_size);
+                }
+
+                if (success) {
+                        p_buffer[offset] = (uint8_t)program_size;
+                        offset += 1 + program_size;
+                }
+        }
+
+        if (success) {
+                success = ((offset + REFLOW_PROFILE_STORE_CRC_SIZE) <= size);
+        }
+
+        if (success) {
+                byte_codec_put_u16(&p_buffer[offset],
+                                   byte_codec_crc16(p_buffer,
+                                                    offset));
+                *p_written = offset + REFLOW_PROFILE_STORE_CRC_SIZE;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Decode the catalogue and default profile name from a snapshot
+ *
+ * Profiles and programs are decoded straight into the catalogue slots. A
+ * default name not found in the catalogue is replaced by the first profile.
+ *
+ * @param[in]           p_buffer            Buffer holding the snapshot
+ * @param[in]           size                Size of the snapshot
+ * @param[out]          p_catalogue         Pointer to the catalogue to fill.
+ *                                          It is left empty on failure
+ * @param[out]          p_default_name      Pointer where to store the name of
+ *                                          the default profile
+ * @param[out]          p_version           Pointer where to store the version
+ *                                          of the snapshot. Snapshots older
+ *                                          than `REFLOW_PROFILE_STORE_SNAPSHOT_VERSION`
+ *                                          are to be written again
+ *
+ * @return              reflow_profile_store_error_t
+ *                                          Operation result
+ * @retval              REFLOW_PROFILE_STORE_ERROR_SUCCESS
+ *                                          Everything went well
+ * @retval              REFLOW_PROFILE_STORE_ERROR_BAD_PARAMETER
+ *                                          Null pointer passed
+ * @retval              REFLOW_PROFILE_STORE_ERROR_CORRUPTED
+ *                                          Truncated or malformed snapshot, or
+ *                                          CRC mismatch
+ * @retval              REFLOW_PROFILE_STORE_ERROR_UNSUPPORTED
+ *                                          Snapshot written by a newer firmware
+ *                                          in a format this one can't read
+ */
+reflow_profile_store_error_t reflow_profile_store_decode(uint8_t const * const p_buffer,
+                                                         size_t const size,
+                                                         reflow_profile_catalogue_t * const p_catalogue,
+                                                         char * const p_default_name,
+                                                         uint8_t * const p_version)
+{
+        reflow_profile_store_error_t result = REFLOW_PROFILE_STORE_ERROR_SUCCESS;
+        uint8_t slot;
+
+        if ((NULL == p_buffer) ||
+            (NULL == p_default_name) ||
+            (NULL == p_version) ||
+            (!reflow_profile_catalogue_init(p_catalogue))) {
+                result = REFLOW_PROFILE_STORE_ERROR_BAD_PARAMETER;
+        } else if (0 == size) {
+                result = REFLOW_PROFILE_STORE_ERROR_CORRUPTED;
+        } else if (1 == p_buffer[0]) {
+                result = decode_v1(p_buffer, size, p_catalogue, p_default_name);
+        } else if (1 < p_buffer[0]) {
+                result = decode_v2(p_buffer, size, p_catalogue, p_default_name);
+        } else {
+                result = REFLOW_PROFILE_STORE_ERROR_CORRUPTED;
+        }
+
+        // A default profile no longer in the catalogue, deleted by an older
+        // firmware, falls back to the first one so there is one to boot on
+        if ((REFLOW_PROFILE_STORE_ERROR_SUCCESS == result) &&
+            (0 < p_catalogue->count) &&
+            (!reflow_profile_catalogue_find(p_catalogue, p_default_name, &slot))) {
+                strcpy(p_default_name, p_catalogue->slots[0].profile.name);
+        }
+
+        if (REFLOW_PROFILE_STORE_ERROR_SUCCESS == result) {
+                *p_version = p_buffer[0];
+        } else if (REFLOW_PROFILE_STORE_ERROR_BAD_PARAMETER != result) {
+                (void)reflow_profile_catalogue_init(p_catalogue);
+        }
+
+        return result;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Decode a version 1 snapshot
+ *
+ * Layout:
+ *
+ *      | version | default name (16) | count | entry 0 | ... | entry n-1 |
+ *
+ * with each profile stored as a copy of its struct.
+ *
+ * @param[in]           p_buffer            Buffer holding the snapshot
+ * @param[in]           size                Size of the snapshot
+ * @param[out]          p_catalogue         Pointer to the empty catalogue to
+ *                                          fill
+ * @param[out]          p_default_name      Pointer where to store the name of
+ *                                          the default profile
+ *
+ * @return              reflow_profile_store_error_t
+ *                                          Operation result
+ */
+static reflow_profile_store_error_t decode_v1(uint8_t const * const p_buffer,
+                                              size_t const size,
+                                              reflow_profile_catalogue_t * const p_catalogue,
+                                              char * const p_default_name)
+{
+        bool success = (V1_HEADER_SIZE <= size);
+        size_t offset = V1_HEADER_SIZE;
+        uint8_t count = 0;
+        uint8_t i;
+
+        if (success) {
+                count = p_buffer[V1_HEADER_SIZE - 1];
+
+                success = (('\0' == p_buffer[V1_DEFAULT_NAME_SIZE]) &&
+                           (REFLOW_PROFILE_CATALOGUE_SLOTS_CNT >= count));
+        }
+
+        for (i = 0; (success) && (count > i); i++) {
+                success = (((offset + REFLOW_PROFILE_CODEC_LEGACY_SIZE) <= size) &&
+                           (reflow_profile_codec_decode_legacy(&p_buffer[offset],
+                                                               REFLOW_PROFILE_CODEC_LEGACY_SIZE,
+                                                               &p_catalogue->slots[i].profile)));
+
+                if (success) {
+                        offset += REFLOW_PROFILE_CODEC_LEGACY_SIZE;
+                        success = add_entry(p_buffer, size, &offset, p_catalogue);
+                }
+        }
+
+        if (success) {
+                success = (offset == size);
+        }
+
+        if (success) {
+                memcpy(p_default_name, &p_buffer[1], V1_DEFAULT_NAME_SIZE);
+        }
+
+        return (success ?
+                REFLOW_PROFILE_STORE_ERROR_SUCCESS :
+                REFLOW_PROFILE_STORE_ERROR_CORRUPTED);
+}
+
+/*!
+ * @brief Decode a snapshot of the current version, or a newer compatible one
+ *
+ * The CRC is checked before anything else is decoded.
+ *
+ * @param[in]           p_buffer            Buffer holding the snapshot
+ * @param[in]           size                Size of the snapshot
+ * @param[out]          p_catalogue         Pointer to the empty catalogue to
+ *                                          fill
+ * @param[out]          p_default_name      Pointer where to store the name of
+ *                                          the default profile
+ *
+ * @return              reflow_profile_store_error_t
+ *                                          Operation result
+ */
+static reflow_profile_store_error_t decode_v2(uint8_t const * const p_buffer,
+                                              size_t const size,
+                                              reflow_profile_catalogue_t * const p_catalogue,
+                                              char * const p_default_name)
+{
+        reflow_profile_store_error_t result = REFLOW_PROFILE_STORE_ERROR_SUCCESS;
+        bool success = false;
+        size_t crc_offset = 0;
+        size_t name_len = 0;
+        size_t offset = FIXED_HEADER_SIZE;
+        size_t record_size;
+        uint8_t count = 0;
+        uint8_t i;
+
+        if ((FIXED_HEADER_SIZE + REFLOW_PROFILE_STORE_CRC_SIZE) > size) {
+                result = REFLOW_PROFILE_STORE_ERROR_CORRUPTED;
+        } else if (REFLOW_PROFILE_STORE_SNAPSHOT_VERSION < p_buffer[1]) {
+                result = REFLOW_PROFILE_STORE_ERROR_UNSUPPORTED;
+        } else {
+                crc_offset = size - REFLOW_PROFILE_STORE_CRC_SIZE;
+                name_len = p_buffer[2];
+
+                success = ((byte_codec_get_u16(&p_buffer[crc_offset]) ==
+                            byte_codec_crc16(p_buffer, crc_offset)) &&
+                           (REFLOW_PROFILE_NAME_LEN_MAX >= name_len) &&
+                           ((offset + name_len + 1) <= crc_offset));
+        }
+
+        if (success) {
+                success = (NULL == memchr(&p_buffer[offset], '\0', name_len));
+        }
+
+        if (success) {
+                memcpy(p_default_name, &p_buffer[offset], name_len);
+                p_default_name[name_len] = '\0';
+                offset += name_len;
+                count = p_buffer[offset++];
+
+                success = (REFLOW_PROFILE_CATALOGUE_SLOTS_CNT >= count);
+        }
+
+        for (i = 0; (success) && (count > i); i++) {
+                success = reflow_profile_codec_decode(&p_buffer[offset],
+                                                      crc_offset - offset,
+                                                      &p_catalogue->slots[i].profile,
+                                                      &record_size);
+
+                if (success) {
+                        offset += record_size;
+                        success = add_entry(p_buffer, crc_offset, &offset, p_catalogue);
+                }
+        }
+
+        if (success) {
+                success = (offset == crc_offset);
+        }
+
+        if ((REFLOW_PROFILE_STORE_ERROR_SUCCESS == result) && (!success)) {
+                result = REFLOW_PROFILE_STORE_ERROR_CORRUPTED;
+        }
+
+        return result;
+}
+
+/*!
+ * @brief Decode the program of the entry being added and add it
+ *
+ * The profile of the entry is expected to be already decoded in the first
+ * free slot of the catalogue, the program is decoded next to it.
+ *
+ * @param[in]           p_buffer            Buffer holding the snapshot
+ * @param[in]           size                Size of the entries area of the
+ *                                          snapshot
+ * @param[in,out]       p_offset            Offset of the program size on the
+ *                                          buffer, updated to the next entry
+ * @param[in,out]       p_catalogue         Pointer to the catalogue
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Truncated or invalid program, or
+ *                                          profile name repeated
+ */
+static bool add_entry(uint8_t const * const p_buffer,
+                      size_t const size,
+                      size_t * const p_offset,
+                      reflow_profile_catalogue_t * const p_catalogue)
+{
+        reflow_profile_catalogue_slot_t * const p_slot =
+                &p_catalogue->slots[p_catalogue->count];
+        size_t offset = *p_offset;
+        size_t program_size = 0;
+        uint8_t slot;
+        bool success = (offset < size);
+
+        if (success) {
+                program_size = p_buffer[offset++];
+
+                success = ((offset + program_size) <= size);
+        }
+
+        if ((success) && (0 < program_size)) {
+                success = reflow_program_decode(&p_buffer[offset],
+                                                program_size,
+                                                &p_slot->program);
+        }
+
+        // Only the slots already added are looked at, not the one being added
+        if (success) {
+                success = !reflow_profile_catalogue_find(p_catalogue,
+                                                         p_slot->profile.name,
+                                                         &slot);
+        }
+
+        if (success) {
+                p_slot->has_program = (0 < program_size);
+                p_catalogue->count++;
+                p_catalogue->is_list_dirty = true;
+                *p_offset = offset + program_size;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
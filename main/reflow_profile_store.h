@@ -0,0 +1,169 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_store.h
+ *
+ * @brief Write-behind policy and snapshot format used to persist the profile
+ *        catalogue to NVS in a single write
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef REFLOW_PROFILE_STORE_H
+#define REFLOW_PROFILE_STORE_H
+
+#include "reflow_profile_catalogue.h"
+#include "reflow_profile_codec.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Version of the snapshot format
+#define REFLOW_PROFILE_STORE_SNAPSHOT_VERSION           (2)
+
+//! @brief Oldest snapshot format version able to read the snapshots written
+#define REFLOW_PROFILE_STORE_SNAPSHOT_MIN_READER        (2)
+
+//! @brief Size in bytes of the largest snapshot header: versions, default name,
+//!        count
+#define REFLOW_PROFILE_STORE_HEADER_SIZE                \
+        (1 + 1 + 1 + REFLOW_PROFILE_NAME_LEN_MAX + 1)
+
+//! @brief Size in bytes of the snapshot CRC
+#define REFLOW_PROFILE_STORE_CRC_SIZE                   (2)
+
+//! @brief Size in bytes of the largest snapshot entry: profile, program
+#define REFLOW_PROFILE_STORE_ENTRY_SIZE_MAX             \
+        (REFLOW_PROFILE_CODEC_RECORD_SIZE_MAX + 1 +     \
+         REFLOW_PROGRAM_ENCODED_SIZE_MAX)
+
+//! @brief Size in bytes of the largest snapshot
+#define REFLOW_PROFILE_STORE_SNAPSHOT_SIZE_MAX          \
+        (REFLOW_PROFILE_STORE_HEADER_SIZE +             \
+         (REFLOW_PROFILE_CATALOGUE_SLOTS_CNT *          \
+          REFLOW_PROFILE_STORE_ENTRY_SIZE_MAX) +        \
+         REFLOW_PROFILE_STORE_CRC_SIZE)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Result of decoding a snapshot
+typedef enum {
+
+        //! @brief Everything went well
+        REFLOW_PROFILE_STORE_ERROR_SUCCESS = 0,
+
+        //! @brief Null parameter passed
+        REFLOW_PROFILE_STORE_ERROR_BAD_PARAMETER,
+
+        //! @brief Snapshot truncated, malformed or failing its CRC
+        REFLOW_PROFILE_STORE_ERROR_CORRUPTED,
+
+        //! @brief Snapshot written by a newer firmware, in a format this one
+        //!        can't read
+        REFLOW_PROFILE_STORE_ERROR_UNSUPPORTED,
+
+        REFLOW_PROFILE_STORE_ERROR_COUNT
+} reflow_profile_store_error_t;
+
+//! @brief NVS usage counters
+typedef struct {
+        //! @brief Number of values written to NVS
+        uint32_t write_count;
+
+        //! @brief Number of values or namespaces erased from NVS
+        uint32_t erase_count;
+
+        //! @brief Number of times pending changes were flushed
+        uint32_t flush_count;
+} reflow_profile_store_stats_t;
+
+//! @brief Write-behind state
+typedef struct {
+        //! @brief Time in milliseconds of the first change not flushed yet
+        uint32_t first_change_ms;
+
+        //! @brief Time in milliseconds of the last change not flushed yet
+        uint32_t last_change_ms;
+
+        //! @brief Time in milliseconds after the last change to flush
+        uint32_t idle_ms;
+
+        //! @brief Maximum time in milliseconds a change can be kept unflushed
+        uint32_t max_delay_ms;
+
+        //! @brief Whether there are changes not flushed yet
+        bool is_dirty;
+
+        //! @brief NVS usage counters
+        reflow_profile_store_stats_t stats;
+} reflow_profile_store_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize the write-behind state
+bool reflow_profile_store_init(reflow_profile_store_t * const p_store,
+                               uint32_t const idle_ms,
+                               uint32_t const max_delay_ms);
+
+//! @brief Record a change to be flushed
+bool reflow_profile_store_mark_dirty(reflow_profile_store_t * const p_store,
+                                     uint32_t const now_ms);
+
+//! @brief Query whether pending changes must be flushed now
+bool reflow_profile_store_is_flush_due(reflow_profile_store_t const * const p_store,
+                                       uint32_t const now_ms);
+
+//! @brief Record that the pending changes were flushed
+bool reflow_profile_store_mark_flushed(reflow_profile_store_t * const p_store);
+
+//! @brief Record that flushing failed, so it is retried later
+bool reflow_profile_store_mark_failed(reflow_profile_store_t * const p_store,
+                                      uint32_t const now_ms);
+
+//! @brief Encode the catalogue and default profile name in a snapshot
+bool reflow_profile_store_encode(reflow_profile_catalogue_t const * const p_catalogue,
+                                 char const * const p_default_name,
+                                 uint8_t * const p_buffer,
+                                 size_t const size,
+                                 size_t * const p_written);
+
+//! @brief Decode the catalogue and default profile name from a snapshot
+reflow_profile_store_error_t reflow_profile_store_decode(uint8_t const * const p_buffer,
+                                                         size_t const size,
+                                                         reflow_profile_catalogue_t * const p_catalogue,
+                                                         char * const p_default_name,
+                                                         uint8_t * const p_version);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //REFLOW_PROFILE_STORE_H
@@ -0,0 +1,428 @@
+/*!
+ *******************************************************************************
+ * @file reflow_program.c
+ *
+ * @brief Variable length reflow program made of (target, ramp, hold) segments,
+ *        followed by a cooling phase
+ *
+ * Programs are stored in a compact little endian format, independent of the
+ * compiler structure packing:
+ *
+ * | Offset | Size | Field                                         |
+ * |--------|------|-----------------------------------------------|
+ * | 0      | 1    | Version, `REFLOW_PROGRAM_ENCODING_VERSION`    |
+ * | 1      | 1    | Segment count                                 |
+ * | 2      | 2    | Cooling temperature                           |
+ * | 4      | 2    | Cooling time                                  |
+ * | 6      | 5*n  | Segments: target (2), ramp (1) and hold (2)   |
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "byte_codec.h"
+#include "reflow_profile.h"
+#include "reflow_program.h"
+#include "supervisor_invariants.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Validate a program segment
+static bool reflow_program_is_valid_segment(
+                reflow_program_segment_t const * const p_segment);
+
+//! @brief Get the time the program plans above liquidus
+static uint32_t reflow_program_get_time_above_liquidus_ms(
+                reflow_program_t const * const p_program);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Build the program equivalent to a five phases profile
+ *
+ * The program has two segments: preheat (ramp to the preheat temperature,
+ * hold for the soak time) and reflow (ramp to the reflow temperature, hold for
+ * the dwell time), followed by the profile cooling phase.
+ *
+ * @param[in]           p_reflow_profile    Pointer to the profile to import
+ * @param[out]          p_program           Pointer where to store the program
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or the profile
+ *                                          doesn't make a valid program
+ */
+bool reflow_program_from_profile(reflow_profile_t const * const p_reflow_profile,
+                                 reflow_program_t * const p_program)
+{
+        reflow_program_t program = {0};
+        bool success = ((NULL != p_reflow_profile) && (NULL != p_program));
+
+        if (success) {
+                success = (UINT8_MAX >= p_reflow_profile->ramp_speed);
+        }
+
+        if (success) {
+                program.segment_count = 2;
+
+                program.segments[0].target_temperature =
+                                p_reflow_profile->preheat_temperature;
+                program.segments[0].ramp_speed =
+                                (uint8_t)p_reflow_profile->ramp_speed;
+                program.segments[0].hold_time_s = p_reflow_profile->soak_time_s;
+
+                program.segments[1].target_temperature =
+                                p_reflow_profile->reflow_temperature;
+                program.segments[1].ramp_speed =
+                                (uint8_t)p_reflow_profile->ramp_speed;
+                program.segments[1].hold_time_s = p_reflow_profile->dwell_time_s;
+
+                program.cooling_temperature =
+                                p_reflow_profile->cooling_temperature;
+                program.cooling_time_s = p_reflow_profile->cooling_time_s;
+
+                success = reflow_program_is_valid(&program);
+        }
+
+        if (success) {
+                *p_program = program;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Validate a program
+ *
+ * @param[in]           p_program           Pointer to the program to validate
+ *
+ * @return              bool                Result of the validation
+ * @retval              true                Program is valid
+ * @retval              false               Null pointer passed, no segments,
+ *                                          too many segments, a field is out
+ *                                          of its limits or the program plans
+ *                                          more time above liquidus than the
+ *                                          supervisor allows
+ */
+bool reflow_program_is_valid(reflow_program_t const * const p_program)
+{
+        bool success = (NULL != p_program);
+        size_t i;
+
+        if (success) {
+                success = ((0 < p_program->segment_count) &&
+                           (REFLOW_PROGRAM_SEGMENTS_MAX >= p_program->segment_count));
+        }
+
+        for (i = 0; (success) && (p_program->segment_count > i); i++) {
+                success = reflow_program_is_valid_segment(&p_program->segments[i]);
+        }
+
+        if (success) {
+                success = ((REFLOW_PROFILE_COOLING_TEMP_MIN_C <=
+                            p_program->cooling_temperature) &&
+                           (REFLOW_PROFILE_COOLING_TEMP_MAX_C >=
+                            p_program->cooling_temperature) &&
+                           (REFLOW_PROFILE_COOLING_TIME_MIN_S <=
+                            p_program->cooling_time_s) &&
+                           (REFLOW_PROFILE_COOLING_TIME_MAX_S >=
+                            p_program->cooling_time_s));
+        }
+
+        // The supervisor would abort the run half way through
+        if (success) {
+                success = (SUPERVISOR_MAX_TIME_ABOVE_LIQUIDUS_MS >=
+                           reflow_program_get_time_above_liquidus_ms(p_program));
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the highest target temperature of a program
+ *
+ * @param[in]           p_program           Pointer to the program
+ *
+ * @return              uint16_t            Highest segment target in Celsius,
+ *                                          0 if null pointer passed
+ */
+uint16_t reflow_program_get_peak_temperature(reflow_program_t const * const p_program)
+{
+        uint16_t peak_temperature = 0;
+        size_t i;
+
+        for (i = 0; (NULL != p_program) && (p_program->segment_count > i); i++) {
+                if (peak_temperature < p_program->segments[i].target_temperature) {
+                        peak_temperature = p_program->segments[i].target_temperature;
+                }
+        }
+
+        return peak_temperature;
+}
+
+/*!
+ * @brief Encode a program in its compact storage format
+ *
+ * @param[in]           p_program           Pointer to the program to encode
+ * @param[out]          p_buffer            Buffer where to write the encoded
+ *                                          program
+ * @param[in]           size                Size of the buffer in bytes. A
+ *                                          `REFLOW_PROGRAM_ENCODED_SIZE_MAX`
+ *                                          bytes buffer fits any program
+ * @param[out]          p_written           Pointer where to store the number
+ *                                          of bytes written
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, invalid
+ *                                          program or buffer too small
+ */
+bool reflow_program_encode(reflow_program_t const * const p_program,
+                           uint8_t * const p_buffer,
+                           size_t const size,
+                           size_t * const p_written)
+{
+        reflow_program_segment_t const * p_segment;
+        uint8_t * p_cursor = p_buffer;
+        bool success = ((NULL != p_buffer) && (NULL != p_written));
+        size_t i;
+
+        if (success) {
+                success = reflow_program_is_valid(p_program);
+        }
+
+        if (success) {
+                success = (REFLOW_PROGRAM_ENCODED_SIZE(p_program->segment_count) <=
+                           size);
+        }
+
+        if (success) {
+                p_cursor[0] = REFLOW_PROGRAM_ENCODING_VERSION;
+                p_cursor[1] = p_program->segment_count;
+                byte_codec_put_u16(&p_cursor[2], p_program->cooling_temperature);
+                byte_codec_put_u16(&p_cursor[4], p_program->cooling_time_s);
+                p_cursor += REFLOW_PROGRAM_ENCODED_HEADER_SIZE;
+
+                for (i = 0; p_program->segment_count > i; i++) {
+                        p_segment = &p_program->segments[i];
+
+                        byte_codec_put_u16(&p_cursor[0],
+                                           p_segment->target_temperature);
+                        p_cursor[2] = p_segment->ramp_speed;
+                        byte_codec_put_u16(&p_cursor[3],
+                                           p_segment->hold_time_s);
+                        p_cursor += REFLOW_PROGRAM_ENCODED_SEGMENT_SIZE;
+                }
+
+                *p_written = REFLOW_PROGRAM_ENCODED_SIZE(p_program->segment_count);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Decode a program from its compact storage format
+ *
+ * @param[in]           p_buffer            Buffer holding the encoded program
+ * @param[in]           size                Size of the encoded program in bytes
+ * @param[out]          p_program           Pointer where to store the program
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, unknown
+ *                                          version, size not matching the
+ *                                          segment count or invalid program
+ */
+bool reflow_program_decode(uint8_t const * const p_buffer,
+                           size_t const size,
+                           reflow_program_t * const p_program)
+{
+        reflow_program_t program = {0};
+        reflow_program_segment_t * p_segment;
+        uint8_t const * p_cursor = p_buffer;
+        bool success = ((NULL != p_buffer) && (NULL != p_program));
+        size_t i;
+
+        if (success) {
+                success = ((REFLOW_PROGRAM_ENCODED_HEADER_SIZE <= size) &&
+                           (REFLOW_PROGRAM_ENCODING_VERSION == p_cursor[0]) &&
+                           (REFLOW_PROGRAM_SEGMENTS_MAX >= p_cursor[1]));
+        }
+
+        if (success) {
+                program.segment_count = p_cursor[1];
+
+                success = (REFLOW_PROGRAM_ENCODED_SIZE(program.segment_count) ==
+                           size);
+        }
+
+        if (success) {
+                program.cooling_temperature = byte_codec_get_u16(&p_cursor[2]);
+                program.cooling_time_s = byte_codec_get_u16(&p_cursor[4]);
+                p_cursor += REFLOW_PROGRAM_ENCODED_HEADER_SIZE;
+
+                for (i = 0; program.segment_count > i; i++) {
+                        p_segment = &program.segments[i];
+
+                        p_segment->target_temperature =
+                                        byte_codec_get_u16(&p_cursor[0]);
+                        p_segment->ramp_speed = p_cursor[2];
+                        p_segment->hold_time_s =
+                                        byte_codec_get_u16(&p_cursor[3]);
+                        p_cursor += REFLOW_PROGRAM_ENCODED_SEGMENT_SIZE;
+                }
+
+                success = reflow_program_is_valid(&program);
+        }
+
+        if (success) {
+                *p_program = program;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Validate a program segment
+ *
+ * @param[in]           p_segment           Pointer to the segment to validate
+ *
+ * @return              bool                Result of the validation
+ */
+static bool reflow_program_is_valid_segment(
+                reflow_program_segment_t const * const p_segment)
+{
+        return ((REFLOW_PROGRAM_TARGET_TEMP_MIN_C <= p_segment->target_temperature) &&
+                (REFLOW_PROGRAM_TARGET_TEMP_MAX_C >= p_segment->target_temperature) &&
+                (REFLOW_PROFILE_RAMP_SPEED_MIN_CS <= p_segment->ramp_speed) &&
+                (REFLOW_PROFILE_RAMP_SPEED_MAX_CS >= p_segment->ramp_speed) &&
+                (REFLOW_PROGRAM_HOLD_TIME_MAX_S >= p_segment->hold_time_s));
+}
+
+/*!
+ * @brief Get the time the program plans above liquidus
+ *
+ * Follows the trajectory of the program: a linear ramp to the target of each
+ * segment, its hold, and a linear cooling down to the cooling temperature,
+ * which is always below liquidus. The run is taken to start below liquidus.
+ * Stretches above liquidus are added up, even if the program goes below it in
+ * between.
+ *
+ * @param[in]           p_program           Pointer to the program, valid
+ *                                          except for this check
+ *
+ * @return              uint32_t            Time in milliseconds planned above
+ *                                          liquidus
+ */
+static uint32_t reflow_program_get_time_above_liquidus_ms(
+                reflow_program_t const * const p_program)
+{
+        reflow_program_segment_t const * p_segment;
+        uint16_t temperature = 0;
+        uint16_t high;
+        uint16_t low;
+        uint32_t time_ms = 0;
+        size_t i;
+
+        for (i = 0; p_program->segment_count > i; i++) {
+                p_segment = &p_program->segments[i];
+
+                // Ramps are walked at the same speed up and down
+                if (p_segment->target_temperature > temperature) {
+                        high = p_segment->target_temperature;
+                        low = temperature;
+                } else {
+                        high = temperature;
+                        low = p_segment->target_temperature;
+                }
+
+                if (SUPERVISOR_LIQUIDUS_TEMPERATURE_C > low) {
+                        low = SUPERVISOR_LIQUIDUS_TEMPERATURE_C;
+                }
+
+                if (high > low) {
+                        time_ms += ((uint32_t)(high - low) * 1000) /
+                                   p_segment->ramp_speed;
+                }
+
+                if (SUPERVISOR_LIQUIDUS_TEMPERATURE_C <
+                    p_segment->target_temperature) {
+                        time_ms += (uint32_t)p_segment->hold_time_s * 1000;
+                }
+
+                temperature = p_segment->target_temperature;
+        }
+
+        if (SUPERVISOR_LIQUIDUS_TEMPERATURE_C < temperature) {
+                time_ms += ((uint32_t)p_program->cooling_time_s * 1000 *
+                            (temperature - SUPERVISOR_LIQUIDUS_TEMPERATURE_C)) /
+                           (temperature - p_program->cooling_temperature);
+        }
+
+        return time_ms;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,132 @@
+/*!
+ *******************************************************************************
+ * @file reflow_program.h
+ *
+ * @brief Variable length reflow program made of (target, ramp, hold) segments,
+ *        followed by a cooling phase
+ *
+ * @note Don't include this header directly but `reflow_profile.h`, which
+ *       includes it once `reflow_profile_t` is defined
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef REFLOW_PROGRAM_H
+#define REFLOW_PROGRAM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Maximum number of segments of a program
+#define REFLOW_PROGRAM_SEGMENTS_MAX                     (16)
+
+//! @brief Limit values for the segments target temperature
+#define REFLOW_PROGRAM_TARGET_TEMP_MIN_C                REFLOW_PROFILE_PREHEAT_TEMP_MIN_C
+#define REFLOW_PROGRAM_TARGET_TEMP_MAX_C                REFLOW_PROFILE_REFLOW_TEMP_MAX_C
+
+//! @brief Maximum time to hold a segment target, long enough for bake recipes
+#define REFLOW_PROGRAM_HOLD_TIME_MAX_S                  (12 * 60 * 60)
+
+//! @brief Version of the encoded program format
+#define REFLOW_PROGRAM_ENCODING_VERSION                 (1)
+
+//! @brief Size in bytes of the encoded program header and of each segment
+#define REFLOW_PROGRAM_ENCODED_HEADER_SIZE              (6)
+#define REFLOW_PROGRAM_ENCODED_SEGMENT_SIZE             (5)
+
+//! @brief Size in bytes of an encoded program with a given segment count, as
+//!        a `size_t` to compare with buffer sizes
+#define REFLOW_PROGRAM_ENCODED_SIZE(count)              \
+        (REFLOW_PROGRAM_ENCODED_HEADER_SIZE +           \
+         ((size_t)(count) * REFLOW_PROGRAM_ENCODED_SEGMENT_SIZE))
+
+//! @brief Size in bytes of the largest encoded program
+#define REFLOW_PROGRAM_ENCODED_SIZE_MAX                 \
+        REFLOW_PROGRAM_ENCODED_SIZE(REFLOW_PROGRAM_SEGMENTS_MAX)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Program segment: ramp to a temperature, then hold it for some time
+typedef struct {
+        //! @brief Temperature to reach, in Celsius. Can be below the previous one
+        uint16_t target_temperature;
+
+        //! @brief Heating speed to reach the target, in Celsius per second
+        uint8_t ramp_speed;
+
+        //! @brief Time to hold the target once reached, in seconds
+        uint16_t hold_time_s;
+} reflow_program_segment_t;
+
+//! @brief Reflow program
+typedef struct {
+        //! @brief Number of valid segments
+        uint8_t segment_count;
+
+        //! @brief Segments, run in order
+        reflow_program_segment_t segments[REFLOW_PROGRAM_SEGMENTS_MAX];
+
+        //! @brief Temperature to reach (downwards) at cooling phase, in Celsius
+        uint16_t cooling_temperature;
+
+        //! @brief Maximum time allowed during cooling phase in seconds
+        uint16_t cooling_time_s;
+} reflow_program_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Build the program equivalent to a five phases profile
+bool reflow_program_from_profile(reflow_profile_t const * const p_reflow_profile,
+                                 reflow_program_t * const p_program);
+
+//! @brief Validate a program
+bool reflow_program_is_valid(reflow_program_t const * const p_program);
+
+//! @brief Get the highest target temperature of a program
+uint16_t reflow_program_get_peak_temperature(reflow_program_t const * const p_program);
+
+//! @brief Encode a program in its compact storage format
+bool reflow_program_encode(reflow_program_t const * const p_program,
+                           uint8_t * const p_buffer,
+                           size_t const size,
+                           size_t * const p_written);
+
+//! @brief Decode a program from its compact storage format
+bool reflow_program_decode(uint8_t const * const p_buffer,
+                           size_t const size,
+                           reflow_program_t * const p_program);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //REFLOW_PROGRAM_H
@@ -23,9 +23,12 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/FreeRTOSConfig.h"
 #include "freertos/timers.h"
+#include "freertos/task.h"
 #include "esp_log.h"
+#include "deferred_log.h"
 #include "state_machine/states/state_machine_states.h"
 #include "state_machine/state_machine.h"
+#include "reflow_clock.h"
 #include "reflow_timer.h"
 
 /*
@@ -55,6 +58,9 @@
 
 static void reflow_timer_callback(TimerHandle_t handle);
 
+//! @brief Get the current time in milliseconds
+static uint32_t reflow_timer_get_time_ms(void);
+
 /*
  *******************************************************************************
  * Public Data Declarations                                                    *
@@ -73,6 +79,12 @@ static bool m_is_initialized = false;
 
 static state_machine_state_text_t m_reflow_timer_state = STATE_MACHINE_STATE_COUNT;
 
+//! @brief Period in milliseconds the timer was last started with
+static uint32_t m_reflow_timer_period_ms = 0;
+
+//! @brief Clock tracking the timer progress, so it can be paused and resumed
+static reflow_clock_t m_reflow_timer_clock;
+
 /*
  *******************************************************************************
  * Public Function Bodies                                                      *
@@ -103,11 +115,13 @@ bool reflow_timer_init(void)
 bool reflow_timer_start_timer(uint32_t const period_s,
                               state_machine_state_text_t const state)
 {
-        uint32_t const period_ticks = pdMS_TO_TICKS(period_s * 1000);
+        uint32_t const period_ms = period_s * 1000;
         BaseType_t result;
         bool success;
 
-        result = xTimerChangePeriod(m_reflow_timer_h, pdMS_TO_TICKS(period_ticks), portMAX_DELAY);
+        result = xTimerChangePeriod(m_reflow_timer_h,
+                                    pdMS_TO_TICKS(period_ms),
+                                    portMAX_DELAY);
 
         success  = (pdPASS == result);
 
@@ -118,8 +132,11 @@ bool reflow_timer_start_timer(uint32_t const period_s,
 
         if (success) {
                 m_reflow_timer_state = state;
-                ESP_LOGI(TAG, "Timer started for %d ticks", pdMS_TO_TICKS(period_ticks));
+                m_reflow_timer_period_ms = period_ms;
+                (void)reflow_clock_start(&m_reflow_timer_clock,
+                                         reflow_timer_get_time_ms());
 
+                DEFERRED_LOGI(TAG, "Timer started for %d ticks", pdMS_TO_TICKS(period_ms));
         }
 
         return success;
@@ -131,15 +148,109 @@ bool reflow_timer_stop_timer(void)
 
         result = xTimerStop(m_reflow_timer_h, portMAX_DELAY);
 
+        (void)reflow_clock_stop(&m_reflow_timer_clock);
+
         return (pdPASS == result);
 }
 
+/*!
+ * @brief Freeze a running timer, keeping track of the time left
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Timer was not running, was already
+ *                                          paused or couldn't be stopped
+ */
+bool reflow_timer_pause_timer(void)
+{
+        BaseType_t result;
+        bool success = reflow_clock_pause(&m_reflow_timer_clock,
+                                          reflow_timer_get_time_ms());
+
+        if (success) {
+                result = xTimerStop(m_reflow_timer_h, portMAX_DELAY);
+                success = (pdPASS == result);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Re-arm a paused timer for the time that was left when pausing it
+ *
+ * @note The clock of the timer is stopped when it expires. If it expired
+ *       while being paused, its message was already sent and there is nothing
+ *       left to re-arm. A timer with less than a tick left is re-armed for a
+ *       single tick, so its message is not lost
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well, or the timer
+ *                                          had already expired
+ * @retval              false               Timer was running and not paused or
+ *                                          couldn't be restarted
+ */
+bool reflow_timer_resume_timer(void)
+{
+        uint32_t const now_ms = reflow_timer_get_time_ms();
+        bool const is_expired = !m_reflow_timer_clock.is_running;
+        TickType_t remaining_ticks = 0;
+        uint32_t remaining_ms = 0;
+        BaseType_t result;
+        bool success = ((is_expired) ||
+                        (reflow_clock_get_remaining(&m_reflow_timer_clock,
+                                                    now_ms,
+                                                    m_reflow_timer_period_ms,
+                                                    &remaining_ms)));
+
+        if ((success) && (!is_expired)) {
+                success = reflow_clock_resume(&m_reflow_timer_clock, now_ms);
+        }
+
+        if ((success) && (!is_expired)) {
+                remaining_ticks = pdMS_TO_TICKS(remaining_ms);
+
+                if (0 == remaining_ticks) {
+                        remaining_ticks = 1;
+                }
+
+                // Changing the period of a dormant timer also starts it
+                result = xTimerChangePeriod(m_reflow_timer_h,
+                                            remaining_ticks,
+                                            portMAX_DELAY);
+
+                success = (pdPASS == result);
+        }
+
+        if ((success) && (!is_expired)) {
+                DEFERRED_LOGI(TAG, "Timer resumed for %d ticks", remaining_ticks);
+        }
+
+        return success;
+}
+
 /*
  *******************************************************************************
  * Private Function Bodies                                                     *
  *******************************************************************************
  */
 
+/*!
+ * @brief Get the current time in milliseconds
+ *
+ * @param               -                   -
+ *
+ * @return              uint32_t            Milliseconds since the scheduler
+ *                                          started
+ */
+static uint32_t reflow_timer_get_time_ms(void)
+{
+        return pdTICKS_TO_MS(xTaskGetTickCount());
+}
+
 /*
  *******************************************************************************
  * Interrupt Service Routines / Tasks / Thread Main Functions                  *
@@ -154,7 +265,10 @@ static void reflow_timer_callback(TimerHandle_t const handle)
         bool success = (STATE_MACHINE_MSG_COUNT != message);
         state_machine_data_t data;
 
-        ESP_LOGI(TAG, "Timer is done, state is %d and message is %d", m_reflow_timer_state, message);
+        DEFERRED_LOGI(TAG, "Timer is done, state is %d and message is %d", m_reflow_timer_state, message);
+
+        // An expired timer can't be paused nor resumed
+        (void)reflow_clock_stop(&m_reflow_timer_clock);
 
         if (success) {
                 data.message = message;
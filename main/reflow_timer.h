@@ -48,5 +48,9 @@ bool reflow_timer_start_timer(uint32_t const period_s, state_machine_state_text_
 
 bool reflow_timer_stop_timer(void);
 
+bool reflow_timer_pause_timer(void);
+
+bool reflow_timer_resume_timer(void);
+
 
 #endif //REFLOW_TIMER_H
\ No newline at end of file
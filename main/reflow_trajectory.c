@@ -0,0 +1,376 @@
+/*!
+ *******************************************************************************
+ * @file reflow_trajectory.c
+ *
+ * @brief Intended temperature curve of a reflow program, compiled into a
+ *        table of linear pieces with constant time lookups
+ *
+ * Each segment compiles into a ramp, lasting the temperature delta over the
+ * ramp speed, and a hold, lasting the hold time. Cooling follows, lasting the
+ * cooling time. Pieces that would take no time are left out, so every piece
+ * is at least a millisecond long.
+ *
+ * Lookups don't search the pieces: the trajectory is split in
+ * `REFLOW_TRAJECTORY_INDEX_SIZE` buckets of a power of two milliseconds, and
+ * the piece running at the start of each bucket is stored. A lookup goes to
+ * its bucket with a shift, and only walks the few pieces starting within it.
+ *
+ * The module doesn't read any time source by itself, so it can be checked on
+ * the host.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "reflow_profile.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Append a piece, unless it takes no time
+static void add_piece(reflow_trajectory_t * const p_trajectory,
+                      uint32_t const duration_ms,
+                      uint16_t const start_temperature,
+                      uint16_t const end_temperature,
+                      uint8_t const segment,
+                      reflow_trajectory_phase_t const phase);
+
+//! @brief Build the lookup index of the compiled pieces
+static void build_index(reflow_trajectory_t * const p_trajectory);
+
+//! @brief Get the piece running at a time within the trajectory
+static reflow_trajectory_piece_t const * find_piece(reflow_trajectory_t const * const p_trajectory,
+                                                    uint32_t const time_ms);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Compile the trajectory of a program
+ *
+ * @param[in]           p_program           Pointer to the program
+ * @param[in]           start_temperature   Temperature in Celsius at the start
+ *                                          of the run
+ * @param[out]          p_trajectory        Pointer to the trajectory to compile
+ *                                          into
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or invalid
+ *                                          program
+ */
+bool reflow_trajectory_compile(reflow_program_t const * const p_program,
+                               uint16_t const start_temperature,
+                               reflow_trajectory_t * const p_trajectory)
+{
+        bool success = ((NULL != p_trajectory) &&
+                        (reflow_program_is_valid(p_program)));
+        reflow_program_segment_t const * p_segment;
+        uint16_t temperature = start_temperature;
+        uint32_t delta;
+        uint8_t i;
+
+        if (success) {
+                memset(p_trajectory, 0, sizeof(*p_trajectory));
+                p_trajectory->segment_count = p_program->segment_count;
+                p_trajectory->peak_temperature = start_temperature;
+        }
+
+        for (i = 0; (success) && (p_program->segment_count > i); i++) {
+                p_segment = &p_program->segments[i];
+
+                if (p_segment->target_temperature > temperature) {
+                        delta = p_segment->target_temperature - temperature;
+                } else {
+                        delta = temperature - p_segment->target_temperature;
+                }
+
+                add_piece(p_trajectory,
+                          (delta * 1000) / p_segment->ramp_speed,
+                          temperature,
+                          p_segment->target_temperature,
+                          i,
+                          REFLOW_TRAJECTORY_PHASE_RAMP);
+
+                temperature = p_segment->target_temperature;
+
+                add_piece(p_trajectory,
+                          (uint32_t)p_segment->hold_time_s * 1000,
+                          temperature,
+                          temperature,
+                          i,
+                          REFLOW_TRAJECTORY_PHASE_HOLD);
+
+                if (temperature > p_trajectory->peak_temperature) {
+                        p_trajectory->peak_temperature = temperature;
+                }
+        }
+
+        // Already below the cooling temperature, there is nothing to cool
+        if ((success) && (p_program->cooling_temperature < temperature)) {
+                add_piece(p_trajectory,
+                          (uint32_t)p_program->cooling_time_s * 1000,
+                          temperature,
+                          p_program->cooling_temperature,
+                          p_program->segment_count,
+                          REFLOW_TRAJECTORY_PHASE_COOLING);
+
+                temperature = p_program->cooling_temperature;
+        }
+
+        if (success) {
+                p_trajectory->end_temperature = temperature;
+                build_index(p_trajectory);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the intended temperature at a given time
+ *
+ * @param[in]           p_trajectory        Pointer to the trajectory
+ * @param[in]           time_ms             Time in milliseconds since the
+ *                                          start of the run
+ * @param[out]          p_temperature       Pointer where to store the
+ *                                          temperature in Celsius. Once the
+ *                                          trajectory is over, it is the one
+ *                                          at its end
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_trajectory_get_setpoint(reflow_trajectory_t const * const p_trajectory,
+                                    uint32_t const time_ms,
+                                    uint16_t * const p_temperature)
+{
+        bool success = ((NULL != p_trajectory) && (NULL != p_temperature));
+        reflow_trajectory_piece_t const * p_piece = NULL;
+        int32_t delta;
+
+        if (success) {
+                p_piece = find_piece(p_trajectory, time_ms);
+        }
+
+        if ((success) && (NULL != p_piece)) {
+                delta = (int32_t)p_piece->end_temperature -
+                        (int32_t)p_piece->start_temperature;
+
+                *p_temperature = (uint16_t)(p_piece->start_temperature +
+                                            (((int64_t)delta *
+                                              (time_ms - p_piece->start_ms)) /
+                                             p_piece->duration_ms));
+        } else if (success) {
+                *p_temperature = p_trajectory->end_temperature;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the phase and program segment at a given time
+ *
+ * @param[in]           p_trajectory        Pointer to the trajectory
+ * @param[in]           time_ms             Time in milliseconds since the
+ *                                          start of the run
+ * @param[out]          p_phase             Pointer where to store the phase
+ * @param[out]          p_segment           Pointer where to store the program
+ *                                          segment. It is the segment count
+ *                                          while cooling and once over
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool reflow_trajectory_get_phase(reflow_trajectory_t const * const p_trajectory,
+                                 uint32_t const time_ms,
+                                 reflow_trajectory_phase_t * const p_phase,
+                                 uint8_t * const p_segment)
+{
+        bool success = ((NULL != p_trajectory) &&
+                        (NULL != p_phase) &&
+                        (NULL != p_segment));
+        reflow_trajectory_piece_t const * p_piece = NULL;
+
+        if (success) {
+                p_piece = find_piece(p_trajectory, time_ms);
+        }
+
+        if ((success) && (NULL != p_piece)) {
+                *p_phase = p_piece->phase;
+                *p_segment = p_piece->segment;
+        } else if (success) {
+                *p_phase = REFLOW_TRAJECTORY_PHASE_DONE;
+                *p_segment = p_trajectory->segment_count;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Append a piece, unless it takes no time
+ *
+ * @param[in,out]       p_trajectory        Pointer to the trajectory
+ * @param[in]           duration_ms         Length of the piece in milliseconds
+ * @param[in]           start_temperature   Temperature at the start of the
+ *                                          piece, in Celsius
+ * @param[in]           end_temperature     Temperature at the end of the
+ *                                          piece, in Celsius
+ * @param[in]           segment             Program segment of the piece
+ * @param[in]           phase               Phase of the piece
+ *
+ * @return              -                   -
+ */
+static void add_piece(reflow_trajectory_t * const p_trajectory,
+                      uint32_t const duration_ms,
+                      uint16_t const start_temperature,
+                      uint16_t const end_temperature,
+                      uint8_t const segment,
+                      reflow_trajectory_phase_t const phase)
+{
+        reflow_trajectory_piece_t * const p_piece =
+                &p_trajectory->pieces[p_trajectory->piece_count];
+
+        if (0 < duration_ms) {
+                p_piece->start_ms = p_trajectory->duration_ms;
+                p_piece->duration_ms = duration_ms;
+                p_piece->start_temperature = start_temperature;
+                p_piece->end_temperature = end_temperature;
+                p_piece->segment = segment;
+                p_piece->phase = phase;
+
+                p_trajectory->duration_ms += duration_ms;
+                p_trajectory->piece_count++;
+        }
+}
+
+/*!
+ * @brief Build the lookup index of the compiled pieces
+ *
+ * Buckets are the shortest power of two milliseconds for the whole trajectory
+ * to fit in the index.
+ *
+ * @param[in,out]       p_trajectory        Pointer to the trajectory
+ *
+ * @return              -                   -
+ */
+static void build_index(reflow_trajectory_t * const p_trajectory)
+{
+        uint32_t bucket_start_ms;
+        uint8_t piece = 0;
+        uint8_t i;
+
+        p_trajectory->bucket_shift = 0;
+
+        while ((p_trajectory->duration_ms >> p_trajectory->bucket_shift) >=
+               REFLOW_TRAJECTORY_INDEX_SIZE) {
+                p_trajectory->bucket_shift++;
+        }
+
+        for (i = 0; REFLOW_TRAJECTORY_INDEX_SIZE > i; i++) {
+                bucket_start_ms = (uint32_t)i << p_trajectory->bucket_shift;
+
+                while (((piece + 1) < p_trajectory->piece_count) &&
+                       (p_trajectory->pieces[piece + 1].start_ms <= bucket_start_ms)) {
+                        piece++;
+                }
+
+                p_trajectory->index[i] = piece;
+        }
+}
+
+/*!
+ * @brief Get the piece running at a time within the trajectory
+ *
+ * @param[in]           p_trajectory        Pointer to the trajectory
+ * @param[in]           time_ms             Time in milliseconds since the
+ *                                          start of the run
+ *
+ * @return              reflow_trajectory_piece_t const *
+ *                                          Piece running at that time, or NULL
+ *                                          once the trajectory is over
+ */
+static reflow_trajectory_piece_t const * find_piece(reflow_trajectory_t const * const p_trajectory,
+                                                    uint32_t const time_ms)
+{
+        reflow_trajectory_piece_t const * p_piece = NULL;
+        uint8_t piece;
+
+        if (p_trajectory->duration_ms > time_ms) {
+                piece = p_trajectory->index[time_ms >> p_trajectory->bucket_shift];
+
+                while (((piece + 1) < p_trajectory->piece_count) &&
+                       (p_trajectory->pieces[piece + 1].start_ms <= time_ms)) {
+                        piece++;
+                }
+
+                p_piece = &p_trajectory->pieces[piece];
+        }
+
+        return p_piece;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,148 @@
+/*!
+ *******************************************************************************
+ * @file reflow_trajectory.h
+ *
+ * @brief Intended temperature curve of a reflow program, compiled into a
+ *        table of linear pieces with constant time lookups
+ *
+ * @note Don't include this header directly but `reflow_profile.h`, which
+ *       includes it once `reflow_program_t` is defined
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef REFLOW_TRAJECTORY_H
+#define REFLOW_TRAJECTORY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Maximum number of pieces: a ramp and a hold per segment, cooling
+#define REFLOW_TRAJECTORY_PIECES_MAX                    \
+        ((2 * REFLOW_PROGRAM_SEGMENTS_MAX) + 1)
+
+//! @brief Number of equally long time buckets the lookup index splits the
+//!        trajectory in
+#define REFLOW_TRAJECTORY_INDEX_SIZE                    (64)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Phase of the trajectory
+typedef enum {
+        //! @brief Ramping to the target of a segment
+        REFLOW_TRAJECTORY_PHASE_RAMP = 0,
+
+        //! @brief Holding the target of a segment
+        REFLOW_TRAJECTORY_PHASE_HOLD,
+
+        //! @brief Cooling down after the last segment
+        REFLOW_TRAJECTORY_PHASE_COOLING,
+
+        //! @brief Trajectory over
+        REFLOW_TRAJECTORY_PHASE_DONE,
+
+        //! @brief Fence member
+        REFLOW_TRAJECTORY_PHASE_COUNT
+} reflow_trajectory_phase_t;
+
+//! @brief Linear piece of the trajectory
+typedef struct {
+        //! @brief Time in milliseconds since the start at which the piece starts
+        uint32_t start_ms;
+
+        //! @brief Length of the piece in milliseconds, never 0
+        uint32_t duration_ms;
+
+        //! @brief Temperature at the start of the piece, in Celsius
+        uint16_t start_temperature;
+
+        //! @brief Temperature at the end of the piece, in Celsius
+        uint16_t end_temperature;
+
+        //! @brief Program segment the piece belongs to, the segment count for
+        //!        the cooling piece
+        uint8_t segment;
+
+        //! @brief Phase of the piece
+        reflow_trajectory_phase_t phase;
+} reflow_trajectory_piece_t;
+
+//! @brief Compiled trajectory
+typedef struct {
+        //! @brief Pieces, in time order and without gaps between them
+        reflow_trajectory_piece_t pieces[REFLOW_TRAJECTORY_PIECES_MAX];
+
+        //! @brief Number of valid pieces
+        uint8_t piece_count;
+
+        //! @brief Piece running at the start of each time bucket
+        uint8_t index[REFLOW_TRAJECTORY_INDEX_SIZE];
+
+        //! @brief Time buckets are `1 << bucket_shift` milliseconds long
+        uint8_t bucket_shift;
+
+        //! @brief Number of program segments
+        uint8_t segment_count;
+
+        //! @brief Total length of the trajectory in milliseconds
+        uint32_t duration_ms;
+
+        //! @brief Temperature once the trajectory is over, in Celsius
+        uint16_t end_temperature;
+
+        //! @brief Highest temperature of the trajectory, in Celsius
+        uint16_t peak_temperature;
+} reflow_trajectory_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Compile the trajectory of a program
+bool reflow_trajectory_compile(reflow_program_t const * const p_program,
+                               uint16_t const start_temperature,
+                               reflow_trajectory_t * const p_trajectory);
+
+//! @brief Get the intended temperature at a given time
+bool reflow_trajectory_get_setpoint(reflow_trajectory_t const * const p_trajectory,
+                                    uint32_t const time_ms,
+                                    uint16_t * const p_temperature);
+
+//! @brief Get the phase and program segment at a given time
+bool reflow_trajectory_get_phase(reflow_trajectory_t const * const p_trajectory,
+                                 uint32_t const time_ms,
+                                 reflow_trajectory_phase_t * const p_phase,
+                                 uint8_t * const p_segment);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //REFLOW_TRAJECTORY_H
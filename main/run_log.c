@@ -0,0 +1,589 @@
+/*!
+ *******************************************************************************
+ * @file run_log.c
+ *
+ * @brief Append-only log of run records on raw flash sectors, written as a
+ *        ring so every sector wears evenly
+ *
+ * Every sector in use starts with a header:
+ *
+ *      | magic | sequence | erase count | 0xFFFF | crc16 |
+ *
+ * with 32 bit little endian values, and the CRC over the fields before it.
+ * Records follow the header back to back, each padded to 4 bytes with 0xFF:
+ *
+ *      | crc16 | length | type | 0xFF 0xFF 0xFF | payload |
+ *
+ * where the CRC covers the rest of the header and the payload. A record
+ * header left erased marks the free space of a sector.
+ *
+ * Records are appended to the head sector, the one with the highest
+ * sequence. When a record doesn't fit, the sector following it is erased and
+ * taken as the new head, wrapping around after the last one, so the oldest
+ * sector is always the one given up, and all of them are erased in turn.
+ *
+ * A record is written with a single write, header first. If power is lost
+ * while writing, its CRC won't match, and the sector is closed on the next
+ * mount: nothing else is appended to it, and readers stop at that record.
+ *
+ * The module only knows the flash through the functions it is mounted with,
+ * so it can be checked on the host.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byte_codec.h"
+#include "run_log.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Magic number of a sector in use, "RLOG"
+#define SECTOR_MAGIC                        (0x474F4C52)
+
+//! @brief Size in bytes of the sector header fields covered by its CRC
+#define SECTOR_HEADER_CRC_OFFSET            (14)
+
+//! @brief Size in bytes of the largest record, header included
+#define RECORD_SIZE_MAX                     \
+        (RUN_LOG_RECORD_HEADER_SIZE + RUN_LOG_PAYLOAD_SIZE_MAX)
+
+//! @brief Size in bytes a record with a given payload takes in flash
+#define RECORD_SIZE(payload_size)           \
+        (RUN_LOG_RECORD_HEADER_SIZE + (((payload_size) + 3) & ~3UL))
+
+//! @brief Value of erased flash
+#define ERASED_BYTE                         (0xFF)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Contents found at a record position
+typedef enum {
+        //! @brief Nothing written yet
+        RECORD_STATE_FREE = 0,
+
+        //! @brief A complete record
+        RECORD_STATE_VALID,
+
+        //! @brief A record damaged or partially written
+        RECORD_STATE_INVALID
+} record_state_t;
+
+//! @brief Decoded sector header
+typedef struct {
+        uint32_t sequence;
+        uint32_t erase_count;
+} sector_header_t;
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Read and check the header of a sector
+static bool read_sector_header(run_log_flash_t const * const p_flash,
+                               uint32_t const sector,
+                               sector_header_t * const p_header);
+
+//! @brief Read and check the record at a position of a sector
+static record_state_t read_record(run_log_flash_t const * const p_flash,
+                                  uint32_t const sector,
+                                  uint32_t const offset,
+                                  uint8_t * const p_record);
+
+//! @brief Find where the next record of the head sector goes
+static uint32_t find_head_offset(run_log_flash_t const * const p_flash,
+                                 uint32_t const sector);
+
+//! @brief Erase the sector following the head and take it as the new head
+static bool open_next_sector(run_log_t * const p_log);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Mount the log kept at a flash area
+ *
+ * Finds the head sector and where its next record goes. Nothing is written:
+ * an area never used, or fully damaged, is taken into use on the first
+ * append.
+ *
+ * @param[out]          p_log               Pointer to the log to mount
+ * @param[in]           p_flash             Flash area of the log, must outlive
+ *                                          it
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer or function is null,
+ *                                          or the area is too small
+ */
+bool run_log_mount(run_log_t * const p_log, run_log_flash_t const * const p_flash)
+{
+        sector_header_t header;
+        uint32_t sector;
+        bool success = ((NULL != p_log) &&
+                        (NULL != p_flash) &&
+                        (NULL != p_flash->pf_read) &&
+                        (NULL != p_flash->pf_write) &&
+                        (NULL != p_flash->pf_erase) &&
+                        (RUN_LOG_SECTORS_MIN <= p_flash->sector_count));
+
+        if (success) {
+                (void)memset(p_log, 0, sizeof(*p_log));
+                p_log->p_flash = p_flash;
+
+                for (sector = 0; p_flash->sector_count > sector; sector++) {
+                        if ((read_sector_header(p_flash, sector, &header)) &&
+                            ((!p_log->has_head) ||
+                             (p_log->head_sequence < header.sequence))) {
+                                p_log->has_head = true;
+                                p_log->head_sector = sector;
+                                p_log->head_sequence = header.sequence;
+                                p_log->head_erase_count = header.erase_count;
+                        }
+                }
+        }
+
+        if ((success) && (p_log->has_head)) {
+                p_log->head_offset = find_head_offset(p_flash, p_log->head_sector);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Append a record
+ *
+ * Takes a new sector when the record doesn't fit on the head one, giving up
+ * the oldest records.
+ *
+ * @note Erasing and writing flash take time, so this is meant to be called
+ *       from a task with no deadlines
+ *
+ * @param[in,out]       p_log               Pointer to the log
+ * @param[in]           type                Type of the record
+ * @param[in]           p_payload           Pointer to the payload, can be null
+ *                                          if empty
+ * @param[in]           size                Size in bytes of the payload
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, the type is
+ *                                          invalid, the payload too large or
+ *                                          there was an I/O error
+ */
+bool run_log_append(run_log_t * const p_log,
+                    run_log_record_type_t const type,
+                    uint8_t const * const p_payload,
+                    size_t const size)
+{
+        uint8_t record[RECORD_SIZE_MAX];
+        size_t const record_size = RECORD_SIZE(size);
+        uint16_t crc;
+        bool success = ((NULL != p_log) &&
+                        (NULL != p_log->p_flash) &&
+                        (RUN_LOG_RECORD_TYPE_COUNT > type) &&
+                        (RUN_LOG_PAYLOAD_SIZE_MAX >= size) &&
+                        ((NULL != p_payload) || (0 == size)));
+
+        if ((success) &&
+            ((!p_log->has_head) ||
+             (RUN_LOG_SECTOR_SIZE < (p_log->head_offset + record_size)))) {
+                success = open_next_sector(p_log);
+        }
+
+        if (success) {
+                (void)memset(record, ERASED_BYTE, record_size);
+                byte_codec_put_u16(&record[2], (uint16_t)size);
+                record[4] = (uint8_t)type;
+
+                if (0 != size) {
+                        (void)memcpy(&record[RUN_LOG_RECORD_HEADER_SIZE],
+                                     p_payload, size);
+                }
+
+                crc = byte_codec_crc16(&record[2],
+                                       RUN_LOG_RECORD_HEADER_SIZE - 2 + size);
+                byte_codec_put_u16(&record[0], crc);
+
+                success = p_log->p_flash->pf_write(
+                                (p_log->head_sector * RUN_LOG_SECTOR_SIZE) +
+                                p_log->head_offset,
+                                record,
+                                record_size);
+
+                // Whatever got written can't be overwritten, leave the
+                // sector for good
+                p_log->head_offset = (success ?
+                                      (p_log->head_offset + record_size) :
+                                      RUN_LOG_SECTOR_SIZE);
+        }
+
+        if (success) {
+                p_log->append_count++;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Place a reader before the oldest record
+ *
+ * @param[in]           p_log               Pointer to the log
+ * @param[out]          p_iterator          Pointer to the reader
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null or the log is
+ *                                          not mounted
+ */
+bool run_log_iterate_start(run_log_t const * const p_log,
+                           run_log_iterator_t * const p_iterator)
+{
+        bool const success = ((NULL != p_log) &&
+                              (NULL != p_log->p_flash) &&
+                              (NULL != p_iterator));
+
+        if (success) {
+                // The sector after the head is the oldest one. A log never
+                // written to has nothing to visit
+                p_iterator->visited_count = (p_log->has_head ?
+                                             0 : p_log->p_flash->sector_count);
+                p_iterator->sector = ((p_log->head_sector + 1) %
+                                      p_log->p_flash->sector_count);
+                p_iterator->offset = 0;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Read the next record
+ *
+ * Sectors with a damaged header are skipped, and so is the rest of a sector
+ * after a damaged record.
+ *
+ * @param[in]           p_log               Pointer to the log
+ * @param[in,out]       p_iterator          Pointer to the reader
+ * @param[out]          p_type              Pointer where to store the type
+ * @param[out]          p_payload           Buffer where to store the payload
+ * @param[in]           size                Size of the buffer
+ * @param[out]          p_length            Pointer where to store the length
+ *                                          of the payload
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If a record was read
+ * @retval              False               If a pointer is null, no records are
+ *                                          left or the buffer is too small
+ */
+bool run_log_iterate_next(run_log_t const * const p_log,
+                          run_log_iterator_t * const p_iterator,
+                          run_log_record_type_t * const p_type,
+                          uint8_t * const p_payload,
+                          size_t const size,
+                          size_t * const p_length)
+{
+        uint8_t record[RECORD_SIZE_MAX];
+        sector_header_t header;
+        record_state_t state;
+        size_t length = 0;
+        bool is_found = false;
+        bool is_sector_done;
+        bool success = ((NULL != p_log) &&
+                        (NULL != p_log->p_flash) &&
+                        (NULL != p_iterator) &&
+                        (NULL != p_type) &&
+                        (NULL != p_payload) &&
+                        (NULL != p_length));
+
+        while ((success) && (!is_found)) {
+                success = (p_log->p_flash->sector_count > p_iterator->visited_count);
+
+                if (!success) {
+                        break;
+                }
+
+                if (0 == p_iterator->offset) {
+                        // Entering the sector
+                        is_sector_done = !read_sector_header(p_log->p_flash,
+                                                             p_iterator->sector,
+                                                             &header);
+                        p_iterator->offset = RUN_LOG_SECTOR_HEADER_SIZE;
+                } else if ((p_log->head_sector == p_iterator->sector) &&
+                           (p_log->head_offset <= p_iterator->offset)) {
+                        is_sector_done = true;
+                } else if (RUN_LOG_SECTOR_SIZE <
+                           (p_iterator->offset + RUN_LOG_RECORD_HEADER_SIZE)) {
+                        is_sector_done = true;
+                } else {
+                        state = read_record(p_log->p_flash,
+                                            p_iterator->sector,
+                                            p_iterator->offset,
+                                            record);
+
+                        is_sector_done = (RECORD_STATE_VALID != state);
+                        is_found = !is_sector_done;
+                }
+
+                if (is_sector_done) {
+                        p_iterator->sector = ((p_iterator->sector + 1) %
+                                              p_log->p_flash->sector_count);
+                        p_iterator->offset = 0;
+                        p_iterator->visited_count++;
+                }
+        }
+
+        if (success) {
+                length = byte_codec_get_u16(&record[2]);
+                p_iterator->offset += RECORD_SIZE(length);
+
+                success = (size >= length);
+        }
+
+        if (success) {
+                *p_type = (run_log_record_type_t)record[4];
+                *p_length = length;
+                (void)memcpy(p_payload, &record[RUN_LOG_RECORD_HEADER_SIZE], length);
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Read and check the header of a sector
+ *
+ * @param[in]           p_flash             Flash area of the log
+ * @param[in]           sector              Sector to read
+ * @param[out]          p_header            Pointer where to store the header
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If the sector is in use
+ * @retval              False               If the header is erased, damaged or
+ *                                          there was an I/O error
+ */
+static bool read_sector_header(run_log_flash_t const * const p_flash,
+                               uint32_t const sector,
+                               sector_header_t * const p_header)
+{
+        uint8_t buffer[RUN_LOG_SECTOR_HEADER_SIZE];
+        bool success = p_flash->pf_read(sector * RUN_LOG_SECTOR_SIZE,
+                                        buffer,
+                                        sizeof(buffer));
+
+        if (success) {
+                success = ((SECTOR_MAGIC == byte_codec_get_u32(&buffer[0])) &&
+                           (byte_codec_crc16(buffer, SECTOR_HEADER_CRC_OFFSET) ==
+                            byte_codec_get_u16(&buffer[SECTOR_HEADER_CRC_OFFSET])));
+        }
+
+        if (success) {
+                p_header->sequence = byte_codec_get_u32(&buffer[4]);
+                p_header->erase_count = byte_codec_get_u32(&buffer[8]);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Read and check the record at a position of a sector
+ *
+ * @param[in]           p_flash             Flash area of the log
+ * @param[in]           sector              Sector to read
+ * @param[in]           offset              Offset of the record in the sector
+ * @param[out]          p_record            Buffer of `RECORD_SIZE_MAX` bytes
+ *                                          where to store the record
+ *
+ * @return              record_state_t      What was found at the position
+ */
+static record_state_t read_record(run_log_flash_t const * const p_flash,
+                                  uint32_t const sector,
+                                  uint32_t const offset,
+                                  uint8_t * const p_record)
+{
+        uint32_t const address = (sector * RUN_LOG_SECTOR_SIZE) + offset;
+        record_state_t state = RECORD_STATE_INVALID;
+        size_t length = 0;
+        size_t i;
+        bool success = p_flash->pf_read(address,
+                                        p_record,
+                                        RUN_LOG_RECORD_HEADER_SIZE);
+
+        if (success) {
+                state = RECORD_STATE_FREE;
+
+                for (i = 0; RUN_LOG_RECORD_HEADER_SIZE > i; i++) {
+                        if (ERASED_BYTE != p_record[i]) {
+                                state = RECORD_STATE_INVALID;
+                        }
+                }
+
+                length = byte_codec_get_u16(&p_record[2]);
+
+                success = ((RECORD_STATE_INVALID == state) &&
+                           (RUN_LOG_PAYLOAD_SIZE_MAX >= length) &&
+                           (RUN_LOG_SECTOR_SIZE >= (offset + RECORD_SIZE(length))) &&
+                           (RUN_LOG_RECORD_TYPE_COUNT > p_record[4]));
+        }
+
+        if ((success) && (0 != length)) {
+                success = p_flash->pf_read(address + RUN_LOG_RECORD_HEADER_SIZE,
+                                           &p_record[RUN_LOG_RECORD_HEADER_SIZE],
+                                           length);
+        }
+
+        if ((success) &&
+            (byte_codec_crc16(&p_record[2],
+                              RUN_LOG_RECORD_HEADER_SIZE - 2 + length) ==
+             byte_codec_get_u16(&p_record[0]))) {
+                state = RECORD_STATE_VALID;
+        }
+
+        return state;
+}
+
+/*!
+ * @brief Find where the next record of the head sector goes
+ *
+ * @param[in]           p_flash             Flash area of the log
+ * @param[in]           sector              Head sector
+ *
+ * @return              uint32_t            Offset of the free space, or the
+ *                                          size of a sector if it is closed
+ */
+static uint32_t find_head_offset(run_log_flash_t const * const p_flash,
+                                 uint32_t const sector)
+{
+        uint8_t record[RECORD_SIZE_MAX];
+        uint32_t offset = RUN_LOG_SECTOR_HEADER_SIZE;
+        record_state_t state = RECORD_STATE_VALID;
+
+        while ((RECORD_STATE_VALID == state) &&
+               (RUN_LOG_SECTOR_SIZE >= (offset + RUN_LOG_RECORD_HEADER_SIZE))) {
+                state = read_record(p_flash, sector, offset, record);
+
+                if (RECORD_STATE_VALID == state) {
+                        offset += RECORD_SIZE(byte_codec_get_u16(&record[2]));
+                }
+        }
+
+        return ((RECORD_STATE_INVALID == state) ? RUN_LOG_SECTOR_SIZE : offset);
+}
+
+/*!
+ * @brief Erase the sector following the head and take it as the new head
+ *
+ * The erase count of the sector is carried over from its old header. If that
+ * is lost, the count of the previous sector is the closest guess, as sectors
+ * are erased in turn.
+ *
+ * @param[in,out]       p_log               Pointer to the log
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If there was an I/O error
+ */
+static bool open_next_sector(run_log_t * const p_log)
+{
+        run_log_flash_t const * const p_flash = p_log->p_flash;
+        uint8_t buffer[RUN_LOG_SECTOR_HEADER_SIZE];
+        sector_header_t header;
+        uint32_t const sector = (p_log->has_head ?
+                                 ((p_log->head_sector + 1) % p_flash->sector_count) :
+                                 0);
+        uint32_t const sequence = (p_log->has_head ? (p_log->head_sequence + 1) : 0);
+        uint32_t erase_count = p_log->head_erase_count;
+        uint16_t crc;
+        bool success;
+
+        if (read_sector_header(p_flash, sector, &header)) {
+                erase_count = header.erase_count;
+        }
+
+        erase_count++;
+
+        success = p_flash->pf_erase(sector);
+
+        if (success) {
+                p_log->erase_count++;
+
+                byte_codec_put_u32(&buffer[0], SECTOR_MAGIC);
+                byte_codec_put_u32(&buffer[4], sequence);
+                byte_codec_put_u32(&buffer[8], erase_count);
+                byte_codec_put_u16(&buffer[12], 0xFFFF);
+                crc = byte_codec_crc16(buffer, SECTOR_HEADER_CRC_OFFSET);
+                byte_codec_put_u16(&buffer[SECTOR_HEADER_CRC_OFFSET], crc);
+
+                success = p_flash->pf_write(sector * RUN_LOG_SECTOR_SIZE,
+                                            buffer,
+                                            sizeof(buffer));
+        }
+
+        // Move on even on failure, so a bad sector is skipped on the next try
+        p_log->has_head = true;
+        p_log->head_sector = sector;
+        p_log->head_sequence = sequence;
+        p_log->head_erase_count = erase_count;
+        p_log->head_offset = (success ?
+                              RUN_LOG_SECTOR_HEADER_SIZE :
+                              RUN_LOG_SECTOR_SIZE);
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
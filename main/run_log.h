@@ -0,0 +1,174 @@
+/*!
+ *******************************************************************************
+ * @file run_log.h
+ *
+ * @brief Append-only log of run records on raw flash sectors, written as a
+ *        ring so every sector wears evenly
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef RUN_LOG_H
+#define RUN_LOG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of an erasable flash sector
+#define RUN_LOG_SECTOR_SIZE                             (4096)
+
+//! @brief Size in bytes of the header starting every sector in use
+#define RUN_LOG_SECTOR_HEADER_SIZE                      (16)
+
+//! @brief Size in bytes of the header starting every record
+#define RUN_LOG_RECORD_HEADER_SIZE                      (8)
+
+//! @brief Largest record payload, in bytes
+#define RUN_LOG_PAYLOAD_SIZE_MAX                        (256)
+
+//! @brief Minimum number of sectors of a log
+#define RUN_LOG_SECTORS_MIN                             (2)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Type of a record
+typedef enum {
+        //! @brief A run started, payload: `run_logger` run header
+        RUN_LOG_RECORD_TYPE_RUN_START = 0,
+
+        //! @brief Temperature and state samples of the run in progress
+        RUN_LOG_RECORD_TYPE_TRACE,
+
+        //! @brief The run in progress ended, payload: `run_logger` run footer
+        RUN_LOG_RECORD_TYPE_RUN_END,
+
+        //! @brief Fence member
+        RUN_LOG_RECORD_TYPE_COUNT
+} run_log_record_type_t;
+
+//! @brief Read from flash, at an offset within the log area
+typedef bool (*run_log_read_func_t)(uint32_t const address,
+                                    void * const p_data,
+                                    size_t const size);
+
+//! @brief Write to flash, at an offset within the log area. Writing can only
+//!        clear bits, and offset and size are multiples of 4
+typedef bool (*run_log_write_func_t)(uint32_t const address,
+                                     void const * const p_data,
+                                     size_t const size);
+
+//! @brief Erase a sector of the log area, setting all of its bits
+typedef bool (*run_log_erase_func_t)(uint32_t const sector);
+
+//! @brief Flash area the log is kept at
+typedef struct {
+        //! @brief Read function
+        run_log_read_func_t pf_read;
+
+        //! @brief Write function
+        run_log_write_func_t pf_write;
+
+        //! @brief Sector erase function
+        run_log_erase_func_t pf_erase;
+
+        //! @brief Number of sectors of the area
+        uint32_t sector_count;
+} run_log_flash_t;
+
+//! @brief Mounted log
+typedef struct {
+        //! @brief Flash area of the log
+        run_log_flash_t const * p_flash;
+
+        //! @brief Whether any sector is in use
+        bool has_head;
+
+        //! @brief Sector records are appended to
+        uint32_t head_sector;
+
+        //! @brief Offset of the next record within the head sector
+        uint32_t head_offset;
+
+        //! @brief Sequence number of the head sector, increased on every
+        //!        sector taken into use
+        uint32_t head_sequence;
+
+        //! @brief Times the head sector was erased, its own included
+        uint32_t head_erase_count;
+
+        //! @brief Number of sectors erased since mounted
+        uint32_t erase_count;
+
+        //! @brief Number of records appended since mounted
+        uint32_t append_count;
+} run_log_t;
+
+//! @brief Position of a reader over the records, oldest first
+typedef struct {
+        //! @brief Number of sectors visited so far
+        uint32_t visited_count;
+
+        //! @brief Sector being read
+        uint32_t sector;
+
+        //! @brief Offset of the next record within the sector
+        uint32_t offset;
+} run_log_iterator_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Mount the log kept at a flash area
+bool run_log_mount(run_log_t * const p_log, run_log_flash_t const * const p_flash);
+
+//! @brief Append a record
+bool run_log_append(run_log_t * const p_log,
+                    run_log_record_type_t const type,
+                    uint8_t const * const p_payload,
+                    size_t const size);
+
+//! @brief Place a reader before the oldest record
+bool run_log_iterate_start(run_log_t const * const p_log,
+                           run_log_iterator_t * const p_iterator);
+
+//! @brief Read the next record
+bool run_log_iterate_next(run_log_t const * const p_log,
+                          run_log_iterator_t * const p_iterator,
+                          run_log_record_type_t * const p_type,
+                          uint8_t * const p_payload,
+                          size_t const size,
+                          size_t * const p_length);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //RUN_LOG_H
@@ -0,0 +1,349 @@
+/*!
+ *******************************************************************************
+ * @file run_log_buffer.c
+ *
+ * @brief Double buffer between the producers of run log records and the task
+ *        writing them to flash
+ *
+ * Producers fill one slot while the writer empties the other, so writing to
+ * flash never holds them. Bytes of the same type are gathered in one record
+ * until the slot is full or sealed. When both slots are waiting for the
+ * writer, new bytes are dropped and counted instead of waited for.
+ *
+ * The buffer has no locking of its own: every call must be done under the
+ * same lock, which is only held while copying bytes or switching states.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "run_log_buffer.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Find the first slot in a given state
+static run_log_buffer_slot_t * find_slot(run_log_buffer_t * const p_buffer,
+                                         run_log_buffer_slot_state_t const state);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Empty a buffer
+ *
+ * @param[out]          p_buffer            Pointer to the buffer
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool run_log_buffer_init(run_log_buffer_t * const p_buffer)
+{
+        bool const success = (NULL != p_buffer);
+
+        if (success) {
+                (void)memset(p_buffer, 0, sizeof(*p_buffer));
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Add bytes to the record being filled
+ *
+ * The record is sealed first if it has another type, or no room left for the
+ * bytes.
+ *
+ * @param[in,out]       p_buffer            Pointer to the buffer
+ * @param[in]           type                Type of the record
+ * @param[in]           p_data              Pointer to the bytes to add
+ * @param[in]           size                Number of bytes to add
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, the type or
+ *                                          size is invalid, or there was no
+ *                                          free slot and the bytes were
+ *                                          dropped
+ */
+bool run_log_buffer_put(run_log_buffer_t * const p_buffer,
+                        run_log_record_type_t const type,
+                        uint8_t const * const p_data,
+                        size_t const size)
+{
+        run_log_buffer_slot_t * p_slot = NULL;
+        bool success = ((NULL != p_buffer) &&
+                        (NULL != p_data) &&
+                        (RUN_LOG_RECORD_TYPE_COUNT > type) &&
+                        (0 != size) &&
+                        (RUN_LOG_PAYLOAD_SIZE_MAX >= size));
+
+        if (success) {
+                p_slot = find_slot(p_buffer, RUN_LOG_BUFFER_SLOT_STATE_FILLING);
+
+                if ((NULL != p_slot) &&
+                    ((type != p_slot->type) ||
+                     (RUN_LOG_PAYLOAD_SIZE_MAX < (p_slot->length + size)))) {
+                        (void)run_log_buffer_seal(p_buffer);
+                        p_slot = NULL;
+                }
+        }
+
+        if ((success) && (NULL == p_slot)) {
+                p_slot = find_slot(p_buffer, RUN_LOG_BUFFER_SLOT_STATE_FREE);
+
+                if (NULL != p_slot) {
+                        p_slot->state = RUN_LOG_BUFFER_SLOT_STATE_FILLING;
+                        p_slot->type = type;
+                        p_slot->length = 0;
+                } else {
+                        p_buffer->dropped_count++;
+                        success = false;
+                }
+        }
+
+        if (success) {
+                (void)memcpy(&p_slot->payload[p_slot->length], p_data, size);
+                p_slot->length += size;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the room left in the record being filled
+ *
+ * Producers keeping state across the bytes of a record can tell from it
+ * whether their next bytes start a new one.
+ *
+ * @param[in]           p_buffer            Pointer to the buffer
+ * @param[in]           type                Type of the record
+ *
+ * @return              size_t              Number of bytes that fit in the
+ *                                          record, 0 if none of this type is
+ *                                          being filled or pointer is null
+ */
+size_t run_log_buffer_get_room(run_log_buffer_t * const p_buffer,
+                               run_log_record_type_t const type)
+{
+        run_log_buffer_slot_t const * p_slot = NULL;
+
+        if (NULL != p_buffer) {
+                p_slot = find_slot(p_buffer, RUN_LOG_BUFFER_SLOT_STATE_FILLING);
+        }
+
+        return (((NULL != p_slot) && (type == p_slot->type)) ?
+                (RUN_LOG_PAYLOAD_SIZE_MAX - p_slot->length) : 0);
+}
+
+/*!
+ * @brief Complete the record being filled
+ *
+ * Makes the record available to the writer. Nothing is done if no record is
+ * being filled.
+ *
+ * @param[in,out]       p_buffer            Pointer to the buffer
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool run_log_buffer_seal(run_log_buffer_t * const p_buffer)
+{
+        run_log_buffer_slot_t * p_slot = NULL;
+        bool const success = (NULL != p_buffer);
+
+        if (success) {
+                p_slot = find_slot(p_buffer, RUN_LOG_BUFFER_SLOT_STATE_FILLING);
+        }
+
+        if (NULL != p_slot) {
+                p_slot->state = RUN_LOG_BUFFER_SLOT_STATE_SEALED;
+                p_slot->sequence = p_buffer->next_sequence++;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get whether any record is waiting to be written
+ *
+ * @param[in]           p_buffer            Pointer to the buffer
+ *
+ * @return              bool                Whether a record is sealed, false
+ *                                          if pointer is null
+ */
+bool run_log_buffer_is_pending(run_log_buffer_t const * const p_buffer)
+{
+        size_t i;
+        bool is_pending = false;
+
+        for (i = 0; (NULL != p_buffer) && (RUN_LOG_BUFFER_SLOTS_CNT > i); i++) {
+                is_pending |= (RUN_LOG_BUFFER_SLOT_STATE_SEALED ==
+                               p_buffer->slots[i].state);
+        }
+
+        return is_pending;
+}
+
+/*!
+ * @brief Take the oldest record waiting to be written
+ *
+ * The slot belongs to the caller until released, and can be read without
+ * holding the lock of the buffer.
+ *
+ * @param[in,out]       p_buffer            Pointer to the buffer
+ * @param[out]          pp_slot             Pointer where to store the slot
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If a record was taken
+ * @retval              False               If a pointer is null or no record
+ *                                          is waiting
+ */
+bool run_log_buffer_take(run_log_buffer_t * const p_buffer,
+                         run_log_buffer_slot_t ** const pp_slot)
+{
+        run_log_buffer_slot_t * p_oldest = NULL;
+        run_log_buffer_slot_t * p_slot;
+        size_t i;
+        bool success = ((NULL != p_buffer) && (NULL != pp_slot));
+
+        for (i = 0; (success) && (RUN_LOG_BUFFER_SLOTS_CNT > i); i++) {
+                p_slot = &p_buffer->slots[i];
+
+                if ((RUN_LOG_BUFFER_SLOT_STATE_SEALED == p_slot->state) &&
+                    ((NULL == p_oldest) ||
+                     (0 > (int32_t)(p_slot->sequence - p_oldest->sequence)))) {
+                        p_oldest = p_slot;
+                }
+        }
+
+        success = (NULL != p_oldest);
+
+        if (success) {
+                p_oldest->state = RUN_LOG_BUFFER_SLOT_STATE_WRITING;
+                *pp_slot = p_oldest;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Give back a slot once its record is written
+ *
+ * @param[in,out]       p_buffer            Pointer to the buffer
+ * @param[in]           p_slot              Slot taken from the buffer
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null or the slot
+ *                                          wasn't taken from this buffer
+ */
+bool run_log_buffer_release(run_log_buffer_t * const p_buffer,
+                            run_log_buffer_slot_t * const p_slot)
+{
+        size_t i;
+        bool success = false;
+
+        for (i = 0; (NULL != p_buffer) && (RUN_LOG_BUFFER_SLOTS_CNT > i); i++) {
+                success |= (&p_buffer->slots[i] == p_slot);
+        }
+
+        success = ((success) &&
+                   (RUN_LOG_BUFFER_SLOT_STATE_WRITING == p_slot->state));
+
+        if (success) {
+                p_slot->state = RUN_LOG_BUFFER_SLOT_STATE_FREE;
+                p_slot->length = 0;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Find the first slot in a given state
+ *
+ * @param[in]           p_buffer            Pointer to the buffer
+ * @param[in]           state               State to look for
+ *
+ * @return              run_log_buffer_slot_t * Slot found, null if none
+ */
+static run_log_buffer_slot_t * find_slot(run_log_buffer_t * const p_buffer,
+                                         run_log_buffer_slot_state_t const state)
+{
+        run_log_buffer_slot_t * p_slot = NULL;
+        size_t i;
+
+        for (i = 0; (NULL == p_slot) && (RUN_LOG_BUFFER_SLOTS_CNT > i); i++) {
+                if (state == p_buffer->slots[i].state) {
+                        p_slot = &p_buffer->slots[i];
+                }
+        }
+
+        return p_slot;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,134 @@
+/*!
+ *******************************************************************************
+ * @file run_log_buffer.h
+ *
+ * @brief Double buffer between the producers of run log records and the task
+ *        writing them to flash
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef RUN_LOG_BUFFER_H
+#define RUN_LOG_BUFFER_H
+
+#include "run_log.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Number of slots of the buffer
+#define RUN_LOG_BUFFER_SLOTS_CNT                        (2)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief State of a slot
+typedef enum {
+        //! @brief Empty, can be filled
+        RUN_LOG_BUFFER_SLOT_STATE_FREE = 0,
+
+        //! @brief Being filled by producers
+        RUN_LOG_BUFFER_SLOT_STATE_FILLING,
+
+        //! @brief Complete, waiting to be written
+        RUN_LOG_BUFFER_SLOT_STATE_SEALED,
+
+        //! @brief Being written by the writer
+        RUN_LOG_BUFFER_SLOT_STATE_WRITING,
+
+        //! @brief Fence member
+        RUN_LOG_BUFFER_SLOT_STATE_COUNT
+} run_log_buffer_slot_state_t;
+
+//! @brief Slot holding the payload of a record
+typedef struct {
+        //! @brief State of the slot
+        run_log_buffer_slot_state_t state;
+
+        //! @brief Type of the record
+        run_log_record_type_t type;
+
+        //! @brief Order the slot was sealed in
+        uint32_t sequence;
+
+        //! @brief Number of bytes of the payload
+        size_t length;
+
+        //! @brief Payload
+        uint8_t payload[RUN_LOG_PAYLOAD_SIZE_MAX];
+} run_log_buffer_slot_t;
+
+//! @brief Double buffer
+typedef struct {
+        //! @brief Slots of the buffer
+        run_log_buffer_slot_t slots[RUN_LOG_BUFFER_SLOTS_CNT];
+
+        //! @brief Sequence of the next slot sealed
+        uint32_t next_sequence;
+
+        //! @brief Number of writes dropped for lack of room
+        uint32_t dropped_count;
+} run_log_buffer_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Empty a buffer
+bool run_log_buffer_init(run_log_buffer_t * const p_buffer);
+
+//! @brief Add bytes to the record being filled
+bool run_log_buffer_put(run_log_buffer_t * const p_buffer,
+                        run_log_record_type_t const type,
+                        uint8_t const * const p_data,
+                        size_t const size);
+
+//! @brief Get the room left in the record being filled
+size_t run_log_buffer_get_room(run_log_buffer_t * const p_buffer,
+                               run_log_record_type_t const type);
+
+//! @brief Complete the record being filled
+bool run_log_buffer_seal(run_log_buffer_t * const p_buffer);
+
+//! @brief Get whether any record is waiting to be written
+bool run_log_buffer_is_pending(run_log_buffer_t const * const p_buffer);
+
+//! @brief Take the oldest record waiting to be written
+bool run_log_buffer_take(run_log_buffer_t * const p_buffer,
+                         run_log_buffer_slot_t ** const pp_slot);
+
+//! @brief Give back a slot once its record is written
+bool run_log_buffer_release(run_log_buffer_t * const p_buffer,
+                            run_log_buffer_slot_t * const p_slot);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //RUN_LOG_BUFFER_H
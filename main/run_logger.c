@@ -0,0 +1,478 @@
+/*!
+ *******************************************************************************
+ * @file run_logger.c
+ *
+ * @brief Traces of the reflow runs, written in the background to the run log
+ *        partition
+ *
+ * Every run is logged as a start record, with the run number and profile
+ * name, trace records with its samples, and an end record with its outcome
+ * and duration. Samples are compressed with `run_trace_codec`, restarted on
+ * every trace record, so each one can be decoded on its own even if the
+ * previous one was dropped.
+ *
+ * Callers only copy their bytes into a double buffer (see `run_log_buffer`)
+ * under a spinlock. A writer task at the lowest priority appends the sealed
+ * records to the `runlog` partition, so flash erases and writes never hold
+ * the control loop. When the writer lags behind, samples are dropped and
+ * counted instead.
+ *
+ * @note While the flash is written, the cache is disabled and code outside
+ *       IRAM stalls on both cores, as with any other flash write. Writes are
+ *       of at most one record, and erases of one sector
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+
+#include "byte_codec.h"
+#include "run_log.h"
+#include "run_log_buffer.h"
+#include "run_trace_codec.h"
+#include "run_logger.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+#define TAG                                 __FILENAME__
+
+//! @brief Label of the run log partition
+#define RUN_LOGGER_PARTITION_LABEL          "runlog"
+
+//! @brief Writer task priority, below any other application task
+#define RUN_LOGGER_TASK_PRIORITY            (tskIDLE_PRIORITY)
+
+//! @brief Size in bytes of the fixed fields of the start and end records
+#define RUN_LOGGER_START_FIXED_SIZE         (4)
+#define RUN_LOGGER_END_SIZE                 (5)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Read from the run log partition
+static bool partition_read(uint32_t const address,
+                           void * const p_data,
+                           size_t const size);
+
+//! @brief Write to the run log partition
+static bool partition_write(uint32_t const address,
+                            void const * const p_data,
+                            size_t const size);
+
+//! @brief Erase a sector of the run log partition
+static bool partition_erase(uint32_t const sector);
+
+//! @brief Buffer a record of its own and wake the writer
+static bool put_record(run_log_record_type_t const type,
+                       uint8_t const * const p_payload,
+                       size_t const size);
+
+//! @brief Run logger writer task
+static void run_logger_task(void * pvParameters);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Whether the module is initialized or not
+static bool m_is_initialized = false;
+
+//! @brief Writer task handle
+static TaskHandle_t m_run_logger_task_h = NULL;
+
+//! @brief Run log partition
+static esp_partition_t const * m_p_partition = NULL;
+
+//! @brief Flash area of the log
+static run_log_flash_t m_flash = {
+        .pf_read = partition_read,
+        .pf_write = partition_write,
+        .pf_erase = partition_erase,
+        .sector_count = 0
+};
+
+//! @brief Mounted log, only used by the writer task once initialized
+static run_log_t m_log;
+
+//! @brief Records waiting to be written
+static run_log_buffer_t m_buffer;
+
+//! @brief Encoder of the trace being filled
+static run_trace_codec_t m_encoder;
+
+//! @brief Spinlock protecting the buffer and the encoder
+static portMUX_TYPE m_buffer_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize the run logger
+ *
+ * Mounts the log kept at the run log partition and starts the writer task.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Module already initialized, the
+ *                                          partition wasn't found or couldn't
+ *                                          create the task
+ */
+bool run_logger_init(void)
+{
+        BaseType_t result;
+        bool success = !m_is_initialized;
+
+        if (success) {
+                m_p_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                         ESP_PARTITION_SUBTYPE_ANY,
+                                                         RUN_LOGGER_PARTITION_LABEL);
+
+                success = (NULL != m_p_partition);
+        }
+
+        if (success) {
+                m_flash.sector_count = m_p_partition->size / RUN_LOG_SECTOR_SIZE;
+
+                success = ((run_log_mount(&m_log, &m_flash)) &&
+                           (run_log_buffer_init(&m_buffer)));
+        }
+
+        if (success) {
+                result = xTaskCreate(run_logger_task,
+                                     "run_logger_task",
+                                     configMINIMAL_STACK_SIZE * 4,
+                                     NULL,
+                                     RUN_LOGGER_TASK_PRIORITY,
+                                     &m_run_logger_task_h);
+
+                success = (pdPASS == result);
+        }
+
+        if (success) {
+                ESP_LOGI(TAG, "Run log mounted: %u sectors, head %u at %u",
+                         m_flash.sector_count,
+                         m_log.head_sector,
+                         m_log.head_offset);
+
+                m_is_initialized = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Log the start of a run
+ *
+ * @param[in]           p_name              Name of the profile run
+ * @param[in]           run_number          Number of the run
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer, module not
+ *                                          initialized or the record was
+ *                                          dropped
+ */
+bool run_logger_start(char const * const p_name, uint32_t const run_number)
+{
+        uint8_t payload[RUN_LOGGER_START_FIXED_SIZE + REFLOW_PROFILE_NAME_LEN_MAX];
+        size_t name_length = 0;
+        bool const success = ((NULL != p_name) && (m_is_initialized));
+
+        if (success) {
+                name_length = strnlen(p_name, REFLOW_PROFILE_NAME_LEN_MAX);
+
+                byte_codec_put_u32(&payload[0], run_number);
+                (void)memcpy(&payload[RUN_LOGGER_START_FIXED_SIZE], p_name, name_length);
+        }
+
+        return ((success) &&
+                (put_record(RUN_LOG_RECORD_TYPE_RUN_START,
+                            payload,
+                            RUN_LOGGER_START_FIXED_SIZE + name_length)));
+}
+
+/*!
+ * @brief Log a temperature sample of the run in progress
+ *
+ * Samples are gathered in trace records, which are handed to the writer as
+ * they fill up.
+ *
+ * @param[in]           time_ms             Run time of the sample
+ * @param[in]           temperature         Temperature, in Celsius
+ * @param[in]           phase               Phase the run is at
+ * @param[in]           segment             Segment the run is at
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Module not initialized or the
+ *                                          sample was dropped
+ */
+bool run_logger_add_sample(uint32_t const time_ms,
+                           uint16_t const temperature,
+                           reflow_trajectory_phase_t const phase,
+                           uint8_t const segment)
+{
+        run_trace_codec_sample_t const sample = {
+                .time_ms = time_ms,
+                .temperature = temperature,
+                .phase = (uint8_t)phase,
+                .segment = segment
+        };
+        uint8_t encoded[RUN_TRACE_CODEC_SAMPLE_SIZE_MAX];
+        size_t length = 0;
+        bool is_pending = false;
+        bool success = m_is_initialized;
+
+        if (success) {
+                taskENTER_CRITICAL(&m_buffer_mux);
+
+                // Samples not fitting start a new trace, and a new stream
+                if (RUN_TRACE_CODEC_SAMPLE_SIZE_MAX >
+                    run_log_buffer_get_room(&m_buffer, RUN_LOG_RECORD_TYPE_TRACE)) {
+                        (void)run_log_buffer_seal(&m_buffer);
+                        (void)run_trace_codec_reset(&m_encoder);
+                }
+
+                success = ((run_trace_codec_encode(&m_encoder,
+                                                   &sample,
+                                                   encoded,
+                                                   sizeof(encoded),
+                                                   &length)) &&
+                           (run_log_buffer_put(&m_buffer,
+                                               RUN_LOG_RECORD_TYPE_TRACE,
+                                               encoded,
+                                               length)));
+
+                is_pending = run_log_buffer_is_pending(&m_buffer);
+                taskEXIT_CRITICAL(&m_buffer_mux);
+        }
+
+        if (is_pending) {
+                xTaskNotifyGive(m_run_logger_task_h);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Log the end of the run in progress
+ *
+ * @param[in]           outcome             How the run ended
+ * @param[in]           duration_ms         Run time at the end
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Module not initialized or the
+ *                                          record was dropped
+ */
+bool run_logger_finish(run_statistics_outcome_t const outcome,
+                       uint32_t const duration_ms)
+{
+        uint8_t payload[RUN_LOGGER_END_SIZE];
+        bool const success = m_is_initialized;
+
+        if (success) {
+                byte_codec_put_u32(&payload[0], duration_ms);
+                payload[4] = (uint8_t)outcome;
+        }
+
+        return ((success) &&
+                (put_record(RUN_LOG_RECORD_TYPE_RUN_END, payload, sizeof(payload))));
+}
+
+/*!
+ * @brief Get the number of writes dropped because the flash lagged behind
+ *
+ * @param               -                   -
+ *
+ * @return              uint32_t            Number of writes dropped
+ */
+uint32_t run_logger_get_dropped_count(void)
+{
+        uint32_t dropped_count;
+
+        taskENTER_CRITICAL(&m_buffer_mux);
+        dropped_count = m_buffer.dropped_count;
+        taskEXIT_CRITICAL(&m_buffer_mux);
+
+        return dropped_count;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Read from the run log partition
+ *
+ * @param[in]           address             Offset within the partition
+ * @param[out]          p_data              Buffer where to store the data
+ * @param[in]           size                Number of bytes to read
+ *
+ * @return              bool                Whether the read succeeded
+ */
+static bool partition_read(uint32_t const address,
+                           void * const p_data,
+                           size_t const size)
+{
+        return (ESP_OK == esp_partition_read(m_p_partition, address, p_data, size));
+}
+
+/*!
+ * @brief Write to the run log partition
+ *
+ * @param[in]           address             Offset within the partition
+ * @param[in]           p_data              Data to write
+ * @param[in]           size                Number of bytes to write
+ *
+ * @return              bool                Whether the write succeeded
+ */
+static bool partition_write(uint32_t const address,
+                            void const * const p_data,
+                            size_t const size)
+{
+        return (ESP_OK == esp_partition_write(m_p_partition, address, p_data, size));
+}
+
+/*!
+ * @brief Erase a sector of the run log partition
+ *
+ * @param[in]           sector              Sector to erase
+ *
+ * @return              bool                Whether the erase succeeded
+ */
+static bool partition_erase(uint32_t const sector)
+{
+        return (ESP_OK == esp_partition_erase_range(m_p_partition,
+                                                    sector * RUN_LOG_SECTOR_SIZE,
+                                                    RUN_LOG_SECTOR_SIZE));
+}
+
+/*!
+ * @brief Buffer a record of its own and wake the writer
+ *
+ * The trace being filled is sealed first, so records keep their order.
+ *
+ * @param[in]           type                Type of the record
+ * @param[in]           p_payload           Payload of the record
+ * @param[in]           size                Size of the payload
+ *
+ * @return              bool                Whether the record was buffered
+ */
+static bool put_record(run_log_record_type_t const type,
+                       uint8_t const * const p_payload,
+                       size_t const size)
+{
+        bool success;
+
+        taskENTER_CRITICAL(&m_buffer_mux);
+        (void)run_log_buffer_seal(&m_buffer);
+        success = run_log_buffer_put(&m_buffer, type, p_payload, size);
+        (void)run_log_buffer_seal(&m_buffer);
+        taskEXIT_CRITICAL(&m_buffer_mux);
+
+        xTaskNotifyGive(m_run_logger_task_h);
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Run logger writer task
+ *
+ * Sleeps until records are sealed, and appends them to the log oldest first.
+ * Slots are written without holding the spinlock, as they belong to the task
+ * until released.
+ *
+ * @param               pvParameters        Not used
+ *
+ * @return              -                   -
+ */
+static void run_logger_task(void * pvParameters)
+{
+        run_log_buffer_slot_t * p_slot = NULL;
+        bool is_taken;
+
+        (void)pvParameters;
+
+        for (;;) {
+                (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+                do {
+                        taskENTER_CRITICAL(&m_buffer_mux);
+                        is_taken = run_log_buffer_take(&m_buffer, &p_slot);
+                        taskEXIT_CRITICAL(&m_buffer_mux);
+
+                        if (is_taken) {
+                                if (!run_log_append(&m_log,
+                                                    p_slot->type,
+                                                    p_slot->payload,
+                                                    p_slot->length)) {
+                                        ESP_LOGE(TAG, "Couldn't append a run log record");
+                                }
+
+                                taskENTER_CRITICAL(&m_buffer_mux);
+                                (void)run_log_buffer_release(&m_buffer, p_slot);
+                                taskEXIT_CRITICAL(&m_buffer_mux);
+                        }
+                } while (is_taken);
+        }
+}
@@ -0,0 +1,76 @@
+/*!
+ *******************************************************************************
+ * @file run_logger.h
+ *
+ * @brief Traces of the reflow runs, written in the background to the run log
+ *        partition
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef RUN_LOGGER_H
+#define RUN_LOGGER_H
+
+#include "run_statistics.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize the run logger
+bool run_logger_init(void);
+
+//! @brief Log the start of a run
+bool run_logger_start(char const * const p_name, uint32_t const run_number);
+
+//! @brief Log a temperature sample of the run in progress
+bool run_logger_add_sample(uint32_t const time_ms,
+                           uint16_t const temperature,
+                           reflow_trajectory_phase_t const phase,
+                           uint8_t const segment);
+
+//! @brief Log the end of the run in progress
+bool run_logger_finish(run_statistics_outcome_t const outcome,
+                       uint32_t const duration_ms);
+
+//! @brief Get the number of writes dropped because the flash lagged behind
+uint32_t run_logger_get_dropped_count(void);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //RUN_LOGGER_H
@@ -0,0 +1,554 @@
+/*!
+ *******************************************************************************
+ * @file run_report.c
+ *
+ * @brief Statistics of the reflow runs, fed from the temperature readings and
+ *        kept in NVS as a summary per run
+ *
+ * A run starts when the state machine enters the segment state, and ends when
+ * it gets back to idle (completed, or aborted if cooling started before the
+ * last segment) or to error. Readings taken while paused are left out, and the
+ * rest are sampled on the run clock, so pauses don't count in the figures.
+ *
+ * The summaries of the last `CONFIGURATION_RUN_HISTORY_CNT` runs are kept in
+ * NVS, each in its own blob, with a counter of the runs done so far. The
+ * samples themselves go to the run log (see `run_logger`).
+ *
+ * Summaries are handed to a writer task at the lowest priority, which does
+ * the NVS writes and commit, so they never hold the control loop.
+ *
+ * @note Readings are expected from a single task, thermocouple_task
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "nvs.h"
+#include "configuration.h"
+#include "reflow_profile.h"
+#include "state_machine/states/state_machine_states.h"
+#include "supervisor_invariants.h"
+#include "run_logger.h"
+#include "run_report.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+#define TAG                                 __FILENAME__
+
+//! @brief NVS namespace and keys of the run summaries
+#define RUN_REPORT_NVS_NAMESPACE            "run_report"
+#define RUN_REPORT_NVS_RUN_COUNT            "run_count"
+#define RUN_REPORT_NVS_SUMMARY_FORMAT       "run_%u"
+
+//! @brief Maximum length of a summary key, terminator included
+#define RUN_REPORT_NVS_KEY_SIZE             (NVS_KEY_NAME_MAX_SIZE)
+
+//! @brief Writer task priority, below any other application task
+#define RUN_REPORT_TASK_PRIORITY            (tskIDLE_PRIORITY)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Start the statistics of a new run
+static void start_run(void);
+
+//! @brief End the current run and store its summary
+static void finish_run(run_statistics_outcome_t const outcome);
+
+//! @brief Store a summary in NVS
+static bool save_summary(run_statistics_summary_t const * const p_summary);
+
+//! @brief Get the number of runs stored so far
+static uint32_t get_run_count(void);
+
+//! @brief Run report writer task
+static void run_report_task(void * pvParameters);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Whether the module is initialized
+static bool m_is_initialized = false;
+
+//! @brief Whether a run is in progress
+static bool m_is_running = false;
+
+//! @brief Whether cooling started before every segment was run
+static bool m_is_aborted = false;
+
+//! @brief Statistics of the current run
+static run_statistics_t m_statistics;
+
+//! @brief Number of runs stored so far
+static uint32_t m_run_count = 0;
+
+//! @brief Writer task handle
+static TaskHandle_t m_run_report_task_h = NULL;
+
+//! @brief Summary waiting to be stored
+static run_statistics_summary_t m_pending_summary;
+
+//! @brief Whether there is a summary waiting to be stored
+static bool m_is_summary_pending = false;
+
+//! @brief Spinlock protecting the pending summary and the run count
+static portMUX_TYPE m_summary_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize the run report module
+ *
+ * Reads the number of runs stored so far and starts the writer task.
+ *
+ * @note NVS must be initialized first
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If there was an I/O error or
+ *                                          couldn't create the task
+ */
+bool run_report_init(void)
+{
+        nvs_handle_t nvs_handle;
+        BaseType_t task_result;
+        bool success;
+        esp_err_t result = nvs_open(RUN_REPORT_NVS_NAMESPACE,
+                                    NVS_READONLY,
+                                    &nvs_handle);
+
+        if (ESP_OK == result) {
+                result = nvs_get_u32(nvs_handle,
+                                     RUN_REPORT_NVS_RUN_COUNT,
+                                     &m_run_count);
+                nvs_close(nvs_handle);
+        }
+
+        // Nothing stored yet
+        if (ESP_ERR_NVS_NOT_FOUND == result) {
+                m_run_count = 0;
+                result = ESP_OK;
+        }
+
+        success = (ESP_OK == result);
+
+        if (success) {
+                task_result = xTaskCreate(run_report_task,
+                                          "run_report_task",
+                                          configMINIMAL_STACK_SIZE * 4,
+                                          NULL,
+                                          RUN_REPORT_TASK_PRIORITY,
+                                          &m_run_report_task_h);
+
+                success = (pdPASS == task_result);
+        }
+
+        m_is_initialized = success;
+
+        return m_is_initialized;
+}
+
+/*!
+ * @brief Account a temperature reading
+ *
+ * @param[in]           state               State machine state
+ * @param[in]           segment             Segment being run, `UINT8_MAX` if
+ *                                          all of them were run
+ * @param[in]           is_holding          Whether the segment is holding its
+ *                                          target
+ * @param[in]           temperature         Temperature read, in Celsius
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If module is not initialized or the
+ *                                          reading couldn't be accounted
+ */
+bool run_report_update(state_machine_state_text_t const state,
+                       uint8_t const segment,
+                       bool const is_holding,
+                       uint16_t const temperature)
+{
+        bool success = m_is_initialized;
+        bool has_sample = false;
+        reflow_program_t const * p_program = NULL;
+        reflow_trajectory_phase_t phase = REFLOW_TRAJECTORY_PHASE_DONE;
+        uint16_t target = 0;
+        uint32_t run_time_ms = 0;
+
+        if ((success) && (!m_is_running) &&
+            (STATE_MACHINE_STATE_SEGMENT == state)) {
+                start_run();
+        }
+
+        if ((success) && (m_is_running)) {
+                success = state_machine_states_get_program(&p_program);
+        }
+
+        if ((success) && (m_is_running)) {
+                switch (state) {
+                case STATE_MACHINE_STATE_SEGMENT:
+                        if (p_program->segment_count > segment) {
+                                phase = (is_holding ?
+                                         REFLOW_TRAJECTORY_PHASE_HOLD :
+                                         REFLOW_TRAJECTORY_PHASE_RAMP);
+                                target = p_program->segments[segment].target_temperature;
+                                has_sample = true;
+                        }
+                        break;
+
+                case STATE_MACHINE_STATE_COOLING:
+                        // Aborted runs start cooling from their segment
+                        m_is_aborted |= (p_program->segment_count > segment);
+                        phase = REFLOW_TRAJECTORY_PHASE_COOLING;
+                        target = p_program->cooling_temperature;
+                        has_sample = true;
+                        break;
+
+                case STATE_MACHINE_STATE_IDLE:
+                        finish_run(m_is_aborted ?
+                                   RUN_STATISTICS_OUTCOME_ABORTED :
+                                   RUN_STATISTICS_OUTCOME_COMPLETED);
+                        break;
+
+                case STATE_MACHINE_STATE_ERROR:
+                        finish_run(RUN_STATISTICS_OUTCOME_FAILED);
+                        break;
+
+                case STATE_MACHINE_STATE_PAUSED:
+                default:
+                        break;
+                }
+        }
+
+        if ((success) && (has_sample)) {
+                success = state_machine_states_get_run_time(&run_time_ms);
+        }
+
+        if ((success) && (has_sample)) {
+                success = run_statistics_add_sample(&m_statistics,
+                                                    run_time_ms,
+                                                    temperature,
+                                                    phase,
+                                                    segment,
+                                                    target);
+
+                // Dropped samples only leave a gap in the trace
+                (void)run_logger_add_sample(run_time_ms,
+                                            temperature,
+                                            phase,
+                                            segment);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Load the summary of a past run from NVS
+ *
+ * @param[in]           age                 Number of runs done after it, 0 for
+ *                                          the last one
+ * @param[out]          p_summary           Pointer where to store the summary
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null, module not
+ *                                          initialized, no such run is kept
+ *                                          or its summary is corrupted
+ */
+bool run_report_load(uint8_t const age, run_statistics_summary_t * const p_summary)
+{
+        uint8_t buffer[RUN_STATISTICS_SUMMARY_SIZE_MAX];
+        char key[RUN_REPORT_NVS_KEY_SIZE];
+        size_t size = sizeof(buffer);
+        bool needs_close = false;
+        nvs_handle_t nvs_handle;
+        esp_err_t result;
+        uint32_t const run_count = get_run_count();
+        bool success = ((NULL != p_summary) &&
+                        (m_is_initialized) &&
+                        (run_count > age) &&
+                        (CONFIGURATION_RUN_HISTORY_CNT > age));
+
+        if (success) {
+                (void)snprintf(key, sizeof(key), RUN_REPORT_NVS_SUMMARY_FORMAT,
+                               (unsigned int)((run_count - 1 - age) %
+                                              CONFIGURATION_RUN_HISTORY_CNT));
+
+                result = nvs_open(RUN_REPORT_NVS_NAMESPACE,
+                                  NVS_READONLY,
+                                  &nvs_handle);
+
+                success = (ESP_OK == result);
+        }
+
+        if (success) {
+                needs_close = true;
+                result = nvs_get_blob(nvs_handle, key, buffer, &size);
+
+                success = (ESP_OK == result);
+        }
+
+        if (success) {
+                success = run_statistics_decode_summary(buffer, size, p_summary);
+        }
+
+        if (needs_close) {
+                nvs_close(nvs_handle);
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Start the statistics of a new run
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void start_run(void)
+{
+        char const * p_name = "";
+
+        (void)reflow_profile_get_current_name(&p_name);
+
+        m_is_running = run_statistics_start(&m_statistics,
+                                            p_name,
+                                            SUPERVISOR_LIQUIDUS_TEMPERATURE_C,
+                                            CONFIGURATION_RUN_SETTLING_BAND_C);
+        m_is_aborted = false;
+
+        if (m_is_running) {
+                (void)run_logger_start(p_name, get_run_count());
+        }
+}
+
+/*!
+ * @brief End the current run and store its summary
+ *
+ * The summary is handed to the writer task, which stores it in NVS.
+ *
+ * @param[in]           outcome             How the run ended
+ *
+ * @return              -                   -
+ */
+static void finish_run(run_statistics_outcome_t const outcome)
+{
+        run_statistics_summary_t summary;
+        bool is_overwritten;
+
+        m_is_running = false;
+
+        if (run_statistics_finish(&m_statistics, outcome, &summary)) {
+                (void)run_logger_finish(outcome, summary.duration_ms);
+
+                ESP_LOGI(TAG, "Run of %s: outcome %d, %u s, peak %u C at %u s, "
+                         "%u s above %u C, overshoot %u C, settling %u s",
+                         summary.profile_name,
+                         summary.outcome,
+                         summary.duration_ms / 1000,
+                         summary.peak_temperature,
+                         summary.peak_time_ms / 1000,
+                         summary.time_above_liquidus_ms / 1000,
+                         summary.liquidus_temperature,
+                         summary.overshoot,
+                         summary.settling_time_ms / 1000);
+
+                taskENTER_CRITICAL(&m_summary_mux);
+                is_overwritten = m_is_summary_pending;
+                m_pending_summary = summary;
+                m_is_summary_pending = true;
+                taskEXIT_CRITICAL(&m_summary_mux);
+
+                if (is_overwritten) {
+                        ESP_LOGW(TAG, "Previous run summary wasn't stored yet");
+                }
+
+                xTaskNotifyGive(m_run_report_task_h);
+        }
+}
+
+/*!
+ * @brief Store a summary in NVS
+ *
+ * The summary replaces the oldest one kept once the history is full.
+ *
+ * @note Only called from the writer task
+ *
+ * @param[in]           p_summary           Pointer to the summary
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If there was an I/O error
+ */
+static bool save_summary(run_statistics_summary_t const * const p_summary)
+{
+        uint8_t buffer[RUN_STATISTICS_SUMMARY_SIZE_MAX];
+        char key[RUN_REPORT_NVS_KEY_SIZE];
+        size_t size = 0;
+        bool needs_close = false;
+        nvs_handle_t nvs_handle;
+        esp_err_t result;
+        bool success = run_statistics_encode_summary(p_summary,
+                                                     buffer,
+                                                     sizeof(buffer),
+                                                     &size);
+
+        if (success) {
+                (void)snprintf(key, sizeof(key), RUN_REPORT_NVS_SUMMARY_FORMAT,
+                               (unsigned int)(m_run_count %
+                                              CONFIGURATION_RUN_HISTORY_CNT));
+
+                result = nvs_open(RUN_REPORT_NVS_NAMESPACE,
+                                  NVS_READWRITE,
+                                  &nvs_handle);
+
+                success = (ESP_OK == result);
+        }
+
+        if (success) {
+                needs_close = true;
+                result = nvs_set_blob(nvs_handle, key, buffer, size);
+
+                success = (ESP_OK == result);
+        }
+
+        if (success) {
+                result = nvs_set_u32(nvs_handle,
+                                     RUN_REPORT_NVS_RUN_COUNT,
+                                     m_run_count + 1);
+
+                success = (ESP_OK == result);
+        }
+
+        if (success) {
+                result = nvs_commit(nvs_handle);
+
+                success = (ESP_OK == result);
+        }
+
+        if (needs_close) {
+                nvs_close(nvs_handle);
+        }
+
+        if (success) {
+                taskENTER_CRITICAL(&m_summary_mux);
+                m_run_count++;
+                taskEXIT_CRITICAL(&m_summary_mux);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the number of runs stored so far
+ *
+ * @param               -                   -
+ *
+ * @return              uint32_t            Number of runs stored so far
+ */
+static uint32_t get_run_count(void)
+{
+        uint32_t run_count;
+
+        taskENTER_CRITICAL(&m_summary_mux);
+        run_count = m_run_count;
+        taskEXIT_CRITICAL(&m_summary_mux);
+
+        return run_count;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Run report writer task
+ *
+ * Sleeps until a run ends, and stores its summary in NVS.
+ *
+ * @param               pvParameters        Not used
+ *
+ * @return              -                   -
+ */
+static void run_report_task(void * pvParameters)
+{
+        run_statistics_summary_t summary;
+        bool is_pending;
+
+        (void)pvParameters;
+
+        for (;;) {
+                (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+                taskENTER_CRITICAL(&m_summary_mux);
+                is_pending = m_is_summary_pending;
+                summary = m_pending_summary;
+                m_is_summary_pending = false;
+                taskEXIT_CRITICAL(&m_summary_mux);
+
+                if ((is_pending) && (!save_summary(&summary))) {
+                        ESP_LOGE(TAG, "Couldn't store the run summary");
+                }
+        }
+}
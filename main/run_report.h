@@ -0,0 +1,70 @@
+/*!
+ *******************************************************************************
+ * @file run_report.h
+ *
+ * @brief Statistics of the reflow runs, fed from the temperature readings and
+ *        kept in NVS as a summary per run
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef RUN_REPORT_H
+#define RUN_REPORT_H
+
+#include "run_statistics.h"
+#include "state_machine/state_machine.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize the run report module
+bool run_report_init(void);
+
+//! @brief Account a temperature reading
+bool run_report_update(state_machine_state_text_t const state,
+                       uint8_t const segment,
+                       bool const is_holding,
+                       uint16_t const temperature);
+
+//! @brief Load the summary of a past run from NVS
+bool run_report_load(uint8_t const age, run_statistics_summary_t * const p_summary);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //RUN_REPORT_H
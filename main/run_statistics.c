@@ -0,0 +1,594 @@
+/*!
+ *******************************************************************************
+ * @file run_statistics.c
+ *
+ * @brief Key figures of a reflow run, computed online from its temperature
+ *        samples in constant memory
+ *
+ * Samples come with the phase and segment the run is at, and the target of
+ * that phase. Nothing but the last sample and a few running figures is kept:
+ *
+ * - Peak: highest temperature and the time it was first reached at.
+ * - Time above liquidus: time at or above the liquidus, with the crossings
+ *   interpolated between samples.
+ * - Ramp rates: highest and lowest rates of each phase, measured over windows
+ *   of at least `RUN_STATISTICS_RATE_WINDOW_MS` that don't span phases.
+ * - Overshoot: highest excess over the target of the segments ramping up.
+ * - Settling time: longest time from the start of a hold to the last sample
+ *   out of the settling band around its target.
+ *
+ * Summaries are encoded with explicit field widths and a CRC to be stored:
+ *
+ *      | version | outcome | name_len | name | duration | time above |
+ *      | peak time | settling time | peak | liquidus | overshoot |
+ *      | overshoot segment | settling segment | measured rates |
+ *      | max rate, min rate (per phase) | crc16 |
+ *
+ * with times as 32 bit, temperatures and rates as 16 bit little endian values,
+ * and measured rates as a bit field indexed by phase.
+ *
+ * The module doesn't read any time source by itself, so it can be checked on
+ * the host.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byte_codec.h"
+#include "run_statistics.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of the summary CRC
+#define CRC_SIZE                            (2)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Start tracking the phase of a sample
+static void enter_phase(run_statistics_t * const p_statistics,
+                        uint32_t const time_ms,
+                        uint16_t const temperature,
+                        reflow_trajectory_phase_t const phase,
+                        uint8_t const segment,
+                        uint16_t const target);
+
+//! @brief Account the settling time of the hold being left, if any
+static void leave_phase(run_statistics_t * const p_statistics);
+
+//! @brief Account the time above liquidus between the last sample and a new one
+static uint32_t get_time_above(uint32_t const duration_ms,
+                               uint16_t const start_temperature,
+                               uint16_t const end_temperature,
+                               uint16_t const liquidus_temperature);
+
+//! @brief Account a ramp rate measured during a phase
+static void add_rate(run_statistics_rates_t * const p_rates, int32_t const rate);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Start the statistics of a new run
+ *
+ * @param[out]          p_statistics        Pointer to the statistics
+ * @param[in]           p_profile_name      Name of the profile run
+ * @param[in]           liquidus_temperature
+ *                                          Liquidus to measure the time above,
+ *                                          in Celsius
+ * @param[in]           settling_band       Half width of the band around a
+ *                                          hold target it is settled within,
+ *                                          in Celsius
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or name too long
+ */
+bool run_statistics_start(run_statistics_t * const p_statistics,
+                          char const * const p_profile_name,
+                          uint16_t const liquidus_temperature,
+                          uint16_t const settling_band)
+{
+        bool success = ((NULL != p_statistics) &&
+                        (NULL != p_profile_name) &&
+                        (REFLOW_PROFILE_NAME_LEN_MAX >= strlen(p_profile_name)));
+
+        if (success) {
+                memset(p_statistics, 0, sizeof(*p_statistics));
+                strcpy(p_statistics->summary.profile_name, p_profile_name);
+                p_statistics->summary.liquidus_temperature = liquidus_temperature;
+                p_statistics->settling_band = settling_band;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Add a temperature sample of the run
+ *
+ * @param[in,out]       p_statistics        Pointer to the statistics
+ * @param[in]           time_ms             Run time of the sample in
+ *                                          milliseconds, not before the last
+ *                                          sample
+ * @param[in]           temperature         Temperature in Celsius
+ * @param[in]           phase               Phase the run is at
+ * @param[in]           segment             Segment the run is at
+ * @param[in]           target              Target of the phase, in Celsius
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, invalid phase
+ *                                          or sample older than the last one
+ */
+bool run_statistics_add_sample(run_statistics_t * const p_statistics,
+                               uint32_t const time_ms,
+                               uint16_t const temperature,
+                               reflow_trajectory_phase_t const phase,
+                               uint8_t const segment,
+                               uint16_t const target)
+{
+        bool success = ((NULL != p_statistics) &&
+                        (REFLOW_TRAJECTORY_PHASE_COUNT > phase));
+        run_statistics_summary_t * p_summary = NULL;
+        uint32_t window_ms;
+        int32_t rate;
+
+        if (success) {
+                p_summary = &p_statistics->summary;
+
+                success = ((!p_statistics->has_sample) ||
+                           (p_statistics->last_time_ms <= time_ms));
+        }
+
+        if ((success) && (p_statistics->has_sample)) {
+                p_summary->time_above_liquidus_ms +=
+                        get_time_above(time_ms - p_statistics->last_time_ms,
+                                       p_statistics->last_temperature,
+                                       temperature,
+                                       p_summary->liquidus_temperature);
+        }
+
+        if (!success) {
+                // Nothing to do
+        } else if ((!p_statistics->has_sample) ||
+                   (phase != p_statistics->phase) ||
+                   (segment != p_statistics->segment)) {
+                leave_phase(p_statistics);
+                enter_phase(p_statistics, time_ms, temperature, phase, segment,
+                            target);
+        } else {
+                window_ms = time_ms - p_statistics->window_start_ms;
+
+                if ((RUN_STATISTICS_RATE_WINDOW_MS <= window_ms) &&
+                    (RUN_STATISTICS_PHASES_CNT > phase)) {
+                        rate = (((int32_t)temperature -
+                                 (int32_t)p_statistics->window_start_temperature) *
+                                10000) / (int32_t)window_ms;
+
+                        add_rate(&p_summary->rates[phase], rate);
+
+                        p_statistics->window_start_ms = time_ms;
+                        p_statistics->window_start_temperature = temperature;
+                }
+        }
+
+        if ((success) &&
+            ((!p_statistics->has_sample) ||
+             (temperature > p_summary->peak_temperature))) {
+                p_summary->peak_temperature = temperature;
+                p_summary->peak_time_ms = time_ms;
+        }
+
+        if ((success) &&
+            (p_statistics->is_rising) &&
+            (temperature > target) &&
+            ((temperature - target) > p_summary->overshoot)) {
+                p_summary->overshoot = (uint16_t)(temperature - target);
+                p_summary->overshoot_segment = segment;
+        }
+
+        if ((success) &&
+            (REFLOW_TRAJECTORY_PHASE_HOLD == phase) &&
+            ((temperature > (target + p_statistics->settling_band)) ||
+             ((temperature + p_statistics->settling_band) < target))) {
+                p_statistics->unsettled_ms = time_ms;
+        }
+
+        if (success) {
+                p_statistics->has_sample = true;
+                p_statistics->last_time_ms = time_ms;
+                p_statistics->last_temperature = temperature;
+                p_statistics->target = target;
+                p_summary->duration_ms = time_ms;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief End the run and get its summary
+ *
+ * @param[in,out]       p_statistics        Pointer to the statistics
+ * @param[in]           outcome             How the run ended
+ * @param[out]          p_summary           Pointer where to store the summary
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or invalid
+ *                                          outcome
+ */
+bool run_statistics_finish(run_statistics_t * const p_statistics,
+                           run_statistics_outcome_t const outcome,
+                           run_statistics_summary_t * const p_summary)
+{
+        bool success = ((NULL != p_statistics) &&
+                        (NULL != p_summary) &&
+                        (RUN_STATISTICS_OUTCOME_COUNT > outcome));
+
+        if ((success) && (p_statistics->has_sample)) {
+                leave_phase(p_statistics);
+
+                // A later sample of the same hold would be accounted twice
+                p_statistics->phase = REFLOW_TRAJECTORY_PHASE_DONE;
+        }
+
+        if (success) {
+                p_statistics->summary.outcome = outcome;
+                *p_summary = p_statistics->summary;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Encode a summary to be stored
+ *
+ * @param[in]           p_summary           Pointer to the summary
+ * @param[out]          p_buffer            Buffer where to encode it
+ * @param[in]           size                Size of the buffer, at least
+ *                                          `RUN_STATISTICS_SUMMARY_SIZE_MAX`
+ *                                          guarantees any summary fits
+ * @param[out]          p_written           Pointer where to store the number
+ *                                          of bytes written
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, buffer too
+ *                                          small or name too long
+ */
+bool run_statistics_encode_summary(run_statistics_summary_t const * const p_summary,
+                                   uint8_t * const p_buffer,
+                                   size_t const size,
+                                   size_t * const p_written)
+{
+        bool success = ((NULL != p_summary) &&
+                        (NULL != p_buffer) &&
+                        (NULL != p_written));
+        run_statistics_rates_t const * p_rates;
+        size_t name_len = 0;
+        size_t offset = 0;
+        uint8_t measured = 0;
+        uint8_t i;
+
+        if (success) {
+                name_len = strnlen(p_summary->profile_name,
+                                   sizeof(p_summary->profile_name));
+
+                success = ((REFLOW_PROFILE_NAME_LEN_MAX >= name_len) &&
+                           ((RUN_STATISTICS_SUMMARY_FIXED_SIZE + name_len) <= size));
+        }
+
+        if (success) {
+                p_buffer[offset++] = RUN_STATISTICS_SUMMARY_VERSION;
+                p_buffer[offset++] = (uint8_t)p_summary->outcome;
+                p_buffer[offset++] = (uint8_t)name_len;
+                memcpy(&p_buffer[offset], p_summary->profile_name, name_len);
+                offset += name_len;
+
+                byte_codec_put_u32(&p_buffer[offset], p_summary->duration_ms);
+                byte_codec_put_u32(&p_buffer[offset + 4], p_summary->time_above_liquidus_ms);
+                byte_codec_put_u32(&p_buffer[offset + 8], p_summary->peak_time_ms);
+                byte_codec_put_u32(&p_buffer[offset + 12], p_summary->settling_time_ms);
+                offset += 16;
+
+                byte_codec_put_u16(&p_buffer[offset], p_summary->peak_temperature);
+                byte_codec_put_u16(&p_buffer[offset + 2], p_summary->liquidus_temperature);
+                byte_codec_put_u16(&p_buffer[offset + 4], p_summary->overshoot);
+                offset += 6;
+
+                p_buffer[offset++] = p_summary->overshoot_segment;
+                p_buffer[offset++] = p_summary->settling_segment;
+
+                for (i = 0; RUN_STATISTICS_PHASES_CNT > i; i++) {
+                        p_rates = &p_summary->rates[i];
+
+                        if (p_rates->is_measured) {
+                                measured |= (uint8_t)(1 << i);
+                        }
+
+                        byte_codec_put_u16(&p_buffer[offset + 1 + (i * 4)],
+                                           (uint16_t)p_rates->max_rate);
+                        byte_codec_put_u16(&p_buffer[offset + 3 + (i * 4)],
+                                           (uint16_t)p_rates->min_rate);
+                }
+
+                p_buffer[offset] = measured;
+                offset += 1 + (RUN_STATISTICS_PHASES_CNT * 4);
+
+                byte_codec_put_u16(&p_buffer[offset],
+                                   byte_codec_crc16(p_buffer, offset));
+                offset += CRC_SIZE;
+
+                *p_written = offset;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Decode a stored summary
+ *
+ * @param[in]           p_buffer            Buffer holding the summary
+ * @param[in]           size                Size of the summary
+ * @param[out]          p_summary           Pointer where to store the summary
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, or truncated,
+ *                                          corrupted or unknown summary
+ */
+bool run_statistics_decode_summary(uint8_t const * const p_buffer,
+                                   size_t const size,
+                                   run_statistics_summary_t * const p_summary)
+{
+        bool success = ((NULL != p_buffer) &&
+                        (NULL != p_summary) &&
+                        (RUN_STATISTICS_SUMMARY_FIXED_SIZE <= size));
+        run_statistics_summary_t summary;
+        size_t name_len = 0;
+        size_t offset = 3;
+        uint8_t measured;
+        uint8_t i;
+
+        if (success) {
+                name_len = p_buffer[2];
+
+                success = ((RUN_STATISTICS_SUMMARY_VERSION == p_buffer[0]) &&
+                           (RUN_STATISTICS_OUTCOME_COUNT > p_buffer[1]) &&
+                           (REFLOW_PROFILE_NAME_LEN_MAX >= name_len) &&
+                           ((RUN_STATISTICS_SUMMARY_FIXED_SIZE + name_len) == size));
+        }
+
+        if (success) {
+                success = (byte_codec_get_u16(&p_buffer[size - CRC_SIZE]) ==
+                           byte_codec_crc16(p_buffer, size - CRC_SIZE));
+        }
+
+        if (success) {
+                memset(&summary, 0, sizeof(summary));
+
+                summary.outcome = (run_statistics_outcome_t)p_buffer[1];
+                memcpy(summary.profile_name, &p_buffer[offset], name_len);
+                offset += name_len;
+
+                summary.duration_ms = byte_codec_get_u32(&p_buffer[offset]);
+                summary.time_above_liquidus_ms = byte_codec_get_u32(&p_buffer[offset + 4]);
+                summary.peak_time_ms = byte_codec_get_u32(&p_buffer[offset + 8]);
+                summary.settling_time_ms = byte_codec_get_u32(&p_buffer[offset + 12]);
+                offset += 16;
+
+                summary.peak_temperature = byte_codec_get_u16(&p_buffer[offset]);
+                summary.liquidus_temperature = byte_codec_get_u16(&p_buffer[offset + 2]);
+                summary.overshoot = byte_codec_get_u16(&p_buffer[offset + 4]);
+                offset += 6;
+
+                summary.overshoot_segment = p_buffer[offset++];
+                summary.settling_segment = p_buffer[offset++];
+                measured = p_buffer[offset++];
+
+                for (i = 0; RUN_STATISTICS_PHASES_CNT > i; i++) {
+                        summary.rates[i].is_measured = (0 != (measured & (1 << i)));
+                        summary.rates[i].max_rate =
+                                (int16_t)byte_codec_get_u16(&p_buffer[offset]);
+                        summary.rates[i].min_rate =
+                                (int16_t)byte_codec_get_u16(&p_buffer[offset + 2]);
+                        offset += 4;
+                }
+
+                *p_summary = summary;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Start tracking the phase of a sample
+ *
+ * @param[in,out]       p_statistics        Pointer to the statistics
+ * @param[in]           time_ms             Run time of the sample
+ * @param[in]           temperature         Temperature of the sample
+ * @param[in]           phase               Phase entered
+ * @param[in]           segment             Segment entered
+ * @param[in]           target              Target of the phase
+ *
+ * @return              -                   -
+ */
+static void enter_phase(run_statistics_t * const p_statistics,
+                        uint32_t const time_ms,
+                        uint16_t const temperature,
+                        reflow_trajectory_phase_t const phase,
+                        uint8_t const segment,
+                        uint16_t const target)
+{
+        // Holds keep the direction of the ramp of their segment
+        if (REFLOW_TRAJECTORY_PHASE_RAMP == phase) {
+                p_statistics->is_rising = (target >= temperature);
+        } else if ((REFLOW_TRAJECTORY_PHASE_HOLD != phase) ||
+                   (segment != p_statistics->segment)) {
+                p_statistics->is_rising = false;
+        }
+
+        if (REFLOW_TRAJECTORY_PHASE_HOLD == phase) {
+                p_statistics->hold_start_ms = time_ms;
+                p_statistics->unsettled_ms = time_ms;
+        }
+
+        p_statistics->phase = phase;
+        p_statistics->segment = segment;
+        p_statistics->window_start_ms = time_ms;
+        p_statistics->window_start_temperature = temperature;
+}
+
+/*!
+ * @brief Account the settling time of the hold being left, if any
+ *
+ * @param[in,out]       p_statistics        Pointer to the statistics
+ *
+ * @return              -                   -
+ */
+static void leave_phase(run_statistics_t * const p_statistics)
+{
+        run_statistics_summary_t * const p_summary = &p_statistics->summary;
+        uint32_t settling_time_ms;
+
+        if ((p_statistics->has_sample) &&
+            (REFLOW_TRAJECTORY_PHASE_HOLD == p_statistics->phase)) {
+                settling_time_ms = p_statistics->unsettled_ms -
+                                   p_statistics->hold_start_ms;
+
+                if (settling_time_ms > p_summary->settling_time_ms) {
+                        p_summary->settling_time_ms = settling_time_ms;
+                        p_summary->settling_segment = p_statistics->segment;
+                }
+        }
+}
+
+/*!
+ * @brief Account the time above liquidus between the last sample and a new one
+ *
+ * The temperature is taken as linear between both samples.
+ *
+ * @param[in]           duration_ms         Time between both samples
+ * @param[in]           start_temperature   Temperature of the last sample
+ * @param[in]           end_temperature     Temperature of the new sample
+ * @param[in]           liquidus_temperature
+ *                                          Liquidus temperature
+ *
+ * @return              uint32_t            Time in milliseconds at or above
+ *                                          the liquidus
+ */
+static uint32_t get_time_above(uint32_t const duration_ms,
+                               uint16_t const start_temperature,
+                               uint16_t const end_temperature,
+                               uint16_t const liquidus_temperature)
+{
+        uint32_t time_above_ms = 0;
+
+        if ((liquidus_temperature <= start_temperature) &&
+            (liquidus_temperature <= end_temperature)) {
+                time_above_ms = duration_ms;
+        } else if (liquidus_temperature <= end_temperature) {
+                time_above_ms = (uint32_t)(((uint64_t)duration_ms *
+                                            (end_temperature - liquidus_temperature)) /
+                                           (end_temperature - start_temperature));
+        } else if (liquidus_temperature <= start_temperature) {
+                time_above_ms = (uint32_t)(((uint64_t)duration_ms *
+                                            (start_temperature - liquidus_temperature)) /
+                                           (start_temperature - end_temperature));
+        }
+
+        return time_above_ms;
+}
+
+/*!
+ * @brief Account a ramp rate measured during a phase
+ *
+ * @param[in,out]       p_rates             Rates of the phase
+ * @param[in]           rate                Rate in tenths of Celsius per second
+ *
+ * @return              -                   -
+ */
+static void add_rate(run_statistics_rates_t * const p_rates, int32_t const rate)
+{
+        int16_t clamped;
+
+        if (INT16_MAX < rate) {
+                clamped = INT16_MAX;
+        } else if (INT16_MIN > rate) {
+                clamped = INT16_MIN;
+        } else {
+                clamped = (int16_t)rate;
+        }
+
+        if ((!p_rates->is_measured) || (clamped > p_rates->max_rate)) {
+                p_rates->max_rate = clamped;
+        }
+
+        if ((!p_rates->is_measured) || (clamped < p_rates->min_rate)) {
+                p_rates->min_rate = clamped;
+        }
+
+        p_rates->is_measured = true;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
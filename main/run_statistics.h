@@ -0,0 +1,216 @@
+/*!
+ *******************************************************************************
+ * @file run_statistics.h
+ *
+ * @brief Key figures of a reflow run, computed online from its temperature
+ *        samples in constant memory
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef RUN_STATISTICS_H
+#define RUN_STATISTICS_H
+
+#include "reflow_profile.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Number of phases ramp rates are tracked for: ramp, hold and cooling
+#define RUN_STATISTICS_PHASES_CNT                       (REFLOW_TRAJECTORY_PHASE_DONE)
+
+//! @brief Minimum time in milliseconds ramp rates are measured over, so the
+//!        1 Celsius resolution of the samples doesn't dominate them
+#define RUN_STATISTICS_RATE_WINDOW_MS                   (2000)
+
+//! @brief Version of the encoded summary format
+#define RUN_STATISTICS_SUMMARY_VERSION                  (1)
+
+//! @brief Size in bytes of an encoded summary, profile name excluded
+#define RUN_STATISTICS_SUMMARY_FIXED_SIZE               \
+        (3 + (4 * 4) + (3 * 2) + 2 + 1 + (RUN_STATISTICS_PHASES_CNT * 4) + 2)
+
+//! @brief Size in bytes of the largest encoded summary
+#define RUN_STATISTICS_SUMMARY_SIZE_MAX                 \
+        (RUN_STATISTICS_SUMMARY_FIXED_SIZE + REFLOW_PROFILE_NAME_LEN_MAX)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief How a run ended
+typedef enum {
+        //! @brief Every segment was run and the oven cooled down
+        RUN_STATISTICS_OUTCOME_COMPLETED = 0,
+
+        //! @brief Aborted by the user before running every segment
+        RUN_STATISTICS_OUTCOME_ABORTED,
+
+        //! @brief Ended in the error state
+        RUN_STATISTICS_OUTCOME_FAILED,
+
+        //! @brief Fence member
+        RUN_STATISTICS_OUTCOME_COUNT
+} run_statistics_outcome_t;
+
+//! @brief Ramp rates measured during a phase
+typedef struct {
+        //! @brief Whether any rate was measured, the rest is meaningless if not
+        bool is_measured;
+
+        //! @brief Highest rate, in tenths of Celsius per second
+        int16_t max_rate;
+
+        //! @brief Lowest rate, in tenths of Celsius per second
+        int16_t min_rate;
+} run_statistics_rates_t;
+
+//! @brief Summary of a run
+typedef struct {
+        //! @brief Name of the profile run
+        char profile_name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+
+        //! @brief How the run ended
+        run_statistics_outcome_t outcome;
+
+        //! @brief Length of the run in milliseconds, pauses excluded
+        uint32_t duration_ms;
+
+        //! @brief Time in milliseconds spent at or above the liquidus
+        uint32_t time_above_liquidus_ms;
+
+        //! @brief Run time in milliseconds at which the peak was first reached
+        uint32_t peak_time_ms;
+
+        //! @brief Longest time in milliseconds a hold took to settle within
+        //!        the settling band of its target
+        uint32_t settling_time_ms;
+
+        //! @brief Highest temperature, in Celsius
+        uint16_t peak_temperature;
+
+        //! @brief Liquidus the time above was measured against, in Celsius
+        uint16_t liquidus_temperature;
+
+        //! @brief Highest excess over the target of a segment ramping up, in
+        //!        Celsius
+        uint16_t overshoot;
+
+        //! @brief Segment the overshoot happened at
+        uint8_t overshoot_segment;
+
+        //! @brief Segment the settling time was measured at
+        uint8_t settling_segment;
+
+        //! @brief Ramp rates, indexed by `reflow_trajectory_phase_t`
+        run_statistics_rates_t rates[RUN_STATISTICS_PHASES_CNT];
+} run_statistics_summary_t;
+
+//! @brief Statistics of a run in progress
+typedef struct {
+        //! @brief Figures computed so far
+        run_statistics_summary_t summary;
+
+        //! @brief Half width of the band around a hold target it is settled
+        //!        within, in Celsius
+        uint16_t settling_band;
+
+        //! @brief Whether a sample was added already
+        bool has_sample;
+
+        //! @brief Time of the last sample, in milliseconds of run time
+        uint32_t last_time_ms;
+
+        //! @brief Temperature of the last sample, in Celsius
+        uint16_t last_temperature;
+
+        //! @brief Phase of the last sample
+        reflow_trajectory_phase_t phase;
+
+        //! @brief Segment of the last sample
+        uint8_t segment;
+
+        //! @brief Target of the last sample, in Celsius
+        uint16_t target;
+
+        //! @brief Whether the current segment ramped up to its target
+        bool is_rising;
+
+        //! @brief Start of the current rate window, in milliseconds
+        uint32_t window_start_ms;
+
+        //! @brief Temperature at the start of the current rate window
+        uint16_t window_start_temperature;
+
+        //! @brief Time the current hold started at, in milliseconds
+        uint32_t hold_start_ms;
+
+        //! @brief Last time the current hold was out of the settling band, in
+        //!        milliseconds
+        uint32_t unsettled_ms;
+} run_statistics_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Start the statistics of a new run
+bool run_statistics_start(run_statistics_t * const p_statistics,
+                          char const * const p_profile_name,
+                          uint16_t const liquidus_temperature,
+                          uint16_t const settling_band);
+
+//! @brief Add a temperature sample of the run
+bool run_statistics_add_sample(run_statistics_t * const p_statistics,
+                               uint32_t const time_ms,
+                               uint16_t const temperature,
+                               reflow_trajectory_phase_t const phase,
+                               uint8_t const segment,
+                               uint16_t const target);
+
+//! @brief End the run and get its summary
+bool run_statistics_finish(run_statistics_t * const p_statistics,
+                           run_statistics_outcome_t const outcome,
+                           run_statistics_summary_t * const p_summary);
+
+//! @brief Encode a summary to be stored
+bool run_statistics_encode_summary(run_statistics_summary_t const * const p_summary,
+                                   uint8_t * const p_buffer,
+                                   size_t const size,
+                                   size_t * const p_written);
+
+//! @brief Decode a stored summary
+bool run_statistics_decode_summary(uint8_t const * const p_buffer,
+                                   size_t const size,
+                                   run_statistics_summary_t * const p_summary);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //RUN_STATISTICS_H
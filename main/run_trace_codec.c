@@ -0,0 +1,384 @@
+/*!
+ *******************************************************************************
+ * @file run_trace_codec.c
+ *
+ * @brief Streaming compression of run trace samples, as deltas from the
+ *        previous sample packed in variable length integers
+ *
+ * Temperatures change by a degree or two between samples, and samples come at
+ * a steady rate, so each sample is encoded from the previous one:
+ *
+ *      | temperature delta, context flag | period delta | phase | segment |
+ *
+ * - The temperature delta is zigzag encoded, so small negative values stay
+ *   small, and shifted left to carry, in its lowest bit, whether the phase or
+ *   segment changed.
+ * - The period delta is the difference between the time since the previous
+ *   sample and the one before, also zigzag encoded. It is 0 while the rate
+ *   holds.
+ * - Phase and segment follow, one byte each, only if the context flag is set.
+ *
+ * Both deltas are written as LEB128 variable length integers: 7 bits per byte,
+ * least significant first, with the top bit set on every byte but the last.
+ * A sample at a steady rate and within 31 degrees of the previous one takes
+ * 2 bytes, down from 8 packed as is.
+ *
+ * Encoder and decoder keep the same state, the previous sample and period,
+ * which is reset at the start of every stream. Each sample is encoded and
+ * decoded in constant time.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "run_trace_codec.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Largest number of bytes of a 32 bit variable length integer
+#define VARINT_SIZE_MAX                     (5)
+
+//! @brief Payload bits of a variable length integer byte
+#define VARINT_PAYLOAD_MASK                 (0x7F)
+
+//! @brief Bit set on variable length integer bytes followed by another one
+#define VARINT_CONTINUATION_BIT             (0x80)
+
+//! @brief Size in bytes of the phase and segment
+#define CONTEXT_SIZE                        (2)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Map a signed value to an unsigned one, small magnitudes first
+static uint32_t zigzag_encode(int32_t const value);
+
+//! @brief Map back a zigzag encoded value
+static int32_t zigzag_decode(uint32_t const value);
+
+//! @brief Write a variable length integer
+static size_t put_varint(uint8_t * const p_buffer, uint32_t const value);
+
+//! @brief Read a variable length integer
+static size_t get_varint(uint8_t const * const p_buffer,
+                         size_t const size,
+                         uint32_t * const p_value);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Start a new stream
+ *
+ * The first sample of a stream is encoded from a sample at time 0, 0 degrees,
+ * phase and segment 0, and a period of 0.
+ *
+ * @param[out]          p_codec             Pointer to the encoder or decoder
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool run_trace_codec_reset(run_trace_codec_t * const p_codec)
+{
+        bool const success = (NULL != p_codec);
+
+        if (success) {
+                (void)memset(p_codec, 0, sizeof(*p_codec));
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Encode a sample
+ *
+ * The encoder only moves on to the sample if it was written.
+ *
+ * @param[in,out]       p_codec             Pointer to the encoder
+ * @param[in]           p_sample            Pointer to the sample
+ * @param[out]          p_buffer            Buffer where to write it
+ * @param[in]           size                Size of the buffer
+ * @param[out]          p_written           Pointer where to store the number
+ *                                          of bytes written
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null or the buffer
+ *                                          is too small
+ */
+bool run_trace_codec_encode(run_trace_codec_t * const p_codec,
+                            run_trace_codec_sample_t const * const p_sample,
+                            uint8_t * const p_buffer,
+                            size_t const size,
+                            size_t * const p_written)
+{
+        uint8_t encoded[RUN_TRACE_CODEC_SAMPLE_SIZE_MAX];
+        uint32_t period_ms = 0;
+        uint32_t value;
+        size_t length = 0;
+        bool is_context_changed = false;
+        bool success = ((NULL != p_codec) &&
+                        (NULL != p_sample) &&
+                        (NULL != p_buffer) &&
+                        (NULL != p_written));
+
+        if (success) {
+                is_context_changed = ((p_sample->phase != p_codec->sample.phase) ||
+                                      (p_sample->segment != p_codec->sample.segment));
+
+                value = zigzag_encode((int32_t)p_sample->temperature -
+                                      (int32_t)p_codec->sample.temperature);
+                length += put_varint(&encoded[length],
+                                     (value << 1) | (is_context_changed ? 1 : 0));
+
+                period_ms = p_sample->time_ms - p_codec->sample.time_ms;
+                length += put_varint(&encoded[length],
+                                     zigzag_encode((int32_t)(period_ms -
+                                                             p_codec->period_ms)));
+
+                if (is_context_changed) {
+                        encoded[length++] = p_sample->phase;
+                        encoded[length++] = p_sample->segment;
+                }
+
+                success = (size >= length);
+        }
+
+        if (success) {
+                (void)memcpy(p_buffer, encoded, length);
+                *p_written = length;
+
+                p_codec->sample = *p_sample;
+                p_codec->period_ms = period_ms;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Decode a sample
+ *
+ * The decoder only moves on to the sample if it was read in full.
+ *
+ * @param[in,out]       p_codec             Pointer to the decoder
+ * @param[in]           p_buffer            Buffer to read the sample from
+ * @param[in]           size                Number of bytes in the buffer
+ * @param[out]          p_sample            Pointer where to store the sample
+ * @param[out]          p_consumed          Pointer where to store the number
+ *                                          of bytes read
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, the sample is
+ *                                          cut short or malformed
+ */
+bool run_trace_codec_decode(run_trace_codec_t * const p_codec,
+                            uint8_t const * const p_buffer,
+                            size_t const size,
+                            run_trace_codec_sample_t * const p_sample,
+                            size_t * const p_consumed)
+{
+        run_trace_codec_sample_t sample;
+        uint32_t period_ms = 0;
+        uint32_t value = 0;
+        int32_t temperature = 0;
+        size_t length = 0;
+        size_t used = 0;
+        bool is_context_changed = false;
+        bool success = ((NULL != p_codec) &&
+                        (NULL != p_buffer) &&
+                        (NULL != p_sample) &&
+                        (NULL != p_consumed));
+
+        if (success) {
+                sample = p_codec->sample;
+                used = get_varint(p_buffer, size, &value);
+                length = used;
+
+                temperature = (int32_t)sample.temperature + zigzag_decode(value >> 1);
+                is_context_changed = (0 != (value & 1));
+
+                success = ((0 != used) &&
+                           (0 <= temperature) &&
+                           (UINT16_MAX >= temperature));
+        }
+
+        if (success) {
+                used = get_varint(&p_buffer[length], size - length, &value);
+                length += used;
+
+                period_ms = p_codec->period_ms + (uint32_t)zigzag_decode(value);
+
+                success = ((0 != used) &&
+                           ((!is_context_changed) || (size >= (length + CONTEXT_SIZE))));
+        }
+
+        if ((success) && (is_context_changed)) {
+                sample.phase = p_buffer[length++];
+                sample.segment = p_buffer[length++];
+        }
+
+        if (success) {
+                sample.time_ms += period_ms;
+                sample.temperature = (uint16_t)temperature;
+
+                *p_sample = sample;
+                *p_consumed = length;
+
+                p_codec->sample = sample;
+                p_codec->period_ms = period_ms;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Map a signed value to an unsigned one, small magnitudes first
+ *
+ * 0, -1, 1, -2, 2... map to 0, 1, 2, 3, 4...
+ *
+ * @param[in]           value               Value to map
+ *
+ * @return              uint32_t            Mapped value
+ */
+static uint32_t zigzag_encode(int32_t const value)
+{
+        return (((uint32_t)value << 1) ^ ((0 > value) ? UINT32_MAX : 0));
+}
+
+/*!
+ * @brief Map back a zigzag encoded value
+ *
+ * @param[in]           value               Value to map back
+ *
+ * @return              int32_t             Signed value
+ */
+static int32_t zigzag_decode(uint32_t const value)
+{
+        return (int32_t)((value >> 1) ^ (0U - (value & 1)));
+}
+
+/*!
+ * @brief Write a variable length integer
+ *
+ * @param[out]          p_buffer            Buffer of at least `VARINT_SIZE_MAX`
+ *                                          bytes where to write the value
+ * @param[in]           value               Value to write
+ *
+ * @return              size_t              Number of bytes written
+ */
+static size_t put_varint(uint8_t * const p_buffer, uint32_t const value)
+{
+        uint32_t remaining = value;
+        size_t length = 0;
+
+        while (VARINT_PAYLOAD_MASK < remaining) {
+                p_buffer[length++] = (uint8_t)((remaining & VARINT_PAYLOAD_MASK) |
+                                               VARINT_CONTINUATION_BIT);
+                remaining >>= 7;
+        }
+
+        p_buffer[length++] = (uint8_t)remaining;
+
+        return length;
+}
+
+/*!
+ * @brief Read a variable length integer
+ *
+ * @param[in]           p_buffer            Buffer to read the value from
+ * @param[in]           size                Number of bytes in the buffer
+ * @param[out]          p_value             Pointer where to store the value
+ *
+ * @return              size_t              Number of bytes read, 0 if the
+ *                                          value is cut short or doesn't fit
+ *                                          in 32 bits
+ */
+static size_t get_varint(uint8_t const * const p_buffer,
+                         size_t const size,
+                         uint32_t * const p_value)
+{
+        uint32_t value = 0;
+        size_t length = 0;
+        bool is_last = false;
+
+        while ((!is_last) && (size > length) && (VARINT_SIZE_MAX > length)) {
+                value |= ((uint32_t)(p_buffer[length] & VARINT_PAYLOAD_MASK) <<
+                          (7 * length));
+                is_last = (0 == (p_buffer[length] & VARINT_CONTINUATION_BIT));
+                length++;
+        }
+
+        // The last byte of a 32 bit value only carries its top 4 bits
+        if ((!is_last) ||
+            ((VARINT_SIZE_MAX == length) && (0x0F < p_buffer[length - 1]))) {
+                length = 0;
+        }
+
+        *p_value = value;
+
+        return length;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,98 @@
+/*!
+ *******************************************************************************
+ * @file run_trace_codec.h
+ *
+ * @brief Streaming compression of run trace samples, as deltas from the
+ *        previous sample packed in variable length integers
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef RUN_TRACE_CODEC_H
+#define RUN_TRACE_CODEC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of the largest encoded sample
+#define RUN_TRACE_CODEC_SAMPLE_SIZE_MAX                 (10)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Trace sample
+typedef struct {
+        //! @brief Run time of the sample
+        uint32_t time_ms;
+
+        //! @brief Temperature, in Celsius
+        uint16_t temperature;
+
+        //! @brief Phase the run is at
+        uint8_t phase;
+
+        //! @brief Segment the run is at
+        uint8_t segment;
+} run_trace_codec_sample_t;
+
+//! @brief State of an encoder or decoder, the previous sample
+typedef struct {
+        //! @brief Previous sample
+        run_trace_codec_sample_t sample;
+
+        //! @brief Time between the last two samples
+        uint32_t period_ms;
+} run_trace_codec_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Start a new stream
+bool run_trace_codec_reset(run_trace_codec_t * const p_codec);
+
+//! @brief Encode a sample
+bool run_trace_codec_encode(run_trace_codec_t * const p_codec,
+                            run_trace_codec_sample_t const * const p_sample,
+                            uint8_t * const p_buffer,
+                            size_t const size,
+                            size_t * const p_written);
+
+//! @brief Decode a sample
+bool run_trace_codec_decode(run_trace_codec_t * const p_codec,
+                            uint8_t const * const p_buffer,
+                            size_t const size,
+                            run_trace_codec_sample_t * const p_sample,
+                            size_t * const p_consumed);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //RUN_TRACE_CODEC_H
@@ -0,0 +1,407 @@
+/*!
+ *******************************************************************************
+ * @file event_recorder.c
+ *
+ * @brief Compact recorder of the events entering the state machine, so that a
+ *        run can be replayed deterministically off target
+ *
+ * Records are kept in a RAM ring buffer, along with the program of the last
+ * run started. A capture is the serialized form of the program and the held
+ * records, with a fixed little endian layout independent of the compiler
+ * structure packing:
+ *
+ * | Offset | Size | Field                                |
+ * |--------|------|--------------------------------------|
+ * | 0      | 4    | Magic, `EVENT_RECORDER_MAGIC`        |
+ * | 4      | 1    | Version, `EVENT_RECORDER_VERSION`    |
+ * | 5      | 1    | Size of the encoded program, 0 if no |
+ * |        |      | run was started                      |
+ * | 6      | 2    | Record count                         |
+ * | 8      | 86   | Program, as `reflow_program_encode`  |
+ * |        |      | writes it, padded with 0             |
+ * | 94     | 8*n  | Records: time (4), temperature (2),  |
+ * |        |      | type (1) and data (1)                |
+ *
+ * The module isn't thread safe, the caller must serialize the access.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byte_codec.h"
+#include "event_recorder.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize (or clear) a recorder
+ *
+ * @param[out]          p_recorder          Pointer to the recorder
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool event_recorder_init(event_recorder_t * const p_recorder)
+{
+        bool success = (NULL != p_recorder);
+
+        if (success) {
+                p_recorder->head = 0;
+                p_recorder->count = 0;
+                p_recorder->total = 0;
+                p_recorder->has_program = false;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Add a record, overwriting the oldest one when full
+ *
+ * @param[in,out]       p_recorder          Pointer to the recorder
+ * @param[in]           p_record            Pointer to the record to add
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool event_recorder_add(event_recorder_t * const p_recorder,
+                        event_recorder_record_t const * const p_record)
+{
+        bool success = ((NULL != p_recorder) && (NULL != p_record));
+
+        if (success) {
+                p_recorder->records[p_recorder->head] = *p_record;
+                p_recorder->head = (p_recorder->head + 1) % EVENT_RECORDER_CAPACITY;
+                p_recorder->total++;
+
+                if (EVENT_RECORDER_CAPACITY > p_recorder->count) {
+                        p_recorder->count++;
+                }
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Set the program of the run being recorded
+ *
+ * A replay runs the recorded events against it, instead of against whatever
+ * program is in use where the capture is replayed.
+ *
+ * @param[in,out]       p_recorder          Pointer to the recorder
+ * @param[in]           p_program           Pointer to the program
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool event_recorder_set_program(event_recorder_t * const p_recorder,
+                                reflow_program_t const * const p_program)
+{
+        bool success = ((NULL != p_recorder) && (NULL != p_program));
+
+        if (success) {
+                p_recorder->program = *p_program;
+                p_recorder->has_program = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the number of records held
+ *
+ * @param[in]           p_recorder          Pointer to the recorder
+ *
+ * @return              uint16_t            Number of records, 0 if null pointer
+ */
+uint16_t event_recorder_get_count(event_recorder_t const * const p_recorder)
+{
+        return (NULL != p_recorder) ? p_recorder->count : 0;
+}
+
+/*!
+ * @brief Get a record by its age, 0 being the oldest one held
+ *
+ * @param[in]           p_recorder          Pointer to the recorder
+ * @param[in]           index               Age of the record
+ * @param[out]          p_record            Pointer where to store the record
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or index out of
+ *                                          range
+ */
+bool event_recorder_get(event_recorder_t const * const p_recorder,
+                        uint16_t const index,
+                        event_recorder_record_t * const p_record)
+{
+        bool success = ((NULL != p_recorder) &&
+                        (NULL != p_record) &&
+                        (p_recorder->count > index));
+        uint16_t position;
+
+        if (success) {
+                position = (p_recorder->head + EVENT_RECORDER_CAPACITY -
+                            p_recorder->count + index) % EVENT_RECORDER_CAPACITY;
+
+                *p_record = p_recorder->records[position];
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Serialize the held records, oldest first, into a capture
+ *
+ * @param[in]           p_recorder          Pointer to the recorder
+ * @param[out]          p_buffer            Buffer where to write the capture
+ * @param[in]           size                Size of the buffer in bytes
+ * @param[out]          p_written           Pointer where to store the number
+ *                                          of bytes written
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or buffer too
+ *                                          small
+ */
+bool event_recorder_serialize(event_recorder_t const * const p_recorder,
+                              uint8_t * const p_buffer,
+                              size_t const size,
+                              size_t * const p_written)
+{
+        event_recorder_record_t record;
+        uint8_t * p_out;
+        size_t program_size = 0;
+        bool success = ((NULL != p_recorder) &&
+                        (NULL != p_buffer) &&
+                        (NULL != p_written));
+        uint16_t i;
+
+        if (success) {
+                success = (EVENT_RECORDER_CAPTURE_SIZE(p_recorder->count) <= size);
+        }
+
+        if (success) {
+                memset(&p_buffer[EVENT_RECORDER_HEADER_SIZE], 0,
+                       EVENT_RECORDER_PROGRAM_SIZE);
+
+                // An invalid program is left out, the run didn't start
+                if ((p_recorder->has_program) &&
+                    (!reflow_program_encode(&p_recorder->program,
+                                            &p_buffer[EVENT_RECORDER_HEADER_SIZE],
+                                            EVENT_RECORDER_PROGRAM_SIZE,
+                                            &program_size))) {
+                        program_size = 0;
+                }
+
+                byte_codec_put_u32(&p_buffer[0], EVENT_RECORDER_MAGIC);
+                p_buffer[4] = EVENT_RECORDER_VERSION;
+                p_buffer[5] = (uint8_t)program_size;
+                byte_codec_put_u16(&p_buffer[6], p_recorder->count);
+
+                p_out = &p_buffer[EVENT_RECORDER_HEADER_SIZE +
+                                  EVENT_RECORDER_PROGRAM_SIZE];
+
+                for (i = 0; p_recorder->count > i; i++) {
+                        (void)event_recorder_get(p_recorder, i, &record);
+
+                        byte_codec_put_u32(&p_out[0], record.time_ms);
+                        byte_codec_put_u16(&p_out[4], record.temperature);
+                        p_out[6] = record.type;
+                        p_out[7] = record.data;
+
+                        p_out += EVENT_RECORDER_RECORD_SIZE;
+                }
+
+                *p_written = EVENT_RECORDER_CAPTURE_SIZE(p_recorder->count);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the number of records of a serialized capture
+ *
+ * The capture header is validated against the buffer size.
+ *
+ * @param[in]           p_buffer            Buffer holding the capture
+ * @param[in]           size                Size of the buffer in bytes
+ * @param[out]          p_count             Pointer where to store the count
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, unknown format
+ *                                          or version, or truncated capture
+ */
+bool event_recorder_get_capture_count(uint8_t const * const p_buffer,
+                                      size_t const size,
+                                      uint16_t * const p_count)
+{
+        bool success = ((NULL != p_buffer) &&
+                        (NULL != p_count) &&
+                        (EVENT_RECORDER_HEADER_SIZE <= size));
+        uint16_t count = 0;
+
+        if (success) {
+                count = byte_codec_get_u16(&p_buffer[6]);
+
+                success = ((EVENT_RECORDER_MAGIC ==
+                            byte_codec_get_u32(&p_buffer[0])) &&
+                           (EVENT_RECORDER_VERSION == p_buffer[4]) &&
+                           (EVENT_RECORDER_PROGRAM_SIZE >= p_buffer[5]) &&
+                           (EVENT_RECORDER_CAPTURE_SIZE(count) <= size));
+        }
+
+        if (success) {
+                *p_count = count;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the program of the run of a serialized capture
+ *
+ * @param[in]           p_buffer            Buffer holding the capture
+ * @param[in]           size                Size of the buffer in bytes
+ * @param[out]          p_program           Pointer where to store the program
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, invalid capture
+ *                                          or no run started in it
+ */
+bool event_recorder_get_capture_program(uint8_t const * const p_buffer,
+                                        size_t const size,
+                                        reflow_program_t * const p_program)
+{
+        uint16_t count = 0;
+        bool success = (NULL != p_program);
+
+        if (success) {
+                success = event_recorder_get_capture_count(p_buffer, size, &count);
+        }
+
+        if (success) {
+                success = ((0 < p_buffer[5]) &&
+                           (reflow_program_decode(&p_buffer[EVENT_RECORDER_HEADER_SIZE],
+                                                  p_buffer[5],
+                                                  p_program)));
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get a record from a serialized capture
+ *
+ * @param[in]           p_buffer            Buffer holding the capture
+ * @param[in]           size                Size of the buffer in bytes
+ * @param[in]           index               Index of the record, 0 being the
+ *                                          oldest one
+ * @param[out]          p_record            Pointer where to store the record
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, invalid capture
+ *                                          or index out of range
+ */
+bool event_recorder_get_capture_record(uint8_t const * const p_buffer,
+                                       size_t const size,
+                                       uint16_t const index,
+                                       event_recorder_record_t * const p_record)
+{
+        uint8_t const * p_in;
+        uint16_t count = 0;
+        bool success = (NULL != p_record);
+
+        if (success) {
+                success = event_recorder_get_capture_count(p_buffer, size, &count);
+        }
+
+        if (success) {
+                success = (count > index);
+        }
+
+        if (success) {
+                p_in = &p_buffer[EVENT_RECORDER_CAPTURE_SIZE(index)];
+
+                p_record->time_ms = byte_codec_get_u32(&p_in[0]);
+                p_record->temperature = byte_codec_get_u16(&p_in[4]);
+                p_record->type = p_in[6];
+                p_record->data = p_in[7];
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
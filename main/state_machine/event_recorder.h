@@ -0,0 +1,161 @@
+/*!
+ *******************************************************************************
+ * @file event_recorder.h
+ *
+ * @brief Compact recorder of the events entering the state machine, so that a
+ *        run can be replayed deterministically off target
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef EVENT_RECORDER_H
+#define EVENT_RECORDER_H
+
+#include "reflow_profile.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Number of records kept in RAM. Oldest ones are overwritten
+#define EVENT_RECORDER_CAPACITY                      (256)
+
+//! @brief Capture format identifier ("RRCP", little endian)
+#define EVENT_RECORDER_MAGIC                         (0x50435252UL)
+
+/*!
+ * @brief Capture format version. Bumped whenever the meaning of the recorded
+ *        event data changes, e.g. when state machine messages are renumbered
+ */
+#define EVENT_RECORDER_VERSION                       (3)
+
+//! @brief Size in bytes of the serialized capture header
+#define EVENT_RECORDER_HEADER_SIZE                   (8)
+
+//! @brief Size in bytes of the serialized program area, fitting any program
+#define EVENT_RECORDER_PROGRAM_SIZE                  REFLOW_PROGRAM_ENCODED_SIZE_MAX
+
+//! @brief Size in bytes of a serialized record
+#define EVENT_RECORDER_RECORD_SIZE                   (8)
+
+//! @brief Size in bytes of a serialized capture with a given record count, as
+//!        a `size_t` to compare with buffer sizes
+#define EVENT_RECORDER_CAPTURE_SIZE(count)           \
+        (EVENT_RECORDER_HEADER_SIZE +                \
+         EVENT_RECORDER_PROGRAM_SIZE +               \
+         ((size_t)(count) * EVENT_RECORDER_RECORD_SIZE))
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Recorded event
+typedef struct {
+        //! @brief Time in milliseconds at which the state machine took the event
+        uint32_t time_ms;
+
+        //! @brief Temperature in Celsius when the state machine took the event
+        uint16_t temperature;
+
+        //! @brief Event type, a `state_machine_event_type_t`
+        uint8_t type;
+
+        //! @brief Event data, a `state_machine_action_t` or `state_machine_msg_t`
+        uint8_t data;
+} event_recorder_record_t;
+
+//! @brief Recorder object, a ring buffer of records
+typedef struct {
+        //! @brief Records storage
+        event_recorder_record_t records[EVENT_RECORDER_CAPACITY];
+
+        //! @brief Index where the next record is written
+        uint16_t head;
+
+        //! @brief Number of valid records
+        uint16_t count;
+
+        //! @brief Total number of records ever added
+        uint32_t total;
+
+        //! @brief Program of the last run started
+        reflow_program_t program;
+
+        //! @brief Whether a run was started since the recorder was initialized
+        bool has_program;
+} event_recorder_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize (or clear) a recorder
+bool event_recorder_init(event_recorder_t * const p_recorder);
+
+//! @brief Add a record, overwriting the oldest one when full
+bool event_recorder_add(event_recorder_t * const p_recorder,
+                        event_recorder_record_t const * const p_record);
+
+//! @brief Set the program of the run being recorded
+bool event_recorder_set_program(event_recorder_t * const p_recorder,
+                                reflow_program_t const * const p_program);
+
+//! @brief Get the number of records held
+uint16_t event_recorder_get_count(event_recorder_t const * const p_recorder);
+
+//! @brief Get a record by its age, 0 being the oldest one held
+bool event_recorder_get(event_recorder_t const * const p_recorder,
+                        uint16_t const index,
+                        event_recorder_record_t * const p_record);
+
+//! @brief Serialize the held records, oldest first, into a capture
+bool event_recorder_serialize(event_recorder_t const * const p_recorder,
+                              uint8_t * const p_buffer,
+                              size_t const size,
+                              size_t * const p_written);
+
+//! @brief Get the number of records of a serialized capture
+bool event_recorder_get_capture_count(uint8_t const * const p_buffer,
+                                      size_t const size,
+                                      uint16_t * const p_count);
+
+//! @brief Get the program of the run of a serialized capture
+bool event_recorder_get_capture_program(uint8_t const * const p_buffer,
+                                        size_t const size,
+                                        reflow_program_t * const p_program);
+
+//! @brief Get a record from a serialized capture
+bool event_recorder_get_capture_record(uint8_t const * const p_buffer,
+                                       size_t const size,
+                                       uint16_t const index,
+                                       event_recorder_record_t * const p_record);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //EVENT_RECORDER_H
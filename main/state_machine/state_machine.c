@@ -21,10 +21,16 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "esp_log.h"
+#include "deferred_log.h"
+#include "nvs.h"
+#include "reflow_profile.h"
+#include "thermocouple.h"
 #include "states/state_machine_states.h"
 #include "state_machine.h"
 #include "state_machine_task.h"
+#include "event_recorder.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -38,6 +44,10 @@
 
 #define TAG                     __FILENAME__
 
+//! @brief NVS namespace and key where the capture is saved
+#define STATE_MACHINE_CAPTURE_NVS_NAMESPACE     "capture"
+#define STATE_MACHINE_CAPTURE_NVS_KEY           "last"
+
 /*
  *******************************************************************************
  * Data types                                                                  *
@@ -60,6 +70,9 @@ static size_t const m_state_map_size = sizeof(m_state_map) /
  *******************************************************************************
  */
 
+//! @brief Add an event to the recorder
+static void state_machine_record_event(state_machine_event_t const * const p_event);
+
 /*
  *******************************************************************************
  * Public Data Declarations                                                    *
@@ -80,6 +93,16 @@ static QueueHandle_t m_state_machine_event_q = NULL;
 
 static TaskHandle_t m_state_machine_task_h = NULL;
 
+//! @brief Recorder of every event the state machine got, in the order it did
+static event_recorder_t m_recorder;
+
+//! @brief Spinlock protecting the recorder, the capture is read from other
+//!        tasks
+static portMUX_TYPE m_recorder_mux = portMUX_INITIALIZER_UNLOCKED;
+
+//! @brief Total recorded events at the time the capture was last saved
+static uint32_t m_saved_capture_total = 0;
+
 /*
  *******************************************************************************
  * Public Function Bodies                                                      *
@@ -115,6 +138,7 @@ bool state_machine_init(void) {
         }
 
         if (success) {
+                (void)event_recorder_init(&m_recorder);
                 state_machine_states_set_entry_point_state();
         }
 
@@ -149,11 +173,14 @@ bool state_machine_wait_for_event(uint32_t const time_ms,
         }
 
         if (success) {
-                ESP_LOGI(TAG, "Got event %d", p_event_buffer->data.message);
+                DEFERRED_LOGI(TAG, "Got event %d", p_event_buffer->data.message);
                 *p_event = *p_event_buffer;
 
                 vPortFree(p_event_buffer);
                 p_event_buffer = NULL;
+
+                // Recorded as taken, so a replay sees the same order and times
+                state_machine_record_event(p_event);
         }
 
         return success;
@@ -259,12 +286,179 @@ char * state_machine_get_state_string(state_machine_state_text_t const state)
         return p_string;
 }
 
+/*!
+ * @brief Get the program of the current profile to start a run with
+ *
+ * The program is kept along with the recorded events, so the capture replays
+ * the run against it.
+ *
+ * @param[out]          p_program           Pointer where to store the program
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or no program
+ *                                          for the current profile
+ */
+bool state_machine_load_program(reflow_program_t * const p_program)
+{
+        bool success = reflow_profile_get_current_program(p_program);
+
+        if (success) {
+                taskENTER_CRITICAL(&m_recorder_mux);
+                (void)event_recorder_set_program(&m_recorder, p_program);
+                taskEXIT_CRITICAL(&m_recorder_mux);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get a capture of the last events taken by the state machine
+ *
+ * The capture can be replayed off target, see `event_recorder.c` for the
+ * format.
+ *
+ * @param[out]          p_buffer            Buffer where to write the capture
+ * @param[in]           size                Size of the buffer in bytes. A
+ *                                          `EVENT_RECORDER_CAPTURE_SIZE(
+ *                                          EVENT_RECORDER_CAPACITY)` bytes
+ *                                          buffer always fits the capture
+ * @param[out]          p_written           Pointer where to store the number
+ *                                          of bytes written
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed, out of memory
+ *                                          or buffer too small
+ */
+bool state_machine_get_capture(uint8_t * const p_buffer,
+                               size_t const size,
+                               size_t * const p_written)
+{
+        event_recorder_t * p_snapshot = NULL;
+        bool success = ((NULL != p_buffer) && (NULL != p_written));
+
+        if (success) {
+                p_snapshot = pvPortMalloc(sizeof(event_recorder_t));
+                success = (NULL != p_snapshot);
+        }
+
+        // Copy under lock and serialize outside, to keep the lock short
+        if (success) {
+                taskENTER_CRITICAL(&m_recorder_mux);
+                memcpy(p_snapshot, &m_recorder, sizeof(event_recorder_t));
+                taskEXIT_CRITICAL(&m_recorder_mux);
+
+                success = event_recorder_serialize(p_snapshot, p_buffer, size,
+                                                   p_written);
+        }
+
+        vPortFree(p_snapshot);
+
+        return success;
+}
+
+/*!
+ * @brief Save the capture of the last events to NVS
+ *
+ * The capture is only written if there were new events since it was last
+ * saved, so calling this function repeatedly doesn't wear the flash.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Out of memory or NVS error
+ */
+bool state_machine_save_capture(void)
+{
+        size_t const size = EVENT_RECORDER_CAPTURE_SIZE(EVENT_RECORDER_CAPACITY);
+        uint8_t * p_buffer = NULL;
+        size_t written = 0;
+        uint32_t total;
+        nvs_handle_t nvs_h;
+        esp_err_t result;
+        bool success = true;
+
+        taskENTER_CRITICAL(&m_recorder_mux);
+        total = m_recorder.total;
+        taskEXIT_CRITICAL(&m_recorder_mux);
+
+        if (total == m_saved_capture_total) {
+                // Code style exception for readability
+                return true;
+        }
+
+        p_buffer = pvPortMalloc(size);
+        success = (NULL != p_buffer);
+
+        if (success) {
+                success = state_machine_get_capture(p_buffer, size, &written);
+        }
+
+        if (success) {
+                result = nvs_open(STATE_MACHINE_CAPTURE_NVS_NAMESPACE,
+                                  NVS_READWRITE,
+                                  &nvs_h);
+
+                success = (ESP_OK == result);
+        }
+
+        if (success) {
+                result = nvs_set_blob(nvs_h, STATE_MACHINE_CAPTURE_NVS_KEY,
+                                      p_buffer, written);
+
+                if (ESP_OK == result) {
+                        result = nvs_commit(nvs_h);
+                }
+
+                nvs_close(nvs_h);
+
+                success = (ESP_OK == result);
+        }
+
+        if (success) {
+                m_saved_capture_total = total;
+                ESP_LOGI(TAG, "Capture saved, %u bytes", written);
+        }
+
+        vPortFree(p_buffer);
+
+        return success;
+}
+
 /*
  *******************************************************************************
  * Private Function Bodies                                                     *
  *******************************************************************************
  */
 
+/*!
+ * @brief Add an event to the recorder
+ *
+ * @param[in]           p_event             Pointer to the event to record
+ *
+ * @return              -                   -
+ */
+static void state_machine_record_event(state_machine_event_t const * const p_event)
+{
+        event_recorder_record_t record;
+        uint16_t temperature = 0;
+
+        (void)thermocouple_get_avg_temperature(&temperature);
+
+        record.time_ms = pdTICKS_TO_MS(xTaskGetTickCount());
+        record.temperature = temperature;
+        record.type = (uint8_t)p_event->type;
+        record.data = (STATE_MACHINE_EVENT_TYPE_ACTION == p_event->type) ?
+                      (uint8_t)p_event->data.user_action :
+                      (uint8_t)p_event->data.message;
+
+        taskENTER_CRITICAL(&m_recorder_mux);
+        (void)event_recorder_add(&m_recorder, &record);
+        taskEXIT_CRITICAL(&m_recorder_mux);
+}
+
 
 /*
  *******************************************************************************
@@ -16,6 +16,13 @@
 #ifndef STATE_MACHINE_H
 #define STATE_MACHINE_H
 
+#include "reflow_profile.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
 /*
  *******************************************************************************
  * Public Macros                                                               *
@@ -48,10 +55,8 @@ typedef enum {
 } state_machine_event_type_t;
 
 typedef enum {
-        STATE_MACHINE_MSG_HEATER_PREHEAT_TARGET_REACHED = 0,
-        STATE_MACHINE_MSG_HEATER_REFLOW_TARGET_REACHED,
-        STATE_MACHINE_MSG_SOAK_TIME_REACHED,
-        STATE_MACHINE_MSG_DWELL_TIME_REACHED,
+        STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED = 0,
+        STATE_MACHINE_MSG_SEGMENT_HOLD_TIME_REACHED,
         STATE_MACHINE_MSG_HEATER_COOLING_TARGET_REACHED,
         STATE_MACHINE_MSG_HEATER_COOLING_TIMEOUT,
         STATE_MACHINE_MSG_HEATER_ERROR,
@@ -74,11 +79,9 @@ typedef struct {
 
 typedef enum {
         STATE_MACHINE_STATE_IDLE = 0,
-        STATE_MACHINE_STATE_HEATING,
-        STATE_MACHINE_STATE_SOAKING,
-        STATE_MACHINE_STATE_REFLOW,
-        STATE_MACHINE_STATE_DWELL,
+        STATE_MACHINE_STATE_SEGMENT,
         STATE_MACHINE_STATE_COOLING,
+        STATE_MACHINE_STATE_PAUSED,
         STATE_MACHINE_STATE_ERROR,
         STATE_MACHINE_STATE_COUNT
 } state_machine_state_text_t;
@@ -100,28 +103,10 @@ static const state_machine_state_map_t m_state_map[STATE_MACHINE_STATE_COUNT] =
                 STATE_MACHINE_MSG_COUNT
         },
         {
-                STATE_MACHINE_STATE_HEATING,
-                state_machine_state_heating,
-                "Heating",
-                STATE_MACHINE_MSG_COUNT
-        },
-        {
-                STATE_MACHINE_STATE_SOAKING,
-                state_machine_state_soak,
-                "Soaking",
-                STATE_MACHINE_MSG_SOAK_TIME_REACHED
-        },
-        {
-                STATE_MACHINE_STATE_REFLOW,
-                state_machine_state_reflow,
-                "Reflow",
-                STATE_MACHINE_MSG_COUNT
-        },
-        {
-                STATE_MACHINE_STATE_DWELL,
-                state_machine_state_dwell,
-                "Dwell",
-                STATE_MACHINE_MSG_DWELL_TIME_REACHED
+                STATE_MACHINE_STATE_SEGMENT,
+                state_machine_state_segment,
+                "Segment",
+                STATE_MACHINE_MSG_SEGMENT_HOLD_TIME_REACHED
         },
         {
                 STATE_MACHINE_STATE_COOLING,
@@ -129,6 +114,12 @@ static const state_machine_state_map_t m_state_map[STATE_MACHINE_STATE_COUNT] =
                 "Cooling",
                 STATE_MACHINE_MSG_HEATER_COOLING_TIMEOUT
         },
+        {
+                STATE_MACHINE_STATE_PAUSED,
+                state_machine_state_paused,
+                "Paused",
+                STATE_MACHINE_MSG_COUNT
+        },
         {
                 STATE_MACHINE_STATE_ERROR,
                 state_machine_state_error,
@@ -169,4 +160,16 @@ state_machine_state_text_t state_machine_pointer_to_text(
 
 char * state_machine_get_state_string(state_machine_state_text_t const state);
 
+bool state_machine_load_program(reflow_program_t * const p_program);
+
+bool state_machine_get_capture(uint8_t * const p_buffer,
+                               size_t const size,
+                               size_t * const p_written);
+
+bool state_machine_save_capture(void);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
 #endif //STATE_MACHINE_H
\ No newline at end of file
@@ -16,6 +16,11 @@
 #ifndef STATE_MACHINE_TASK_H
 #define STATE_MACHINE_TASK_H
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
 /*
  *******************************************************************************
  * Public Macros                                                               *
@@ -44,4 +49,8 @@
 
 bool state_machine_set_state(state_machine_state_t const state);
 
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
 #endif //STATE_MACHINE_TASK_H
\ No newline at end of file
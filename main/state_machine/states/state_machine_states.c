@@ -21,11 +21,17 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <assert.h>
 #include "esp_log.h"
+#include "deferred_log.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "freertos/timers.h"
 #include "lvgl.h"
 #include "reflow_profile.h"
+#include "reflow_clock.h"
+#include "thermocouple.h"
+#include "configuration.h"
 
 #include "state_machine/states/state_machine_states.h"
 #include "state_machine/state_machine.h"
@@ -48,19 +54,18 @@
  *******************************************************************************
  */
 
+//! @brief Program of a run and the trajectory compiled from it
+typedef struct {
+        reflow_program_t program;
+        reflow_trajectory_t trajectory;
+} state_machine_states_run_t;
+
 /*
  *******************************************************************************
  * Constants                                                                   *
  *******************************************************************************
  */
 
-//TODO: define timeout
-/*!
- * @brief Maximum allowed time (ms) to reach the reflow temperature before
- *        jumping to state error
- */
-uint32_t const m_reflow_dwell_cooling_timeout = portMAX_DELAY;
-
 
 /*
  *******************************************************************************
@@ -68,6 +73,30 @@ uint32_t const m_reflow_dwell_cooling_timeout = portMAX_DELAY;
  *******************************************************************************
  */
 
+//! @brief Get the current time in milliseconds
+static uint32_t state_machine_states_get_time_ms(void);
+
+//! @brief Start a run of the program of the current profile
+static void state_machine_transition_start(void);
+
+//! @brief Start holding the target of the current segment
+static void state_machine_transition_hold(void);
+
+//! @brief Go to the next segment, or to cooling after the last one
+static void state_machine_transition_next_segment(void);
+
+//! @brief Freeze the run and hold the current temperature
+static void state_machine_transition_pause(state_machine_state_t const state);
+
+//! @brief Continue a paused run from the point it was paused
+static void state_machine_transition_resume(void);
+
+//! @brief Go to error after a phase failed to progress
+static void state_machine_transition_phase_failure(state_machine_msg_t const message);
+
+//! @brief Query whether thermocouple_task waits for a message to be processed
+static bool state_machine_is_acknowledged_msg(state_machine_msg_t const message);
+
 /*
  *******************************************************************************
  * Public Data Declarations                                                    *
@@ -82,6 +111,30 @@ extern xTaskHandle m_thermocouple_task_h;
  *******************************************************************************
  */
 
+//! @brief Clock measuring the progress of the current run, excluding pauses
+static reflow_clock_t m_run_clock;
+
+//! @brief State to go back to when resuming a paused run
+static state_machine_state_t m_pf_paused_state = NULL;
+
+//! @brief Whether the phase timer was frozen by a pause and must be resumed
+static bool m_is_phase_timer_paused = false;
+
+//! @brief Buffers of the current (or last) run and of the one being started
+static state_machine_states_run_t m_runs[2];
+
+//! @brief Current run, its trajectory from the temperature it started at
+static state_machine_states_run_t * m_p_run = &m_runs[0];
+
+//! @brief Spinlock protecting the current run pointer and the run clock
+static portMUX_TYPE m_run_mux = portMUX_INITIALIZER_UNLOCKED;
+
+//! @brief Index of the segment being run
+static uint8_t m_segment_index = 0;
+
+//! @brief Whether the current segment reached its target and is holding it
+static bool m_is_segment_holding = false;
+
 /*
  *******************************************************************************
  * Public Function Bodies                                                      *
@@ -93,12 +146,123 @@ void state_machine_states_set_entry_point_state(void)
         state_machine_set_state(state_machine_state_idle);
 }
 
+/*!
+ * @brief Get the time elapsed since the current run started
+ *
+ * Time spent in the paused state is not accounted, so the returned value can
+ * be used to index the intended profile trajectory.
+ *
+ * @param[out]          p_run_time_ms       Pointer where to store the run time
+ *                                          in milliseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer or no run in progress
+ */
+bool state_machine_states_get_run_time(uint32_t * const p_run_time_ms)
+{
+        reflow_clock_t run_clock;
+
+        taskENTER_CRITICAL(&m_run_mux);
+        run_clock = m_run_clock;
+        taskEXIT_CRITICAL(&m_run_mux);
+
+        return reflow_clock_get_elapsed(&run_clock,
+                                        state_machine_states_get_time_ms(),
+                                        p_run_time_ms);
+}
+
+/*!
+ * @brief Get the program of the current (or last) run
+ *
+ * The program pointed to is not written while it is the current one, and is
+ * kept until the run after the next one starts.
+ *
+ * @param[out]          pp_program          Pointer where to store the pointer
+ *                                          to the program
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool state_machine_states_get_program(reflow_program_t const ** const pp_program)
+{
+        bool success = (NULL != pp_program);
+
+        if (success) {
+                taskENTER_CRITICAL(&m_run_mux);
+                *pp_program = &m_p_run->program;
+                taskEXIT_CRITICAL(&m_run_mux);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the intended trajectory of the current (or last) run
+ *
+ * It is indexed with the run time, @see `state_machine_states_get_run_time`.
+ * It is kept as the program is, @see `state_machine_states_get_program`
+ *
+ * @param[out]          pp_trajectory       Pointer where to store the pointer
+ *                                          to the trajectory
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool state_machine_states_get_trajectory(reflow_trajectory_t const ** const pp_trajectory)
+{
+        bool success = (NULL != pp_trajectory);
+
+        if (success) {
+                taskENTER_CRITICAL(&m_run_mux);
+                *pp_trajectory = &m_p_run->trajectory;
+                taskEXIT_CRITICAL(&m_run_mux);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the progress of the current run through the program segments
+ *
+ * @param[out]          p_index             Pointer where to store the index of
+ *                                          the segment being run
+ * @param[out]          p_is_holding        Pointer where to store whether the
+ *                                          segment is holding its target, or
+ *                                          still ramping to it
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or all the
+ *                                          segments were already run
+ */
+bool state_machine_states_get_segment(uint8_t * const p_index,
+                                      bool * const p_is_holding)
+{
+        bool success = ((NULL != p_index) &&
+                        (NULL != p_is_holding) &&
+                        (m_p_run->program.segment_count > m_segment_index));
+
+        if (success) {
+                *p_index = m_segment_index;
+                *p_is_holding = m_is_segment_holding;
+        }
+
+        return success;
+}
+
 void state_machine_state_idle(void)
 {
         state_machine_event_t event = {.type = STATE_MACHINE_EVENT_TYPE_COUNT};
         state_machine_state_text_t state;
         bool success = state_machine_get_state(&state);
-        ESP_LOGI(TAG, "State Idle");
+        DEFERRED_LOGI(TAG, "State Idle");
+
+        taskENTER_CRITICAL(&m_run_mux);
+        (void)reflow_clock_stop(&m_run_clock);
+        taskEXIT_CRITICAL(&m_run_mux);
 
         if (success) {
                 gui_ctrls_main_update_buttons(state);
@@ -116,7 +280,15 @@ void state_machine_state_idle(void)
                 switch (event.type) {
                 case STATE_MACHINE_EVENT_TYPE_ACTION:
                         if (STATE_MACHINE_ACTION_START == event.data.user_action) {
-                                state_machine_set_state(state_machine_state_heating);
+                                state_machine_transition_start();
+                        } else {
+                                assert(0 && "This event type was not expected here");
+                        }
+                        break;
+                case STATE_MACHINE_EVENT_TYPE_MESSAGE:
+                        // The supervisor keeps checking while idle
+                        if (STATE_MACHINE_MSG_HEATER_ERROR == event.data.message) {
+                                state_machine_set_state(state_machine_state_error);
                         } else {
                                 assert(0 && "This event type was not expected here");
                         }
@@ -130,28 +302,38 @@ void state_machine_state_idle(void)
 static void state_machine_transition_abort(void)
 {
 
-        ESP_LOGI(TAG, "Transition Abort");
+        DEFERRED_LOGI(TAG, "Transition Abort");
         reflow_timer_stop_timer();
+        m_is_phase_timer_paused = false;
+        m_pf_paused_state = NULL;
         state_machine_set_state(state_machine_state_cooling);
 }
 
-void state_machine_state_heating(void)
+/*!
+ * @brief Segment state
+ *
+ * Runs the segments of the program one after the other. Each segment first
+ * ramps to its target temperature, reported by thermocouple_task, and then
+ * holds it for its hold time, measured by the reflow timer. The run goes to
+ * cooling after the last segment.
+ */
+void state_machine_state_segment(void)
 {
-        ESP_LOGI(TAG, "State Heating");
+        DEFERRED_LOGI(TAG, "State Segment %d of %d", m_segment_index + 1,
+                      m_p_run->program.segment_count);
 
+        reflow_program_segment_t const * const p_segment =
+                        &m_p_run->program.segments[m_segment_index];
         state_machine_event_t event;
         state_machine_state_text_t state;
         heater_error_t heater_result;
-        reflow_profile_t profile;
         bool success = state_machine_get_state(&state);
 
         if (success) {
                 gui_ctrls_main_update_buttons(state);
-                success = reflow_profile_get_current(&profile);
-        }
 
-        if (success) {
-                heater_result = heater_set_target(profile.preheat_temperature);
+                // Restore the segment target in case a pause changed it
+                heater_result = heater_set_target(p_segment->target_temperature);
 
                 success = (HEATER_ERROR_SUCCESS == heater_result);
         }
@@ -162,6 +344,11 @@ void state_machine_state_heating(void)
                 success = (HEATER_ERROR_SUCCESS == heater_result);
         }
 
+        if ((success) && (m_is_phase_timer_paused)) {
+                m_is_phase_timer_paused = false;
+                success = reflow_timer_resume_timer();
+        }
+
         if (success) {
                 success = state_machine_wait_for_event(portMAX_DELAY, &event);
         }
@@ -173,16 +360,30 @@ void state_machine_state_heating(void)
                 case STATE_MACHINE_EVENT_TYPE_ACTION:
                         if (STATE_MACHINE_ACTION_ABORT == event.data.user_action) {
                                 state_machine_transition_abort();
-                                state_machine_set_state(state_machine_state_cooling);
+                        } else if (STATE_MACHINE_ACTION_PAUSE ==
+                                   event.data.user_action) {
+                                state_machine_transition_pause(state_machine_state_segment);
                         }
                         break;
                 case STATE_MACHINE_EVENT_TYPE_MESSAGE:
-                        if (STATE_MACHINE_MSG_HEATER_PREHEAT_TARGET_REACHED == event.data.message) {
-                                state_machine_set_state(state_machine_state_soak);
+                        if (STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED ==
+                            event.data.message) {
+                                if (!m_is_segment_holding) {
+                                        state_machine_transition_hold();
+                                }
 
                                 // Notify thermocouple_task that the event was processed
                                 xTaskNotify(m_thermocouple_task_h, 1, eSetValueWithOverwrite);
 
+                        } else if ((STATE_MACHINE_MSG_SEGMENT_HOLD_TIME_REACHED ==
+                                    event.data.message) &&
+                                   (m_is_segment_holding)) {
+                                state_machine_transition_next_segment();
+                        } else if ((STATE_MACHINE_MSG_HEATER_TIMEOUT ==
+                                    event.data.message) ||
+                                   (STATE_MACHINE_MSG_HEATER_TOO_SLOW ==
+                                    event.data.message)) {
+                                state_machine_transition_phase_failure(event.data.message);
                         } else if (STATE_MACHINE_MSG_HEATER_ERROR ==
                                    event.data.message) {
                                 state_machine_set_state(state_machine_state_error);
@@ -194,22 +395,23 @@ void state_machine_state_heating(void)
         }
 }
 
-void state_machine_state_soak(void)
+void state_machine_state_cooling(void)
 {
-        ESP_LOGI(TAG, "State Soaking");
+        DEFERRED_LOGI(TAG, "State Cooling");
 
+        heater_error_t heater_result;
         state_machine_event_t event;
         state_machine_state_text_t state;
         bool success = state_machine_get_state(&state);
-        reflow_profile_t profile;
 
         if (success) {
                 gui_ctrls_main_update_buttons(state);
-                success = reflow_profile_get_current(&profile);
         }
 
         if (success) {
-                success = reflow_timer_start_timer(profile.soak_time_s, state);
+                heater_result = heater_stop();
+
+                success = (HEATER_ERROR_SUCCESS == heater_result);
         }
 
         if (success) {
@@ -222,17 +424,26 @@ void state_machine_state_soak(void)
 
         switch (event.type) {
         case STATE_MACHINE_EVENT_TYPE_ACTION:
-                if (STATE_MACHINE_ACTION_ABORT == event.data.user_action) {
-                        state_machine_transition_abort();
-                        state_machine_set_state(state_machine_state_cooling);
-                }
                 break;
         case STATE_MACHINE_EVENT_TYPE_MESSAGE:
-                if (STATE_MACHINE_MSG_SOAK_TIME_REACHED == event.data.message) {
-                        state_machine_set_state(state_machine_state_reflow);
+                if (STATE_MACHINE_MSG_HEATER_COOLING_TARGET_REACHED == event.data.message) {
+                        state_machine_set_state(state_machine_state_idle);
+
+                        // Notify thermocouple_task that the event was processed
+                        xTaskNotify(m_thermocouple_task_h, 1, eSetValueWithOverwrite);
+
+                } else if (STATE_MACHINE_MSG_HEATER_COOLING_TIMEOUT ==
+                           event.data.message) {
+                        state_machine_transition_phase_failure(event.data.message);
                 } else if (STATE_MACHINE_MSG_HEATER_ERROR ==
-                           event.data.message) { //cannot keep temperature, too high, too low for long time, etc
+                           event.data.message) {
                         state_machine_set_state(state_machine_state_error);
+                } else if (state_machine_is_acknowledged_msg(event.data.message)) {
+                        /*
+                         * Raised by the run phase right before aborting it.
+                         * Only unblock thermocouple_task, the run is over
+                         */
+                        xTaskNotify(m_thermocouple_task_h, 1, eSetValueWithOverwrite);
                 }
                 break;
         default:
@@ -240,30 +451,83 @@ void state_machine_state_soak(void)
         }
 }
 
-void state_machine_state_reflow(void)
+/*!
+ * @brief Paused state
+ *
+ * The run is frozen: the phase timer is stopped and the heater holds the
+ * temperature measured when pausing. A new pause (or start) action resumes the
+ * run from the same point, while an abort action goes to cooling.
+ */
+void state_machine_state_paused(void)
 {
-        ESP_LOGI(TAG, "State Reflow");
+        DEFERRED_LOGI(TAG, "State Paused");
 
         state_machine_event_t event;
         state_machine_state_text_t state;
-        reflow_profile_t profile;
-        heater_error_t heater_result;
         bool success = state_machine_get_state(&state);
 
         if (success) {
                 gui_ctrls_main_update_buttons(state);
-                success = reflow_profile_get_current(&profile);
+                success = state_machine_wait_for_event(portMAX_DELAY, &event);
         }
 
-        if (success) {
-                heater_result = heater_set_target(profile.reflow_temperature);
-
-                success = (HEATER_ERROR_SUCCESS == heater_result);
+        if (!success) {
+                state_machine_set_state(state_machine_state_error);
+        } else {
+                switch (event.type) {
+                case STATE_MACHINE_EVENT_TYPE_ACTION:
+                        if ((STATE_MACHINE_ACTION_PAUSE == event.data.user_action) ||
+                            (STATE_MACHINE_ACTION_START == event.data.user_action)) {
+                                state_machine_transition_resume();
+                        } else if (STATE_MACHINE_ACTION_ABORT ==
+                                   event.data.user_action) {
+                                state_machine_transition_abort();
+                        }
+                        break;
+                case STATE_MACHINE_EVENT_TYPE_MESSAGE:
+                        if (STATE_MACHINE_MSG_HEATER_ERROR == event.data.message) {
+                                state_machine_set_state(state_machine_state_error);
+                        } else if ((STATE_MACHINE_MSG_HEATER_TIMEOUT ==
+                                    event.data.message) ||
+                                   (STATE_MACHINE_MSG_HEATER_TOO_SLOW ==
+                                    event.data.message)) {
+                                // Phase failed right before pausing
+                                state_machine_transition_phase_failure(event.data.message);
+                        } else if (STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED ==
+                                   event.data.message) {
+                                /*
+                                 * Target was reached right before pausing. Only
+                                 * acknowledge it so thermocouple_task doesn't
+                                 * block, it will be raised again once resumed
+                                 */
+                                xTaskNotify(m_thermocouple_task_h, 1, eSetValueWithOverwrite);
+                        }
+                        break;
+                default:
+                        assert(0);
+                }
         }
+}
 
-        if (success) {
-                success = state_machine_wait_for_event(m_reflow_dwell_cooling_timeout, &event);
+void state_machine_state_error(void)
+{
+        DEFERRED_LOGI(TAG, "State Error");
+
+        state_machine_event_t event;
+        bool success = true;
+
+        gui_ctrls_main_update_buttons(STATE_MACHINE_STATE_ERROR);
+
+        heater_emergency_stop();
+
+#if CONFIGURATION_CAPTURE_SAVE_ON_ERROR
+        // Keep the events that led here for an off target replay
+        if (!state_machine_save_capture()) {
+                ESP_LOGE(TAG, "Couldn't save the event capture");
         }
+#endif // #if CONFIGURATION_CAPTURE_SAVE_ON_ERROR
+
+        success = state_machine_wait_for_event(portMAX_DELAY, &event);
 
         if (!success) {
                 state_machine_set_state(state_machine_state_error);
@@ -271,163 +535,274 @@ void state_machine_state_reflow(void)
 
         switch (event.type) {
         case STATE_MACHINE_EVENT_TYPE_ACTION:
-                if (STATE_MACHINE_ACTION_ABORT == event.data.user_action) {
-                        state_machine_transition_abort();
-                        state_machine_set_state(state_machine_state_cooling);
+                if (STATE_MACHINE_ACTION_RESET == event.data.user_action) {
+                        state_machine_set_state(state_machine_state_idle);
                 }
                 break;
-
         case STATE_MACHINE_EVENT_TYPE_MESSAGE:
-                if (STATE_MACHINE_MSG_HEATER_REFLOW_TARGET_REACHED == event.data.message) {
-                        state_machine_set_state(state_machine_state_dwell);
-
-                        // Notify thermocouple_task that the event was processed
+                /*
+                 * Messages sent before getting here, or further errors. Only
+                 * unblock thermocouple_task if it is waiting for one of them
+                 */
+                if (state_machine_is_acknowledged_msg(event.data.message)) {
                         xTaskNotify(m_thermocouple_task_h, 1, eSetValueWithOverwrite);
-
-                } else if (STATE_MACHINE_MSG_HEATER_ERROR ==
-                           event.data.message) {
-                        state_machine_set_state(state_machine_state_error);
                 }
                 break;
-
         default:
                 assert(0);
         }
+
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Get the current time in milliseconds
+ *
+ * @param               -                   -
+ *
+ * @return              uint32_t            Milliseconds since the scheduler
+ *                                          started
+ */
+static uint32_t state_machine_states_get_time_ms(void)
+{
+        return pdTICKS_TO_MS(xTaskGetTickCount());
 }
 
-void state_machine_state_dwell(void)
+/*!
+ * @brief Start a run of the program of the current profile
+ *
+ * The program is copied, so editing profiles doesn't affect a run in progress.
+ * Its trajectory is compiled from the temperature the oven is at. The heater
+ * is re-armed, as this is the only place an emergency stop is lifted.
+ *
+ * Both are built in the buffer that is not the current run, and published
+ * along with the run clock once the run can start, so other tasks never see
+ * them half written.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void state_machine_transition_start(void)
 {
-        ESP_LOGI(TAG, "State Dwell");
+        state_machine_states_run_t * const p_next_run =
+                ((&m_runs[0] == m_p_run) ? &m_runs[1] : &m_runs[0]);
+        uint16_t temperature = CONFIGURATION_AMBIENT_TEMPERATURE_C;
+        bool success = state_machine_load_program(&p_next_run->program);
 
-        state_machine_event_t event;
-        state_machine_state_text_t state;
-        bool success = state_machine_get_state(&state);
-        reflow_profile_t profile;
+        DEFERRED_LOGI(TAG, "Transition Start");
+
+        m_segment_index = 0;
+        m_is_segment_holding = false;
+        m_is_phase_timer_paused = false;
+
+        if ((success) && (!thermocouple_get_avg_temperature(&temperature))) {
+                temperature = CONFIGURATION_AMBIENT_TEMPERATURE_C;
+        }
 
         if (success) {
-                gui_ctrls_main_update_buttons(state);
-                success = reflow_profile_get_current(&profile);
+                success = reflow_trajectory_compile(&p_next_run->program,
+                                                    temperature,
+                                                    &p_next_run->trajectory);
         }
 
         if (success) {
-                success = reflow_timer_start_timer(profile.dwell_time_s, state);
+                success = (HEATER_ERROR_SUCCESS == heater_rearm());
         }
 
         if (success) {
-                success = state_machine_wait_for_event(
-                                m_reflow_dwell_cooling_timeout,
-                                &event);
+                taskENTER_CRITICAL(&m_run_mux);
+                m_p_run = p_next_run;
+                (void)reflow_clock_start(&m_run_clock,
+                                         state_machine_states_get_time_ms());
+                taskEXIT_CRITICAL(&m_run_mux);
+
+                state_machine_set_state(state_machine_state_segment);
+        } else {
+                state_machine_set_state(state_machine_state_error);
+        }
+}
+
+/*!
+ * @brief Start holding the target of the current segment
+ *
+ * Segments without hold time are done as soon as their target is reached.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void state_machine_transition_hold(void)
+{
+        uint16_t const hold_time_s = m_p_run->program.segments[m_segment_index].hold_time_s;
+        bool success = true;
+
+        DEFERRED_LOGI(TAG, "Transition Hold");
+
+        m_is_segment_holding = true;
+
+        if (0 < hold_time_s) {
+                success = reflow_timer_start_timer(hold_time_s,
+                                                   STATE_MACHINE_STATE_SEGMENT);
+        } else {
+                state_machine_transition_next_segment();
         }
 
         if (!success) {
                 state_machine_set_state(state_machine_state_error);
         }
+}
 
-        switch (event.type) {
-        case STATE_MACHINE_EVENT_TYPE_ACTION:
-                if (STATE_MACHINE_ACTION_ABORT == event.data.user_action) {
-                        state_machine_transition_abort();
-                        state_machine_set_state(state_machine_state_cooling);
-                }
-                break;
-        case STATE_MACHINE_EVENT_TYPE_MESSAGE:
-                if (STATE_MACHINE_MSG_DWELL_TIME_REACHED == event.data.message) {
-                        state_machine_transition_abort();
-                        state_machine_set_state(state_machine_state_cooling);
-                } else if (STATE_MACHINE_MSG_HEATER_ERROR ==
-                           event.data.message) {
-                        state_machine_set_state(state_machine_state_error);
-                }
-                break;
-        default:
-                assert(0);
+/*!
+ * @brief Go to the next segment, or to cooling after the last one
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void state_machine_transition_next_segment(void)
+{
+        DEFERRED_LOGI(TAG, "Transition Next Segment");
+
+        m_is_segment_holding = false;
+        m_segment_index++;
+
+        if (m_p_run->program.segment_count > m_segment_index) {
+                state_machine_set_state(state_machine_state_segment);
+        } else {
+                state_machine_set_state(state_machine_state_cooling);
         }
 }
 
-void state_machine_state_cooling(void)
+/*!
+ * @brief Freeze the run and hold the current temperature
+ *
+ * The phase timer (only running while a segment holds) and the run clock are
+ * frozen, and the heater target is set to the current temperature so the
+ * heater controller keeps it until the run is resumed.
+ *
+ * @param[in]           state               State to go back to when resuming
+ *
+ * @return              -                   -
+ */
+static void state_machine_transition_pause(state_machine_state_t const state)
 {
-        ESP_LOGI(TAG, "State Cooling");
-
         heater_error_t heater_result;
-        state_machine_event_t event;
-        state_machine_state_text_t state;
-        bool success = state_machine_get_state(&state);
+        uint16_t temperature;
+        bool success;
 
-        if (success) {
-                gui_ctrls_main_update_buttons(state);
-        }
+        DEFERRED_LOGI(TAG, "Transition Pause");
+
+        m_is_phase_timer_paused = reflow_timer_pause_timer();
+        taskENTER_CRITICAL(&m_run_mux);
+        (void)reflow_clock_pause(&m_run_clock, state_machine_states_get_time_ms());
+        taskEXIT_CRITICAL(&m_run_mux);
+
+        success = thermocouple_get_avg_temperature(&temperature);
 
         if (success) {
-                heater_result = heater_stop();
+                heater_result = heater_set_target(temperature);
 
                 success = (HEATER_ERROR_SUCCESS == heater_result);
         }
 
         if (success) {
-                success = state_machine_wait_for_event(
-                                m_reflow_dwell_cooling_timeout,
-                                &event);
-        }
+                heater_result = heater_start();
 
-        if (!success) {
-                state_machine_set_state(state_machine_state_error);
+                success = (HEATER_ERROR_SUCCESS == heater_result);
         }
 
-        switch (event.type) {
-        case STATE_MACHINE_EVENT_TYPE_ACTION:
-                break;
-        case STATE_MACHINE_EVENT_TYPE_MESSAGE:
-                if (STATE_MACHINE_MSG_HEATER_COOLING_TARGET_REACHED == event.data.message) {
-                        state_machine_set_state(state_machine_state_idle);
-
-                        // Notify thermocouple_task that the event was processed
-                        xTaskNotify(m_thermocouple_task_h, 1, eSetValueWithOverwrite);
-
-                } else if (STATE_MACHINE_MSG_HEATER_ERROR ==
-                           event.data.message) {
-                        state_machine_set_state(state_machine_state_error);
-                }
-                break;
-        default:
-                assert(0);
+        if (success) {
+                m_pf_paused_state = state;
+                state_machine_set_state(state_machine_state_paused);
+        } else {
+                state_machine_set_state(state_machine_state_error);
         }
 }
 
-void state_machine_state_error(void)
+/*!
+ * @brief Continue a paused run from the point it was paused
+ *
+ * Going back to the paused state restores its heater target, and if it was
+ * holding, the phase timer is re-armed for the time that was left.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void state_machine_transition_resume(void)
 {
-        ESP_LOGI(TAG, "State Error");
+        bool success = (NULL != m_pf_paused_state);
 
-        state_machine_event_t event;
-        bool success = true;
+        DEFERRED_LOGI(TAG, "Transition Resume");
 
-        gui_ctrls_main_update_buttons(STATE_MACHINE_STATE_ERROR);
+        taskENTER_CRITICAL(&m_run_mux);
+        (void)reflow_clock_resume(&m_run_clock, state_machine_states_get_time_ms());
+        taskEXIT_CRITICAL(&m_run_mux);
 
-        heater_emergency_stop();
-
-        success = state_machine_wait_for_event(portMAX_DELAY, &event);
+        if (success) {
+                success = state_machine_set_state(m_pf_paused_state);
+                m_pf_paused_state = NULL;
+        }
 
         if (!success) {
                 state_machine_set_state(state_machine_state_error);
         }
+}
 
-        switch (event.type) {
-        case STATE_MACHINE_EVENT_TYPE_ACTION:
-                if (STATE_MACHINE_ACTION_RESET == event.data.user_action) {
-                        state_machine_set_state(state_machine_state_idle);
-                }
+/*!
+ * @brief Go to error after a phase failed to progress
+ *
+ * Phase failures are detected by thermocouple_task, which waits until the
+ * message is processed.
+ *
+ * @param[in]           message             Failure message received
+ *
+ * @return              -                   -
+ */
+static void state_machine_transition_phase_failure(state_machine_msg_t const message)
+{
+        ESP_LOGE(TAG, "Transition Phase Failure: %d", message);
+
+        state_machine_set_state(state_machine_state_error);
+
+        // Notify thermocouple_task that the event was processed
+        xTaskNotify(m_thermocouple_task_h, 1, eSetValueWithOverwrite);
+}
+
+/*!
+ * @brief Query whether thermocouple_task waits for a message to be processed
+ *
+ * @param[in]           message             Message to query about
+ *
+ * @return              bool                Result of the query
+ */
+static bool state_machine_is_acknowledged_msg(state_machine_msg_t const message)
+{
+        bool is_acknowledged;
+
+        switch (message) {
+        // Intentionally fall through
+        case STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED:
+        case STATE_MACHINE_MSG_HEATER_COOLING_TARGET_REACHED:
+        case STATE_MACHINE_MSG_HEATER_COOLING_TIMEOUT:
+        case STATE_MACHINE_MSG_HEATER_TIMEOUT:
+        case STATE_MACHINE_MSG_HEATER_TOO_SLOW:
+                is_acknowledged = true;
                 break;
         default:
-                assert(0);
+                is_acknowledged = false;
+                break;
         }
 
+        return is_acknowledged;
 }
 
-/*
- *******************************************************************************
- * Private Function Bodies                                                     *
- *******************************************************************************
- */
-
 /*
  *******************************************************************************
  * Interrupt Service Routines / Tasks / Thread Main Functions                  *
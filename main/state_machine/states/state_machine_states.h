@@ -16,6 +16,13 @@
 #ifndef STATE_MACHINE_STATES_IDLE_H
 #define STATE_MACHINE_STATES_IDLE_H
 
+#include "reflow_profile.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
 /*
  *******************************************************************************
  * Public Macros                                                               *
@@ -45,18 +52,27 @@
 
 void state_machine_states_set_entry_point_state(void);
 
-void state_machine_state_idle(void);
+bool state_machine_states_get_run_time(uint32_t * const p_run_time_ms);
 
-void state_machine_state_heating(void);
+bool state_machine_states_get_program(reflow_program_t const ** const pp_program);
 
-void state_machine_state_soak(void);
+bool state_machine_states_get_trajectory(reflow_trajectory_t const ** const pp_trajectory);
 
-void state_machine_state_reflow(void);
+bool state_machine_states_get_segment(uint8_t * const p_index,
+                                      bool * const p_is_holding);
 
-void state_machine_state_dwell(void);
+void state_machine_state_idle(void);
+
+void state_machine_state_segment(void);
 
 void state_machine_state_cooling(void);
 
+void state_machine_state_paused(void);
+
 void state_machine_state_error(void);
 
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
 #endif //STATE_MACHINE_STATES_IDLE_H
\ No newline at end of file
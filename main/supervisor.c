@@ -0,0 +1,328 @@
+/*!
+ *******************************************************************************
+ * @file supervisor.c
+ *
+ * @brief Safety supervisor. Periodically checks the control invariants and
+ *        cuts the heater power as soon as one of them is violated
+ *
+ * The supervisor runs at the highest application priority with a fixed rate,
+ * so only interrupts can delay it. On a violation the heater power is cut
+ * directly from the supervisor task (see `heater_emergency_stop`), and then the
+ * state machine is notified so it goes to the error state. Power is cut again,
+ * and the state machine notified again until it is in the error state, on
+ * every period while the violation persists.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "state_machine/state_machine.h"
+#include "supervisor_invariants.h"
+#include "thermocouple.h"
+#include "heater.h"
+#include "panic.h"
+#include "wdt.h"
+#include "supervisor.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+#define TAG                                 __FILENAME__
+
+//! @brief Supervisor task priority, above any other application task
+#define SUPERVISOR_TASK_PRIORITY            (configMAX_PRIORITIES - 1)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Take a snapshot of the control state
+static void supervisor_take_sample(supervisor_sample_t * const p_sample);
+
+//! @brief Cut the heater power and notify the state machine
+static void supervisor_handle_violation(supervisor_violation_t const violation);
+
+//! @brief Supervisor task
+static void supervisor_task(void * pvParameters);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Whether the module is initialized or not
+static bool m_is_initialized = false;
+
+//! @brief Supervisor task handle
+static TaskHandle_t m_supervisor_task_h = NULL;
+
+//! @brief Invariants checker
+static supervisor_invariants_t m_invariants;
+
+//! @brief Violation detected on the previous check
+static supervisor_violation_t m_previous_violation = SUPERVISOR_VIOLATION_NONE;
+
+//! @brief Supervisor statistics
+static supervisor_stats_t m_stats;
+
+//! @brief Spinlock protecting the statistics
+static portMUX_TYPE m_stats_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize the safety supervisor
+ *
+ * @note Thermocouple and heater modules must be initialized before
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Module already initialized,
+ *                                          couldn't create the task or couldn't
+ *                                          add it to the WDT
+ */
+bool supervisor_init(void)
+{
+        supervisor_limits_t limits;
+        BaseType_t result;
+        bool success = !m_is_initialized;
+
+        if (success) {
+                success = supervisor_invariants_get_default_limits(&limits);
+        }
+
+        if (success) {
+                success = supervisor_invariants_init(&m_invariants, &limits);
+        }
+
+        if (success) {
+                memset(&m_stats, 0, sizeof(m_stats));
+
+                result = xTaskCreate(supervisor_task,
+                                     "supervisor_task",
+                                     configMINIMAL_STACK_SIZE * 3,
+                                     NULL,
+                                     SUPERVISOR_TASK_PRIORITY,
+                                     &m_supervisor_task_h);
+
+                success = (pdPASS == result);
+        }
+
+        if (success) {
+                success = wdt_add_task(m_supervisor_task_h);
+        }
+
+        if (success) {
+                m_is_initialized = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the supervisor statistics
+ *
+ * @param[out]          p_stats             Pointer where to store the
+ *                                          statistics
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or module not
+ *                                          initialized
+ */
+bool supervisor_get_stats(supervisor_stats_t * const p_stats)
+{
+        bool success = ((NULL != p_stats) && (m_is_initialized));
+
+        if (success) {
+                taskENTER_CRITICAL(&m_stats_mux);
+                *p_stats = m_stats;
+                taskEXIT_CRITICAL(&m_stats_mux);
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Take a snapshot of the control state
+ *
+ * @param[out]          p_sample            Pointer where to store the snapshot
+ *
+ * @return              -                   -
+ */
+static void supervisor_take_sample(supervisor_sample_t * const p_sample)
+{
+        bool success;
+
+        p_sample->now_ms = pdTICKS_TO_MS(xTaskGetTickCount());
+        p_sample->is_heater_on = heater_is_powered();
+
+        success = thermocouple_get_avg_temperature(&p_sample->temperature);
+
+        if (success) {
+                success = thermocouple_get_last_update_time(
+                                &p_sample->sample_time_ms);
+        }
+
+        p_sample->is_sample_valid = success;
+}
+
+/*!
+ * @brief Cut the heater power and notify the state machine
+ *
+ * The time it takes to cut the power is measured and tracked in the
+ * statistics. The state machine is notified without blocking, as the power is
+ * already cut at that point, and so again on the next periods until it is in
+ * the error state, in case its queue was full.
+ *
+ * @param[in]           violation           Detected violation
+ *
+ * @return              -                   -
+ */
+static void supervisor_handle_violation(supervisor_violation_t const violation)
+{
+        state_machine_data_t data;
+        state_machine_state_text_t state = STATE_MACHINE_STATE_COUNT;
+        int64_t const start_us = esp_timer_get_time();
+        uint32_t cut_latency_us;
+
+        heater_emergency_stop();
+
+        cut_latency_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+        taskENTER_CRITICAL(&m_stats_mux);
+
+        if (cut_latency_us > m_stats.max_cut_latency_us) {
+                m_stats.max_cut_latency_us = cut_latency_us;
+        }
+
+        if (SUPERVISOR_CUT_LATENCY_BUDGET_US < cut_latency_us) {
+                m_stats.cut_budget_overrun_count++;
+        }
+
+        if (violation != m_previous_violation) {
+                m_stats.violation_count++;
+                m_stats.last_violation = violation;
+        }
+
+        taskEXIT_CRITICAL(&m_stats_mux);
+
+        if (violation != m_previous_violation) {
+                ESP_LOGE(TAG, "Invariant violated: %d, heater power cut in %u us",
+                         violation, cut_latency_us);
+        }
+
+        if ((!state_machine_get_state(&state)) ||
+            (STATE_MACHINE_STATE_ERROR != state)) {
+                data.message = STATE_MACHINE_MSG_HEATER_ERROR;
+                (void)state_machine_send_event(STATE_MACHINE_EVENT_TYPE_MESSAGE,
+                                               data,
+                                               0);
+        }
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Supervisor task
+ *
+ * Checks the invariants every `SUPERVISOR_PERIOD_MS`. Fixed rate is kept with
+ * `vTaskDelayUntil`, so the check time doesn't add drift.
+ *
+ * @param               pvParameters        Not used
+ *
+ * @return              -                   -
+ */
+static void supervisor_task(void * pvParameters)
+{
+        TickType_t last_wake_time = xTaskGetTickCount();
+        supervisor_sample_t sample;
+        supervisor_violation_t violation;
+
+        (void)pvParameters;
+
+        for (;;) {
+                vTaskDelayUntil(&last_wake_time,
+                                pdMS_TO_TICKS(SUPERVISOR_PERIOD_MS));
+
+                supervisor_take_sample(&sample);
+
+                violation = supervisor_invariants_check(&m_invariants, &sample);
+
+                if (SUPERVISOR_VIOLATION_NONE != violation) {
+                        supervisor_handle_violation(violation);
+                }
+
+                m_previous_violation = violation;
+
+                taskENTER_CRITICAL(&m_stats_mux);
+                m_stats.check_count++;
+                taskEXIT_CRITICAL(&m_stats_mux);
+
+                if (!wdt_kick()) {
+                        break;
+                }
+        }
+
+        panic("General failure at supervisor_task ", __FILENAME__, __LINE__);
+}
@@ -0,0 +1,92 @@
+/*!
+ *******************************************************************************
+ * @file supervisor.h
+ *
+ * @brief Safety supervisor. Periodically checks the control invariants and
+ *        cuts the heater power as soon as one of them is violated
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+#include "supervisor_invariants.h"
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Period of the invariants check in milliseconds. A violation is acted
+ *        on at most one period after it happens
+ */
+#define SUPERVISOR_PERIOD_MS                         (20)
+
+/*!
+ * @brief Budget in microseconds for cutting the heater power once a violation
+ *        is detected. Exceeding it is reported in the statistics
+ */
+#define SUPERVISOR_CUT_LATENCY_BUDGET_US             (50)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Supervisor statistics
+typedef struct {
+        //! @brief Number of checks performed
+        uint32_t check_count;
+
+        //! @brief Number of violations detected (edges, not periods)
+        uint32_t violation_count;
+
+        //! @brief Last violation detected
+        supervisor_violation_t last_violation;
+
+        //! @brief Worst measured time to cut the heater power, in microseconds
+        uint32_t max_cut_latency_us;
+
+        //! @brief Number of times the cut latency budget was exceeded
+        uint32_t cut_budget_overrun_count;
+} supervisor_stats_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize the safety supervisor
+bool supervisor_init(void);
+
+//! @brief Get the supervisor statistics
+bool supervisor_get_stats(supervisor_stats_t * const p_stats);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //SUPERVISOR_H
@@ -0,0 +1,271 @@
+/*!
+ *******************************************************************************
+ * @file supervisor_invariants.c
+ *
+ * @brief Safety invariants of the oven control, evaluated periodically by the
+ *        supervisor on a snapshot of the control state
+ *
+ * The module has no dependencies on the RTOS or the hardware: the caller
+ * provides a snapshot with the time, the temperature and the heater state on
+ * each check. This keeps the check deterministic and testable in the host.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "supervisor_invariants.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Check how long the temperature has been above liquidus
+static bool supervisor_invariants_check_liquidus(
+                supervisor_invariants_t * const p_invariants,
+                supervisor_sample_t const * const p_sample);
+
+//! @brief Check that the temperature rises while the heater is powered
+static bool supervisor_invariants_check_rise(
+                supervisor_invariants_t * const p_invariants,
+                supervisor_sample_t const * const p_sample);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize an invariants checker object
+ *
+ * @param[out]          p_invariants        Pointer to the object to initialize
+ * @param[in]           p_limits            Pointer to the limits to check
+ *                                          against
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool supervisor_invariants_init(supervisor_invariants_t * const p_invariants,
+                                supervisor_limits_t const * const p_limits)
+{
+        bool success = ((NULL != p_invariants) && (NULL != p_limits));
+
+        if (success) {
+                p_invariants->limits = *p_limits;
+                p_invariants->above_liquidus_since_ms = 0;
+                p_invariants->heater_on_since_ms = 0;
+                p_invariants->heater_on_start_temperature = 0;
+                p_invariants->is_above_liquidus = false;
+                p_invariants->is_heater_on = false;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the default limits
+ *
+ * @param[out]          p_limits            Pointer where to store the limits
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed
+ */
+bool supervisor_invariants_get_default_limits(supervisor_limits_t * const p_limits)
+{
+        bool success = (NULL != p_limits);
+
+        if (success) {
+                p_limits->max_temperature = SUPERVISOR_MAX_TEMPERATURE_C;
+                p_limits->liquidus_temperature = SUPERVISOR_LIQUIDUS_TEMPERATURE_C;
+                p_limits->max_time_above_liquidus_ms =
+                                SUPERVISOR_MAX_TIME_ABOVE_LIQUIDUS_MS;
+                p_limits->heater_on_window_ms = SUPERVISOR_HEATER_ON_WINDOW_MS;
+                p_limits->heater_on_min_rise = SUPERVISOR_HEATER_ON_MIN_RISE_C;
+                p_limits->max_sample_age_ms = SUPERVISOR_MAX_SAMPLE_AGE_MS;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Check the invariants on a new snapshot of the control state
+ *
+ * Checks are performed in priority order and the first one failing is
+ * returned. Time based checks keep running even if a higher priority check
+ * fails, so their tracking stays consistent.
+ *
+ * @param[in,out]       p_invariants        Pointer to the checker object
+ * @param[in]           p_sample            Pointer to the snapshot to check
+ *
+ * @return              supervisor_violation_t
+ *                                          Violated invariant, or
+ *                                          SUPERVISOR_VIOLATION_NONE if all of
+ *                                          them hold. A null pointer is
+ *                                          reported as a stale sensor
+ */
+supervisor_violation_t supervisor_invariants_check(
+                supervisor_invariants_t * const p_invariants,
+                supervisor_sample_t const * const p_sample)
+{
+        supervisor_violation_t violation = SUPERVISOR_VIOLATION_NONE;
+        bool is_liquidus_ok;
+        bool is_rise_ok;
+
+        if ((NULL == p_invariants) || (NULL == p_sample)) {
+                // Code style exception for readability
+                return SUPERVISOR_VIOLATION_STALE_SENSOR;
+        }
+
+        if ((!p_sample->is_sample_valid) ||
+            ((p_sample->now_ms - p_sample->sample_time_ms) >
+             p_invariants->limits.max_sample_age_ms)) {
+                // Temperature based checks would work on garbage
+                return SUPERVISOR_VIOLATION_STALE_SENSOR;
+        }
+
+        is_liquidus_ok = supervisor_invariants_check_liquidus(p_invariants,
+                                                              p_sample);
+        is_rise_ok = supervisor_invariants_check_rise(p_invariants, p_sample);
+
+        if (p_sample->temperature > p_invariants->limits.max_temperature) {
+                violation = SUPERVISOR_VIOLATION_OVER_TEMPERATURE;
+        } else if (!is_liquidus_ok) {
+                violation = SUPERVISOR_VIOLATION_TIME_ABOVE_LIQUIDUS;
+        } else if (!is_rise_ok) {
+                violation = SUPERVISOR_VIOLATION_NO_TEMPERATURE_RISE;
+        }
+
+        return violation;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Check how long the temperature has been above liquidus
+ *
+ * @param[in,out]       p_invariants        Pointer to the checker object
+ * @param[in]           p_sample            Pointer to the snapshot to check
+ *
+ * @return              bool                Whether the invariant holds
+ */
+static bool supervisor_invariants_check_liquidus(
+                supervisor_invariants_t * const p_invariants,
+                supervisor_sample_t const * const p_sample)
+{
+        bool is_ok = true;
+
+        if (p_sample->temperature <= p_invariants->limits.liquidus_temperature) {
+                p_invariants->is_above_liquidus = false;
+        } else if (!p_invariants->is_above_liquidus) {
+                p_invariants->is_above_liquidus = true;
+                p_invariants->above_liquidus_since_ms = p_sample->now_ms;
+        } else {
+                is_ok = ((p_sample->now_ms -
+                          p_invariants->above_liquidus_since_ms) <=
+                         p_invariants->limits.max_time_above_liquidus_ms);
+        }
+
+        return is_ok;
+}
+
+/*!
+ * @brief Check that the temperature rises while the heater is powered
+ *
+ * A window starts when the heater is powered. If the heater stays powered for
+ * the whole window, the temperature must have risen the minimum amount, and
+ * then a new window starts. Switching the heater off discards the window, so
+ * the bang-bang regulation around a target never trips the check.
+ *
+ * @param[in,out]       p_invariants        Pointer to the checker object
+ * @param[in]           p_sample            Pointer to the snapshot to check
+ *
+ * @return              bool                Whether the invariant holds
+ */
+static bool supervisor_invariants_check_rise(
+                supervisor_invariants_t * const p_invariants,
+                supervisor_sample_t const * const p_sample)
+{
+        bool is_ok = true;
+        uint16_t const min_temperature =
+                        p_invariants->heater_on_start_temperature +
+                        p_invariants->limits.heater_on_min_rise;
+
+        if (!p_sample->is_heater_on) {
+                p_invariants->is_heater_on = false;
+        } else if (!p_invariants->is_heater_on) {
+                p_invariants->is_heater_on = true;
+                p_invariants->heater_on_since_ms = p_sample->now_ms;
+                p_invariants->heater_on_start_temperature = p_sample->temperature;
+        } else if ((p_sample->now_ms - p_invariants->heater_on_since_ms) >=
+                   p_invariants->limits.heater_on_window_ms) {
+
+                is_ok = (p_sample->temperature >= min_temperature);
+
+                if (is_ok) {
+                        p_invariants->heater_on_since_ms = p_sample->now_ms;
+                        p_invariants->heater_on_start_temperature =
+                                        p_sample->temperature;
+                }
+        }
+
+        return is_ok;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
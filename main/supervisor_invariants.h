@@ -0,0 +1,169 @@
+/*!
+ *******************************************************************************
+ * @file supervisor_invariants.h
+ *
+ * @brief Safety invariants of the oven control, evaluated periodically by the
+ *        supervisor on a snapshot of the control state
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef SUPERVISOR_INVARIANTS_H
+#define SUPERVISOR_INVARIANTS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Absolute maximum temperature in Celsius, above any valid profile
+#define SUPERVISOR_MAX_TEMPERATURE_C                 (290)
+
+//! @brief Liquidus temperature in Celsius of the solder alloy (SAC305), also
+//!        the one the run statistics measure the time above against
+#define SUPERVISOR_LIQUIDUS_TEMPERATURE_C            (217)
+
+//! @brief Maximum time in milliseconds allowed above liquidus
+#define SUPERVISOR_MAX_TIME_ABOVE_LIQUIDUS_MS        (150 * 1000)
+
+/*!
+ * @brief Time in milliseconds the heater can be continuously powered without
+ *        the temperature rising at least `SUPERVISOR_HEATER_ON_MIN_RISE_C`
+ */
+#define SUPERVISOR_HEATER_ON_WINDOW_MS               (30 * 1000)
+
+//! @brief Minimum temperature rise in Celsius within the heater on window
+#define SUPERVISOR_HEATER_ON_MIN_RISE_C              (5)
+
+//! @brief Maximum age in milliseconds of the last temperature sample
+#define SUPERVISOR_MAX_SAMPLE_AGE_MS                 (2500)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Invariant violations, sorted by priority
+typedef enum {
+        //! @brief All invariants hold
+        SUPERVISOR_VIOLATION_NONE = 0,
+
+        //! @brief Temperature sample is too old or couldn't be retrieved
+        SUPERVISOR_VIOLATION_STALE_SENSOR,
+
+        //! @brief Temperature over the absolute maximum
+        SUPERVISOR_VIOLATION_OVER_TEMPERATURE,
+
+        //! @brief Too long above the liquidus temperature
+        SUPERVISOR_VIOLATION_TIME_ABOVE_LIQUIDUS,
+
+        //! @brief Heater powered but the temperature doesn't rise
+        SUPERVISOR_VIOLATION_NO_TEMPERATURE_RISE,
+
+        //! @brief Fence member
+        SUPERVISOR_VIOLATION_COUNT
+} supervisor_violation_t;
+
+//! @brief Limits the invariants are checked against
+typedef struct {
+        //! @brief Absolute maximum temperature in Celsius
+        uint16_t max_temperature;
+
+        //! @brief Liquidus temperature in Celsius
+        uint16_t liquidus_temperature;
+
+        //! @brief Maximum time in milliseconds allowed above liquidus
+        uint32_t max_time_above_liquidus_ms;
+
+        //! @brief Heater on window in milliseconds for the rise check
+        uint32_t heater_on_window_ms;
+
+        //! @brief Minimum temperature rise in Celsius within the window
+        uint16_t heater_on_min_rise;
+
+        //! @brief Maximum age in milliseconds of the temperature sample
+        uint32_t max_sample_age_ms;
+} supervisor_limits_t;
+
+//! @brief Snapshot of the control state
+typedef struct {
+        //! @brief Time in milliseconds at which the snapshot was taken
+        uint32_t now_ms;
+
+        //! @brief Time in milliseconds at which the temperature was sampled
+        uint32_t sample_time_ms;
+
+        //! @brief Temperature in Celsius
+        uint16_t temperature;
+
+        //! @brief Whether the temperature sample could be retrieved
+        bool is_sample_valid;
+
+        //! @brief Whether the heater is physically powered
+        bool is_heater_on;
+} supervisor_sample_t;
+
+//! @brief Invariants checker object
+typedef struct {
+        //! @brief Limits to check against
+        supervisor_limits_t limits;
+
+        //! @brief Time in milliseconds at which liquidus was exceeded
+        uint32_t above_liquidus_since_ms;
+
+        //! @brief Time in milliseconds at which the heater on window started
+        uint32_t heater_on_since_ms;
+
+        //! @brief Temperature in Celsius at the start of the heater on window
+        uint16_t heater_on_start_temperature;
+
+        //! @brief Whether the temperature is above liquidus
+        bool is_above_liquidus;
+
+        //! @brief Whether the heater was on at the previous check
+        bool is_heater_on;
+} supervisor_invariants_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize an invariants checker object
+bool supervisor_invariants_init(supervisor_invariants_t * const p_invariants,
+                                supervisor_limits_t const * const p_limits);
+
+//! @brief Get the default limits
+bool supervisor_invariants_get_default_limits(supervisor_limits_t * const p_limits);
+
+//! @brief Check the invariants on a new snapshot of the control state
+supervisor_violation_t supervisor_invariants_check(
+                supervisor_invariants_t * const p_invariants,
+                supervisor_sample_t const * const p_sample);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //SUPERVISOR_INVARIANTS_H
@@ -0,0 +1,362 @@
+/*!
+ *******************************************************************************
+ * @file telemetry.c
+ *
+ * @brief Binary telemetry stream of the controller over the console UART
+ *
+ * Once every period, the control loop reading the temperature takes a
+ * snapshot of the controller: temperature, heater setpoint and duty, state
+ * and timing of the reading. Snapshots are pushed to a lock-free ring (see
+ * `telemetry_ring`), so the control loop never waits for the UART, and sent
+ * as frames (see `telemetry_frame`) by a task at a low priority. When the task
+ * lags behind, snapshots are dropped and counted instead, and show as gaps in
+ * the sequence of the frames.
+ *
+ * Snapshots can't come faster than the temperature readings: 4 Hz during a
+ * run, 1 Hz otherwise. The stream is off at boot unless
+ * `CONFIGURATION_TELEMETRY_PERIOD_MS` says otherwise, and is started and
+ * stopped with the `TELEMETRY` console request.
+ *
+ * @note The console is shared with the logs and the profile console answers.
+ *       Each frame is written at once, so it is never mixed with them, and is
+ *       delimited by 0x00 bytes text never carries.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "esp_log.h"
+
+#include "configuration.h"
+#include "heater.h"
+#include "thermocouple.h"
+#include "state_machine/states/state_machine_states.h"
+#include "telemetry_frame.h"
+#include "telemetry_ring.h"
+#include "telemetry.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+#define TAG                                 __FILENAME__
+
+//! @brief UART the console runs on
+#define TELEMETRY_UART_NUM                  (CONFIG_ESP_CONSOLE_UART_NUM)
+
+//! @brief Sender task priority, only above the run logger writer
+#define TELEMETRY_TASK_PRIORITY             (tskIDLE_PRIORITY + 1)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Percentage of heater control cycles powered since the last call
+static uint8_t get_heater_duty(void);
+
+//! @brief Telemetry sender task
+static void telemetry_task(void * pvParameters);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Whether the module is initialized or not
+static bool m_is_initialized = false;
+
+//! @brief Sender task handle
+static TaskHandle_t m_telemetry_task_h = NULL;
+
+//! @brief Snapshots waiting to be sent
+static telemetry_ring_t m_ring;
+
+//! @brief Period of the stream in milliseconds, 0 if stopped
+static volatile uint16_t m_period_ms = CONFIGURATION_TELEMETRY_PERIOD_MS;
+
+//! @brief Whether the next reading is to be sent regardless of the period,
+//!        set when the stream is (re)started
+static volatile bool m_is_restarted = true;
+
+//! @brief Sequence of the next snapshot, only used by the control loop
+static uint16_t m_sequence = 0;
+
+//! @brief Time of the last reading and of the last snapshot, only used by
+//!        the control loop
+static uint32_t m_last_reading_ms = 0;
+static uint32_t m_last_snapshot_ms = 0;
+
+//! @brief Heater cycle counts at the last snapshot, only used by the control
+//!        loop
+static uint32_t m_last_powered_count = 0;
+static uint32_t m_last_cycle_count = 0;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Initialize the telemetry stream
+ *
+ * Starts the sender task. Frames are written through the UART driver, which
+ * must have been installed by `profile_console_init` already.
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Module already initialized or
+ *                                          couldn't create the task
+ */
+bool telemetry_init(void)
+{
+        BaseType_t result;
+        bool success = ((!m_is_initialized) && (telemetry_ring_init(&m_ring)));
+
+        if (success) {
+                result = xTaskCreate(telemetry_task,
+                                     "telemetry_task",
+                                     configMINIMAL_STACK_SIZE * 3,
+                                     NULL,
+                                     TELEMETRY_TASK_PRIORITY,
+                                     &m_telemetry_task_h);
+
+                success = (pdPASS == result);
+        }
+
+        if (success) {
+                m_is_initialized = true;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Set the period of the telemetry stream
+ *
+ * The first snapshot is taken on the next temperature reading.
+ *
+ * @param[in]           period_ms           Period in milliseconds, 0 to stop
+ *                                          the stream
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Module not initialized
+ */
+bool telemetry_set_period(uint16_t const period_ms)
+{
+        bool const success = m_is_initialized;
+
+        if (success) {
+                m_period_ms = period_ms;
+                m_is_restarted = true;
+
+                ESP_LOGI(TAG, "Telemetry period set to %u ms", period_ms);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Account a temperature reading of the control loop
+ *
+ * Takes a snapshot if the stream is on and its period elapsed.
+ *
+ * @note This function is to be called on every reading, and only from the
+ *       control loop, the single producer of the ring
+ *
+ * @param[in]           state               State machine state
+ * @param[in]           segment             Segment of the run, `UINT8_MAX` if
+ *                                          none
+ * @param[in]           is_holding          Whether the segment is holding
+ * @param[in]           temperature         Temperature read, in Celsius
+ * @param[in]           update_us           Time taken by the reading, in
+ *                                          microseconds
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Module not initialized, or the
+ *                                          snapshot was dropped
+ */
+bool telemetry_sample(state_machine_state_text_t const state,
+                      uint8_t const segment,
+                      bool const is_holding,
+                      uint16_t const temperature,
+                      uint32_t const update_us)
+{
+        telemetry_snapshot_t snapshot;
+        uint32_t time_ms = 0;
+        uint32_t period_ms = 0;
+        uint16_t const stream_period_ms = m_period_ms;
+        bool is_due = false;
+        bool success = ((m_is_initialized) &&
+                        (thermocouple_get_last_update_time(&time_ms)));
+
+        if (success) {
+                period_ms = time_ms - m_last_reading_ms;
+                m_last_reading_ms = time_ms;
+
+                is_due = ((0 != stream_period_ms) &&
+                          ((m_is_restarted) ||
+                           (stream_period_ms <= (time_ms - m_last_snapshot_ms))));
+        }
+
+        if ((success) && (is_due)) {
+                m_is_restarted = false;
+                m_last_snapshot_ms = time_ms;
+
+                snapshot.sequence = m_sequence++;
+                snapshot.time_ms = time_ms;
+                snapshot.temperature = temperature;
+                snapshot.setpoint = 0;
+                snapshot.heater_duty = get_heater_duty();
+                snapshot.state = (uint8_t)state;
+                snapshot.segment = segment;
+                snapshot.flags = ((is_holding ? TELEMETRY_SNAPSHOT_FLAG_HOLDING : 0) |
+                                  (heater_is_running() ? TELEMETRY_SNAPSHOT_FLAG_HEATER_RUNNING : 0) |
+                                  (heater_is_powered() ? TELEMETRY_SNAPSHOT_FLAG_HEATER_POWERED : 0));
+                snapshot.period_ms = (uint16_t)((UINT16_MAX < period_ms) ?
+                                                UINT16_MAX : period_ms);
+                snapshot.update_us = (uint16_t)((UINT16_MAX < update_us) ?
+                                                UINT16_MAX : update_us);
+                (void)heater_get_target(&snapshot.setpoint);
+
+                success = telemetry_ring_push(&m_ring, &snapshot);
+
+                if (success) {
+                        xTaskNotifyGive(m_telemetry_task_h);
+                }
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the number of snapshots dropped because the UART lagged behind
+ *
+ * @param               -                   -
+ *
+ * @return              uint32_t            Number of snapshots dropped
+ */
+uint32_t telemetry_get_dropped_count(void)
+{
+        return telemetry_ring_get_dropped_count(&m_ring);
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Percentage of heater control cycles powered since the last call
+ *
+ * @param               -                   -
+ *
+ * @return              uint8_t             Duty of the heater, 0 to 100
+ */
+static uint8_t get_heater_duty(void)
+{
+        uint32_t powered_count = 0;
+        uint32_t cycle_count = 0;
+        uint32_t cycles = 0;
+        uint8_t duty = 0;
+
+        if (HEATER_ERROR_SUCCESS == heater_get_cycle_counts(&powered_count,
+                                                            &cycle_count)) {
+                cycles = cycle_count - m_last_cycle_count;
+
+                if (0 != cycles) {
+                        duty = (uint8_t)(((powered_count - m_last_powered_count) * 100) /
+                                         cycles);
+                }
+
+                m_last_powered_count = powered_count;
+                m_last_cycle_count = cycle_count;
+        }
+
+        return duty;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Telemetry sender task
+ *
+ * Sleeps until snapshots are pushed, and sends them oldest first, one frame
+ * per UART write.
+ *
+ * @param               pvParameters        Not used
+ *
+ * @return              -                   -
+ */
+static void telemetry_task(void * pvParameters)
+{
+        uint8_t frame[TELEMETRY_FRAME_SIZE_MAX];
+        telemetry_snapshot_t snapshot;
+        size_t length = 0;
+
+        (void)pvParameters;
+
+        for (;;) {
+                (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+                while (telemetry_ring_pop(&m_ring, &snapshot)) {
+                        if (telemetry_frame_encode(&snapshot,
+                                                   frame,
+                                                   sizeof(frame),
+                                                   &length)) {
+                                (void)uart_write_bytes(TELEMETRY_UART_NUM,
+                                                       (char const *)frame,
+                                                       length);
+                        }
+                }
+        }
+}
@@ -0,0 +1,72 @@
+/*!
+ *******************************************************************************
+ * @file telemetry.h
+ *
+ * @brief Binary telemetry stream of the controller over the console UART
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "state_machine/state_machine.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Initialize the telemetry stream
+bool telemetry_init(void);
+
+//! @brief Set the period of the telemetry stream
+bool telemetry_set_period(uint16_t const period_ms);
+
+//! @brief Account a temperature reading of the control loop
+bool telemetry_sample(state_machine_state_text_t const state,
+                      uint8_t const segment,
+                      bool const is_holding,
+                      uint16_t const temperature,
+                      uint32_t const update_us);
+
+//! @brief Get the number of snapshots dropped because the UART lagged behind
+uint32_t telemetry_get_dropped_count(void);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //TELEMETRY_H
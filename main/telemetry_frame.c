@@ -0,0 +1,319 @@
+/*!
+ *******************************************************************************
+ * @file telemetry_frame.c
+ *
+ * @brief Binary frames of the telemetry stream, checked with a CRC and byte
+ *        stuffed with COBS
+ *
+ * Each snapshot is sent as a payload of little endian fields followed by its
+ * CRC:
+ *
+ *      | type | sequence | time | temperature | setpoint | duty | state |
+ *      | segment | flags | period | update time | CRC-16 |
+ *
+ * - `type` is 1 byte, `TELEMETRY_FRAME_TYPE_SNAPSHOT`.
+ * - `sequence`, `temperature`, `setpoint`, `period` and `update time` are 16
+ *   bits, `time` is 32 bits, the rest are 1 byte. See `telemetry_snapshot_t`.
+ * - The CRC is the CRC-16/CCITT-FALSE of `reflow_profile_codec` over the
+ *   fields before it.
+ *
+ * Payload and CRC are then byte stuffed with COBS (Consistent Overhead Byte
+ * Stuffing), which removes every 0x00 for 1 byte of overhead per 254 bytes,
+ * and framed with a 0x00 on both sides. Receivers resynchronize on the next
+ * 0x00 after any lost or corrupted byte, and can tell frames apart from text
+ * sent on the same link, as text never carries 0x00 and fails the CRC.
+ *
+ * COBS replaces every 0x00 with the distance to the next one, and starts with
+ * the distance to the first: the bytes 11 22 00 33 are sent as 03 11 22 02 33.
+ * Runs of 254 non zero bytes are split with a code of 0xFF, not followed by a
+ * 0x00 once decoded.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byte_codec.h"
+#include "telemetry_frame.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of the CRC following the payload
+#define CRC_SIZE                            (2)
+
+//! @brief Size in bytes of the payload and its CRC, before stuffing
+#define RAW_SIZE                            (TELEMETRY_FRAME_PAYLOAD_SIZE + CRC_SIZE)
+
+//! @brief COBS code of a run of 254 non zero bytes, not followed by a zero
+#define COBS_CODE_MAX                       (0xFF)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Byte stuff a buffer with COBS
+static size_t cobs_encode(uint8_t const * const p_input,
+                          size_t const size,
+                          uint8_t * const p_output);
+
+//! @brief Undo the COBS byte stuffing of a buffer
+static bool cobs_decode(uint8_t const * const p_input,
+                        size_t const size,
+                        uint8_t * const p_output,
+                        size_t const output_size,
+                        size_t * const p_length);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Encode a snapshot as a frame
+ *
+ * @param[in]           p_snapshot          Pointer to the snapshot
+ * @param[out]          p_buffer            Buffer where to write the frame
+ * @param[in]           size                Size of the buffer, at least
+ *                                          `TELEMETRY_FRAME_SIZE_MAX`
+ * @param[out]          p_written           Pointer where to store the number
+ *                                          of bytes written, delimiters
+ *                                          included
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null or the buffer
+ *                                          is too small
+ */
+bool telemetry_frame_encode(telemetry_snapshot_t const * const p_snapshot,
+                            uint8_t * const p_buffer,
+                            size_t const size,
+                            size_t * const p_written)
+{
+        uint8_t raw[RAW_SIZE];
+        size_t length;
+        bool const success = ((NULL != p_snapshot) &&
+                              (NULL != p_buffer) &&
+                              (NULL != p_written) &&
+                              (TELEMETRY_FRAME_SIZE_MAX <= size));
+
+        if (success) {
+                raw[0] = TELEMETRY_FRAME_TYPE_SNAPSHOT;
+                byte_codec_put_u16(&raw[1], p_snapshot->sequence);
+                byte_codec_put_u32(&raw[3], p_snapshot->time_ms);
+                byte_codec_put_u16(&raw[7], p_snapshot->temperature);
+                byte_codec_put_u16(&raw[9], p_snapshot->setpoint);
+                raw[11] = p_snapshot->heater_duty;
+                raw[12] = p_snapshot->state;
+                raw[13] = p_snapshot->segment;
+                raw[14] = p_snapshot->flags;
+                byte_codec_put_u16(&raw[15], p_snapshot->period_ms);
+                byte_codec_put_u16(&raw[17], p_snapshot->update_us);
+                byte_codec_put_u16(&raw[TELEMETRY_FRAME_PAYLOAD_SIZE],
+                                   byte_codec_crc16(raw,
+                                                    TELEMETRY_FRAME_PAYLOAD_SIZE));
+
+                p_buffer[0] = TELEMETRY_FRAME_DELIMITER;
+                length = 1 + cobs_encode(raw, sizeof(raw), &p_buffer[1]);
+                p_buffer[length++] = TELEMETRY_FRAME_DELIMITER;
+
+                *p_written = length;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Decode a snapshot frame
+ *
+ * @param[in]           p_buffer            Bytes received between two
+ *                                          delimiters, not included
+ * @param[in]           size                Number of bytes
+ * @param[out]          p_snapshot          Pointer where to store the snapshot
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, or the bytes
+ *                                          are not a valid snapshot frame
+ */
+bool telemetry_frame_decode(uint8_t const * const p_buffer,
+                            size_t const size,
+                            telemetry_snapshot_t * const p_snapshot)
+{
+        uint8_t raw[RAW_SIZE];
+        size_t length = 0;
+        bool success = ((NULL != p_buffer) && (NULL != p_snapshot));
+
+        if (success) {
+                success = ((cobs_decode(p_buffer, size, raw, sizeof(raw), &length)) &&
+                           (RAW_SIZE == length) &&
+                           (TELEMETRY_FRAME_TYPE_SNAPSHOT == raw[0]) &&
+                           (byte_codec_get_u16(&raw[TELEMETRY_FRAME_PAYLOAD_SIZE]) ==
+                            byte_codec_crc16(raw, TELEMETRY_FRAME_PAYLOAD_SIZE)));
+        }
+
+        if (success) {
+                p_snapshot->sequence = byte_codec_get_u16(&raw[1]);
+                p_snapshot->time_ms = byte_codec_get_u32(&raw[3]);
+                p_snapshot->temperature = byte_codec_get_u16(&raw[7]);
+                p_snapshot->setpoint = byte_codec_get_u16(&raw[9]);
+                p_snapshot->heater_duty = raw[11];
+                p_snapshot->state = raw[12];
+                p_snapshot->segment = raw[13];
+                p_snapshot->flags = raw[14];
+                p_snapshot->period_ms = byte_codec_get_u16(&raw[15]);
+                p_snapshot->update_us = byte_codec_get_u16(&raw[17]);
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Byte stuff a buffer with COBS
+ *
+ * @param[in]           p_input             Bytes to stuff
+ * @param[in]           size                Number of bytes
+ * @param[out]          p_output            Buffer of at least `size` plus one
+ *                                          byte every 254 where to write them
+ *
+ * @return              size_t              Number of bytes written
+ */
+static size_t cobs_encode(uint8_t const * const p_input,
+                          size_t const size,
+                          uint8_t * const p_output)
+{
+        size_t code_index = 0;
+        size_t length = 1;
+        uint8_t code = 1;
+        size_t i;
+
+        for (i = 0; size > i; i++) {
+                if (0 != p_input[i]) {
+                        p_output[length++] = p_input[i];
+                        code++;
+                }
+
+                if ((0 == p_input[i]) || (COBS_CODE_MAX == code)) {
+                        p_output[code_index] = code;
+                        code_index = length++;
+                        code = 1;
+                }
+        }
+
+        p_output[code_index] = code;
+
+        return length;
+}
+
+/*!
+ * @brief Undo the COBS byte stuffing of a buffer
+ *
+ * @param[in]           p_input             Stuffed bytes, without delimiters
+ * @param[in]           size                Number of stuffed bytes
+ * @param[out]          p_output            Buffer where to write the bytes
+ * @param[in]           output_size         Size of the buffer
+ * @param[out]          p_length            Pointer where to store the number
+ *                                          of bytes written
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If the bytes are not valid COBS,
+ *                                          or don't fit in the buffer
+ */
+static bool cobs_decode(uint8_t const * const p_input,
+                        size_t const size,
+                        uint8_t * const p_output,
+                        size_t const output_size,
+                        size_t * const p_length)
+{
+        size_t length = 0;
+        size_t i = 0;
+        uint8_t code;
+        uint8_t j;
+        bool success = (0 != size);
+
+        while ((success) && (size > i)) {
+                code = p_input[i++];
+                success = ((0 != code) && (size >= (i + code - 1)));
+
+                for (j = 1; (success) && (code > j); j++) {
+                        success = ((0 != p_input[i]) && (output_size > length));
+
+                        if (success) {
+                                p_output[length++] = p_input[i++];
+                        }
+                }
+
+                // The zero implied by the last code isn't part of the data
+                if ((success) && (COBS_CODE_MAX != code) && (size > i)) {
+                        success = (output_size > length);
+
+                        if (success) {
+                                p_output[length++] = 0;
+                        }
+                }
+        }
+
+        if (success) {
+                *p_length = length;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
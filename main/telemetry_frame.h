@@ -0,0 +1,128 @@
+/*!
+ *******************************************************************************
+ * @file telemetry_frame.h
+ *
+ * @brief Binary frames of the telemetry stream, checked with a CRC and byte
+ *        stuffed with COBS
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Byte delimiting the frames, never found inside of them
+#define TELEMETRY_FRAME_DELIMITER                       (0x00)
+
+//! @brief Size in bytes of a snapshot payload, type included
+#define TELEMETRY_FRAME_PAYLOAD_SIZE                    (19)
+
+//! @brief Size in bytes of an encoded frame, delimiters included: payload,
+//!        CRC, COBS overhead byte and both delimiters
+#define TELEMETRY_FRAME_SIZE_MAX                        \
+        (TELEMETRY_FRAME_PAYLOAD_SIZE + 2 + 1 + 2)
+
+//! @brief The run is holding the target of its segment
+#define TELEMETRY_SNAPSHOT_FLAG_HOLDING                 (1 << 0)
+
+//! @brief The heater control is active
+#define TELEMETRY_SNAPSHOT_FLAG_HEATER_RUNNING          (1 << 1)
+
+//! @brief The heater is physically powered
+#define TELEMETRY_SNAPSHOT_FLAG_HEATER_POWERED          (1 << 2)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Type of a frame, its first byte
+typedef enum {
+        //! @brief Snapshot of the controller
+        TELEMETRY_FRAME_TYPE_SNAPSHOT = 1,
+
+        //! @brief Fence member
+        TELEMETRY_FRAME_TYPE_COUNT
+} telemetry_frame_type_t;
+
+//! @brief Snapshot of the controller
+typedef struct {
+        //! @brief Order of the snapshot, gaps are snapshots dropped
+        uint16_t sequence;
+
+        //! @brief Time since boot of the temperature reading, in milliseconds
+        uint32_t time_ms;
+
+        //! @brief Temperature, in Celsius
+        uint16_t temperature;
+
+        //! @brief Target temperature of the heater, in Celsius
+        uint16_t setpoint;
+
+        //! @brief Percentage of heater control cycles powered since the
+        //!        previous snapshot
+        uint8_t heater_duty;
+
+        //! @brief State machine state
+        uint8_t state;
+
+        //! @brief Segment the run is at
+        uint8_t segment;
+
+        //! @brief `TELEMETRY_SNAPSHOT_FLAG_*` flags
+        uint8_t flags;
+
+        //! @brief Time since the previous temperature reading, in milliseconds
+        uint16_t period_ms;
+
+        //! @brief Time taken by the temperature reading, in microseconds
+        uint16_t update_us;
+} telemetry_snapshot_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Encode a snapshot as a frame
+bool telemetry_frame_encode(telemetry_snapshot_t const * const p_snapshot,
+                            uint8_t * const p_buffer,
+                            size_t const size,
+                            size_t * const p_written);
+
+//! @brief Decode a snapshot frame
+bool telemetry_frame_decode(uint8_t const * const p_buffer,
+                            size_t const size,
+                            telemetry_snapshot_t * const p_snapshot);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //TELEMETRY_FRAME_H
@@ -0,0 +1,201 @@
+/*!
+ *******************************************************************************
+ * @file telemetry_ring.c
+ *
+ * @brief Lock-free ring of telemetry snapshots, between a single producer and
+ *        a single consumer
+ *
+ * The producer only writes the head and the consumer only writes the tail,
+ * both free running counters, so neither ever waits for the other nor takes a
+ * lock: the control loop pushing snapshots is never held by the task sending
+ * them. Counters are published with release stores and read with acquire
+ * loads, so a snapshot is fully copied before it is seen on the other side,
+ * even from the other core.
+ *
+ * When the ring is full the new snapshot is dropped and counted, the ones
+ * already queued are kept.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "telemetry_ring.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Mask turning a counter into an index
+#define INDEX_MASK                          (TELEMETRY_RING_SIZE - 1)
+
+#if (0 != (TELEMETRY_RING_SIZE & INDEX_MASK))
+#error "TELEMETRY_RING_SIZE must be a power of 2"
+#endif
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Empty a ring
+ *
+ * @note Not to be called while the ring is in use
+ *
+ * @param[out]          p_ring              Pointer to the ring
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool telemetry_ring_init(telemetry_ring_t * const p_ring)
+{
+        bool const success = (NULL != p_ring);
+
+        if (success) {
+                (void)memset(p_ring, 0, sizeof(*p_ring));
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Add a snapshot to the ring, from the producer
+ *
+ * @param[in,out]       p_ring              Pointer to the ring
+ * @param[in]           p_snapshot          Pointer to the snapshot
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If a pointer is null, or the ring
+ *                                          was full and the snapshot was
+ *                                          dropped
+ */
+bool telemetry_ring_push(telemetry_ring_t * const p_ring,
+                         telemetry_snapshot_t const * const p_snapshot)
+{
+        uint32_t head = 0;
+        bool success = ((NULL != p_ring) && (NULL != p_snapshot));
+
+        if (success) {
+                head = p_ring->head;
+                success = (TELEMETRY_RING_SIZE >
+                           (head - __atomic_load_n(&p_ring->tail, __ATOMIC_ACQUIRE)));
+
+                if (!success) {
+                        p_ring->dropped_count++;
+                }
+        }
+
+        if (success) {
+                p_ring->snapshots[head & INDEX_MASK] = *p_snapshot;
+                __atomic_store_n(&p_ring->head, head + 1, __ATOMIC_RELEASE);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Take the oldest snapshot from the ring, from the consumer
+ *
+ * @param[in,out]       p_ring              Pointer to the ring
+ * @param[out]          p_snapshot          Pointer where to store the snapshot
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If a snapshot was taken
+ * @retval              False               If a pointer is null or the ring is
+ *                                          empty
+ */
+bool telemetry_ring_pop(telemetry_ring_t * const p_ring,
+                        telemetry_snapshot_t * const p_snapshot)
+{
+        uint32_t tail = 0;
+        bool success = ((NULL != p_ring) && (NULL != p_snapshot));
+
+        if (success) {
+                tail = p_ring->tail;
+                success = (__atomic_load_n(&p_ring->head, __ATOMIC_ACQUIRE) != tail);
+        }
+
+        if (success) {
+                *p_snapshot = p_ring->snapshots[tail & INDEX_MASK];
+                __atomic_store_n(&p_ring->tail, tail + 1, __ATOMIC_RELEASE);
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the number of snapshots dropped for lack of room
+ *
+ * @param[in]           p_ring              Pointer to the ring
+ *
+ * @return              uint32_t            Number of snapshots dropped, 0 if
+ *                                          pointer is null
+ */
+uint32_t telemetry_ring_get_dropped_count(telemetry_ring_t const * const p_ring)
+{
+        return ((NULL != p_ring) ?
+                __atomic_load_n(&p_ring->dropped_count, __ATOMIC_RELAXED) : 0);
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,89 @@
+/*!
+ *******************************************************************************
+ * @file telemetry_ring.h
+ *
+ * @brief Lock-free ring of telemetry snapshots, between a single producer and
+ *        a single consumer
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef TELEMETRY_RING_H
+#define TELEMETRY_RING_H
+
+#include "telemetry_frame.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Number of snapshots the ring holds, a power of 2
+#define TELEMETRY_RING_SIZE                             (16)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Ring of snapshots
+typedef struct {
+        //! @brief Snapshots, indexed by the counters modulo the size
+        telemetry_snapshot_t snapshots[TELEMETRY_RING_SIZE];
+
+        //! @brief Number of snapshots pushed, only written by the producer
+        uint32_t head;
+
+        //! @brief Number of snapshots popped, only written by the consumer
+        uint32_t tail;
+
+        //! @brief Number of snapshots dropped for lack of room, only written
+        //!        by the producer
+        uint32_t dropped_count;
+} telemetry_ring_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Empty a ring
+bool telemetry_ring_init(telemetry_ring_t * const p_ring);
+
+//! @brief Add a snapshot to the ring, from the producer
+bool telemetry_ring_push(telemetry_ring_t * const p_ring,
+                         telemetry_snapshot_t const * const p_snapshot);
+
+//! @brief Take the oldest snapshot from the ring, from the consumer
+bool telemetry_ring_pop(telemetry_ring_t * const p_ring,
+                        telemetry_snapshot_t * const p_snapshot);
+
+//! @brief Get the number of snapshots dropped for lack of room
+uint32_t telemetry_ring_get_dropped_count(telemetry_ring_t const * const p_ring);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //TELEMETRY_RING_H
@@ -26,11 +26,14 @@
 #include "driver/spi_master.h"
 #include "max6675_spi.h"
 #include <esp_log.h>
+#include <esp_timer.h>
 
 #include "state_machine/states/state_machine_states.h"
 #include "state_machine/state_machine.h"
-#include "reflow_profile.h"
 #include "maxim_max6675.h"
+#include "phase_guard.h"
+#include "run_report.h"
+#include "telemetry.h"
 #include "panic.h"
 #include "wdt.h"
 #include "configuration.h"
@@ -66,6 +69,11 @@
 //! @brief Update temperature value
 static bool thermocouple_update_temperature(void);
 
+//! @brief Start guarding a newly entered phase of the run
+static void thermocouple_start_phase_guard(state_machine_state_text_t const state,
+                                           reflow_program_t const * const p_program,
+                                           uint16_t const temperature);
+
 //! @brief Thermocouple internal task
 static void thermocouple_task(void * pvParameters);
 
@@ -90,6 +98,15 @@ static bool m_is_initialized = false;
 //! @brief Temperature tracking of the different thermocouples
 static int16_t m_temperatures[THERMOCOUPLE_COUNT];
 
+//! @brief Time in milliseconds of the last successful temperature update
+static uint32_t m_last_update_ms = 0;
+
+//! @brief Deadline and stall detection for the current phase
+static phase_guard_t m_phase_guard;
+
+//! @brief Whether the current segment ramps up (or cools down) to its target
+static bool m_is_segment_rising = true;
+
 //! @brief Collection of handles for the configured instances
 static max6675_handle_t m_max_6675_handles[THERMOCOUPLE_COUNT];
 
@@ -240,6 +257,33 @@ bool thermocouple_get_avg_temperature(uint16_t * const p_avg_temperature)
         return success;
 }
 
+/*!
+ * @brief Get the time of the last successful temperature update
+ *
+ * Allows other modules to detect a stalled sensor or a stalled thermocouple
+ * task, since the temperature value itself is kept when updates stop.
+ *
+ * @note The value is a single 32 bit word, so it is read atomically
+ *
+ * @param[out]          p_time_ms           Pointer where to store the time of
+ *                                          the last update in milliseconds
+ *                                          since the scheduler started
+ *
+ * @return              bool                Operation result
+ * @retval              true                Everything went well
+ * @retval              false               Null pointer passed or module not
+ *                                          initialized
+ */
+bool thermocouple_get_last_update_time(uint32_t * const p_time_ms)
+{
+        bool success = ((NULL != p_time_ms) && (m_is_initialized));
+
+        if (success) {
+                *p_time_ms = m_last_update_ms;
+        }
+
+        return success;
+}
 
 /*
  *******************************************************************************
@@ -299,9 +343,72 @@ static bool thermocouple_update_temperature(void)
                 success = (MAX6675_ERROR_SUCCESS == max6675_result);
         }
 
+        if (success) {
+                m_last_update_ms = pdTICKS_TO_MS(xTaskGetTickCount());
+        }
+
         return success;
 }
 
+/*!
+ * @brief Start guarding a newly entered phase of the run
+ *
+ * Ramping segments get a deadline and stall detection based on their ramp
+ * speed. Segments cooling down to their target and the cooling phase only get
+ * a deadline, the cooling time. Holding and other states aren't guarded.
+ *
+ * @param[in]           state               State machine state
+ * @param[in]           p_program           Program of the run
+ * @param[in]           temperature         Temperature when entering the phase
+ *
+ * @return              -                   -
+ */
+static void thermocouple_start_phase_guard(state_machine_state_text_t const state,
+                                           reflow_program_t const * const p_program,
+                                           uint16_t const temperature)
+{
+        uint32_t const now_ms = pdTICKS_TO_MS(xTaskGetTickCount());
+        uint32_t const cooling_time_ms = p_program->cooling_time_s * 1000;
+        reflow_program_segment_t const * p_segment;
+        bool is_holding = false;
+        uint8_t index = 0;
+
+        switch (state) {
+        case STATE_MACHINE_STATE_SEGMENT:
+                if ((!state_machine_states_get_segment(&index, &is_holding)) ||
+                    (is_holding)) {
+                        (void)phase_guard_stop(&m_phase_guard);
+                        break;
+                }
+
+                p_segment = &p_program->segments[index];
+                m_is_segment_rising = (p_segment->target_temperature >= temperature);
+
+                if (m_is_segment_rising) {
+                        (void)phase_guard_start_heating(&m_phase_guard,
+                                                        now_ms,
+                                                        temperature,
+                                                        p_segment->target_temperature,
+                                                        p_segment->ramp_speed);
+                } else {
+                        (void)phase_guard_start_timed(&m_phase_guard,
+                                                      now_ms,
+                                                      cooling_time_ms);
+                }
+                break;
+
+        case STATE_MACHINE_STATE_COOLING:
+                (void)phase_guard_start_timed(&m_phase_guard,
+                                              now_ms,
+                                              cooling_time_ms);
+                break;
+
+        default:
+                (void)phase_guard_stop(&m_phase_guard);
+                break;
+        }
+}
+
 /*
  *******************************************************************************
  * Interrupt Service Routines / Tasks / Thread Main Functions                  *
@@ -326,11 +433,21 @@ static bool thermocouple_update_temperature(void)
 void thermocouple_task(void * pvParameters)
 {
         thermocouple_refresh_rate_t refresh_rate = THERMOCOUPLE_REFRESH_RATE_1_HZ;
+        state_machine_state_text_t previous_state = STATE_MACHINE_STATE_COUNT;
+        uint8_t previous_segment = UINT8_MAX;
+        bool previous_is_holding = false;
+        phase_guard_result_t guard_result;
         bool success;
         state_machine_state_text_t state;
         state_machine_data_t data;
-        reflow_profile_t profile;
+        reflow_program_t const * p_program;
+        reflow_program_segment_t const * p_segment;
+        uint8_t segment = UINT8_MAX;
+        bool is_holding = false;
+        bool is_target_reached;
         uint16_t avg_temperature;
+        int64_t update_start_us;
+        uint32_t update_us;
 
         (void)pvParameters;
 
@@ -344,7 +461,9 @@ void thermocouple_task(void * pvParameters)
                  */
                 vTaskDelay(refresh_rate);
 
+                update_start_us = esp_timer_get_time();
                 success = thermocouple_update_temperature();
+                update_us = (uint32_t)(esp_timer_get_time() - update_start_us);
 
                 if (success) {
                         success = thermocouple_get_avg_temperature(&avg_temperature);
@@ -352,7 +471,7 @@ void thermocouple_task(void * pvParameters)
                 }
 
                 if (success) {
-                        success = reflow_profile_get_current(&profile);
+                        success = state_machine_states_get_program(&p_program);
                 }
 
                 if (success) {
@@ -362,25 +481,63 @@ void thermocouple_task(void * pvParameters)
                         break;
                 }
 
+                if (!state_machine_states_get_segment(&segment, &is_holding)) {
+                        segment = UINT8_MAX;
+                }
+
+                if ((state != previous_state) ||
+                    (segment != previous_segment) ||
+                    (is_holding != previous_is_holding)) {
+                        thermocouple_start_phase_guard(state, p_program,
+                                                       avg_temperature);
+                        previous_state = state;
+                        previous_segment = segment;
+                        previous_is_holding = is_holding;
+                }
+
+                (void)run_report_update(state, segment, is_holding,
+                                        avg_temperature);
+
+                // Dropped snapshots only leave a gap in the stream
+                (void)telemetry_sample(state, segment, is_holding,
+                                       avg_temperature, update_us);
+
+                guard_result = phase_guard_check(&m_phase_guard,
+                                                 pdTICKS_TO_MS(xTaskGetTickCount()),
+                                                 avg_temperature);
+
                 switch (state) {
-                case STATE_MACHINE_STATE_HEATING:
-                        if (profile.preheat_temperature <= avg_temperature) {
-                                data.message = STATE_MACHINE_MSG_HEATER_PREHEAT_TARGET_REACHED;
+                case STATE_MACHINE_STATE_SEGMENT:
+                        if ((UINT8_MAX == segment) || (is_holding)) {
+                                // Hold time is measured by the reflow timer
+                                break;
                         }
-                        refresh_rate = THERMOCOUPLE_REFRESH_RATE_4_HZ;
-                        break;
 
+                        p_segment = &p_program->segments[segment];
+
+                        if (m_is_segment_rising) {
+                                is_target_reached = (p_segment->target_temperature <=
+                                                     avg_temperature);
+                        } else {
+                                is_target_reached = (p_segment->target_temperature >=
+                                                     avg_temperature);
+                        }
 
-                case STATE_MACHINE_STATE_REFLOW:
-                        if (profile.reflow_temperature <= avg_temperature) {
-                                data.message = STATE_MACHINE_MSG_HEATER_REFLOW_TARGET_REACHED;
+                        if (is_target_reached) {
+                                data.message = STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED;
+                        } else if (PHASE_GUARD_RESULT_TIMEOUT == guard_result) {
+                                data.message = STATE_MACHINE_MSG_HEATER_TIMEOUT;
+                        } else if (PHASE_GUARD_RESULT_TOO_SLOW == guard_result) {
+                                data.message = STATE_MACHINE_MSG_HEATER_TOO_SLOW;
                         }
                         refresh_rate = THERMOCOUPLE_REFRESH_RATE_4_HZ;
                         break;
 
                 case STATE_MACHINE_STATE_COOLING:
-                        if (profile.cooling_temperature >= avg_temperature) {
+                        if (p_program->cooling_temperature >= avg_temperature) {
                                 data.message = STATE_MACHINE_MSG_HEATER_COOLING_TARGET_REACHED;
+                        } else if (PHASE_GUARD_RESULT_TIMEOUT == guard_result) {
+                                data.message = STATE_MACHINE_MSG_HEATER_COOLING_TIMEOUT;
                         }
                         refresh_rate = THERMOCOUPLE_REFRESH_RATE_4_HZ;
                         break;
@@ -392,8 +549,7 @@ void thermocouple_task(void * pvParameters)
                         break;
 
                         // Intentionally fall through
-                case STATE_MACHINE_STATE_SOAKING:
-                case STATE_MACHINE_STATE_DWELL:
+                case STATE_MACHINE_STATE_PAUSED:
                 default:
                         break;
                 }
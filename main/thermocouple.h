@@ -78,6 +78,9 @@ bool thermocouple_get_temperature(thermocouple_id_t const id,
 
 bool thermocouple_get_avg_temperature(uint16_t * const p_avg_temperature);
 
+//! @brief Get the time of the last successful temperature update
+bool thermocouple_get_last_update_time(uint32_t * const p_time_ms);
+
 #ifdef __cplusplus
 }
 #endif // #ifdef __cplusplus
@@ -0,0 +1,63 @@
+/*!
+ *******************************************************************************
+ * @file byte_codec_tests.cpp
+ *
+ * @brief Checks on the little endian fields and CRC-16 of the binary formats
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+#include "byte_codec.h"
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(byte_codec)
+{
+};
+
+TEST(byte_codec, crc_matches_reference)
+{
+        uint8_t const check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+        UNSIGNED_LONGS_EQUAL(0x29B1, byte_codec_crc16(check, sizeof(check)));
+        UNSIGNED_LONGS_EQUAL(0xFFFF, byte_codec_crc16(check, 0));
+}
+
+TEST(byte_codec, fields_are_little_endian)
+{
+        uint8_t buffer[5] = {0};
+
+        byte_codec_put_u16(&buffer[1], 0xA1B2);
+        BYTES_EQUAL(0x00, buffer[0]);
+        BYTES_EQUAL(0xB2, buffer[1]);
+        BYTES_EQUAL(0xA1, buffer[2]);
+        UNSIGNED_LONGS_EQUAL(0xA1B2, byte_codec_get_u16(&buffer[1]));
+
+        // Unaligned on purpose
+        byte_codec_put_u32(&buffer[1], 0xC3D4E5F6);
+        BYTES_EQUAL(0xF6, buffer[1]);
+        BYTES_EQUAL(0xE5, buffer[2]);
+        BYTES_EQUAL(0xD4, buffer[3]);
+        BYTES_EQUAL(0xC3, buffer[4]);
+        UNSIGNED_LONGS_EQUAL(0xC3D4E5F6, byte_codec_get_u32(&buffer[1]));
+}
@@ -0,0 +1,265 @@
+/*!
+ *******************************************************************************
+ * @file deferred_log_tests.cpp
+ *
+ * @brief Checks on the deferred log ring, and a benchmark of storing a record
+ *        against formatting it, built when benchmarks are printed
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#if TESTS_PRINT_BENCHMARKS
+#include <chrono>
+#endif // #if TESTS_PRINT_BENCHMARKS
+#include <cstdio>
+#include <cstring>
+
+#include "CppUTest/TestHarness.h"
+
+#include "deferred_log_ring.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Number of records of the benchmark
+#define BENCHMARK_ITERATIONS                (1000000)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Format of the records, as the hottest log of the state machine
+static char const m_format[] = "Got event %d";
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+#if TESTS_PRINT_BENCHMARKS
+static double elapsed_s(std::chrono::steady_clock::time_point const start)
+{
+        std::chrono::duration<double> const elapsed =
+                std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+}
+#endif // #if TESTS_PRINT_BENCHMARKS
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(deferred_log_ring)
+{
+        deferred_log_ring_t ring;
+        deferred_log_record_t record;
+
+        void setup()
+        {
+                CHECK_TRUE(deferred_log_ring_init(&ring));
+                memset(&record, 0, sizeof(record));
+                record.p_format = m_format;
+                record.arg_count = 1;
+        }
+};
+
+TEST(deferred_log_ring, records_come_out_in_order)
+{
+        deferred_log_record_t popped;
+        int32_t next_pushed = 0;
+        int32_t next_popped = 0;
+        size_t i;
+
+        // Wraps the ring around several times, half full on average
+        for (i = 0; (8 * DEFERRED_LOG_RING_SIZE) > i; i++) {
+                record.time_ms = (uint32_t)i;
+                record.args[0] = next_pushed++;
+                CHECK_TRUE(deferred_log_ring_push(&ring, &record));
+
+                if ((DEFERRED_LOG_RING_SIZE / 2) <= (next_pushed - next_popped)) {
+                        CHECK_TRUE(deferred_log_ring_pop(&ring, &popped));
+                        LONGS_EQUAL(next_popped++, popped.args[0]);
+                        POINTERS_EQUAL(m_format, popped.p_format);
+                }
+        }
+
+        while (deferred_log_ring_pop(&ring, &popped)) {
+                LONGS_EQUAL(next_popped++, popped.args[0]);
+        }
+
+        LONGS_EQUAL(next_pushed, next_popped);
+        UNSIGNED_LONGS_EQUAL(0, deferred_log_ring_get_dropped_count(&ring));
+}
+
+TEST(deferred_log_ring, full_ring_drops_new_records)
+{
+        deferred_log_record_t popped;
+        int32_t i;
+
+        for (i = 0; (DEFERRED_LOG_RING_SIZE + 5) > i; i++) {
+                record.args[0] = i;
+                CHECK_EQUAL((DEFERRED_LOG_RING_SIZE > i),
+                            deferred_log_ring_push(&ring, &record));
+        }
+
+        UNSIGNED_LONGS_EQUAL(5, deferred_log_ring_get_dropped_count(&ring));
+
+        // Popping makes room for one more
+        CHECK_TRUE(deferred_log_ring_pop(&ring, &popped));
+        LONGS_EQUAL(0, popped.args[0]);
+        CHECK_TRUE(deferred_log_ring_push(&ring, &record));
+        CHECK_FALSE(deferred_log_ring_push(&ring, &record));
+        UNSIGNED_LONGS_EQUAL(6, deferred_log_ring_get_dropped_count(&ring));
+}
+
+TEST(deferred_log_ring, preempted_producer_only_holds_the_consumer)
+{
+        deferred_log_record_t popped;
+
+        // A producer claims the first position and is preempted before
+        // writing its record
+        ring.head++;
+
+        record.args[0] = 1;
+        CHECK_TRUE(deferred_log_ring_push(&ring, &record));
+        CHECK_FALSE(deferred_log_ring_pop(&ring, &popped));
+
+        // It resumes and marks its record as written
+        ring.slots[0].record = record;
+        ring.slots[0].record.args[0] = 0;
+        ring.slots[0].sequence = 1;
+
+        CHECK_TRUE(deferred_log_ring_pop(&ring, &popped));
+        LONGS_EQUAL(0, popped.args[0]);
+        CHECK_TRUE(deferred_log_ring_pop(&ring, &popped));
+        LONGS_EQUAL(1, popped.args[0]);
+        CHECK_FALSE(deferred_log_ring_pop(&ring, &popped));
+}
+
+TEST(deferred_log_ring, invalid_input_fails)
+{
+        CHECK_FALSE(deferred_log_ring_init(NULL));
+        CHECK_FALSE(deferred_log_ring_push(NULL, &record));
+        CHECK_FALSE(deferred_log_ring_push(&ring, NULL));
+        CHECK_FALSE(deferred_log_ring_pop(NULL, &record));
+        CHECK_FALSE(deferred_log_ring_pop(&ring, NULL));
+        CHECK_FALSE(deferred_log_ring_pop(&ring, &record));
+        UNSIGNED_LONGS_EQUAL(0, deferred_log_ring_get_dropped_count(NULL));
+}
+
+#if TESTS_PRINT_BENCHMARKS
+TEST_GROUP(deferred_log_benchmark)
+{
+};
+
+/*!
+ * @test Store records as the hot paths do now, and format the same ones as
+ *       they did before
+ *
+ * @result - Every record stored comes out with its arguments
+ *         - Cost of both per call is printed
+ */
+TEST(deferred_log_benchmark, store_against_format)
+{
+        deferred_log_ring_t ring;
+        deferred_log_record_t record;
+        deferred_log_record_t popped;
+        char message[96];
+        std::chrono::steady_clock::time_point start;
+        double store_s;
+        double format_s;
+        size_t length = 0;
+        int32_t checksum = 0;
+        int32_t i;
+
+        CHECK_TRUE(deferred_log_ring_init(&ring));
+        memset(&record, 0, sizeof(record));
+        record.p_format = m_format;
+        record.arg_count = 1;
+
+        // The consumer keeps up, one record behind
+        start = std::chrono::steady_clock::now();
+
+        for (i = 0; BENCHMARK_ITERATIONS > i; i++) {
+                record.args[0] = i & 0xFF;
+                (void)deferred_log_ring_push(&ring, &record);
+                (void)deferred_log_ring_pop(&ring, &popped);
+                checksum += popped.args[0];
+        }
+
+        store_s = elapsed_s(start);
+        start = std::chrono::steady_clock::now();
+
+        for (i = 0; BENCHMARK_ITERATIONS > i; i++) {
+                length += (size_t)snprintf(message, sizeof(message),
+                                           "I (%u) %s: Got event %d\n",
+                                           (unsigned int)i,
+                                           "state_machine.c",
+                                           (int)(i & 0xFF));
+        }
+
+        format_s = elapsed_s(start);
+
+        UNSIGNED_LONGS_EQUAL(0, deferred_log_ring_get_dropped_count(&ring));
+        CHECK(0 < checksum);
+        CHECK(0 < length);
+
+        printf("\nbenchmark deferred log, %d records: store and take %.1f ns, "
+               "format %.1f ns per record (%.1fx)\n",
+               BENCHMARK_ITERATIONS,
+               (store_s * 1e9) / BENCHMARK_ITERATIONS,
+               (format_s * 1e9) / BENCHMARK_ITERATIONS,
+               format_s / store_s);
+}
+#endif // #if TESTS_PRINT_BENCHMARKS
@@ -0,0 +1,239 @@
+/*!
+ *******************************************************************************
+ * @file gui_chart_decimator_tests.cpp
+ *
+ * @brief Checks on the min/max decimation of the chart series
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <cstdint>
+
+#include "CppUTest/TestHarness.h"
+
+#include "gui/gui_chart_decimator.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Buckets of the graph chart
+#define BUCKET_COUNT                        (130)
+
+//! @brief Samples of a 10 minute run at 4 Hz
+#define RUN_SAMPLE_COUNT                    (2400)
+
+//! @brief Period of the samples of a run, in milliseconds
+#define RUN_SAMPLE_PERIOD_MS                (250)
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+//! @brief Temperature of a run, a slow ramp with a one sample spike every
+//!        so often, alternating up and down
+static int16_t run_temperature(uint32_t const sample)
+{
+        int16_t temperature = (int16_t)(25 + (sample / 10));
+
+        if (0 == (sample % 97)) {
+                temperature += ((0 == (sample % 2)) ? 40 : -40);
+        }
+
+        return temperature;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(gui_chart_decimator)
+{
+        gui_chart_decimator_t decimator;
+        gui_chart_decimator_change_t change;
+        uint16_t first_bucket;
+
+        void setup()
+        {
+                CHECK_TRUE(gui_chart_decimator_init(&decimator, BUCKET_COUNT, 1000));
+        }
+};
+
+TEST(gui_chart_decimator, extremes_are_kept_in_order)
+{
+        int16_t first;
+        int16_t second;
+
+        CHECK_TRUE(gui_chart_decimator_add(&decimator, 0, 50, &change, &first_bucket));
+        UNSIGNED_LONGS_EQUAL(GUI_CHART_DECIMATOR_CHANGE_FROM, change);
+        UNSIGNED_LONGS_EQUAL(0, first_bucket);
+
+        // Within the extremes, nothing to redraw
+        CHECK_TRUE(gui_chart_decimator_add(&decimator, 250, 50, &change, &first_bucket));
+        UNSIGNED_LONGS_EQUAL(GUI_CHART_DECIMATOR_CHANGE_NONE, change);
+
+        CHECK_TRUE(gui_chart_decimator_add(&decimator, 500, 70, &change, &first_bucket));
+        CHECK_TRUE(gui_chart_decimator_add(&decimator, 750, 30, &change, &first_bucket));
+        UNSIGNED_LONGS_EQUAL(GUI_CHART_DECIMATOR_CHANGE_FROM, change);
+        UNSIGNED_LONGS_EQUAL(0, first_bucket);
+
+        CHECK_TRUE(gui_chart_decimator_get_points(&decimator, 0, &first, &second));
+        LONGS_EQUAL(70, first);
+        LONGS_EQUAL(30, second);
+
+        CHECK_TRUE(gui_chart_decimator_add(&decimator, 999, 80, &change, &first_bucket));
+        CHECK_TRUE(gui_chart_decimator_get_points(&decimator, 0, &first, &second));
+        LONGS_EQUAL(30, first);
+        LONGS_EQUAL(80, second);
+        UNSIGNED_LONGS_EQUAL(1, decimator.filled_count);
+}
+
+TEST(gui_chart_decimator, skipped_buckets_take_the_next_sample)
+{
+        int16_t first;
+        int16_t second;
+
+        CHECK_TRUE(gui_chart_decimator_add(&decimator, 0, 50, &change, &first_bucket));
+        CHECK_TRUE(gui_chart_decimator_add(&decimator, 3500, 60, &change, &first_bucket));
+        UNSIGNED_LONGS_EQUAL(GUI_CHART_DECIMATOR_CHANGE_FROM, change);
+        UNSIGNED_LONGS_EQUAL(1, first_bucket);
+        UNSIGNED_LONGS_EQUAL(4, decimator.filled_count);
+
+        CHECK_TRUE(gui_chart_decimator_get_points(&decimator, 2, &first, &second));
+        LONGS_EQUAL(60, first);
+        LONGS_EQUAL(60, second);
+        CHECK_FALSE(gui_chart_decimator_get_points(&decimator, 4, &first, &second));
+}
+
+TEST(gui_chart_decimator, full_chart_merges_buckets)
+{
+        int16_t first;
+        int16_t second;
+        uint32_t i;
+
+        for (i = 0; BUCKET_COUNT > i; i++) {
+                CHECK_TRUE(gui_chart_decimator_add(&decimator, i * 1000,
+                                                   (int16_t)(((i % 2) == 0) ? i : -(int16_t)i),
+                                                   &change, &first_bucket));
+                UNSIGNED_LONGS_EQUAL(GUI_CHART_DECIMATOR_CHANGE_FROM, change);
+        }
+
+        CHECK_TRUE(gui_chart_decimator_add(&decimator, BUCKET_COUNT * 1000, 500,
+                                           &change, &first_bucket));
+        UNSIGNED_LONGS_EQUAL(GUI_CHART_DECIMATOR_CHANGE_ALL, change);
+        UNSIGNED_LONGS_EQUAL(0, first_bucket);
+        UNSIGNED_LONGS_EQUAL(2000, decimator.bucket_span);
+        UNSIGNED_LONGS_EQUAL((BUCKET_COUNT / 2) + 1, decimator.filled_count);
+
+        // Buckets 2 and 3 were 2 then -3
+        CHECK_TRUE(gui_chart_decimator_get_points(&decimator, 1, &first, &second));
+        LONGS_EQUAL(2, first);
+        LONGS_EQUAL(-3, second);
+
+        CHECK_TRUE(gui_chart_decimator_get_points(&decimator, BUCKET_COUNT / 2,
+                                                  &first, &second));
+        LONGS_EQUAL(500, first);
+        LONGS_EQUAL(500, second);
+}
+
+/*!
+ * @test Feed a 10 minute run with one sample spikes, and compare the buckets
+ *       with the extremes of the samples falling in each of them
+ *
+ * @result - The run fits in the buckets, at any point of it
+ *         - Every bucket holds the extremes of its samples, so every spike
+ *           shows
+ */
+TEST(gui_chart_decimator, long_run_keeps_the_peaks)
+{
+        int16_t first;
+        int16_t second;
+        int16_t min;
+        int16_t max;
+        int16_t temperature;
+        uint32_t sample;
+        uint32_t span_samples;
+        uint32_t compaction_count = 0;
+        uint16_t i;
+
+        CHECK_TRUE(gui_chart_decimator_init(&decimator, BUCKET_COUNT, 1000));
+
+        for (sample = 0; RUN_SAMPLE_COUNT > sample; sample++) {
+                CHECK_TRUE(gui_chart_decimator_add(&decimator,
+                                                   sample * RUN_SAMPLE_PERIOD_MS,
+                                                   run_temperature(sample),
+                                                   &change, &first_bucket));
+                CHECK(BUCKET_COUNT >= decimator.filled_count);
+
+                if (GUI_CHART_DECIMATOR_CHANGE_ALL == change) {
+                        compaction_count++;
+                } else if (GUI_CHART_DECIMATOR_CHANGE_FROM == change) {
+                        CHECK(decimator.filled_count > first_bucket);
+                }
+        }
+
+        // 600 s in 130 buckets of 1, 2, 4 and then 8 s
+        UNSIGNED_LONGS_EQUAL(3, compaction_count);
+        UNSIGNED_LONGS_EQUAL(8000, decimator.bucket_span);
+
+        span_samples = decimator.bucket_span / RUN_SAMPLE_PERIOD_MS;
+        UNSIGNED_LONGS_EQUAL((RUN_SAMPLE_COUNT + span_samples - 1) / span_samples,
+                             decimator.filled_count);
+
+        for (i = 0; decimator.filled_count > i; i++) {
+                min = INT16_MAX;
+                max = INT16_MIN;
+
+                for (sample = i * span_samples;
+                     ((i + 1) * span_samples > sample) && (RUN_SAMPLE_COUNT > sample);
+                     sample++) {
+                        temperature = run_temperature(sample);
+                        min = ((temperature < min) ? temperature : min);
+                        max = ((temperature > max) ? temperature : max);
+                }
+
+                CHECK_TRUE(gui_chart_decimator_get_points(&decimator, i, &first, &second));
+                LONGS_EQUAL(min, ((first < second) ? first : second));
+                LONGS_EQUAL(max, ((first > second) ? first : second));
+        }
+}
+
+TEST(gui_chart_decimator, invalid_input_fails)
+{
+        int16_t first;
+        int16_t second;
+
+        CHECK_FALSE(gui_chart_decimator_init(NULL, BUCKET_COUNT, 1000));
+        CHECK_FALSE(gui_chart_decimator_init(&decimator, 0, 1000));
+        CHECK_FALSE(gui_chart_decimator_init(&decimator,
+                                             GUI_CHART_DECIMATOR_BUCKETS_MAX + 1,
+                                             1000));
+        CHECK_FALSE(gui_chart_decimator_init(&decimator, BUCKET_COUNT, 0));
+
+        CHECK_FALSE(gui_chart_decimator_add(NULL, 0, 0, &change, &first_bucket));
+        CHECK_FALSE(gui_chart_decimator_add(&decimator, 0, 0, NULL, &first_bucket));
+        CHECK_FALSE(gui_chart_decimator_add(&decimator, 0, 0, &change, NULL));
+
+        CHECK_FALSE(gui_chart_decimator_get_points(NULL, 0, &first, &second));
+        CHECK_FALSE(gui_chart_decimator_get_points(&decimator, 0, NULL, &second));
+        CHECK_FALSE(gui_chart_decimator_get_points(&decimator, 0, &first, NULL));
+        CHECK_FALSE(gui_chart_decimator_get_points(&decimator, 0, &first, &second));
+}
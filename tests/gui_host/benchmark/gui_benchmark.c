@@ -0,0 +1,535 @@
+/*!
+ *******************************************************************************
+ * @file gui_benchmark.c
+ *
+ * @brief Render benchmark of the GUI screens and of the lv_examples benchmark
+ *        scenes, on the host display driver
+ *
+ * Each scene is rendered on `host_display` and reports its frames, the time
+ * taken per frame, the pixels sent per second and the LVGL heap used. Screens
+ * of the GUI are rendered both redrawn in full and as they are updated during
+ * a run. The lv_examples benchmark scenes are its "screen load" test, with its
+ * options turned on one after the other.
+ *
+ * Results are written to the standard output as CSV, one line per scene, to
+ * be compared against the ones of a previous build with
+ * `tools/gui_benchmark_compare.py`.
+ *
+ * @note Times are the ones of the host, and only comparable between runs on
+ *       the same machine. The heap holds 64-bit pointers here, so it is
+ *       fuller than on the controller.
+ *
+ * @note The host display flushes right away, so the time spent waiting on
+ *       the display link doesn't show here, and neither does the idle share
+ *       of the core running the GUI. Those come from the refresh statistics
+ *       of `gui`, on the controller.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lvgl.h"
+#include "lv_examples/lv_apps/benchmark/benchmark.h"
+#include "reflow_profile.h"
+#include "state_machine/states/state_machine_states.h"
+#include "state_machine/state_machine.h"
+#include "gui/gui.h"
+#include "gui/gui_views/gui_views_profile.h"
+#include "thermocouple_fake.h"
+#include "reflow_profile_fake.h"
+#include "state_machine_fake.h"
+#include "host_display.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Number of frames of the scenes redrawn in full
+#define FULL_REDRAW_COUNT                   (50)
+
+//! @brief Row the tab buttons are tapped at
+#define TAB_BUTTON_Y                        (10)
+
+//! @brief Time a tap is held for, and time given to the GUI to settle after
+//!        it, animations included
+#define TAP_TIME_MS                         (100)
+#define SETTLE_TIME_MS                      (1000)
+
+//! @brief Period of the temperature readings during a run
+#define READING_PERIOD_MS                   (250)
+
+//! @brief Length of the runs rendered, in milliseconds
+#define RUN_TIME_MS                         (60000)
+
+//! @brief Time given to the lv_examples benchmark to finish its test
+#define LV_BENCHMARK_TIMEOUT_MS             (10000)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Tabs of the GUI, in the order they are added by `gui_init`
+typedef enum {
+        TAB_MAIN = 0,
+        TAB_GRAPH,
+        TAB_PROFILE,
+        TAB_COUNT
+} tab_t;
+
+//! @brief Scene rendered by the benchmark
+typedef struct {
+        //! @brief Name of the scene, as reported
+        char const * p_name;
+
+        //! @brief Render the scene, after the statistics were reset
+        bool (*f_render)(void);
+} scene_t;
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+static bool render_main_full(void);
+
+static bool render_main_run(void);
+
+static bool render_graph_full(void);
+
+static bool render_graph_run(void);
+
+static bool render_profile_full(void);
+
+static bool render_editor_full(void);
+
+static bool render_lv_plain(void);
+
+static bool render_lv_wallpaper(void);
+
+static bool render_lv_recolor(void);
+
+static bool render_lv_shadow(void);
+
+static bool render_lv_opacity(void);
+
+//! @brief Let the time pass, keeping the peak of the LVGL heap used
+static void run(uint32_t const time_ms);
+
+//! @brief Tap the display at a point
+static void tap(lv_coord_t const x, lv_coord_t const y);
+
+//! @brief Tap the display at the center of an object
+static void tap_object(lv_obj_t const * const p_object);
+
+//! @brief Show a tab of the GUI
+static void show_tab(tab_t const tab);
+
+//! @brief Redraw the screen shown in full, a number of times
+static void redraw_full(void);
+
+//! @brief Render a run of the profile in use
+static void render_run(void);
+
+//! @brief Take a temperature reading, and give the GUI the time until the next
+static void read_temperature(uint16_t const temperature);
+
+//! @brief Tap a button of the lv_examples benchmark, by its text
+static bool tap_lv_button(char const * const p_text);
+
+//! @brief Run the lv_examples benchmark test
+static bool render_lv_benchmark(void);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Scenes, in the order they are rendered. Each of them starts where
+//!        the one before left the display
+static scene_t const m_scenes[] = {
+        {"main_full",           render_main_full},
+        {"main_run",            render_main_run},
+        {"graph_full",          render_graph_full},
+        {"graph_run",           render_graph_run},
+        {"profile_full",        render_profile_full},
+        {"editor_full",         render_editor_full},
+        {"lv_bench_plain",      render_lv_plain},
+        {"lv_bench_wallpaper",  render_lv_wallpaper},
+        {"lv_bench_recolor",    render_lv_recolor},
+        {"lv_bench_shadow",     render_lv_shadow},
+        {"lv_bench_opacity",    render_lv_opacity},
+};
+
+static size_t const m_scene_count = sizeof(m_scenes) / sizeof(m_scenes[0]);
+
+//! @brief Peak of the LVGL heap used during the scene, in bytes
+static uint32_t m_mem_max_used = 0;
+
+//! @brief Time of the last temperature reading
+static uint32_t m_reading_time_ms = 0;
+
+//! @brief Screen of the lv_examples benchmark, NULL until created
+static lv_obj_t * m_p_lv_screen = NULL;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Render every scene and write out their results as CSV
+ *
+ * @param               -                   -
+ *
+ * @return              int                 EXIT_SUCCESS if every scene
+ *                                          rendered any frame
+ */
+int main(void)
+{
+        host_display_stats_t stats;
+        lv_mem_monitor_t memory;
+        double render_s;
+        size_t i;
+        bool success = (NULL != host_display_get());
+
+        if (success) {
+                success = reflow_profile_fake_reset();
+        }
+
+        if (success) {
+                state_machine_fake_reset();
+                thermocouple_fake_set_temperature(25);
+                gui_init();
+                run(SETTLE_TIME_MS);
+
+                printf("scene,frames,ms_per_frame,max_ms_per_frame,"
+                       "pixels_per_s,mem_used_bytes,mem_max_used_bytes,"
+                       "mem_frag_pct\n");
+        }
+
+        for (i = 0; (success) && (m_scene_count > i); i++) {
+                host_display_reset_stats();
+                lv_mem_monitor(&memory);
+                m_mem_max_used = memory.total_size - memory.free_size;
+
+                success = m_scenes[i].f_render();
+
+                if (success) {
+                        (void)host_display_get_stats(&stats);
+                        lv_mem_monitor(&memory);
+                        success = (0 != stats.frame_count);
+                }
+
+                if (success) {
+                        render_s = (double)stats.render_us / 1e6;
+
+                        printf("%s,%u,%.3f,%.3f,%.0f,%u,%u,%u\n",
+                               m_scenes[i].p_name,
+                               stats.frame_count,
+                               (render_s * 1e3) / stats.frame_count,
+                               (double)stats.render_max_us / 1e3,
+                               (0.0 < render_s) ?
+                               ((double)stats.pixel_count / render_s) : 0.0,
+                               memory.total_size - memory.free_size,
+                               m_mem_max_used,
+                               memory.frag_pct);
+                } else {
+                        fprintf(stderr, "Scene %s rendered nothing\n",
+                                m_scenes[i].p_name);
+                }
+        }
+
+        return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+static bool render_main_full(void)
+{
+        show_tab(TAB_MAIN);
+        host_display_reset_stats();
+        redraw_full();
+
+        return true;
+}
+
+static bool render_main_run(void)
+{
+        render_run();
+
+        return true;
+}
+
+static bool render_graph_full(void)
+{
+        show_tab(TAB_GRAPH);
+        host_display_reset_stats();
+        redraw_full();
+
+        return true;
+}
+
+static bool render_graph_run(void)
+{
+        render_run();
+
+        return true;
+}
+
+static bool render_profile_full(void)
+{
+        show_tab(TAB_PROFILE);
+        host_display_reset_stats();
+        redraw_full();
+
+        return true;
+}
+
+static bool render_editor_full(void)
+{
+        lv_obj_t * p_window;
+
+        tap_object(p_edit_button);
+        host_display_reset_stats();
+        redraw_full();
+
+        // The editor window is the last object created on the screen
+        p_window = lv_obj_get_child(lv_scr_act(), NULL);
+        lv_obj_del(p_window);
+        run(SETTLE_TIME_MS);
+
+        return true;
+}
+
+static bool render_lv_plain(void)
+{
+        m_p_lv_screen = lv_obj_create(NULL, NULL);
+        lv_scr_load(m_p_lv_screen);
+        benchmark_create();
+        run(SETTLE_TIME_MS);
+
+        return render_lv_benchmark();
+}
+
+static bool render_lv_wallpaper(void)
+{
+        return ((tap_lv_button("Wallpaper")) && (render_lv_benchmark()));
+}
+
+static bool render_lv_recolor(void)
+{
+        return ((tap_lv_button("Wp. recolor!")) && (render_lv_benchmark()));
+}
+
+static bool render_lv_shadow(void)
+{
+        return ((tap_lv_button("Shadow")) && (render_lv_benchmark()));
+}
+
+static bool render_lv_opacity(void)
+{
+        return ((tap_lv_button("Opacity")) && (render_lv_benchmark()));
+}
+
+/*!
+ * @brief Let the time pass, keeping the peak of the LVGL heap used
+ *
+ * @param[in]           time_ms             Time to pass, in milliseconds
+ *
+ * @return              -                   -
+ */
+static void run(uint32_t const time_ms)
+{
+        lv_mem_monitor_t memory;
+        uint32_t used;
+        uint32_t i;
+
+        for (i = 0; time_ms > i; i++) {
+                host_display_run(1);
+                lv_mem_monitor(&memory);
+                used = memory.total_size - memory.free_size;
+
+                if (m_mem_max_used < used) {
+                        m_mem_max_used = used;
+                }
+        }
+}
+
+static void tap(lv_coord_t const x, lv_coord_t const y)
+{
+        host_display_press(x, y);
+        run(TAP_TIME_MS);
+        host_display_release();
+        run(SETTLE_TIME_MS);
+}
+
+static void tap_object(lv_obj_t const * const p_object)
+{
+        lv_area_t coords;
+
+        lv_obj_get_coords(p_object, &coords);
+        tap((coords.x1 + coords.x2) / 2, (coords.y1 + coords.y2) / 2);
+}
+
+static void show_tab(tab_t const tab)
+{
+        tap((lv_coord_t)((LV_HOR_RES_MAX * ((2 * tab) + 1)) / (2 * TAB_COUNT)),
+            TAB_BUTTON_Y);
+}
+
+/*!
+ * @brief Redraw the screen shown in full, a number of times
+ *
+ * A frame is drawn on every refresh period, as when the screen is loaded.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void redraw_full(void)
+{
+        uint32_t i;
+
+        for (i = 0; FULL_REDRAW_COUNT > i; i++) {
+                lv_obj_invalidate(lv_scr_act());
+                run(LV_DISP_DEF_REFR_PERIOD);
+        }
+}
+
+/*!
+ * @brief Render a run of the profile in use, on the tab shown
+ *
+ * The temperature is read every `READING_PERIOD_MS` and rises at 2 Celsius
+ * per second. The state machine is left idle after.
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+static void render_run(void)
+{
+        uint32_t run_time_ms;
+
+        state_machine_fake_set_state(STATE_MACHINE_STATE_SEGMENT);
+
+        for (run_time_ms = 0; RUN_TIME_MS > run_time_ms; run_time_ms += READING_PERIOD_MS) {
+                state_machine_fake_set_run(run_time_ms, 0, false);
+                read_temperature((uint16_t)(25 + (run_time_ms / 500)));
+        }
+
+        // The GUI only sees the run ended on the next reading
+        state_machine_fake_set_state(STATE_MACHINE_STATE_IDLE);
+        read_temperature(25);
+        run(SETTLE_TIME_MS);
+}
+
+/*!
+ * @brief Take a temperature reading, and give the GUI the time until the next
+ *
+ * @param[in]           temperature         Temperature read, in Celsius
+ *
+ * @return              -                   -
+ */
+static void read_temperature(uint16_t const temperature)
+{
+        m_reading_time_ms += READING_PERIOD_MS;
+        thermocouple_fake_set_temperature(temperature);
+        thermocouple_fake_set_last_update_time(m_reading_time_ms);
+        run(READING_PERIOD_MS);
+}
+
+/*!
+ * @brief Tap a button of the lv_examples benchmark, by its text
+ *
+ * @param[in]           p_text              Text of the button
+ *
+ * @return              bool                Whether the button was found
+ */
+static bool tap_lv_button(char const * const p_text)
+{
+        lv_obj_t * const p_page = lv_obj_get_child(m_p_lv_screen, NULL);
+        lv_obj_t * p_child = NULL;
+        lv_obj_t * p_label = NULL;
+        lv_obj_t * p_button = NULL;
+
+        // Buttons are laid out on the scrollable part of the page
+        while ((NULL == p_button) &&
+               (NULL != (p_child = lv_obj_get_child(lv_page_get_scrl(p_page),
+                                                    p_child)))) {
+                p_label = lv_obj_get_child(p_child, NULL);
+
+                if ((NULL != p_label) &&
+                    (0 == strcmp(p_text, lv_label_get_text(p_label)))) {
+                        p_button = p_child;
+                }
+        }
+
+        if (NULL != p_button) {
+                tap_object(p_button);
+        }
+
+        return (NULL != p_button);
+}
+
+/*!
+ * @brief Run the lv_examples benchmark test, only its frames are accounted
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Whether the test finished in time
+ */
+static bool render_lv_benchmark(void)
+{
+        uint32_t time_ms = 0;
+
+        host_display_reset_stats();
+        benchmark_start();
+
+        while ((!benchmark_is_ready()) && (LV_BENCHMARK_TIMEOUT_MS > time_ms)) {
+                run(1);
+                time_ms++;
+        }
+
+        return benchmark_is_ready();
+}
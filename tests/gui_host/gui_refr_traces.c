@@ -0,0 +1,369 @@
+/*!
+ *******************************************************************************
+ * @file gui_refr_traces.c
+ *
+ * @brief Invalidated areas of the display refreshes recorded on the GUI
+ *
+ * Recorded on the host, by logging the areas LVGL held at every refresh
+ * while our screens went through the uses below, with the temperature
+ * readings and the run faked. LVGL only drops the areas lying inside one
+ * held already, so these are the areas `lv_refr_join_area` is given.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gui_refr_traces.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Trace entry of an array of refreshes
+#define TRACE(name, refreshes)              {(name), (refreshes), \
+                                             sizeof(refreshes) / sizeof(refreshes[0])}
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+//! @brief Main tab while idle, a reading a second
+static int16_t const m_main_idle[] = {
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        3, 167, 111, 229, 158, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+};
+
+//! @brief Main tab during a run, four readings a second and the state changing
+static int16_t const m_main_run[] = {
+        5, 39, 103, 91, 126, 12, 210, 117, 224, 5, 55, 304, 224,
+           5, 55, 304, 229, 305, 51, 309, 193,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        3, 167, 111, 229, 158, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        3, 167, 111, 229, 158, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        3, 167, 111, 229, 158, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        6, 39, 103, 91, 126, 33, 221, 97, 229, 12, 210, 117, 229,
+           129, 185, 199, 202, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        3, 167, 111, 229, 158, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        3, 167, 111, 229, 158, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        3, 167, 111, 229, 158, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+        2, 167, 111, 238, 158, 139, 64, 280, 205,
+};
+
+//! @brief Graph tab during the same run
+static int16_t const m_graph_run[] = {
+        4, 5, 0, 100, 49, 0, 50, 309, 229, 106, 45, 201, 49, 106, 0, 201, 49,
+        3, 56, 60, 61, 209, 55, 60, 60, 209, 57, 60, 62, 209,
+        3, 56, 60, 61, 209, 55, 60, 60, 209, 57, 60, 62, 209,
+        3, 56, 60, 61, 209, 55, 60, 60, 209, 57, 60, 62, 209,
+        3, 56, 60, 61, 209, 55, 60, 60, 209, 57, 60, 62, 209,
+        3, 56, 60, 61, 209, 55, 60, 60, 209, 57, 60, 62, 209,
+        3, 56, 60, 61, 209, 55, 60, 60, 209, 57, 60, 62, 209,
+        3, 56, 60, 61, 209, 55, 60, 60, 209, 57, 60, 62, 209,
+        3, 58, 60, 63, 209, 57, 60, 62, 209, 59, 60, 64, 209,
+        3, 58, 60, 63, 209, 57, 60, 62, 209, 59, 60, 64, 209,
+        3, 58, 60, 63, 209, 57, 60, 62, 209, 59, 60, 64, 209,
+        3, 58, 60, 63, 209, 57, 60, 62, 209, 59, 60, 64, 209,
+        3, 58, 60, 63, 209, 57, 60, 62, 209, 59, 60, 64, 209,
+        3, 58, 60, 63, 209, 57, 60, 62, 209, 59, 60, 64, 209,
+        3, 58, 60, 63, 209, 57, 60, 62, 209, 59, 60, 64, 209,
+        3, 60, 60, 65, 209, 59, 60, 64, 209, 61, 60, 66, 209,
+        3, 60, 60, 65, 209, 59, 60, 64, 209, 61, 60, 66, 209,
+        3, 60, 60, 65, 209, 59, 60, 64, 209, 61, 60, 66, 209,
+        3, 60, 60, 65, 209, 59, 60, 64, 209, 61, 60, 66, 209,
+        3, 60, 60, 65, 209, 59, 60, 64, 209, 61, 60, 66, 209,
+        3, 60, 60, 65, 209, 59, 60, 64, 209, 61, 60, 66, 209,
+        3, 60, 60, 65, 209, 59, 60, 64, 209, 61, 60, 66, 209,
+        3, 62, 60, 67, 209, 61, 60, 66, 209, 63, 60, 68, 209,
+        3, 62, 60, 67, 209, 61, 60, 66, 209, 63, 60, 68, 209,
+        3, 62, 60, 67, 209, 61, 60, 66, 209, 63, 60, 68, 209,
+        3, 62, 60, 67, 209, 61, 60, 66, 209, 63, 60, 68, 209,
+        3, 62, 60, 67, 209, 61, 60, 66, 209, 63, 60, 68, 209,
+        3, 62, 60, 67, 209, 61, 60, 66, 209, 63, 60, 68, 209,
+        3, 62, 60, 67, 209, 61, 60, 66, 209, 63, 60, 68, 209,
+        3, 62, 60, 67, 209, 61, 60, 66, 209, 63, 60, 68, 209,
+        3, 64, 60, 69, 209, 63, 60, 68, 209, 65, 60, 70, 209,
+        3, 64, 60, 69, 209, 63, 60, 68, 209, 65, 60, 70, 209,
+        3, 64, 60, 69, 209, 63, 60, 68, 209, 65, 60, 70, 209,
+        3, 64, 60, 69, 209, 63, 60, 68, 209, 65, 60, 70, 209,
+        3, 64, 60, 69, 209, 63, 60, 68, 209, 65, 60, 70, 209,
+        3, 64, 60, 69, 209, 63, 60, 68, 209, 65, 60, 70, 209,
+        3, 64, 60, 69, 209, 63, 60, 68, 209, 65, 60, 70, 209,
+        3, 66, 60, 71, 209, 65, 60, 70, 209, 67, 60, 72, 209,
+        3, 66, 60, 71, 209, 65, 60, 70, 209, 67, 60, 72, 209,
+        3, 66, 60, 71, 209, 65, 60, 70, 209, 67, 60, 72, 209,
+        3, 66, 60, 71, 209, 65, 60, 70, 209, 67, 60, 72, 209,
+        3, 66, 60, 71, 209, 65, 60, 70, 209, 67, 60, 72, 209,
+        3, 66, 60, 71, 209, 65, 60, 70, 209, 67, 60, 72, 209,
+        3, 66, 60, 71, 209, 65, 60, 70, 209, 67, 60, 72, 209,
+        3, 68, 60, 73, 209, 67, 60, 72, 209, 69, 60, 74, 209,
+        3, 68, 60, 73, 209, 67, 60, 72, 209, 69, 60, 74, 209,
+        3, 68, 60, 73, 209, 67, 60, 72, 209, 69, 60, 74, 209,
+        3, 68, 60, 73, 209, 67, 60, 72, 209, 69, 60, 74, 209,
+        3, 68, 60, 73, 209, 67, 60, 72, 209, 69, 60, 74, 209,
+        3, 68, 60, 73, 209, 67, 60, 72, 209, 69, 60, 74, 209,
+        3, 68, 60, 73, 209, 67, 60, 72, 209, 69, 60, 74, 209,
+        3, 70, 60, 75, 209, 69, 60, 74, 209, 71, 60, 76, 209,
+        3, 70, 60, 75, 209, 69, 60, 74, 209, 71, 60, 76, 209,
+        3, 70, 60, 75, 209, 69, 60, 74, 209, 71, 60, 76, 209,
+        3, 70, 60, 75, 209, 69, 60, 74, 209, 71, 60, 76, 209,
+        3, 70, 60, 75, 209, 69, 60, 74, 209, 71, 60, 76, 209,
+        3, 70, 60, 75, 209, 69, 60, 74, 209, 71, 60, 76, 209,
+        3, 70, 60, 75, 209, 69, 60, 74, 209, 71, 60, 76, 209,
+        3, 72, 60, 77, 209, 71, 60, 76, 209, 73, 60, 78, 209,
+        3, 72, 60, 77, 209, 71, 60, 76, 209, 73, 60, 78, 209,
+        3, 72, 60, 77, 209, 71, 60, 76, 209, 73, 60, 78, 209,
+        3, 72, 60, 77, 209, 71, 60, 76, 209, 73, 60, 78, 209,
+        3, 72, 60, 77, 209, 71, 60, 76, 209, 73, 60, 78, 209,
+        3, 72, 60, 77, 209, 71, 60, 76, 209, 73, 60, 78, 209,
+        3, 72, 60, 77, 209, 71, 60, 76, 209, 73, 60, 78, 209,
+        3, 74, 60, 79, 209, 73, 60, 78, 209, 75, 60, 80, 209,
+        3, 74, 60, 79, 209, 73, 60, 78, 209, 75, 60, 80, 209,
+        3, 74, 60, 79, 209, 73, 60, 78, 209, 75, 60, 80, 209,
+        3, 74, 60, 79, 209, 73, 60, 78, 209, 75, 60, 80, 209,
+        3, 74, 60, 79, 209, 73, 60, 78, 209, 75, 60, 80, 209,
+        3, 74, 60, 79, 209, 73, 60, 78, 209, 75, 60, 80, 209,
+        3, 74, 60, 79, 209, 73, 60, 78, 209, 75, 60, 80, 209,
+        3, 76, 60, 81, 209, 75, 60, 80, 209, 77, 60, 82, 209,
+        3, 76, 60, 81, 209, 75, 60, 80, 209, 77, 60, 82, 209,
+        3, 76, 60, 81, 209, 75, 60, 80, 209, 77, 60, 82, 209,
+        3, 76, 60, 81, 209, 75, 60, 80, 209, 77, 60, 82, 209,
+        3, 76, 60, 81, 209, 75, 60, 80, 209, 77, 60, 82, 209,
+        3, 76, 60, 81, 209, 75, 60, 80, 209, 77, 60, 82, 209,
+        3, 76, 60, 81, 209, 75, 60, 80, 209, 77, 60, 82, 209,
+        3, 78, 60, 83, 209, 77, 60, 82, 209, 79, 60, 84, 209,
+        3, 78, 60, 83, 209, 77, 60, 82, 209, 79, 60, 84, 209,
+        3, 78, 60, 83, 209, 77, 60, 82, 209, 79, 60, 84, 209,
+        3, 78, 60, 83, 209, 77, 60, 82, 209, 79, 60, 84, 209,
+        3, 78, 60, 83, 209, 77, 60, 82, 209, 79, 60, 84, 209,
+        3, 78, 60, 83, 209, 77, 60, 82, 209, 79, 60, 84, 209,
+        3, 78, 60, 83, 209, 77, 60, 82, 209, 79, 60, 84, 209,
+        3, 78, 60, 83, 209, 77, 60, 82, 209, 79, 60, 84, 209,
+        3, 80, 60, 85, 209, 79, 60, 84, 209, 81, 60, 86, 209,
+        3, 80, 60, 85, 209, 79, 60, 84, 209, 81, 60, 86, 209,
+        3, 80, 60, 85, 209, 79, 60, 84, 209, 81, 60, 86, 209,
+        3, 80, 60, 85, 209, 79, 60, 84, 209, 81, 60, 86, 209,
+        3, 80, 60, 85, 209, 79, 60, 84, 209, 81, 60, 86, 209,
+        3, 80, 60, 85, 209, 79, 60, 84, 209, 81, 60, 86, 209,
+        3, 80, 60, 85, 209, 79, 60, 84, 209, 81, 60, 86, 209,
+        3, 82, 60, 87, 209, 81, 60, 86, 209, 83, 60, 88, 209,
+        3, 82, 60, 87, 209, 81, 60, 86, 209, 83, 60, 88, 209,
+        3, 82, 60, 87, 209, 81, 60, 86, 209, 83, 60, 88, 209,
+        3, 82, 60, 87, 209, 81, 60, 86, 209, 83, 60, 88, 209,
+        3, 82, 60, 87, 209, 81, 60, 86, 209, 83, 60, 88, 209,
+        3, 82, 60, 87, 209, 81, 60, 86, 209, 83, 60, 88, 209,
+        3, 82, 60, 87, 209, 81, 60, 86, 209, 83, 60, 88, 209,
+        3, 84, 60, 89, 209, 83, 60, 88, 209, 85, 60, 90, 209,
+        3, 84, 60, 89, 209, 83, 60, 88, 209, 85, 60, 90, 209,
+        3, 84, 60, 89, 209, 83, 60, 88, 209, 85, 60, 90, 209,
+        3, 84, 60, 89, 209, 83, 60, 88, 209, 85, 60, 90, 209,
+        3, 84, 60, 89, 209, 83, 60, 88, 209, 85, 60, 90, 209,
+        3, 84, 60, 89, 209, 83, 60, 88, 209, 85, 60, 90, 209,
+        3, 84, 60, 89, 209, 83, 60, 88, 209, 85, 60, 90, 209,
+        3, 86, 60, 91, 209, 85, 60, 90, 209, 87, 60, 92, 209,
+        3, 86, 60, 91, 209, 85, 60, 90, 209, 87, 60, 92, 209,
+        3, 86, 60, 91, 209, 85, 60, 90, 209, 87, 60, 92, 209,
+        3, 86, 60, 91, 209, 85, 60, 90, 209, 87, 60, 92, 209,
+        3, 86, 60, 91, 209, 85, 60, 90, 209, 87, 60, 92, 209,
+        3, 86, 60, 91, 209, 85, 60, 90, 209, 87, 60, 92, 209,
+        3, 86, 60, 91, 209, 85, 60, 90, 209, 87, 60, 92, 209,
+        3, 88, 60, 93, 209, 87, 60, 92, 209, 89, 60, 94, 209,
+        3, 88, 60, 93, 209, 87, 60, 92, 209, 89, 60, 94, 209,
+        3, 88, 60, 93, 209, 87, 60, 92, 209, 89, 60, 94, 209,
+        3, 88, 60, 93, 209, 87, 60, 92, 209, 89, 60, 94, 209,
+        3, 88, 60, 93, 209, 87, 60, 92, 209, 89, 60, 94, 209,
+        3, 88, 60, 93, 209, 87, 60, 92, 209, 89, 60, 94, 209,
+        3, 88, 60, 93, 209, 87, 60, 92, 209, 89, 60, 94, 209,
+        3, 90, 60, 95, 209, 89, 60, 94, 209, 91, 60, 96, 209,
+        3, 90, 60, 95, 209, 89, 60, 94, 209, 91, 60, 96, 209,
+        3, 90, 60, 95, 209, 89, 60, 94, 209, 91, 60, 96, 209,
+        3, 90, 60, 95, 209, 89, 60, 94, 209, 91, 60, 96, 209,
+        3, 90, 60, 95, 209, 89, 60, 94, 209, 91, 60, 96, 209,
+        3, 90, 60, 95, 209, 89, 60, 94, 209, 91, 60, 96, 209,
+        3, 90, 60, 95, 209, 89, 60, 94, 209, 91, 60, 96, 209,
+        3, 92, 60, 97, 209, 91, 60, 96, 209, 93, 60, 98, 209,
+};
+
+//! @brief Profile editor, dragging three sliders with the preview updating
+static int16_t const m_profile_edit[] = {
+        4, 106, 0, 201, 49, 0, 50, 309, 229, 207, 45, 302, 49, 208, 0, 303, 49,
+        3, 0, 0, 100, 66, 0, 0, 309, 229, 1, 1, 310, 230,
+        1, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        3, 11, 137, 240, 203, 226, 161, 252, 178, 74, 91, 78, 109,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        3, 11, 137, 240, 203, 226, 161, 252, 178, 74, 91, 78, 109,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        2, 11, 137, 240, 203, 226, 161, 252, 178,
+        1, 11, 222, 240, 230,
+        2, 11, 222, 240, 230, 74, 91, 78, 109,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        2, 11, 222, 240, 230, 74, 91, 78, 109,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 11, 222, 240, 230,
+        1, 74, 91, 78, 109,
+        1, 74, 91, 78, 109,
+        1, 74, 91, 78, 109,
+};
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+gui_refr_trace_t const gui_refr_traces[] = {
+        TRACE("main idle", m_main_idle),
+        TRACE("main run", m_main_run),
+        TRACE("graph run", m_graph_run),
+        TRACE("profile edit", m_profile_edit),
+};
+
+size_t const gui_refr_trace_count = sizeof(gui_refr_traces) /
+                                    sizeof(gui_refr_traces[0]);
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,71 @@
+/*!
+ *******************************************************************************
+ * @file gui_refr_traces.h
+ *
+ * @brief Invalidated areas of the display refreshes recorded on the GUI
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef GUI_REFR_TRACES_H
+#define GUI_REFR_TRACES_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Refreshes recorded on a use of the GUI
+typedef struct {
+        //! @brief Name of the use
+        char const * p_name;
+
+        //! @brief Refreshes, each one as its number of areas followed by the
+        //!        areas, as x1, y1, x2 and y2
+        int16_t const * p_refreshes;
+
+        //! @brief Number of values in `p_refreshes`
+        size_t length;
+} gui_refr_trace_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+//! @brief Traces recorded, one per use
+extern gui_refr_trace_t const gui_refr_traces[];
+
+//! @brief Number of traces recorded
+extern size_t const gui_refr_trace_count;
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //GUI_REFR_TRACES_H
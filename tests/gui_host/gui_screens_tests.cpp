@@ -0,0 +1,276 @@
+/*!
+ *******************************************************************************
+ * @file gui_screens_tests.cpp
+ *
+ * @brief Screenshots of the GUI compared pixel by pixel with the reference
+ *        ones. The time taken to render them is measured by `gui_benchmark`
+ *
+ * The screens are compared by the checksum of their frame buffer. When one
+ * differs, it is saved as `<screen>.ppm` in the working directory, to be
+ * looked at and, if the change is wanted, its checksum taken as the new
+ * reference.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "CppUTest/TestHarness.h"
+
+extern "C"
+{
+#include "lvgl.h"
+#include "reflow_profile.h"
+#include "state_machine/states/state_machine_states.h"
+#include "state_machine/state_machine.h"
+#include "gui/gui.h"
+#include "gui/gui_views/gui_views_graph.h"
+#include "gui/gui_views/gui_views_main.h"
+#include "gui/gui_views/gui_views_profile.h"
+#include "thermocouple_fake.h"
+#include "reflow_profile_fake.h"
+#include "state_machine_fake.h"
+#include "host_display.h"
+}
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Row the tab buttons are tapped at
+#define TAB_BUTTON_Y                        (10)
+
+//! @brief Time a tap is held for, and time given to the GUI to settle after
+//!        it, animations included
+#define TAP_TIME_MS                         (100)
+#define SETTLE_TIME_MS                      (1000)
+
+//! @brief Period of the temperature readings during a run
+#define READING_PERIOD_MS                   (250)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Tabs of the GUI, in the order they are added by `gui_init`
+typedef enum {
+        TAB_MAIN = 0,
+        TAB_GRAPH,
+        TAB_PROFILE,
+        TAB_COUNT
+} tab_t;
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Whether the GUI was created, once for every test
+static bool m_is_gui_initialized = false;
+
+//! @brief Time of the last temperature reading
+static uint32_t m_reading_time_ms = 0;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+static void tap(lv_coord_t const x, lv_coord_t const y)
+{
+        host_display_press(x, y);
+        host_display_run(TAP_TIME_MS);
+        host_display_release();
+        host_display_run(SETTLE_TIME_MS);
+}
+
+static void tap_object(lv_obj_t const * const p_object)
+{
+        lv_area_t coords;
+
+        lv_obj_get_coords(p_object, &coords);
+        tap((coords.x1 + coords.x2) / 2, (coords.y1 + coords.y2) / 2);
+}
+
+static void show_tab(tab_t const tab)
+{
+        tap((lv_coord_t)((LV_HOR_RES_MAX * ((2 * tab) + 1)) / (2 * TAB_COUNT)),
+            TAB_BUTTON_Y);
+}
+
+static void read_temperature(uint16_t const temperature)
+{
+        m_reading_time_ms += READING_PERIOD_MS;
+        thermocouple_fake_set_temperature(temperature);
+        thermocouple_fake_set_last_update_time(m_reading_time_ms);
+        host_display_run(READING_PERIOD_MS);
+}
+
+static void check_screen(char const * const p_name,
+                         uint32_t const expected_checksum)
+{
+        char path[32];
+        uint32_t const checksum = host_display_get_checksum();
+
+        if (expected_checksum != checksum) {
+                (void)snprintf(path, sizeof(path), "%s.ppm", p_name);
+                (void)host_display_save_ppm(path);
+                printf("\nscreen %s differs, checksum 0x%08X saved to %s\n",
+                       p_name, checksum, path);
+        }
+
+        UNSIGNED_LONGS_EQUAL(expected_checksum, checksum);
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(gui_screens)
+{
+        void setup()
+        {
+                CHECK(NULL != host_display_get());
+
+                CHECK_TRUE(reflow_profile_fake_reset());
+                state_machine_fake_reset();
+                m_reading_time_ms = 0;
+                read_temperature(25);
+
+                if (!m_is_gui_initialized) {
+                        gui_init();
+                        m_is_gui_initialized = true;
+                }
+
+                show_tab(TAB_MAIN);
+        }
+};
+
+TEST(gui_screens, main_idle)
+{
+        read_temperature(26);
+        host_display_run(SETTLE_TIME_MS);
+
+        check_screen("main_idle", 0xC14992C5);
+}
+
+TEST(gui_screens, start_button_starts_a_run)
+{
+        state_machine_action_t action;
+
+        tap_object(p_start_button);
+
+        CHECK_TRUE(state_machine_fake_get_last_action(&action));
+        LONGS_EQUAL(STATE_MACHINE_ACTION_START, action);
+}
+
+TEST(gui_screens, graph_run)
+{
+        uint16_t temperature = 25;
+        uint32_t run_time_ms;
+
+        state_machine_fake_set_state(STATE_MACHINE_STATE_SEGMENT);
+        state_machine_fake_set_run(0, 0, false);
+        show_tab(TAB_GRAPH);
+
+        // Up to the soak, at 2 Celsius per second
+        for (run_time_ms = 0; 60000 > run_time_ms; run_time_ms += READING_PERIOD_MS) {
+                state_machine_fake_set_run(run_time_ms, 0, false);
+                read_temperature(temperature);
+                temperature = (uint16_t)(25 + (run_time_ms / 500));
+        }
+
+        check_screen("graph_run", 0xECCD57AF);
+}
+
+TEST(gui_screens, graph_run_past_its_end)
+{
+        reflow_trajectory_t const * p_trajectory;
+        uint32_t span_ms;
+        uint32_t run_time_ms;
+        uint16_t i;
+
+        state_machine_fake_set_state(STATE_MACHINE_STATE_SEGMENT);
+        state_machine_fake_set_run(0, 0, false);
+        CHECK_TRUE(state_machine_states_get_trajectory(&p_trajectory));
+        span_ms = p_trajectory->duration_ms + (p_trajectory->duration_ms / 8);
+        show_tab(TAB_GRAPH);
+
+        // One reading per bucket, up to one past the end of the chart
+        for (run_time_ms = 0;
+             (span_ms + (span_ms / GUI_GRAPH_BUCKET_COUNT)) > run_time_ms;
+             run_time_ms += span_ms / GUI_GRAPH_BUCKET_COUNT) {
+                state_machine_fake_set_run(run_time_ms, 0, false);
+                read_temperature(200);
+        }
+
+        // Buckets were merged in pairs, and the points past them emptied
+        CHECK(LV_CHART_POINT_DEF !=
+              p_graph_temperature_series->points[GUI_GRAPH_BUCKET_COUNT - 1]);
+
+        for (i = GUI_GRAPH_BUCKET_COUNT + 4; GUI_GRAPH_POINT_COUNT > i; i++) {
+                LONGS_EQUAL(LV_CHART_POINT_DEF,
+                            p_graph_temperature_series->points[i]);
+        }
+}
+
+TEST(gui_screens, profile_editor)
+{
+        lv_obj_t * p_window;
+
+        show_tab(TAB_PROFILE);
+        check_screen("profile", 0x7398D4E9);
+
+        tap_object(p_edit_button);
+        check_screen("profile_editor", 0x89E054B8);
+
+        // The editor window is the last object created on the screen
+        p_window = lv_obj_get_child(lv_scr_act(), NULL);
+        lv_obj_del(p_window);
+        host_display_run(SETTLE_TIME_MS);
+}
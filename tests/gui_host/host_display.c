@@ -0,0 +1,449 @@
+/*!
+ *******************************************************************************
+ * @file host_display.c
+ *
+ * @brief Display and touch drivers of LVGL for the host, drawing to a frame
+ *        buffer in memory
+ *
+ * The drivers keep the contract of `ili9341_flush` and `xpt2046_read`, and are
+ * registered as `display_init` in `main.c` does, with the same draw buffers.
+ * Flushed areas are copied to a frame buffer of the size of the display, which
+ * screenshot tests compare and save. Flushing is done at once, so the draw
+ * buffers are never waited for.
+ *
+ * Time is simulated: `host_display_run` advances the tick of LVGL and the time
+ * of `esp_timer_get_time` one millisecond at a time, and runs the LVGL tasks
+ * in between, as the main loop does. Refreshes are timed with the clock of the
+ * host, the only real time taken.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "lvgl.h"
+#include "esp_timer.h"
+#include "host_display.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief FNV-1a parameters of the frame buffer checksum
+#define HOST_DISPLAY_FNV_OFFSET             (2166136261u)
+#define HOST_DISPLAY_FNV_PRIME              (16777619u)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Copy the rendered area to the frame buffer
+static void host_display_flush(lv_disp_drv_t * p_driver,
+                               lv_area_t const * p_area,
+                               lv_color_t * p_colors);
+
+//! @brief Read the touch panel
+static bool host_display_read(lv_indev_drv_t * p_driver,
+                              lv_indev_data_t * p_data);
+
+//! @brief Get the time of the host in microseconds
+static uint64_t get_host_time_us(void);
+
+//! @brief Refresh the display and time it
+static void refresh_task(lv_task_t * p_task);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Draw buffers of the display
+static lv_color_t m_buffer_1[HOST_DISPLAY_BUFFER_SIZE];
+static lv_color_t m_buffer_2[HOST_DISPLAY_BUFFER_SIZE];
+static lv_disp_buf_t m_display_buffer;
+
+//! @brief Pixels shown on the display
+static lv_color_t m_frame_buffer[LV_VER_RES_MAX][LV_HOR_RES_MAX];
+
+//! @brief Display, NULL until the first call to `host_display_get`
+static lv_disp_t * m_p_display = NULL;
+
+//! @brief Point the touch panel is pressed at, and whether it is pressed
+static lv_point_t m_touch_point = {0, 0};
+static bool m_is_touched = false;
+
+//! @brief Simulated time since boot
+static int64_t m_time_us = 0;
+
+//! @brief Frames rendered since the statistics were reset
+static host_display_stats_t m_stats;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Get the display, initializing LVGL and the drivers on the first call
+ *
+ * @param               -                   -
+ *
+ * @return              lv_disp_t *         Display, NULL if it couldn't be
+ *                                          registered
+ */
+lv_disp_t * host_display_get(void)
+{
+        lv_disp_drv_t display_driver;
+        lv_indev_drv_t input_dev_driver;
+        lv_indev_t const * p_input_device = NULL;
+
+        if (NULL != m_p_display) {
+                // Code style exception for readability
+                return m_p_display;
+        }
+
+        lv_init();
+        lv_disp_buf_init(&m_display_buffer,
+                         m_buffer_1,
+                         m_buffer_2,
+                         HOST_DISPLAY_BUFFER_SIZE);
+
+        lv_disp_drv_init(&display_driver);
+        display_driver.flush_cb = host_display_flush;
+        display_driver.buffer = &m_display_buffer;
+        m_p_display = lv_disp_drv_register(&display_driver);
+
+        if (NULL != m_p_display) {
+                lv_task_set_cb(m_p_display->refr_task, refresh_task);
+
+                lv_indev_drv_init(&input_dev_driver);
+                input_dev_driver.read_cb = host_display_read;
+                input_dev_driver.type = LV_INDEV_TYPE_POINTER;
+                p_input_device = lv_indev_drv_register(&input_dev_driver);
+        }
+
+        if (NULL == p_input_device) {
+                m_p_display = NULL;
+        }
+
+        return m_p_display;
+}
+
+/*!
+ * @brief Let the time pass, running LVGL every millisecond
+ *
+ * @param[in]           time_ms             Time to pass, in milliseconds
+ *
+ * @return              -                   -
+ */
+void host_display_run(uint32_t const time_ms)
+{
+        uint32_t i;
+
+        for (i = 0; time_ms > i; i++) {
+                lv_tick_inc(1);
+                m_time_us += 1000;
+                lv_task_handler();
+        }
+}
+
+/*!
+ * @brief Press the touch panel at a point, until released
+ *
+ * @param[in]           x                   Column pressed at
+ * @param[in]           y                   Row pressed at
+ *
+ * @return              -                   -
+ */
+void host_display_press(lv_coord_t const x, lv_coord_t const y)
+{
+        m_touch_point.x = x;
+        m_touch_point.y = y;
+        m_is_touched = true;
+}
+
+/*!
+ * @brief Release the touch panel
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+void host_display_release(void)
+{
+        m_is_touched = false;
+}
+
+/*!
+ * @brief Get the frames rendered since the statistics were reset
+ *
+ * @param[out]          p_stats             Pointer where to store them
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null
+ */
+bool host_display_get_stats(host_display_stats_t * const p_stats)
+{
+        bool const success = (NULL != p_stats);
+
+        if (success) {
+                *p_stats = m_stats;
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Reset the frame statistics
+ *
+ * @param               -                   -
+ *
+ * @return              -                   -
+ */
+void host_display_reset_stats(void)
+{
+        m_stats = (host_display_stats_t){0, 0, 0, 0, 0};
+}
+
+/*!
+ * @brief Get the frame buffer, a row after the other
+ *
+ * @param               -                   -
+ *
+ * @return              lv_color_t const *  First pixel of the frame buffer
+ */
+lv_color_t const * host_display_get_frame_buffer(void)
+{
+        return &m_frame_buffer[0][0];
+}
+
+/*!
+ * @brief Get a checksum of the frame buffer
+ *
+ * Any pixel changing changes the checksum, so a screen can be compared with
+ * a reference one pixel by pixel by only keeping its checksum.
+ *
+ * @param               -                   -
+ *
+ * @return              uint32_t            FNV-1a hash of the frame buffer
+ */
+uint32_t host_display_get_checksum(void)
+{
+        uint8_t const * p_byte = (uint8_t const *)m_frame_buffer;
+        uint8_t const * const p_end = p_byte + sizeof(m_frame_buffer);
+        uint32_t hash = HOST_DISPLAY_FNV_OFFSET;
+
+        while (p_end > p_byte) {
+                hash = (hash ^ *p_byte++) * HOST_DISPLAY_FNV_PRIME;
+        }
+
+        return hash;
+}
+
+/*!
+ * @brief Save the frame buffer as a PPM image
+ *
+ * @param[in]           p_path              Path of the image
+ *
+ * @return              bool                Result of the operation
+ * @retval              True                If everything went well
+ * @retval              False               If pointer is null or the image
+ *                                          couldn't be written
+ */
+bool host_display_save_ppm(char const * const p_path)
+{
+        FILE * p_file = NULL;
+        uint32_t color;
+        uint8_t rgb[3];
+        lv_coord_t x;
+        lv_coord_t y;
+        bool success = (NULL != p_path);
+
+        if (success) {
+                p_file = fopen(p_path, "wb");
+                success = (NULL != p_file);
+        }
+
+        if (success) {
+                (void)fprintf(p_file, "P6\n%d %d\n255\n",
+                              LV_HOR_RES_MAX, LV_VER_RES_MAX);
+
+                for (y = 0; (success) && (LV_VER_RES_MAX > y); y++) {
+                        for (x = 0; (success) && (LV_HOR_RES_MAX > x); x++) {
+                                color = lv_color_to32(m_frame_buffer[y][x]);
+                                rgb[0] = (uint8_t)(color >> 16);
+                                rgb[1] = (uint8_t)(color >> 8);
+                                rgb[2] = (uint8_t)color;
+                                success = (sizeof(rgb) == fwrite(rgb, 1,
+                                                                 sizeof(rgb),
+                                                                 p_file));
+                        }
+                }
+
+                success = ((0 == fclose(p_file)) && (success));
+        }
+
+        return success;
+}
+
+/*!
+ * @brief Get the time since boot, as simulated by `host_display_run`
+ *
+ * @param               -                   -
+ *
+ * @return              int64_t             Time in microseconds
+ */
+int64_t esp_timer_get_time(void)
+{
+        return m_time_us;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Copy the rendered area to the frame buffer
+ *
+ * @param[in]           p_driver            Display driver
+ * @param[in]           p_area              Area rendered, within the display
+ * @param[in]           p_colors            Pixels of the area, a row after
+ *                                          the other
+ *
+ * @return              -                   -
+ */
+static void host_display_flush(lv_disp_drv_t * p_driver,
+                               lv_area_t const * p_area,
+                               lv_color_t * p_colors)
+{
+        lv_coord_t const width = lv_area_get_width(p_area);
+        lv_coord_t y;
+
+        for (y = p_area->y1; p_area->y2 >= y; y++) {
+                memcpy(&m_frame_buffer[y][p_area->x1],
+                                p_colors,
+                                (uint32_t)width * sizeof(lv_color_t));
+                p_colors += width;
+        }
+
+        m_stats.flush_count++;
+        m_stats.pixel_count += lv_area_get_size(p_area);
+
+        lv_disp_flush_ready(p_driver);
+}
+
+/*!
+ * @brief Read the touch panel
+ *
+ * @param[in]           p_driver            Input device driver, not used
+ * @param[out]          p_data              Point and state read
+ *
+ * @return              bool                Whether there is more to read,
+ *                                          always false
+ */
+static bool host_display_read(lv_indev_drv_t * p_driver,
+                              lv_indev_data_t * p_data)
+{
+        (void)p_driver;
+
+        p_data->point = m_touch_point;
+        p_data->state = (m_is_touched ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL);
+
+        return false;
+}
+
+/*!
+ * @brief Get the time of the host in microseconds
+ *
+ * @param               -                   -
+ *
+ * @return              uint64_t            Monotonic time in microseconds
+ */
+static uint64_t get_host_time_us(void)
+{
+        struct timespec now;
+
+        (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+        return (((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000));
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Refresh the display and time it, in place of the refresh task of
+ *        LVGL
+ *
+ * Refreshes sending nothing to the display aren't accounted as frames.
+ *
+ * @param[in]           p_task              Refresh task of the display
+ *
+ * @return              -                   -
+ */
+static void refresh_task(lv_task_t * p_task)
+{
+        uint32_t const flush_count = m_stats.flush_count;
+        uint64_t const start_us = get_host_time_us();
+        uint32_t elapsed_us;
+
+        lv_disp_refr_task(p_task);
+
+        elapsed_us = (uint32_t)(get_host_time_us() - start_us);
+
+        if (flush_count != m_stats.flush_count) {
+                m_stats.frame_count++;
+                m_stats.render_us += elapsed_us;
+
+                if (m_stats.render_max_us < elapsed_us) {
+                        m_stats.render_max_us = elapsed_us;
+                }
+        }
+}
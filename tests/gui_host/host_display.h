@@ -0,0 +1,102 @@
+/*!
+ *******************************************************************************
+ * @file host_display.h
+ *
+ * @brief Display and touch drivers of LVGL for the host, drawing to a frame
+ *        buffer in memory
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef HOST_DISPLAY_H
+#define HOST_DISPLAY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Size of each draw buffer, as set up for the ILI9341 in `main.c`
+#define HOST_DISPLAY_BUFFER_SIZE            (LV_HOR_RES_MAX * 40)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Frames rendered since the statistics were reset
+typedef struct {
+        //! @brief Refreshes that sent anything to the display
+        uint32_t frame_count;
+
+        //! @brief Areas sent to the display
+        uint32_t flush_count;
+
+        //! @brief Pixels sent to the display
+        uint32_t pixel_count;
+
+        //! @brief Time spent rendering and sending the frames, in
+        //!        microseconds of the host
+        uint64_t render_us;
+
+        //! @brief Longest frame, in microseconds of the host
+        uint32_t render_max_us;
+} host_display_stats_t;
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Get the display, initializing LVGL and the drivers on the first call
+lv_disp_t * host_display_get(void);
+
+//! @brief Let the time pass, running LVGL every millisecond
+void host_display_run(uint32_t const time_ms);
+
+//! @brief Press the touch panel at a point, until released
+void host_display_press(lv_coord_t const x, lv_coord_t const y);
+
+//! @brief Release the touch panel
+void host_display_release(void);
+
+//! @brief Get the frames rendered since the statistics were reset
+bool host_display_get_stats(host_display_stats_t * const p_stats);
+
+//! @brief Reset the frame statistics
+void host_display_reset_stats(void);
+
+//! @brief Get the frame buffer, a row after the other
+lv_color_t const * host_display_get_frame_buffer(void);
+
+//! @brief Get a checksum of the frame buffer
+uint32_t host_display_get_checksum(void);
+
+//! @brief Save the frame buffer as a PPM image
+bool host_display_save_ppm(char const * const p_path);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //HOST_DISPLAY_H
@@ -0,0 +1,265 @@
+/*!
+ *******************************************************************************
+ * @file refr_coalescing_tests.cpp
+ *
+ * @brief Checks on joining the invalidated areas by their refresh cost, and a
+ *        benchmark of it on the refreshes recorded on the GUI
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "CppUTest/TestHarness.h"
+
+#include "lvgl.h"
+#include "host_display.h"
+#include "gui_refr_traces.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Time of sending a pixel to the ILI9341 at 40 MHz, in nanoseconds
+#define PIXEL_TIME_NS                       (400)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Flushes of a number of refreshes
+typedef struct {
+        uint32_t flush_count;
+        uint32_t pixel_count;
+} flush_count_t;
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Display refreshed, shared with the other tests
+static lv_disp_t * m_p_display = NULL;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+static flush_count_t get_flushes(void)
+{
+        host_display_stats_t stats;
+
+        (void)host_display_get_stats(&stats);
+
+        return {stats.flush_count, stats.pixel_count};
+}
+
+static void invalidate(lv_coord_t const x1,
+                       lv_coord_t const y1,
+                       lv_coord_t const x2,
+                       lv_coord_t const y2)
+{
+        lv_area_t area;
+
+        lv_area_set(&area, x1, y1, x2, y2);
+        lv_inv_area(m_p_display, &area);
+}
+
+static flush_count_t replay(gui_refr_trace_t const * const p_trace,
+                            uint16_t const flush_cost)
+{
+        int16_t const * p_value = p_trace->p_refreshes;
+        int16_t const * const p_end = p_trace->p_refreshes + p_trace->length;
+        int16_t area_count;
+
+        m_p_display->driver.flush_cost = flush_cost;
+        host_display_reset_stats();
+
+        while (p_end > p_value) {
+                for (area_count = *p_value++; 0 < area_count; area_count--) {
+                        invalidate(p_value[0], p_value[1], p_value[2], p_value[3]);
+                        p_value += 4;
+                }
+
+                lv_refr_now(m_p_display);
+        }
+
+        return get_flushes();
+}
+
+static double get_sending_time_ms(flush_count_t const * const p_flushes)
+{
+        uint64_t const pixels = (p_flushes->pixel_count +
+                                 ((uint64_t)p_flushes->flush_count *
+                                  LV_DISP_DEF_FLUSH_COST));
+
+        return (double)(pixels * PIXEL_TIME_NS) / 1e6;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(refr_coalescing)
+{
+        void setup()
+        {
+                m_p_display = host_display_get();
+                CHECK(NULL != m_p_display);
+
+                // Nothing left from the screen creation or the last test
+                lv_refr_now(m_p_display);
+                m_p_display->driver.flush_cost = LV_DISP_DEF_FLUSH_COST;
+                host_display_reset_stats();
+        }
+};
+
+TEST(refr_coalescing, close_labels_are_flushed_together)
+{
+        // Two labels side by side, 10 pixels apart
+        invalidate(10, 10, 69, 29);
+        invalidate(80, 10, 139, 29);
+        lv_refr_now(m_p_display);
+
+        UNSIGNED_LONGS_EQUAL(1, get_flushes().flush_count);
+        UNSIGNED_LONGS_EQUAL(130 * 20, get_flushes().pixel_count);
+
+        // Without flush cost only overlapping areas are joined, as before
+        m_p_display->driver.flush_cost = 0;
+        host_display_reset_stats();
+        invalidate(10, 10, 69, 29);
+        invalidate(80, 10, 139, 29);
+        lv_refr_now(m_p_display);
+
+        UNSIGNED_LONGS_EQUAL(2, get_flushes().flush_count);
+        UNSIGNED_LONGS_EQUAL(2 * 60 * 20, get_flushes().pixel_count);
+}
+
+TEST(refr_coalescing, far_areas_are_flushed_apart)
+{
+        invalidate(0, 0, 59, 19);
+        invalidate(250, 200, 309, 219);
+        lv_refr_now(m_p_display);
+
+        UNSIGNED_LONGS_EQUAL(2, get_flushes().flush_count);
+        UNSIGNED_LONGS_EQUAL(2 * 60 * 20, get_flushes().pixel_count);
+}
+
+TEST(refr_coalescing, overlapping_areas_are_joined_without_flush_cost)
+{
+        m_p_display->driver.flush_cost = 0;
+
+        invalidate(0, 0, 99, 19);
+        invalidate(20, 5, 119, 24);
+        lv_refr_now(m_p_display);
+
+        UNSIGNED_LONGS_EQUAL(1, get_flushes().flush_count);
+        UNSIGNED_LONGS_EQUAL(120 * 25, get_flushes().pixel_count);
+}
+
+TEST(refr_coalescing, flushes_of_tall_areas_are_accounted)
+{
+        // Joined, the areas don't fit in a buffer and still take two flushes
+        invalidate(0, 0, 319, 24);
+        invalidate(0, 26, 319, 50);
+        lv_refr_now(m_p_display);
+
+        UNSIGNED_LONGS_EQUAL(2, get_flushes().flush_count);
+        UNSIGNED_LONGS_EQUAL(2 * 320 * 25, get_flushes().pixel_count);
+}
+
+TEST_GROUP(refr_coalescing_benchmark)
+{
+        void setup()
+        {
+                m_p_display = host_display_get();
+                CHECK(NULL != m_p_display);
+                lv_refr_now(m_p_display);
+        }
+};
+
+/*!
+ * @test Replay the refreshes recorded on the GUI, joining the areas by their
+ *       cost and only when they overlap
+ *
+ * @result - Joining by cost takes no longer to send on any of them
+ *         - Flushes, pixels and time to send of both are printed, when
+ *           benchmarks are
+ */
+TEST(refr_coalescing_benchmark, recorded_traces)
+{
+        flush_count_t joined;
+        flush_count_t overlapping;
+        size_t i;
+
+#if TESTS_PRINT_BENCHMARKS
+        printf("\nbenchmark refresh coalescing, flush cost %d px:\n",
+               LV_DISP_DEF_FLUSH_COST);
+#endif // #if TESTS_PRINT_BENCHMARKS
+
+        for (i = 0; gui_refr_trace_count > i; i++) {
+                joined = replay(&gui_refr_traces[i], LV_DISP_DEF_FLUSH_COST);
+                overlapping = replay(&gui_refr_traces[i], 0);
+
+                CHECK(get_sending_time_ms(&joined) <=
+                      get_sending_time_ms(&overlapping));
+
+#if TESTS_PRINT_BENCHMARKS
+                printf("  %-13s %4u flushes %7u px %7.1f ms, "
+                       "only overlapping %4u flushes %7u px %7.1f ms\n",
+                       gui_refr_traces[i].p_name,
+                       joined.flush_count,
+                       joined.pixel_count,
+                       get_sending_time_ms(&joined),
+                       overlapping.flush_count,
+                       overlapping.pixel_count,
+                       get_sending_time_ms(&overlapping));
+#endif // #if TESTS_PRINT_BENCHMARKS
+        }
+}
@@ -0,0 +1,253 @@
+/*!
+ *******************************************************************************
+ * @file state_machine_fake.c
+ *
+ * @brief State machine fake for the GUI, with the state and run set by the
+ *        test
+ *
+ * Only the state machine functions the GUI calls are faked. A run is in
+ * progress from `state_machine_fake_set_run` until the state machine goes
+ * back to idle, and runs the program of the profile in use.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "reflow_profile.h"
+#include "state_machine/states/state_machine_states.h"
+#include "state_machine/state_machine.h"
+#include "state_machine_fake.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+static size_t const m_state_map_size = sizeof(m_state_map) /
+                                       sizeof(m_state_map[0]);
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+static state_machine_state_text_t m_state = STATE_MACHINE_STATE_IDLE;
+
+static bool m_is_running = false;
+
+static uint32_t m_run_time_ms = 0;
+
+static uint8_t m_segment = 0;
+
+static bool m_is_holding = false;
+
+static bool m_is_action_sent = false;
+
+static state_machine_action_t m_last_action;
+
+static reflow_program_t m_program;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+void state_machine_fake_reset(void)
+{
+        m_state = STATE_MACHINE_STATE_IDLE;
+        m_is_running = false;
+        m_run_time_ms = 0;
+        m_segment = 0;
+        m_is_holding = false;
+        m_is_action_sent = false;
+}
+
+void state_machine_fake_set_state(state_machine_state_text_t const state)
+{
+        m_state = state;
+
+        if (STATE_MACHINE_STATE_IDLE == state) {
+                m_is_running = false;
+        }
+}
+
+void state_machine_fake_set_run(uint32_t const run_time_ms,
+                                uint8_t const segment,
+                                bool const is_holding)
+{
+        m_is_running = true;
+        m_run_time_ms = run_time_ms;
+        m_segment = segment;
+        m_is_holding = is_holding;
+}
+
+bool state_machine_fake_get_last_action(state_machine_action_t * const p_action)
+{
+        bool const success = ((NULL != p_action) && (m_is_action_sent));
+
+        if (success) {
+                *p_action = m_last_action;
+        }
+
+        return success;
+}
+
+bool state_machine_get_state(state_machine_state_text_t * const p_state)
+{
+        bool const success = (NULL != p_state);
+
+        if (success) {
+                *p_state = m_state;
+        }
+
+        return success;
+}
+
+bool state_machine_send_event(state_machine_event_type_t const type,
+                              state_machine_data_t const data,
+                              uint32_t const timeout)
+{
+        bool const success = (STATE_MACHINE_EVENT_TYPE_ACTION == type);
+
+        (void)timeout;
+
+        if (success) {
+                m_last_action = data.user_action;
+                m_is_action_sent = true;
+        }
+
+        return success;
+}
+
+char * state_machine_get_state_string(state_machine_state_text_t const state)
+{
+        char * p_string = NULL;
+
+        if (m_state_map_size > (size_t)state) {
+                p_string = m_state_map[state].string;
+        }
+
+        return p_string;
+}
+
+bool state_machine_states_get_run_time(uint32_t * const p_run_time_ms)
+{
+        bool const success = ((NULL != p_run_time_ms) && (m_is_running));
+
+        if (success) {
+                *p_run_time_ms = m_run_time_ms;
+        }
+
+        return success;
+}
+
+bool state_machine_states_get_program(reflow_program_t const ** const pp_program)
+{
+        bool success = ((NULL != pp_program) && (m_is_running));
+
+        if (success) {
+                success = reflow_profile_get_current_program(&m_program);
+        }
+
+        if (success) {
+                *pp_program = &m_program;
+        }
+
+        return success;
+}
+
+bool state_machine_states_get_trajectory(reflow_trajectory_t const ** const pp_trajectory)
+{
+        return ((m_is_running) &&
+                (reflow_profile_get_current_trajectory(pp_trajectory)));
+}
+
+bool state_machine_states_get_segment(uint8_t * const p_index,
+                                      bool * const p_is_holding)
+{
+        bool const success = ((NULL != p_index) &&
+                              (NULL != p_is_holding) &&
+                              (m_is_running));
+
+        if (success) {
+                *p_index = m_segment;
+                *p_is_holding = m_is_holding;
+        }
+
+        return success;
+}
+
+// The states are only referenced by the state map, and never run
+void state_machine_state_idle(void)
+{
+}
+
+void state_machine_state_segment(void)
+{
+}
+
+void state_machine_state_cooling(void)
+{
+}
+
+void state_machine_state_paused(void)
+{
+}
+
+void state_machine_state_error(void)
+{
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,67 @@
+/*!
+ *******************************************************************************
+ * @file state_machine_fake.h
+ *
+ * @brief State machine fake for the GUI, with the state and run set by the
+ *        test
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef STATE_MACHINE_FAKE_H
+#define STATE_MACHINE_FAKE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Go back to idle, with no run and no action sent
+void state_machine_fake_reset(void);
+
+//! @brief Set the state the state machine is at
+void state_machine_fake_set_state(state_machine_state_text_t const state);
+
+//! @brief Set the run in progress
+void state_machine_fake_set_run(uint32_t const run_time_ms,
+                                uint8_t const segment,
+                                bool const is_holding);
+
+//! @brief Get the last user action sent to the state machine
+bool state_machine_fake_get_last_action(state_machine_action_t * const p_action);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //STATE_MACHINE_FAKE_H
@@ -0,0 +1,109 @@
+/*!
+ *******************************************************************************
+ * @file gui_main_cache_tests.cpp
+ *
+ * @brief Checks on the values cached by the main screen
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include "CppUTest/TestHarness.h"
+
+#include "gui/gui_main_cache.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Every widget of the main screen
+#define CHANGE_ALL                          (GUI_MAIN_CACHE_CHANGE_TEMPERATURE |  \
+                                             GUI_MAIN_CACHE_CHANGE_PROFILE_NAME | \
+                                             GUI_MAIN_CACHE_CHANGE_METER_RANGE)
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(gui_main_cache)
+{
+        gui_main_cache_t cache;
+
+        void setup()
+        {
+                CHECK_TRUE(gui_main_cache_init(&cache));
+        }
+};
+
+TEST(gui_main_cache, everything_is_shown_first)
+{
+        UNSIGNED_LONGS_EQUAL(CHANGE_ALL,
+                             gui_main_cache_update(&cache, 25, 245, "Default"));
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_NONE,
+                             gui_main_cache_update(&cache, 25, 245, "Default"));
+
+        // Again after forgetting them
+        CHECK_TRUE(gui_main_cache_init(&cache));
+        UNSIGNED_LONGS_EQUAL(CHANGE_ALL,
+                             gui_main_cache_update(&cache, 25, 245, "Default"));
+}
+
+TEST(gui_main_cache, only_changes_are_shown)
+{
+        (void)gui_main_cache_update(&cache, 25, 245, "Default");
+
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_TEMPERATURE,
+                             gui_main_cache_update(&cache, 26, 245, "Default"));
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_NONE,
+                             gui_main_cache_update(&cache, 26, 245, "Default"));
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_PROFILE_NAME |
+                             GUI_MAIN_CACHE_CHANGE_METER_RANGE,
+                             gui_main_cache_update(&cache, 26, 230, "Leaded"));
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_PROFILE_NAME,
+                             gui_main_cache_update(&cache, 26, 230, "Lead"));
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_NONE,
+                             gui_main_cache_update(&cache, 26, 230, "Lead"));
+}
+
+TEST(gui_main_cache, long_names_are_cut)
+{
+        char const * const p_name = "A name longer than fits";
+
+        (void)gui_main_cache_update(&cache, 25, 245, p_name);
+
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_NAME_SIZE - 1, strlen(cache.profile_name));
+        STRCMP_EQUAL("A name longer t", cache.profile_name);
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_NONE,
+                             gui_main_cache_update(&cache, 25, 245, p_name));
+}
+
+TEST(gui_main_cache, invalid_input_fails)
+{
+        CHECK_FALSE(gui_main_cache_init(NULL));
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_NONE,
+                             gui_main_cache_update(NULL, 25, 245, "Default"));
+        UNSIGNED_LONGS_EQUAL(GUI_MAIN_CACHE_CHANGE_NONE,
+                             gui_main_cache_update(&cache, 25, 245, NULL));
+
+        // Nothing was stored
+        UNSIGNED_LONGS_EQUAL(CHANGE_ALL,
+                             gui_main_cache_update(&cache, 25, 245, "Default"));
+}
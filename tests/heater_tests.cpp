@@ -144,6 +144,15 @@ TEST(heater_no_init, stop_no_init_fails)
         ENUMS_EQUAL_INT(HEATER_ERROR_NOT_INITIALIZED, result);
 }
 
+TEST(heater_no_init, rearm_no_init_fails)
+{
+        heater_error_t result;
+
+        result = heater_rearm();
+
+        ENUMS_EQUAL_INT(HEATER_ERROR_NOT_INITIALIZED, result);
+}
+
 TEST(heater_no_init, deinit_no_init_fails)
 {
         heater_error_t result;
@@ -506,4 +515,39 @@ TEST(heater_initialized, stops_heating_when_reaching_target_temperature)
                           m_valid_target_degrees + 20,
                           0,
                           true);
+}
+
+/*!
+ * @test Run a powered control cycle and an unpowered one
+ *
+ * @result - Both cycles are counted
+ *         - Only the first one is counted as powered
+ */
+TEST(heater_initialized, cycle_counts_follow_the_power)
+{
+        uint32_t powered_count = 0;
+        uint32_t cycle_count = 0;
+        uint32_t start_powered_count = 0;
+        uint32_t start_cycle_count = 0;
+
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS,
+                        heater_get_cycle_counts(&start_powered_count,
+                                                &start_cycle_count));
+
+        check_heater_with(m_valid_target_degrees,
+                          m_valid_target_degrees - 20,
+                          1,
+                          true);
+
+        check_heater_with(m_valid_target_degrees,
+                          m_valid_target_degrees + 20,
+                          0,
+                          true);
+
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS,
+                        heater_get_cycle_counts(&powered_count, &cycle_count));
+        UNSIGNED_LONGS_EQUAL(1, powered_count - start_powered_count);
+        UNSIGNED_LONGS_EQUAL(2, cycle_count - start_cycle_count);
+        ENUMS_EQUAL_INT(HEATER_ERROR_BAD_PARAMETER,
+                        heater_get_cycle_counts(NULL, &cycle_count));
 }
\ No newline at end of file
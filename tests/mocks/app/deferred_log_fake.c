@@ -0,0 +1,109 @@
+/*!
+ *******************************************************************************
+ * @file deferred_log_fake.c
+ *
+ * @brief Deferred log fake, records are dropped in the host build as the
+ *        `ESP_LOGx` ones
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "deferred_log.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+bool deferred_log_init(void)
+{
+        return true;
+}
+
+void deferred_log_write(deferred_log_format_t const * const p_format,
+                        int32_t const * const p_args,
+                        size_t const arg_count)
+{
+        (void)p_format;
+        (void)p_args;
+        (void)arg_count;
+}
+
+bool deferred_log_get_stats(deferred_log_stats_t * const p_stats)
+{
+        bool const success = (NULL != p_stats);
+
+        if (success) {
+                p_stats->write_cycles = 0;
+                p_stats->format_cycles = 0;
+                p_stats->record_count = 0;
+                p_stats->dropped_count = 0;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,270 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_fake.c
+ *
+ * @brief Reflow profile fake, holds the profile and program in use without
+ *        touching NVS
+ *
+ * The profiles list only holds the profile in use. Saving a profile makes it
+ * the one in use.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "configuration.h"
+#include "reflow_profile.h"
+#include "reflow_profile_fake.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+static reflow_profile_t m_current_profile;
+
+static reflow_program_t m_current_program;
+
+static reflow_trajectory_t m_current_trajectory;
+
+//! @brief Profile used until one is set
+static reflow_profile_t const m_factory_profile = {
+        "Sn60Pb40", 170, 5, 220, 5, 30, 100, 10
+};
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+bool reflow_profile_get_current(reflow_profile_t * const p_reflow_profile)
+{
+        bool success = (NULL != p_reflow_profile);
+
+        if (success) {
+                *p_reflow_profile = m_current_profile;
+        }
+
+        return success;
+}
+
+bool reflow_profile_get_current_program(reflow_program_t * const p_program)
+{
+        bool success = (NULL != p_program);
+
+        if (success) {
+                *p_program = m_current_program;
+        }
+
+        return success;
+}
+
+bool reflow_profile_get_current_name(char const ** const pp_name)
+{
+        bool success = (NULL != pp_name);
+
+        if (success) {
+                *pp_name = m_current_profile.name;
+        }
+
+        return success;
+}
+
+bool reflow_profile_get_current_trajectory(reflow_trajectory_t const ** const pp_trajectory)
+{
+        bool success = (NULL != pp_trajectory);
+
+        if (success) {
+                *pp_trajectory = &m_current_trajectory;
+        }
+
+        return success;
+}
+
+bool reflow_profile_get_factory_profile(reflow_profile_t * const p_reflow_profile)
+{
+        bool success = (NULL != p_reflow_profile);
+
+        if (success) {
+                *p_reflow_profile = m_factory_profile;
+        }
+
+        return success;
+}
+
+bool reflow_profile_save(reflow_profile_t const * const p_reflow_profile)
+{
+        bool success = (NULL != p_reflow_profile);
+
+        if (success) {
+                success = reflow_profile_fake_set_current(p_reflow_profile);
+        }
+
+        return success;
+}
+
+bool reflow_profile_load(char const * const p_name,
+                         reflow_profile_t * const p_reflow_profile)
+{
+        bool success = ((NULL != p_name) &&
+                        (NULL != p_reflow_profile) &&
+                        (0 == strcmp(p_name, m_current_profile.name)));
+
+        if (success) {
+                *p_reflow_profile = m_current_profile;
+        }
+
+        return success;
+}
+
+bool reflow_profile_delete(char const * const p_name)
+{
+        // The profile in use can't be deleted
+        (void)p_name;
+
+        return false;
+}
+
+bool reflow_profile_use(char const * p_name)
+{
+        return ((NULL != p_name) && (0 == strcmp(p_name, m_current_profile.name)));
+}
+
+bool reflow_profile_get_profiles_list(char const ** const pp_profiles,
+                                      size_t * const p_size)
+{
+        bool success = ((NULL != pp_profiles) && (NULL != p_size));
+
+        if (success) {
+                *pp_profiles = m_current_profile.name;
+                *p_size = strlen(m_current_profile.name);
+        }
+
+        return success;
+}
+
+bool reflow_profile_get_profiles_count(uint8_t * const p_count)
+{
+        bool success = (NULL != p_count);
+
+        if (success) {
+                *p_count = 1;
+        }
+
+        return success;
+}
+
+bool reflow_profile_get_position(char const * const p_name,
+                                 uint8_t * const p_position)
+{
+        bool success = ((NULL != p_position) &&
+                        (reflow_profile_use(p_name)));
+
+        if (success) {
+                *p_position = 0;
+        }
+
+        return success;
+}
+
+bool reflow_profile_get_name_at(uint8_t const position, char * const p_name)
+{
+        bool success = ((NULL != p_name) && (0 == position));
+
+        if (success) {
+                strcpy(p_name, m_current_profile.name);
+        }
+
+        return success;
+}
+
+bool reflow_profile_fake_set_current(reflow_profile_t const * const p_reflow_profile)
+{
+        bool success;
+
+        m_current_profile = *p_reflow_profile;
+
+        success = reflow_program_from_profile(p_reflow_profile, &m_current_program);
+
+        if (success) {
+                success = reflow_trajectory_compile(&m_current_program,
+                                                    CONFIGURATION_AMBIENT_TEMPERATURE_C,
+                                                    &m_current_trajectory);
+        }
+
+        return success;
+}
+
+void reflow_profile_fake_set_current_program(reflow_program_t const * const p_program)
+{
+        m_current_program = *p_program;
+
+        (void)reflow_trajectory_compile(&m_current_program,
+                                        CONFIGURATION_AMBIENT_TEMPERATURE_C,
+                                        &m_current_trajectory);
+}
+
+bool reflow_profile_fake_reset(void)
+{
+        return reflow_profile_fake_set_current(&m_factory_profile);
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
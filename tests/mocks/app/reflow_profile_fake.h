@@ -0,0 +1,61 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_fake.h
+ *
+ * @brief Reflow profile fake, holds the profile and program in use without
+ *        touching NVS
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef REFLOW_PROFILE_FAKE_H
+#define REFLOW_PROFILE_FAKE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+bool reflow_profile_fake_set_current(reflow_profile_t const * const p_reflow_profile);
+
+void reflow_profile_fake_set_current_program(reflow_program_t const * const p_program);
+
+bool reflow_profile_fake_reset(void);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //REFLOW_PROFILE_FAKE_H
@@ -0,0 +1,134 @@
+/*!
+ *******************************************************************************
+ * @file reflow_timer_fake.c
+ *
+ * @brief Reflow timer fake. It never expires by itself: in the host the timer
+ *        messages are provided by the test, e.g. from a replayed capture
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "state_machine/states/state_machine_states.h"
+#include "state_machine/state_machine.h"
+#include "reflow_timer.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+static bool m_is_running = false;
+
+static bool m_is_paused = false;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+bool reflow_timer_init(void)
+{
+        m_is_running = false;
+        m_is_paused = false;
+
+        return true;
+}
+
+bool reflow_timer_start_timer(uint32_t const period_s,
+                              state_machine_state_text_t const state)
+{
+        m_is_running = true;
+        m_is_paused = false;
+
+        return true;
+}
+
+bool reflow_timer_stop_timer(void)
+{
+        m_is_running = false;
+        m_is_paused = false;
+
+        return true;
+}
+
+bool reflow_timer_pause_timer(void)
+{
+        bool success = ((m_is_running) && (!m_is_paused));
+
+        if (success) {
+                m_is_paused = true;
+        }
+
+        return success;
+}
+
+bool reflow_timer_resume_timer(void)
+{
+        bool success = (m_is_paused);
+
+        if (success) {
+                m_is_paused = false;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
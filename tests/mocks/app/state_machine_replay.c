@@ -0,0 +1,285 @@
+/*!
+ *******************************************************************************
+ * @file state_machine_replay.c
+ *
+ * @brief Host replacement of state_machine.c that feeds the states with the
+ *        events of a capture taken on target, so a field failure can be
+ *        reproduced deterministically
+ *
+ * The real states (state_machine_states.c) are run one event at a time, the
+ * same way state_machine_task does it. Before each event is delivered, the
+ * tick count and the temperature are set to the values recorded with it, so
+ * the states see the same inputs they saw on target. Runs are started with the
+ * program recorded in the capture, not the one of the current profile.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "thermocouple_fake.h"
+#include "state_machine/states/state_machine_states.h"
+#include "state_machine/state_machine.h"
+#include "state_machine/state_machine_task.h"
+#include "state_machine/event_recorder.h"
+#include "state_machine_replay.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Maximum times a state is run for a single event. States failing
+ *        before waiting for an event don't consume it, but they go to another
+ *        state which will
+ */
+#define STATE_MACHINE_REPLAY_MAX_RUNS_PER_EVENT     (4)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+static size_t const m_state_map_size = sizeof(m_state_map) /
+                                       sizeof(m_state_map[0]);
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+static uint8_t const * m_p_capture = NULL;
+
+static size_t m_capture_size = 0;
+
+static uint16_t m_capture_count = 0;
+
+static uint16_t m_next_index = 0;
+
+static state_machine_event_t m_pending_event;
+
+static bool m_is_event_pending = false;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+bool state_machine_replay_load(uint8_t const * const p_capture,
+                               size_t const size)
+{
+        uint16_t count = 0;
+        bool success = event_recorder_get_capture_count(p_capture, size, &count);
+
+        if (success) {
+                m_p_capture = p_capture;
+                m_capture_size = size;
+                m_capture_count = count;
+                m_next_index = 0;
+                m_is_event_pending = false;
+
+                state_machine_states_set_entry_point_state();
+        }
+
+        return success;
+}
+
+bool state_machine_replay_step(state_machine_state_text_t * const p_state)
+{
+        event_recorder_record_t record;
+        state_machine_state_text_t state = STATE_MACHINE_STATE_COUNT;
+        size_t runs = 0;
+        bool success = ((NULL != p_state) && (m_capture_count > m_next_index));
+
+        if (success) {
+                success = event_recorder_get_capture_record(m_p_capture,
+                                                            m_capture_size,
+                                                            m_next_index,
+                                                            &record);
+        }
+
+        if (success) {
+                m_next_index++;
+
+                task_spy_set_tick_count(pdMS_TO_TICKS(record.time_ms));
+                thermocouple_fake_set_temperature(record.temperature);
+
+                m_pending_event.type = (state_machine_event_type_t)record.type;
+                m_pending_event.time_received = record.time_ms;
+
+                if (STATE_MACHINE_EVENT_TYPE_ACTION == m_pending_event.type) {
+                        m_pending_event.data.user_action =
+                                        (state_machine_action_t)record.data;
+                } else {
+                        m_pending_event.data.message =
+                                        (state_machine_msg_t)record.data;
+                }
+
+                m_is_event_pending = true;
+        }
+
+        // Run states, as state_machine_task does, until one takes the event
+        while ((success) && (m_is_event_pending)) {
+                success = ((STATE_MACHINE_REPLAY_MAX_RUNS_PER_EVENT > runs) &&
+                           (state_machine_get_state(&state)) &&
+                           (m_state_map_size > (size_t)state));
+
+                if (success) {
+                        m_state_map[state].function();
+                        runs++;
+                }
+        }
+
+        if (success) {
+                success = state_machine_get_state(p_state);
+        }
+
+        return success;
+}
+
+bool state_machine_replay_run(state_machine_state_text_t * const p_trace,
+                              size_t const trace_size,
+                              size_t * const p_trace_len)
+{
+        bool success = ((NULL != p_trace) && (NULL != p_trace_len));
+
+        if (success) {
+                *p_trace_len = 0;
+        }
+
+        while ((success) && (m_capture_count > m_next_index)) {
+                success = (trace_size > *p_trace_len);
+
+                if (success) {
+                        success = state_machine_replay_step(&p_trace[*p_trace_len]);
+                }
+
+                if (success) {
+                        (*p_trace_len)++;
+                }
+        }
+
+        return success;
+}
+
+bool state_machine_wait_for_event(uint32_t const time_ms,
+                                  state_machine_event_t * const p_event)
+{
+        bool success = ((NULL != p_event) && (m_is_event_pending));
+
+        if (success) {
+                *p_event = m_pending_event;
+                m_is_event_pending = false;
+        }
+
+        return success;
+}
+
+bool state_machine_send_event(state_machine_event_type_t const type,
+                              state_machine_data_t const data,
+                              uint32_t const timeout)
+{
+        // Events only come from the capture while replaying
+        return false;
+}
+
+state_machine_msg_t state_machine_get_timeout_msg(
+                state_machine_state_text_t const state)
+{
+        state_machine_msg_t message = STATE_MACHINE_MSG_COUNT;
+
+        if (m_state_map_size > (size_t)state) {
+                message = m_state_map[state].timeout_msg;
+        }
+
+        return message;
+}
+
+state_machine_state_text_t state_machine_pointer_to_text(
+                state_machine_state_t const state)
+{
+        state_machine_state_text_t text = STATE_MACHINE_STATE_COUNT;
+        size_t i;
+
+        for (i = 0; m_state_map_size > i; i++) {
+                if (state == m_state_map[i].function) {
+                        text = m_state_map[i].text;
+                }
+        }
+
+        return text;
+}
+
+char * state_machine_get_state_string(state_machine_state_text_t const state)
+{
+        char * p_string = NULL;
+
+        if (m_state_map_size > (size_t)state) {
+                p_string = m_state_map[state].string;
+        }
+
+        return p_string;
+}
+
+bool state_machine_load_program(reflow_program_t * const p_program)
+{
+        // The run is replayed against the program it was recorded with
+        return event_recorder_get_capture_program(m_p_capture, m_capture_size,
+                                                  p_program);
+}
+
+bool state_machine_save_capture(void)
+{
+        return true;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
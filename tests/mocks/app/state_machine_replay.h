@@ -0,0 +1,65 @@
+/*!
+ *******************************************************************************
+ * @file state_machine_replay.h
+ *
+ * @brief Host replacement of state_machine.c that feeds the states with the
+ *        events of a capture taken on target, so a field failure can be
+ *        reproduced deterministically
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef STATE_MACHINE_REPLAY_H
+#define STATE_MACHINE_REPLAY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+bool state_machine_replay_load(uint8_t const * const p_capture,
+                               size_t const size);
+
+bool state_machine_replay_step(state_machine_state_text_t * const p_state);
+
+bool state_machine_replay_run(state_machine_state_text_t * const p_trace,
+                              size_t const trace_size,
+                              size_t * const p_trace_len);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //STATE_MACHINE_REPLAY_H
@@ -0,0 +1,51 @@
+/*!
+ *******************************************************************************
+ * @file esp_log.h
+ *
+ * @brief Logging mock, log calls compile to nothing in the host build
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+#ifndef __FILENAME__
+#define __FILENAME__ __FILE__
+#endif // #ifndef __FILENAME__
+
+#define ESP_LOGE(tag, format, ...)  do { (void)(tag); } while (0)
+#define ESP_LOGW(tag, format, ...)  do { (void)(tag); } while (0)
+#define ESP_LOGI(tag, format, ...)  do { (void)(tag); } while (0)
+#define ESP_LOGD(tag, format, ...)  do { (void)(tag); } while (0)
+#define ESP_LOGV(tag, format, ...)  do { (void)(tag); } while (0)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+//! @brief Log levels, as in ESP-IDF
+typedef enum {
+        ESP_LOG_NONE = 0,
+        ESP_LOG_ERROR,
+        ESP_LOG_WARN,
+        ESP_LOG_INFO,
+        ESP_LOG_DEBUG,
+        ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+#endif //ESP_LOG_H
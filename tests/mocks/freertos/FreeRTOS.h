@@ -82,6 +82,26 @@ typedef uint32_t TickType_t;
 
 #define configTICK_RATE_HZ 1000
 #define pdMS_TO_TICKS( xTimeInMs )    ( ( TickType_t ) ( ( ( TickType_t ) ( xTimeInMs ) * ( TickType_t ) configTICK_RATE_HZ ) / ( TickType_t ) 1000U ) )
+#define pdTICKS_TO_MS( xTicks )       ( ( TickType_t ) ( ( uint64_t ) ( xTicks ) * 1000 / configTICK_RATE_HZ ) )
+
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+#define xTaskHandle                   TaskHandle_t
+
+// Tests run on a single thread, critical sections do nothing
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED  0
+#define taskENTER_CRITICAL(mux)       ((void)(mux))
+#define taskEXIT_CRITICAL(mux)        ((void)(mux))
+
+typedef enum
+{
+        eNoAction = 0,
+        eSetBits,
+        eIncrement,
+        eSetValueWithOverwrite,
+        eSetValueWithoutOverwrite
+} eNotifyAction;
 
 
 /*
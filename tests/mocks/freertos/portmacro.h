@@ -0,0 +1,21 @@
+/*!
+ *******************************************************************************
+ * @file portmacro.h
+ *
+ * @brief FreeRTOS port mock, the port macros are kept in the FreeRTOS mock
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include "freertos/FreeRTOS.h"
+
+#endif //PORTMACRO_H
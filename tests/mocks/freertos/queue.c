@@ -134,6 +134,9 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 debug("copy to -> %p, contents -> %p\n", pvBuffer, *(void**)pvBuffer);
 
                 memcpy((void *) pvBuffer, (void const *) m_queue, m_queue_item_size);
+
+                // Consume the item so a task loop can be stepped several times
+                memset((void *) m_queue, 0, m_queue_item_size);
         }
 
         return success;
@@ -64,6 +64,10 @@ static TaskHandle_t m_singe_handle ;
 
 static TaskFunction_t m_task_function = NULL;
 
+static TickType_t m_tick_count = 0;
+
+static uint32_t m_notify_count = 0;
+
 /*
  *******************************************************************************
  * Public Function Bodies                                                      *
@@ -104,11 +108,59 @@ void vTaskDelete( TaskHandle_t xTaskToDelete )
         free(xTaskToDelete);
 }
 
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify,
+                       uint32_t ulValue,
+                       eNotifyAction eAction)
+{
+        m_notify_count++;
+
+        return pdPASS;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry,
+                           uint32_t ulBitsToClearOnExit,
+                           uint32_t * pulNotificationValue,
+                           TickType_t xTicksToWait)
+{
+        return pdPASS;
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+        m_tick_count += xTicksToDelay;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+        return m_tick_count;
+}
+
+uint32_t ulTaskGetIdleRunTimeCounter(void)
+{
+        return 0;
+}
+
 void task_spy_get_task_function(TaskFunction_t * p_task_function)
 {
          *p_task_function = m_task_function;
 }
 
+void task_spy_set_tick_count(TickType_t const ticks)
+{
+        m_tick_count = ticks;
+}
+
+uint32_t task_spy_get_notify_count(void)
+{
+        return m_notify_count;
+}
+
+void task_spy_reset(void)
+{
+        m_tick_count = 0;
+        m_notify_count = 0;
+}
+
 /*
  *******************************************************************************
  * Private Function Bodies                                                     *
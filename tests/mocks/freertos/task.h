@@ -57,8 +57,29 @@ BaseType_t xTaskCreate(
 
 void vTaskDelete( TaskHandle_t xTaskToDelete );
 
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify,
+                       uint32_t ulValue,
+                       eNotifyAction eAction);
+
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry,
+                           uint32_t ulBitsToClearOnExit,
+                           uint32_t * pulNotificationValue,
+                           TickType_t xTicksToWait);
+
+void vTaskDelay(const TickType_t xTicksToDelay);
+
+TickType_t xTaskGetTickCount(void);
+
+uint32_t ulTaskGetIdleRunTimeCounter(void);
+
 void task_spy_get_task_function(TaskFunction_t * p_task_function);
 
+void task_spy_set_tick_count(TickType_t const ticks);
+
+uint32_t task_spy_get_notify_count(void);
+
+void task_spy_reset(void);
+
 #ifdef __cplusplus
 }
 #endif // #ifdef __cplusplus
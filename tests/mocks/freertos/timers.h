@@ -0,0 +1,28 @@
+/*!
+ *******************************************************************************
+ * @file timers.h
+ *
+ * @brief Software timers mock, only the declarations needed by the host build
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef TIMERS_H
+#define TIMERS_H
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+struct tmrTimerControl;
+typedef struct tmrTimerControl * TimerHandle_t;
+
+#endif //TIMERS_H
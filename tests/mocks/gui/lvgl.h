@@ -0,0 +1,29 @@
+/*!
+ *******************************************************************************
+ * @file lvgl.h
+ *
+ * @brief LVGL mock, only the types used by the GUI controllers headers
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef LVGL_H
+#define LVGL_H
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+typedef struct _lv_obj_t lv_obj_t;
+
+typedef uint8_t lv_event_t;
+
+#endif //LVGL_H
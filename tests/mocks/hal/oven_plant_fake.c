@@ -0,0 +1,163 @@
+/*!
+ *******************************************************************************
+ * @file oven_plant_fake.c
+ *
+ * @brief Simple thermal model of the oven, driven by the heater GPIO level and
+ *        feeding the thermocouple fake, so that closed loop behaviour can be
+ *        simulated in the host
+ *
+ * Two lumped masses are modelled: the heating element, which receives the
+ * heater power, and the oven load, where the thermocouple sits. The heat
+ * stored in the element is what makes the load keep heating after the heater
+ * switches off, so overshoot shows up as in the real oven.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "stddef.h"
+
+#include "driver/gpio_spy.h"
+#include "heater.h"
+#include "thermocouple_fake.h"
+#include "oven_plant_fake.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Heater power in watts
+#define OVEN_PLANT_HEATER_POWER_W           (1200.0f)
+
+//! @brief Heat capacity of the heating element in joules per celsius
+#define OVEN_PLANT_ELEMENT_CAPACITY_JC      (150.0f)
+
+//! @brief Heat capacity of the oven load in joules per celsius
+#define OVEN_PLANT_LOAD_CAPACITY_JC         (2500.0f)
+
+//! @brief Thermal conductance from element to load in watts per celsius
+#define OVEN_PLANT_ELEMENT_LOAD_WC          (12.0f)
+
+//! @brief Thermal conductance from load to ambient in watts per celsius
+#define OVEN_PLANT_LOAD_AMBIENT_WC          (2.0f)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+static float m_ambient_temperature = 25.0f;
+
+static float m_element_temperature = 25.0f;
+
+static float m_load_temperature = 25.0f;
+
+static bool m_is_heater_broken = false;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+void oven_plant_fake_init(float const ambient_temperature)
+{
+        m_ambient_temperature = ambient_temperature;
+        m_element_temperature = ambient_temperature;
+        m_load_temperature = ambient_temperature;
+        m_is_heater_broken = false;
+
+        thermocouple_fake_set_temperature((uint16_t)ambient_temperature);
+}
+
+void oven_plant_fake_set_heater_broken(bool const is_broken)
+{
+        m_is_heater_broken = is_broken;
+}
+
+void oven_plant_fake_step(uint32_t const step_ms)
+{
+        float const step_s = (float)step_ms / 1000.0f;
+        uint32_t level = 0;
+        float heater_power;
+        float element_to_load;
+        float load_to_ambient;
+
+        (void)gpio_spy_get_pin_level(HEATER_ACTIVE_HIGH_GPIO_PIN, &level);
+
+        heater_power = (0 != level) ? OVEN_PLANT_HEATER_POWER_W : 0.0f;
+
+        if (m_is_heater_broken) {
+                heater_power = 0.0f;
+        }
+
+        element_to_load = OVEN_PLANT_ELEMENT_LOAD_WC *
+                          (m_element_temperature - m_load_temperature);
+        load_to_ambient = OVEN_PLANT_LOAD_AMBIENT_WC *
+                          (m_load_temperature - m_ambient_temperature);
+
+        m_element_temperature += step_s * (heater_power - element_to_load) /
+                                 OVEN_PLANT_ELEMENT_CAPACITY_JC;
+        m_load_temperature += step_s * (element_to_load - load_to_ambient) /
+                              OVEN_PLANT_LOAD_CAPACITY_JC;
+
+        // The thermocouple truncates to whole degrees, as the MAX6675 does
+        thermocouple_fake_set_temperature((uint16_t)m_load_temperature);
+}
+
+float oven_plant_fake_get_temperature(void)
+{
+        return m_load_temperature;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
@@ -0,0 +1,65 @@
+/*!
+ *******************************************************************************
+ * @file oven_plant_fake.h
+ *
+ * @brief Simple thermal model of the oven, driven by the heater GPIO level and
+ *        feeding the thermocouple fake, so that closed loop behaviour can be
+ *        simulated in the host
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef OVEN_PLANT_FAKE_H
+#define OVEN_PLANT_FAKE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+void oven_plant_fake_init(float const ambient_temperature);
+
+void oven_plant_fake_set_heater_broken(bool const is_broken);
+
+void oven_plant_fake_step(uint32_t const step_ms);
+
+float oven_plant_fake_get_temperature(void);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //OVEN_PLANT_FAKE_H
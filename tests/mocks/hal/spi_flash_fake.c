@@ -0,0 +1,210 @@
+/*!
+ *******************************************************************************
+ * @file spi_flash_fake.c
+ *
+ * @brief NOR flash kept in RAM, with the same rules as the SPI flash emulator
+ *        of the NVS host tests, and power loss injection
+ *
+ * As with the emulator in components/nvs_flash/test_nvs_host, erasing sets
+ * every bit of a sector, writing can only clear bits and must be 4 byte
+ * aligned, and erases are counted per sector.
+ *
+ * Power loss is simulated by failing the n-th write or erase from a given
+ * point: a write is then cut halfway, and an erase leaves the sector
+ * untouched. Every later write or erase fails too, until power is restored
+ * with `spi_flash_fake_lose_power_at(0)` or the fake is initialized again.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "stddef.h"
+#include "string.h"
+
+#include "spi_flash_fake.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+static bool is_powered(void);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+static uint8_t m_memory[SPI_FLASH_FAKE_SECTORS_MAX * SPI_FLASH_FAKE_SECTOR_SIZE];
+
+static uint32_t m_erase_counts[SPI_FLASH_FAKE_SECTORS_MAX];
+
+static uint32_t m_sector_count = 0;
+
+//! @brief Operations left until power is lost, the last one included, 0 if
+//!        it is never lost
+static uint32_t m_operations_left = 0;
+
+static bool m_is_power_lost = false;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+void spi_flash_fake_init(uint32_t const sector_count)
+{
+        m_sector_count = ((SPI_FLASH_FAKE_SECTORS_MAX < sector_count) ?
+                          SPI_FLASH_FAKE_SECTORS_MAX : sector_count);
+
+        // Fresh chips come erased
+        (void)memset(m_memory, 0xFF, sizeof(m_memory));
+        (void)memset(m_erase_counts, 0, sizeof(m_erase_counts));
+
+        m_operations_left = 0;
+        m_is_power_lost = false;
+}
+
+void spi_flash_fake_lose_power_at(uint32_t const operation)
+{
+        m_operations_left = operation;
+        m_is_power_lost = false;
+}
+
+uint32_t spi_flash_fake_get_erase_count(uint32_t const sector)
+{
+        return ((m_sector_count > sector) ? m_erase_counts[sector] : 0);
+}
+
+uint32_t spi_flash_fake_get_sector_count(void)
+{
+        return m_sector_count;
+}
+
+bool spi_flash_fake_read(uint32_t const address,
+                         void * const p_data,
+                         size_t const size)
+{
+        bool const success = ((NULL != p_data) &&
+                              ((m_sector_count * SPI_FLASH_FAKE_SECTOR_SIZE) >=
+                               (address + size)));
+
+        if (success) {
+                (void)memcpy(p_data, &m_memory[address], size);
+        }
+
+        return success;
+}
+
+bool spi_flash_fake_write(uint32_t const address,
+                          void const * const p_data,
+                          size_t const size)
+{
+        uint8_t const * const p_bytes = (uint8_t const *)p_data;
+        size_t length = size;
+        size_t i;
+        bool success = ((NULL != p_data) &&
+                        (0 == (address % 4)) &&
+                        (0 == (size % 4)) &&
+                        ((m_sector_count * SPI_FLASH_FAKE_SECTOR_SIZE) >=
+                         (address + size)));
+
+        if (success) {
+                success = is_powered();
+
+                if (!success) {
+                        length = ((size / 2) & ~(size_t)3);
+                }
+        }
+
+        for (i = 0; (NULL != p_data) && (length > i) &&
+                    ((m_sector_count * SPI_FLASH_FAKE_SECTOR_SIZE) > (address + i)); i++) {
+                // Programming can only clear bits
+                m_memory[address + i] &= p_bytes[i];
+        }
+
+        return success;
+}
+
+bool spi_flash_fake_erase_sector(uint32_t const sector)
+{
+        bool const success = ((m_sector_count > sector) && (is_powered()));
+
+        if (success) {
+                (void)memset(&m_memory[sector * SPI_FLASH_FAKE_SECTOR_SIZE],
+                             0xFF,
+                             SPI_FLASH_FAKE_SECTOR_SIZE);
+                m_erase_counts[sector]++;
+        }
+
+        return success;
+}
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*!
+ * @brief Account an operation against the power loss countdown
+ *
+ * @param               -                   -
+ *
+ * @return              bool                Whether the operation goes through
+ */
+static bool is_powered(void)
+{
+        if ((!m_is_power_lost) && (0 != m_operations_left)) {
+                m_operations_left--;
+                m_is_power_lost = (0 == m_operations_left);
+        }
+
+        return !m_is_power_lost;
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
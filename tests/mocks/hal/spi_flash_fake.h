@@ -0,0 +1,79 @@
+/*!
+ *******************************************************************************
+ * @file spi_flash_fake.h
+ *
+ * @brief NOR flash kept in RAM, with the same rules as the SPI flash emulator
+ *        of the NVS host tests, and power loss injection
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+#ifndef SPI_FLASH_FAKE_H
+#define SPI_FLASH_FAKE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // #ifdef __cplusplus
+
+/*
+ *******************************************************************************
+ * Public Macros                                                               *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of a sector
+#define SPI_FLASH_FAKE_SECTOR_SIZE          (4096)
+
+//! @brief Largest number of sectors of the fake
+#define SPI_FLASH_FAKE_SECTORS_MAX          (16)
+
+/*
+ *******************************************************************************
+ * Public Data Types                                                           *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Constants                                                            *
+ *******************************************************************************
+ */
+
+
+/*
+ *******************************************************************************
+ * Public Function Prototypes                                                  *
+ *******************************************************************************
+ */
+
+void spi_flash_fake_init(uint32_t const sector_count);
+
+void spi_flash_fake_lose_power_at(uint32_t const operation);
+
+uint32_t spi_flash_fake_get_erase_count(uint32_t const sector);
+
+uint32_t spi_flash_fake_get_sector_count(void);
+
+bool spi_flash_fake_read(uint32_t const address,
+                         void * const p_data,
+                         size_t const size);
+
+bool spi_flash_fake_write(uint32_t const address,
+                          void const * const p_data,
+                          size_t const size);
+
+bool spi_flash_fake_erase_sector(uint32_t const sector);
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif //SPI_FLASH_FAKE_H
@@ -23,6 +23,7 @@
 #include "stdbool.h"
 #include "stddef.h"
 
+#include "freertos/FreeRTOS.h"
 #include "thermocouple.h"
 
 /*
@@ -55,6 +56,9 @@
  *******************************************************************************
  */
 
+//! @brief Handle of the thermocouple task, notified by the state machine
+xTaskHandle m_thermocouple_task_h = NULL;
+
 /*
  *******************************************************************************
  * Static Data Declarations                                                    *
@@ -63,6 +67,8 @@
 
 static uint16_t m_fake_temperatures = 0;
 
+static uint32_t m_fake_update_time_ms = 0;
+
 /*
  *******************************************************************************
  * Public Function Bodies                                                      *
@@ -85,6 +91,27 @@ bool thermocouple_fake_get_temperature(uint16_t * const temperature)
         return temperature;
 }
 
+bool thermocouple_get_avg_temperature(uint16_t * const p_avg_temperature)
+{
+        return thermocouple_fake_get_temperature(p_avg_temperature);
+}
+
+void thermocouple_fake_set_last_update_time(uint32_t const time_ms)
+{
+        m_fake_update_time_ms = time_ms;
+}
+
+bool thermocouple_get_last_update_time(uint32_t * const p_time_ms)
+{
+        bool const success = (NULL != p_time_ms);
+
+        if (success) {
+                *p_time_ms = m_fake_update_time_ms;
+        }
+
+        return success;
+}
+
 /*
  *******************************************************************************
  * Private Function Bodies                                                     *
@@ -51,6 +51,8 @@ void thermocouple_fake_set_temperature(uint16_t const temperature);
 
 bool thermocouple_fake_get_temperature(uint16_t * const temperature);
 
+void thermocouple_fake_set_last_update_time(uint32_t const time_ms);
+
 #ifdef __cplusplus
 }
 #endif // #ifdef __cplusplus
@@ -0,0 +1,328 @@
+/*!
+ *******************************************************************************
+ * @file pause_resume_tests.cpp
+ *
+ * @brief Checks on the run pause/resume: timing of the pausable clock and
+ *        temperature hold of the heater controller on a simulated oven
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "driver/gpio_spy.h"
+
+#include "thermocouple.h"
+#include "thermocouple_fake.h"
+#include "oven_plant_fake.h"
+#include "heater.h"
+#include "reflow_clock.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Period of the heater task loop
+#define SIMULATION_STEP_MS                  (100)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Maximum allowed deviation from the held temperature while paused
+static float const m_hold_band_degrees = 5.0f;
+
+//! @brief Maximum allowed overshoot over the target after resuming
+static float const m_resume_overshoot_degrees = 10.0f;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(reflow_clock)
+{
+        reflow_clock_t clock;
+
+        void setup()
+        {
+                (void)reflow_clock_start(&clock, 1000);
+        }
+};
+
+TEST(reflow_clock, elapsed_excludes_pause)
+{
+        uint32_t elapsed = 0;
+
+        CHECK_TRUE(reflow_clock_pause(&clock, 4000));
+        CHECK_TRUE(reflow_clock_get_elapsed(&clock, 9000, &elapsed));
+        UNSIGNED_LONGS_EQUAL(3000, elapsed);
+
+        CHECK_TRUE(reflow_clock_resume(&clock, 10000));
+        CHECK_TRUE(reflow_clock_get_elapsed(&clock, 12000, &elapsed));
+        UNSIGNED_LONGS_EQUAL(5000, elapsed);
+}
+
+TEST(reflow_clock, remaining_is_kept_across_pause)
+{
+        uint32_t remaining_before = 0;
+        uint32_t remaining_after = 0;
+
+        CHECK_TRUE(reflow_clock_pause(&clock, 21000));
+        CHECK_TRUE(reflow_clock_get_remaining(&clock, 21000, 60000,
+                                              &remaining_before));
+        CHECK_TRUE(reflow_clock_resume(&clock, 51000));
+        CHECK_TRUE(reflow_clock_get_remaining(&clock, 51000, 60000,
+                                              &remaining_after));
+
+        UNSIGNED_LONGS_EQUAL(40000, remaining_before);
+        UNSIGNED_LONGS_EQUAL(remaining_before, remaining_after);
+}
+
+TEST(reflow_clock, remaining_saturates_at_zero)
+{
+        uint32_t remaining = 1;
+
+        CHECK_TRUE(reflow_clock_get_remaining(&clock, 70000, 60000, &remaining));
+        UNSIGNED_LONGS_EQUAL(0, remaining);
+}
+
+TEST(reflow_clock, elapsed_survives_time_wrap_around)
+{
+        uint32_t elapsed = 0;
+
+        CHECK_TRUE(reflow_clock_start(&clock, UINT32_MAX - 499));
+        CHECK_TRUE(reflow_clock_pause(&clock, 500));
+        CHECK_TRUE(reflow_clock_resume(&clock, 1500));
+        CHECK_TRUE(reflow_clock_get_elapsed(&clock, 2500, &elapsed));
+
+        UNSIGNED_LONGS_EQUAL(2000, elapsed);
+}
+
+TEST(reflow_clock, pause_twice_fails)
+{
+        CHECK_TRUE(reflow_clock_pause(&clock, 2000));
+        CHECK_FALSE(reflow_clock_pause(&clock, 3000));
+        CHECK_TRUE(reflow_clock_is_paused(&clock));
+}
+
+TEST(reflow_clock, resume_not_paused_fails)
+{
+        CHECK_FALSE(reflow_clock_resume(&clock, 2000));
+}
+
+TEST(reflow_clock, stopped_clock_has_no_elapsed_time)
+{
+        uint32_t elapsed = 0;
+
+        CHECK_TRUE(reflow_clock_stop(&clock));
+        CHECK_FALSE(reflow_clock_get_elapsed(&clock, 2000, &elapsed));
+        CHECK_FALSE(reflow_clock_pause(&clock, 2000));
+}
+
+TEST_GROUP(pause_resume_simulation)
+{
+        TaskFunction_t task_function;
+        uint32_t now_ms;
+
+        void setup()
+        {
+                gpio_spy_init();
+                queue_spy_create();
+                oven_plant_fake_init(25.0f);
+                (void)heater_init((heater_temp_getter_t)thermocouple_fake_get_temperature);
+                task_spy_get_task_function(&task_function);
+                now_ms = 0;
+        }
+
+        void teardown()
+        {
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_deinit());
+                queue_spy_destroy();
+                gpio_spy_deinit();
+        }
+
+        void step(void)
+        {
+                task_function(NULL);
+                oven_plant_fake_step(SIMULATION_STEP_MS);
+                now_ms += SIMULATION_STEP_MS;
+        }
+
+        void run_to(uint16_t const target)
+        {
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_set_target(target));
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+        }
+};
+
+TEST(pause_resume_simulation, paused_temperature_is_held)
+{
+        uint16_t hold_temperature = 0;
+        float min_temperature;
+        float max_temperature;
+        float temperature;
+
+        run_to(180);
+
+        while (oven_plant_fake_get_temperature() < 120.0f) {
+                step();
+        }
+
+        // Pause: hold the temperature measured at that moment
+        CHECK_TRUE(thermocouple_fake_get_temperature(&hold_temperature));
+        run_to(hold_temperature);
+
+        min_temperature = oven_plant_fake_get_temperature();
+        max_temperature = min_temperature;
+
+        for (uint32_t i = 0; i < (120 * 1000 / SIMULATION_STEP_MS); i++) {
+                step();
+                temperature = oven_plant_fake_get_temperature();
+
+                if (temperature < min_temperature) {
+                        min_temperature = temperature;
+                }
+
+                if (temperature > max_temperature) {
+                        max_temperature = temperature;
+                }
+        }
+
+        CHECK_TRUE(max_temperature <= (hold_temperature + m_hold_band_degrees));
+        CHECK_TRUE(min_temperature >= (hold_temperature - m_hold_band_degrees));
+}
+
+TEST(pause_resume_simulation, resume_reaches_target_with_bounded_overshoot)
+{
+        uint16_t hold_temperature = 0;
+        uint16_t const target = 180;
+        float max_temperature = 0.0f;
+        bool is_target_reached = false;
+
+        run_to(target);
+
+        while (oven_plant_fake_get_temperature() < 120.0f) {
+                step();
+        }
+
+        CHECK_TRUE(thermocouple_fake_get_temperature(&hold_temperature));
+        run_to(hold_temperature);
+
+        for (uint32_t i = 0; i < (60 * 1000 / SIMULATION_STEP_MS); i++) {
+                step();
+        }
+
+        // Resume: the state restores its own target
+        run_to(target);
+
+        for (uint32_t i = 0; i < (600 * 1000 / SIMULATION_STEP_MS); i++) {
+                step();
+
+                if (oven_plant_fake_get_temperature() > max_temperature) {
+                        max_temperature = oven_plant_fake_get_temperature();
+                }
+
+                if (oven_plant_fake_get_temperature() >= target) {
+                        is_target_reached = true;
+                }
+        }
+
+        CHECK_TRUE(is_target_reached);
+        CHECK_TRUE(max_temperature <= (target + m_resume_overshoot_degrees));
+}
+
+TEST(pause_resume_simulation, phase_time_is_kept_across_pause)
+{
+        uint32_t const phase_ms = 60000;
+        uint32_t const pause_ms = 30000;
+        uint32_t phase_start_ms;
+        uint32_t remaining = 1;
+        reflow_clock_t clock;
+        uint16_t hold_temperature = 0;
+
+        run_to(150);
+        phase_start_ms = now_ms;
+        CHECK_TRUE(reflow_clock_start(&clock, now_ms));
+
+        while (now_ms - phase_start_ms < 20000) {
+                step();
+        }
+
+        CHECK_TRUE(reflow_clock_pause(&clock, now_ms));
+        CHECK_TRUE(thermocouple_fake_get_temperature(&hold_temperature));
+        run_to(hold_temperature);
+
+        for (uint32_t i = 0; i < (pause_ms / SIMULATION_STEP_MS); i++) {
+                step();
+        }
+
+        CHECK_TRUE(reflow_clock_resume(&clock, now_ms));
+        run_to(150);
+
+        while (0 != remaining) {
+                step();
+                CHECK_TRUE(reflow_clock_get_remaining(&clock, now_ms, phase_ms,
+                                                      &remaining));
+        }
+
+        // Timing error is bounded by one step of the control loop
+        CHECK_TRUE((now_ms - phase_start_ms - pause_ms) >= phase_ms);
+        CHECK_TRUE((now_ms - phase_start_ms - pause_ms) <= (phase_ms + SIMULATION_STEP_MS));
+}
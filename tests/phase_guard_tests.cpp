@@ -0,0 +1,257 @@
+/*!
+ *******************************************************************************
+ * @file phase_guard_tests.cpp
+ *
+ * @brief Checks on the heating phase deadlines and stall detection, alone and
+ *        on a simulated oven with a healthy and a broken heater
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "driver/gpio_spy.h"
+
+#include "thermocouple.h"
+#include "thermocouple_fake.h"
+#include "oven_plant_fake.h"
+#include "heater.h"
+#include "phase_guard.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Period of the heater task loop
+#define SIMULATION_STEP_MS                  (100)
+
+//! @brief Period of the thermocouple sampling during heating phases (4 Hz)
+#define SAMPLE_PERIOD_MS                    (250)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(phase_guard)
+{
+        phase_guard_t guard;
+};
+
+TEST(phase_guard, deadline_scales_with_delta_over_ramp)
+{
+        uint32_t deadline_ms = 0;
+
+        CHECK_TRUE(phase_guard_get_heating_deadline(20, 170, 5, &deadline_ms));
+
+        UNSIGNED_LONGS_EQUAL(((150 / 5) * PHASE_GUARD_DEADLINE_FACTOR +
+                              PHASE_GUARD_DEADLINE_MARGIN_S) * 1000,
+                             deadline_ms);
+}
+
+TEST(phase_guard, deadline_when_already_at_target_is_margin)
+{
+        uint32_t deadline_ms = 0;
+
+        CHECK_TRUE(phase_guard_get_heating_deadline(200, 170, 5, &deadline_ms));
+
+        UNSIGNED_LONGS_EQUAL(PHASE_GUARD_DEADLINE_MARGIN_S * 1000, deadline_ms);
+}
+
+TEST(phase_guard, null_ramp_speed_fails)
+{
+        uint32_t deadline_ms = 0;
+
+        CHECK_FALSE(phase_guard_get_heating_deadline(20, 170, 0, &deadline_ms));
+        CHECK_FALSE(phase_guard_start_heating(&guard, 0, 20, 170, 0));
+}
+
+TEST(phase_guard, inactive_guard_is_ok)
+{
+        CHECK_TRUE(phase_guard_start_timed(&guard, 0, 1000));
+        CHECK_TRUE(phase_guard_stop(&guard));
+
+        ENUMS_EQUAL_INT(PHASE_GUARD_RESULT_OK,
+                        phase_guard_check(&guard, 100000, 20));
+}
+
+TEST(phase_guard, timed_phase_times_out)
+{
+        CHECK_TRUE(phase_guard_start_timed(&guard, 5000, 100000));
+
+        ENUMS_EQUAL_INT(PHASE_GUARD_RESULT_OK,
+                        phase_guard_check(&guard, 105000, 100));
+        ENUMS_EQUAL_INT(PHASE_GUARD_RESULT_TIMEOUT,
+                        phase_guard_check(&guard, 105001, 100));
+}
+
+TEST(phase_guard, plateau_below_target_times_out)
+{
+        uint32_t deadline_ms = 0;
+        uint32_t now_ms = 0;
+        uint16_t temperature = 100;
+        phase_guard_result_t result = PHASE_GUARD_RESULT_OK;
+
+        CHECK_TRUE(phase_guard_get_heating_deadline(100, 200, 1, &deadline_ms));
+        CHECK_TRUE(phase_guard_start_heating(&guard, 0, 100, 200, 1));
+
+        // Rising just enough to never stall, but levelling off before target
+        while ((PHASE_GUARD_RESULT_OK == result) && (now_ms <= deadline_ms)) {
+                now_ms += SAMPLE_PERIOD_MS;
+
+                if ((0 == (now_ms % PHASE_GUARD_STALL_WINDOW_MS)) &&
+                    (190 > temperature)) {
+                        temperature += 2;
+                }
+
+                result = phase_guard_check(&guard, now_ms, temperature);
+        }
+
+        ENUMS_EQUAL_INT(PHASE_GUARD_RESULT_TIMEOUT, result);
+        CHECK_TRUE(now_ms <= (deadline_ms + SAMPLE_PERIOD_MS));
+}
+
+TEST(phase_guard, no_rise_is_too_slow)
+{
+        CHECK_TRUE(phase_guard_start_heating(&guard, 0, 100, 200, 10));
+
+        ENUMS_EQUAL_INT(PHASE_GUARD_RESULT_OK,
+                        phase_guard_check(&guard, PHASE_GUARD_STALL_WINDOW_MS - 1,
+                                          100));
+        ENUMS_EQUAL_INT(PHASE_GUARD_RESULT_TOO_SLOW,
+                        phase_guard_check(&guard, PHASE_GUARD_STALL_WINDOW_MS,
+                                          100));
+}
+
+TEST_GROUP(phase_guard_simulation)
+{
+        TaskFunction_t task_function;
+        phase_guard_t guard;
+        uint32_t now_ms;
+
+        void setup()
+        {
+                gpio_spy_init();
+                queue_spy_create();
+                oven_plant_fake_init(25.0f);
+                (void)heater_init((heater_temp_getter_t)thermocouple_fake_get_temperature);
+                task_spy_get_task_function(&task_function);
+                now_ms = 0;
+        }
+
+        void teardown()
+        {
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_deinit());
+                queue_spy_destroy();
+                gpio_spy_deinit();
+        }
+
+        /*
+         * Heat to the target as the heating state does, checking the guard as
+         * thermocouple_task does. Returns the first guard failure, if any
+         */
+        phase_guard_result_t heat_to(uint16_t const target,
+                                     uint16_t const ramp_speed,
+                                     uint32_t const max_ms)
+        {
+                phase_guard_result_t result = PHASE_GUARD_RESULT_OK;
+                uint16_t temperature = 0;
+
+                (void)thermocouple_fake_get_temperature(&temperature);
+                CHECK_TRUE(phase_guard_start_heating(&guard, now_ms, temperature,
+                                                     target, ramp_speed));
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_set_target(target));
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+
+                while ((PHASE_GUARD_RESULT_OK == result) &&
+                       (target > temperature) &&
+                       (now_ms < max_ms)) {
+                        task_function(NULL);
+                        oven_plant_fake_step(SIMULATION_STEP_MS);
+                        now_ms += SIMULATION_STEP_MS;
+
+                        (void)thermocouple_fake_get_temperature(&temperature);
+
+                        if (0 == (now_ms % SAMPLE_PERIOD_MS)) {
+                                result = phase_guard_check(&guard, now_ms,
+                                                           temperature);
+                        }
+                }
+
+                return result;
+        }
+};
+
+TEST(phase_guard_simulation, healthy_heater_reaches_target)
+{
+        ENUMS_EQUAL_INT(PHASE_GUARD_RESULT_OK, heat_to(150, 1, 3600 * 1000));
+        CHECK_TRUE(150 <= oven_plant_fake_get_temperature());
+}
+
+TEST(phase_guard_simulation, broken_heater_fails_within_one_window)
+{
+        oven_plant_fake_set_heater_broken(true);
+
+        ENUMS_EQUAL_INT(PHASE_GUARD_RESULT_TOO_SLOW, heat_to(150, 1, 3600 * 1000));
+        CHECK_TRUE(now_ms <= (PHASE_GUARD_STALL_WINDOW_MS + SAMPLE_PERIOD_MS));
+}
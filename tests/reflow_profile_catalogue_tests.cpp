@@ -0,0 +1,485 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_catalogue_tests.cpp
+ *
+ * @brief Checks on the in-RAM profile catalogue, and on a full one against
+ *        walking the stored entries on every call, as it was done before
+ *
+ * With TESTS_PRINT_BENCHMARKS, the list and load latency of both ways is also
+ * timed and printed.
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#if TESTS_PRINT_BENCHMARKS
+#include <chrono>
+#endif // #if TESTS_PRINT_BENCHMARKS
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "CppUTest/TestHarness.h"
+
+#include "reflow_profile_catalogue.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Number of times the list is read without changing the catalogue
+#define LIST_READ_COUNT                     (100)
+
+//! @brief Number of calls timed on each benchmark
+#define BENCHMARK_ITERATIONS                (20000)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+//! @brief Stored entries, as the NVS iterator hands them out
+typedef struct {
+        reflow_profile_t entries[REFLOW_PROFILE_CATALOGUE_SLOTS_CNT];
+        uint8_t count;
+} stored_profiles_t;
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+static reflow_profile_t make_profile(char const * const p_name)
+{
+        reflow_profile_t profile = {"", 150, 60, 230, 30, 60, 300, 2};
+
+        strncpy(profile.name, p_name, REFLOW_PROFILE_NAME_LEN_MAX);
+
+        return profile;
+}
+
+//! @brief List built the way it was before the catalogue: count, then strcat
+static char * uncached_list(stored_profiles_t const * const p_stored)
+{
+        size_t counter = 0;
+        char * buffer;
+        uint8_t i;
+
+        for (i = 0; p_stored->count > i; i++) {
+                counter += strlen(p_stored->entries[i].name) + 1;
+        }
+
+        buffer = (char *)malloc(counter + 1);
+        strcpy(buffer, "");
+
+        for (i = 0; p_stored->count > i; i++) {
+                strcat(buffer, p_stored->entries[i].name);
+                strcat(buffer, "\n");
+        }
+
+        return buffer;
+}
+
+//! @brief Load the way it was before the catalogue: look up, copy, validate
+static bool uncached_load(stored_profiles_t const * const p_stored,
+                          char const * const p_name,
+                          reflow_profile_t * const p_profile)
+{
+        reflow_profile_t buffer;
+        bool found = false;
+        uint8_t i;
+
+        for (i = 0; (!found) && (p_stored->count > i); i++) {
+                found = (0 == strcmp(p_stored->entries[i].name, p_name));
+
+                if (found) {
+                        memcpy(&buffer, &p_stored->entries[i], sizeof(buffer));
+                }
+        }
+
+        if (found) {
+                found = ((REFLOW_PROFILE_NAME_LEN_MAX >= strlen(buffer.name)) &&
+                         (0 < buffer.ramp_speed));
+                *p_profile = buffer;
+        }
+
+        return found;
+}
+
+#if TESTS_PRINT_BENCHMARKS
+static double elapsed_ns(std::chrono::steady_clock::time_point const start)
+{
+        std::chrono::duration<double, std::nano> const elapsed =
+                std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / BENCHMARK_ITERATIONS;
+}
+#endif // #if TESTS_PRINT_BENCHMARKS
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(reflow_profile_catalogue)
+{
+        reflow_profile_catalogue_t catalogue;
+        reflow_profile_t profile;
+        char const * p_list;
+        size_t list_size;
+
+        void setup()
+        {
+                CHECK_TRUE(reflow_profile_catalogue_init(&catalogue));
+                p_list = NULL;
+                list_size = 0;
+        }
+
+        void put(char const * const p_name)
+        {
+                profile = make_profile(p_name);
+                CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+        }
+
+        void check_list(char const * const p_expected)
+        {
+                CHECK_TRUE(reflow_profile_catalogue_get_list(&catalogue, &p_list,
+                                                             &list_size));
+                STRCMP_EQUAL(p_expected, p_list);
+                UNSIGNED_LONGS_EQUAL(strlen(p_expected), list_size);
+        }
+};
+
+TEST(reflow_profile_catalogue, empty_list)
+{
+        check_list("");
+}
+
+TEST(reflow_profile_catalogue, slot_is_list_position)
+{
+        uint8_t slot = UINT8_MAX;
+
+        put("Sn60Pb40");
+        put("SAC305");
+        put("bake");
+
+        check_list("Sn60Pb40\nSAC305\nbake\n");
+        CHECK_TRUE(reflow_profile_catalogue_find(&catalogue, "bake", &slot));
+        UNSIGNED_LONGS_EQUAL(2, slot);
+        CHECK_FALSE(reflow_profile_catalogue_find(&catalogue, "SAC", &slot));
+}
+
+TEST(reflow_profile_catalogue, get_copies_stored_profile)
+{
+        reflow_profile_t loaded;
+
+        put("SAC305");
+        profile.reflow_temperature = 245;
+        CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+
+        CHECK_TRUE(reflow_profile_catalogue_get(&catalogue, "SAC305", &loaded));
+        MEMCMP_EQUAL(&profile, &loaded, sizeof(loaded));
+        UNSIGNED_LONGS_EQUAL(1, catalogue.count);
+}
+
+TEST(reflow_profile_catalogue, list_is_only_built_after_a_change)
+{
+        put("Sn60Pb40");
+        check_list("Sn60Pb40\n");
+        CHECK_FALSE(catalogue.is_list_dirty);
+
+        // Replacing a profile doesn't change the names
+        profile.soak_time_s = 90;
+        CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+        CHECK_FALSE(catalogue.is_list_dirty);
+
+        put("SAC305");
+        CHECK_TRUE(catalogue.is_list_dirty);
+        check_list("Sn60Pb40\nSAC305\n");
+}
+
+TEST(reflow_profile_catalogue, remove_keeps_order)
+{
+        put("a");
+        put("b");
+        put("c");
+
+        CHECK_TRUE(reflow_profile_catalogue_remove(&catalogue, "a"));
+        check_list("b\nc\n");
+        CHECK_FALSE(reflow_profile_catalogue_remove(&catalogue, "a"));
+}
+
+TEST(reflow_profile_catalogue, full_catalogue_refuses_new_names)
+{
+        char name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+        uint8_t i;
+
+        for (i = 0; REFLOW_PROFILE_CATALOGUE_SLOTS_CNT > i; i++) {
+                snprintf(name, sizeof(name), "profile_%u", i);
+                put(name);
+        }
+
+        profile = make_profile("one_too_many");
+        CHECK_FALSE(reflow_profile_catalogue_put(&catalogue, &profile));
+
+        // Existing ones can still be replaced
+        profile = make_profile("profile_0");
+        CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+}
+
+TEST(reflow_profile_catalogue, longest_names_fit_the_list)
+{
+        char name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+        uint8_t i;
+
+        for (i = 0; REFLOW_PROFILE_CATALOGUE_SLOTS_CNT > i; i++) {
+                memset(name, 'a' + i, REFLOW_PROFILE_NAME_LEN_MAX);
+                name[REFLOW_PROFILE_NAME_LEN_MAX] = '\0';
+                put(name);
+        }
+
+        CHECK_TRUE(reflow_profile_catalogue_get_list(&catalogue, &p_list,
+                                                     &list_size));
+        UNSIGNED_LONGS_EQUAL(REFLOW_PROFILE_CATALOGUE_LIST_SIZE - 1, list_size);
+}
+
+TEST(reflow_profile_catalogue, program_follows_its_profile)
+{
+        reflow_program_t program;
+        reflow_program_t loaded;
+
+        put("a");
+        put("b");
+        CHECK_TRUE(reflow_program_from_profile(&profile, &program));
+
+        CHECK_FALSE(reflow_profile_catalogue_get_program(&catalogue, "b", &loaded));
+        CHECK_TRUE(reflow_profile_catalogue_set_program(&catalogue, "b", &program));
+
+        // Removing a previous profile moves the program along with its slot
+        CHECK_TRUE(reflow_profile_catalogue_remove(&catalogue, "a"));
+        CHECK_TRUE(reflow_profile_catalogue_get_program(&catalogue, "b", &loaded));
+        MEMCMP_EQUAL(&program, &loaded, sizeof(loaded));
+
+        CHECK_TRUE(reflow_profile_catalogue_set_program(&catalogue, "b", NULL));
+        CHECK_FALSE(reflow_profile_catalogue_get_program(&catalogue, "b", &loaded));
+}
+
+TEST_GROUP(reflow_profile_catalogue_full)
+{
+        reflow_profile_catalogue_t catalogue;
+        stored_profiles_t stored;
+
+        void setup()
+        {
+                char name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+                uint8_t i;
+
+                (void)reflow_profile_catalogue_init(&catalogue);
+                stored.count = 0;
+
+                for (i = 0; REFLOW_PROFILE_CATALOGUE_SLOTS_CNT > i; i++) {
+                        snprintf(name, sizeof(name), "profile_%02u", i);
+                        stored.entries[i] = make_profile(name);
+                        stored.count++;
+                        (void)reflow_profile_catalogue_put(&catalogue,
+                                                           &stored.entries[i]);
+                }
+        }
+};
+
+TEST(reflow_profile_catalogue_full, list_is_not_built_again_on_reads)
+{
+        char const * p_first = NULL;
+        char const * p_list = NULL;
+        size_t first_size = 0;
+        size_t list_size = 0;
+        char * p_uncached;
+        uint32_t i;
+
+        CHECK_TRUE(reflow_profile_catalogue_get_list(&catalogue, &p_first,
+                                                     &first_size));
+        p_uncached = uncached_list(&stored);
+        STRCMP_EQUAL(p_uncached, p_first);
+        UNSIGNED_LONGS_EQUAL(strlen(p_uncached), first_size);
+
+        // Reads keep handing out the same list
+        for (i = 0; LIST_READ_COUNT > i; i++) {
+                CHECK_TRUE(reflow_profile_catalogue_get_list(&catalogue, &p_list,
+                                                             &list_size));
+                POINTERS_EQUAL(p_first, p_list);
+                UNSIGNED_LONGS_EQUAL(first_size, list_size);
+        }
+
+        STRCMP_EQUAL(p_uncached, p_list);
+        free(p_uncached);
+
+        // Changing the catalogue does rebuild it
+        CHECK_TRUE(reflow_profile_catalogue_remove(&catalogue, "profile_09"));
+        stored.count--;
+        CHECK_TRUE(reflow_profile_catalogue_get_list(&catalogue, &p_list,
+                                                     &list_size));
+        p_uncached = uncached_list(&stored);
+        STRCMP_EQUAL(p_uncached, p_list);
+        UNSIGNED_LONGS_EQUAL(strlen(p_uncached), list_size);
+        free(p_uncached);
+}
+
+TEST(reflow_profile_catalogue_full, load_matches_the_stored_entries)
+{
+        reflow_profile_t expected;
+        reflow_profile_t profile;
+        uint8_t i;
+
+        for (i = 0; stored.count > i; i++) {
+                CHECK_TRUE(uncached_load(&stored, stored.entries[i].name,
+                                         &expected));
+                CHECK_TRUE(reflow_profile_catalogue_get(&catalogue,
+                                                        stored.entries[i].name,
+                                                        &profile));
+                MEMCMP_EQUAL(&expected, &profile, sizeof(profile));
+        }
+
+        CHECK_FALSE(reflow_profile_catalogue_get(&catalogue, "profile_99",
+                                                 &profile));
+}
+
+#if TESTS_PRINT_BENCHMARKS
+TEST_GROUP(reflow_profile_catalogue_benchmark)
+{
+        reflow_profile_catalogue_t catalogue;
+        stored_profiles_t stored;
+
+        void setup()
+        {
+                char name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+                uint8_t i;
+
+                (void)reflow_profile_catalogue_init(&catalogue);
+                stored.count = 0;
+
+                for (i = 0; REFLOW_PROFILE_CATALOGUE_SLOTS_CNT > i; i++) {
+                        snprintf(name, sizeof(name), "profile_%02u", i);
+                        stored.entries[i] = make_profile(name);
+                        stored.count++;
+                        (void)reflow_profile_catalogue_put(&catalogue,
+                                                           &stored.entries[i]);
+                }
+        }
+};
+
+TEST(reflow_profile_catalogue_benchmark, list_latency)
+{
+        char const * p_list = NULL;
+        size_t list_size = 0;
+        char * p_uncached;
+        std::chrono::steady_clock::time_point start;
+        double uncached_ns;
+        double cached_ns;
+        uint32_t i;
+
+        start = std::chrono::steady_clock::now();
+
+        for (i = 0; BENCHMARK_ITERATIONS > i; i++) {
+                p_uncached = uncached_list(&stored);
+                free(p_uncached);
+        }
+
+        uncached_ns = elapsed_ns(start);
+        start = std::chrono::steady_clock::now();
+
+        for (i = 0; BENCHMARK_ITERATIONS > i; i++) {
+                (void)reflow_profile_catalogue_get_list(&catalogue, &p_list,
+                                                        &list_size);
+        }
+
+        cached_ns = elapsed_ns(start);
+
+        printf("\nbenchmark list, %u profiles: uncached %.1f ns, cached %.1f ns\n",
+               stored.count, uncached_ns, cached_ns);
+
+        p_uncached = uncached_list(&stored);
+        STRCMP_EQUAL(p_uncached, p_list);
+        free(p_uncached);
+}
+
+TEST(reflow_profile_catalogue_benchmark, load_latency)
+{
+        reflow_profile_t profile;
+        std::chrono::steady_clock::time_point start;
+        double uncached_ns;
+        double cached_ns;
+        uint32_t i;
+
+        start = std::chrono::steady_clock::now();
+
+        for (i = 0; BENCHMARK_ITERATIONS > i; i++) {
+                (void)uncached_load(&stored,
+                                    stored.entries[i % stored.count].name,
+                                    &profile);
+        }
+
+        uncached_ns = elapsed_ns(start);
+        start = std::chrono::steady_clock::now();
+
+        for (i = 0; BENCHMARK_ITERATIONS > i; i++) {
+                (void)reflow_profile_catalogue_get(&catalogue,
+                                                   stored.entries[i % stored.count].name,
+                                                   &profile);
+        }
+
+        cached_ns = elapsed_ns(start);
+
+        // On target the uncached load also pays an NVS open, read and close
+        printf("\nbenchmark load, %u profiles: uncached %.1f ns, cached %.1f ns\n",
+               stored.count, uncached_ns, cached_ns);
+
+        CHECK_TRUE(reflow_profile_catalogue_get(&catalogue, "profile_09", &profile));
+        MEMCMP_EQUAL(&stored.entries[9], &profile, sizeof(profile));
+}
+#endif // #if TESTS_PRINT_BENCHMARKS
@@ -0,0 +1,379 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_codec_tests.cpp
+ *
+ * @brief Checks on the profile records encoding: round trips, migration of
+ *        profiles stored as a copy of their struct, forward compatibility and
+ *        fuzzing of the decoders with random and mutated input
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <cstring>
+
+#include "CppUTest/TestHarness.h"
+
+#include "byte_codec.h"
+#include "reflow_profile_codec.h"
+#include "reflow_profile_store.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Number of random inputs tried on each check
+#define ROUNDS_CNT                          (2000)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+//! @brief Get the next pseudo random number, fixed seed so runs are repeatable
+static uint32_t next_random(void);
+
+//! @brief Fill a profile with random fields and name
+static void random_profile(reflow_profile_t * const p_profile);
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief State of the pseudo random generator
+static uint32_t m_random_state;
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+static uint32_t next_random(void)
+{
+        // xorshift32
+        m_random_state ^= m_random_state << 13;
+        m_random_state ^= m_random_state >> 17;
+        m_random_state ^= m_random_state << 5;
+
+        return m_random_state;
+}
+
+static void random_profile(reflow_profile_t * const p_profile)
+{
+        size_t const name_len = 1 + (next_random() % REFLOW_PROFILE_NAME_LEN_MAX);
+        size_t i;
+
+        memset(p_profile, 0, sizeof(*p_profile));
+
+        for (i = 0; name_len > i; i++) {
+                p_profile->name[i] = (char)(' ' + (next_random() % 95));
+        }
+
+        p_profile->preheat_temperature = (uint16_t)next_random();
+        p_profile->soak_time_s = (uint16_t)next_random();
+        p_profile->reflow_temperature = (uint16_t)next_random();
+        p_profile->dwell_time_s = (uint16_t)next_random();
+        p_profile->cooling_temperature = (uint16_t)next_random();
+        p_profile->cooling_time_s = (uint16_t)next_random();
+        p_profile->ramp_speed = (uint8_t)next_random();
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(reflow_profile_codec)
+{
+        reflow_profile_t profile;
+        reflow_profile_t decoded;
+        uint8_t buffer[REFLOW_PROFILE_CODEC_RECORD_SIZE_MAX + 8];
+        size_t written;
+        size_t consumed;
+
+        void setup()
+        {
+                reflow_profile_t const sac305 = {
+                        "SAC305", 150, 60, 245, 30, 60, 300, 2
+                };
+
+                m_random_state = 0x2545F491;
+                profile = sac305;
+                memset(&decoded, 0, sizeof(decoded));
+                written = 0;
+                consumed = 0;
+        }
+};
+
+TEST(reflow_profile_codec, record_has_explicit_layout)
+{
+        uint8_t const expected[] = {
+                REFLOW_PROFILE_CODEC_RECORD_SIZE(6) - 1, 6,
+                'S', 'A', 'C', '3', '0', '5',
+                150, 0, 60, 0, 245, 0, 30, 0, 60, 0, 0x2C, 0x01, 2
+        };
+
+        CHECK_TRUE(reflow_profile_codec_encode(&profile, buffer, sizeof(buffer),
+                                               &written));
+
+        UNSIGNED_LONGS_EQUAL(sizeof(expected), written);
+        MEMCMP_EQUAL(expected, buffer, sizeof(expected));
+}
+
+TEST(reflow_profile_codec, random_profiles_round_trip)
+{
+        uint32_t i;
+
+        for (i = 0; ROUNDS_CNT > i; i++) {
+                random_profile(&profile);
+                memset(&decoded, 0xA5, sizeof(decoded));
+
+                CHECK_TRUE(reflow_profile_codec_encode(&profile, buffer,
+                                                       sizeof(buffer),
+                                                       &written));
+                CHECK_TRUE(reflow_profile_codec_decode(buffer, written,
+                                                       &decoded, &consumed));
+
+                UNSIGNED_LONGS_EQUAL(written, consumed);
+                MEMCMP_EQUAL(&profile, &decoded, sizeof(profile));
+        }
+}
+
+TEST(reflow_profile_codec, unencodable_profiles_fail)
+{
+        CHECK_FALSE(reflow_profile_codec_encode(&profile, buffer,
+                                                REFLOW_PROFILE_CODEC_RECORD_SIZE(6) - 1,
+                                                &written));
+
+        profile.ramp_speed = UINT8_MAX + 1;
+        CHECK_FALSE(reflow_profile_codec_encode(&profile, buffer, sizeof(buffer),
+                                                &written));
+
+        profile.ramp_speed = 2;
+        profile.name[0] = '\0';
+        CHECK_FALSE(reflow_profile_codec_encode(&profile, buffer, sizeof(buffer),
+                                                &written));
+}
+
+TEST(reflow_profile_codec, truncated_records_fail)
+{
+        size_t size;
+
+        CHECK_TRUE(reflow_profile_codec_encode(&profile, buffer, sizeof(buffer),
+                                               &written));
+
+        for (size = 0; written > size; size++) {
+                CHECK_FALSE(reflow_profile_codec_decode(buffer, size, &decoded,
+                                                        &consumed));
+        }
+}
+
+TEST(reflow_profile_codec, unknown_trailing_fields_are_skipped)
+{
+        CHECK_TRUE(reflow_profile_codec_encode(&profile, buffer, sizeof(buffer),
+                                               &written));
+
+        // Record of a newer firmware, followed by the next one
+        buffer[0] += 3;
+        buffer[written + 3] = 0xEE;
+
+        CHECK_TRUE(reflow_profile_codec_decode(buffer, written + 4, &decoded,
+                                               &consumed));
+        UNSIGNED_LONGS_EQUAL(written + 3, consumed);
+        MEMCMP_EQUAL(&profile, &decoded, sizeof(profile));
+}
+
+TEST(reflow_profile_codec, record_shorter_than_its_fields_fails)
+{
+        CHECK_TRUE(reflow_profile_codec_encode(&profile, buffer, sizeof(buffer),
+                                               &written));
+
+        buffer[0] -= 1;
+        CHECK_FALSE(reflow_profile_codec_decode(buffer, sizeof(buffer), &decoded,
+                                                &consumed));
+}
+
+TEST(reflow_profile_codec, name_with_terminator_fails)
+{
+        CHECK_TRUE(reflow_profile_codec_encode(&profile, buffer, sizeof(buffer),
+                                               &written));
+
+        buffer[4] = '\0';
+        CHECK_FALSE(reflow_profile_codec_decode(buffer, written, &decoded,
+                                                &consumed));
+}
+
+TEST(reflow_profile_codec, legacy_layout_is_decoded)
+{
+        uint8_t const legacy[REFLOW_PROFILE_CODEC_LEGACY_SIZE] = {
+                'S', 'A', 'C', '3', '0', '5', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                150, 0, 60, 0, 245, 0, 30, 0, 60, 0, 0x2C, 0x01, 2, 0
+        };
+        uint32_t i;
+
+        CHECK_TRUE(reflow_profile_codec_decode_legacy(legacy, sizeof(legacy),
+                                                      &decoded));
+        MEMCMP_EQUAL(&profile, &decoded, sizeof(profile));
+
+        CHECK_FALSE(reflow_profile_codec_decode_legacy(legacy, sizeof(legacy) - 1,
+                                                       &decoded));
+
+        // Whatever the contents, the name comes out terminated
+        for (i = 0; ROUNDS_CNT > i; i++) {
+                uint8_t random_legacy[REFLOW_PROFILE_CODEC_LEGACY_SIZE];
+                size_t j;
+
+                for (j = 0; sizeof(random_legacy) > j; j++) {
+                        random_legacy[j] = (uint8_t)next_random();
+                }
+
+                if (reflow_profile_codec_decode_legacy(random_legacy,
+                                                       sizeof(random_legacy),
+                                                       &decoded)) {
+                        CHECK(REFLOW_PROFILE_NAME_LEN_MAX >=
+                              strnlen(decoded.name, sizeof(decoded.name)));
+                }
+        }
+}
+
+TEST(reflow_profile_codec, fuzz_random_records)
+{
+        uint32_t i;
+        size_t size;
+        size_t j;
+
+        for (i = 0; ROUNDS_CNT > i; i++) {
+                size = next_random() % sizeof(buffer);
+
+                for (j = 0; size > j; j++) {
+                        buffer[j] = (uint8_t)next_random();
+                }
+
+                // Plausible headers, so the fields get decoded too
+                if ((0 == (i % 2)) && (2 <= size)) {
+                        buffer[1] = (uint8_t)(1 + (buffer[1] % REFLOW_PROFILE_NAME_LEN_MAX));
+                        buffer[0] = (uint8_t)(REFLOW_PROFILE_CODEC_RECORD_SIZE(buffer[1]) - 1 +
+                                              (buffer[0] % 4));
+                }
+
+                if (reflow_profile_codec_decode(buffer, size, &decoded, &consumed)) {
+                        CHECK(size >= consumed);
+                        CHECK(REFLOW_PROFILE_CODEC_RECORD_SIZE(strlen(decoded.name)) <=
+                              consumed);
+                        CHECK(0 < strlen(decoded.name));
+                        CHECK(REFLOW_PROFILE_NAME_LEN_MAX >= strlen(decoded.name));
+                }
+        }
+}
+
+TEST(reflow_profile_codec, fuzz_mutated_snapshots)
+{
+        reflow_profile_catalogue_t catalogue;
+        reflow_profile_catalogue_t decoded_catalogue;
+        uint8_t snapshot[REFLOW_PROFILE_STORE_SNAPSHOT_SIZE_MAX];
+        uint8_t mutated[REFLOW_PROFILE_STORE_SNAPSHOT_SIZE_MAX];
+        char default_name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+        reflow_profile_store_error_t result;
+        char const * p_list;
+        size_t list_size;
+        size_t snapshot_size;
+        size_t size;
+        uint8_t version;
+        uint8_t slot;
+        uint32_t i;
+        uint32_t j;
+
+        CHECK_TRUE(reflow_profile_catalogue_init(&catalogue));
+
+        for (i = 0; REFLOW_PROFILE_CATALOGUE_SLOTS_CNT > i; i++) {
+                random_profile(&profile);
+                (void)reflow_profile_catalogue_put(&catalogue, &profile);
+        }
+
+        CHECK_TRUE(reflow_profile_store_encode(&catalogue, profile.name,
+                                               snapshot, sizeof(snapshot),
+                                               &snapshot_size));
+
+        for (i = 0; ROUNDS_CNT > i; i++) {
+                memcpy(mutated, snapshot, snapshot_size);
+                size = snapshot_size - (next_random() % 4);
+
+                for (j = 1 + (next_random() % 4); 0 < j; j--) {
+                        mutated[next_random() % size] = (uint8_t)next_random();
+                }
+
+                // Most mutations are caught by the CRC, so half of the time it
+                // is fixed to reach the parser
+                if ((0 == (i % 2)) && (REFLOW_PROFILE_STORE_CRC_SIZE < size)) {
+                        byte_codec_put_u16(&mutated[size - 2],
+                                           byte_codec_crc16(mutated,
+                                                            size - 2));
+                }
+
+                result = reflow_profile_store_decode(mutated, size,
+                                                     &decoded_catalogue,
+                                                     default_name, &version);
+
+                if (REFLOW_PROFILE_STORE_ERROR_SUCCESS != result) {
+                        UNSIGNED_LONGS_EQUAL(0, decoded_catalogue.count);
+                } else {
+                        CHECK(REFLOW_PROFILE_CATALOGUE_SLOTS_CNT >=
+                              decoded_catalogue.count);
+                        CHECK(REFLOW_PROFILE_NAME_LEN_MAX >= strlen(default_name));
+
+                        for (j = 0; decoded_catalogue.count > j; j++) {
+                                CHECK_TRUE(reflow_profile_catalogue_find(&decoded_catalogue,
+                                                                         decoded_catalogue.slots[j].profile.name,
+                                                                         &slot));
+                                UNSIGNED_LONGS_EQUAL(j, slot);
+                        }
+
+                        CHECK_TRUE(reflow_profile_catalogue_get_list(&decoded_catalogue,
+                                                                     &p_list,
+                                                                     &list_size));
+                        CHECK(REFLOW_PROFILE_CATALOGUE_LIST_SIZE > list_size);
+                }
+        }
+}
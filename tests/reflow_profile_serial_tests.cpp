@@ -0,0 +1,277 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_serial_tests.cpp
+ *
+ * @brief Checks on the serial profile protocol: requests parsed from data fed
+ *        in any chunks, rejected lines, and profiles formatted back
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+
+#include "reflow_profile_serial.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(reflow_profile_serial)
+{
+        reflow_profile_serial_parser_t parser;
+        reflow_profile_serial_request_t request;
+
+        void setup()
+        {
+                CHECK_TRUE(reflow_profile_serial_init(&parser));
+                memset(&request, 0, sizeof(request));
+        }
+
+        reflow_profile_serial_error_t feed_all(char const * const p_data)
+        {
+                size_t consumed = 0;
+                reflow_profile_serial_error_t const result =
+                        reflow_profile_serial_feed(&parser,
+                                                   p_data,
+                                                   strlen(p_data),
+                                                   &consumed,
+                                                   &request);
+
+                UNSIGNED_LONGS_EQUAL(strlen(p_data), consumed);
+
+                return result;
+        }
+};
+
+TEST(reflow_profile_serial, put_request_is_parsed)
+{
+        reflow_profile_t const expected = {
+                "SAC 305", 150, 60, 235, 30, 60, 300, 2
+        };
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS,
+                        feed_all("PUT SAC 305,150,60,235,30,60,300,2\n"));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_COMMAND_PUT, request.command);
+        MEMCMP_EQUAL(&expected, &request.profile, sizeof(expected));
+}
+
+TEST(reflow_profile_serial, commands_are_parsed)
+{
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS, feed_all("LIST\n"));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_COMMAND_LIST, request.command);
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS, feed_all("GET Sn60Pb40\n"));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_COMMAND_GET, request.command);
+        STRCMP_EQUAL("Sn60Pb40", request.profile.name);
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS, feed_all("DEL lead free\r\n"));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_COMMAND_DELETE, request.command);
+        STRCMP_EQUAL("lead free", request.profile.name);
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS, feed_all("SYNC\n"));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_COMMAND_SYNC, request.command);
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS, feed_all("TELEMETRY 250\n"));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_COMMAND_TELEMETRY, request.command);
+        UNSIGNED_LONGS_EQUAL(250, request.telemetry_period_ms);
+}
+
+TEST(reflow_profile_serial, data_can_come_one_character_at_a_time)
+{
+        char const * const p_data = "\nGET ab\n";
+        size_t consumed;
+        size_t i;
+
+        for (i = 0; (strlen(p_data) - 1) > i; i++) {
+                ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_PENDING,
+                                reflow_profile_serial_feed(&parser, &p_data[i], 1,
+                                                           &consumed, &request));
+                UNSIGNED_LONGS_EQUAL(1, consumed);
+        }
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS,
+                        reflow_profile_serial_feed(&parser, &p_data[i], 1,
+                                                   &consumed, &request));
+        STRCMP_EQUAL("ab", request.profile.name);
+}
+
+TEST(reflow_profile_serial, feeding_stops_after_each_request)
+{
+        char data[REFLOW_PROFILES_MAX_PROFILES_CNT * (REFLOW_PROFILE_SERIAL_LINE_LEN_MAX + 1)];
+        size_t length = 0;
+        size_t offset = 0;
+        size_t consumed;
+        uint8_t count = 0;
+        uint8_t i;
+
+        // A whole catalogue, sent back to back with the widest fields
+        for (i = 0; REFLOW_PROFILES_MAX_PROFILES_CNT > i; i++) {
+                length += (size_t)sprintf(&data[length],
+                                          "PUT longest_name_%u,65535,65535,65535,65535,65535,65535,%u\n",
+                                          i % 10, i);
+        }
+
+        while (length > offset) {
+                ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS,
+                                reflow_profile_serial_feed(&parser, &data[offset],
+                                                           length - offset,
+                                                           &consumed, &request));
+                UNSIGNED_LONGS_EQUAL(count, request.profile.ramp_speed);
+                offset += consumed;
+                count++;
+        }
+
+        UNSIGNED_LONGS_EQUAL(REFLOW_PROFILES_MAX_PROFILES_CNT, count);
+}
+
+TEST(reflow_profile_serial, malformed_lines_are_rejected)
+{
+        char const * const p_lines[] = {
+                "LIST all\n",
+                "LISTS\n",
+                "list\n",
+                "GET\n",
+                "GET \n",
+                "GET name_too_long_for_it\n",
+                "PUT a,150,60,235,30,60,300\n",
+                "PUT a,150,60,235,30,60,300,2,1\n",
+                "PUT a,150,60,235,30,60,300,\n",
+                "PUT a,150,,235,30,60,300,2\n",
+                "PUT a,150,-60,235,30,60,300,2\n",
+                "PUT a,150,60,235,30,60,300,65536\n",
+                "PUT ,150,60,235,30,60,300,2\n",
+                "PUT a\t,150,60,235,30,60,300,2\n",
+                "TELEMETRY\n",
+                "TELEMETRY 250,\n",
+                "TELEMETRY 65536\n",
+        };
+        size_t i;
+
+        for (i = 0; (sizeof(p_lines) / sizeof(p_lines[0])) > i; i++) {
+                ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SYNTAX,
+                                feed_all(p_lines[i]));
+        }
+
+        // The parser keeps working after them
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS, feed_all("LIST\n"));
+}
+
+TEST(reflow_profile_serial, too_long_line_is_dropped_to_its_end)
+{
+        char data[(2 * REFLOW_PROFILE_SERIAL_LINE_LEN_MAX) + 8];
+
+        memset(data, 'x', sizeof(data));
+        memcpy(data, "GET ", 4);
+        data[sizeof(data) - 2] = '\n';
+        data[sizeof(data) - 1] = '\0';
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_TOO_LONG, feed_all(data));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS, feed_all("GET x\n"));
+        STRCMP_EQUAL("x", request.profile.name);
+}
+
+TEST(reflow_profile_serial, formatted_profile_parses_back)
+{
+        reflow_profile_t const profile = {
+                "longest_name_15", 220, 300, 280, 100, 80, 600, 10
+        };
+        char line[REFLOW_PROFILE_SERIAL_PROFILE_LINE_SIZE];
+        size_t written = 0;
+
+        CHECK_TRUE(reflow_profile_serial_format(&profile, line, sizeof(line),
+                                                &written));
+        STRCMP_EQUAL("PROFILE longest_name_15,220,300,280,100,80,600,10\n", line);
+        UNSIGNED_LONGS_EQUAL(strlen(line), written);
+
+        // Exported lines are not requests, but their arguments are the ones
+        // of `PUT`
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SYNTAX, feed_all(line));
+
+        memcpy(&line[4], "PUT ", 4);
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_SUCCESS, feed_all(&line[4]));
+        MEMCMP_EQUAL(&profile, &request.profile, sizeof(profile));
+}
+
+TEST(reflow_profile_serial, invalid_input_fails)
+{
+        reflow_profile_t const profile = {"a", 1, 2, 3, 4, 5, 6, 7};
+        char line[REFLOW_PROFILE_SERIAL_PROFILE_LINE_SIZE];
+        size_t written;
+        size_t consumed;
+
+        CHECK_FALSE(reflow_profile_serial_init(NULL));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_BAD_PARAMETER,
+                        reflow_profile_serial_feed(NULL, "\n", 1, &consumed, &request));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_BAD_PARAMETER,
+                        reflow_profile_serial_feed(&parser, "\n", 1, NULL, &request));
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_SERIAL_ERROR_PENDING,
+                        reflow_profile_serial_feed(&parser, NULL, 0, &consumed, &request));
+
+        CHECK_FALSE(reflow_profile_serial_format(&profile, line, 8, &written));
+        CHECK_FALSE(reflow_profile_serial_format(NULL, line, sizeof(line), &written));
+}
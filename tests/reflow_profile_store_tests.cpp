@@ -0,0 +1,459 @@
+/*!
+ *******************************************************************************
+ * @file reflow_profile_store_tests.cpp
+ *
+ * @brief Checks on the profile write-behind policy and on the catalogue
+ *        snapshot format
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <cstring>
+
+#include "CppUTest/TestHarness.h"
+
+#include "byte_codec.h"
+#include "reflow_profile_store.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Write-behind timing used on the checks
+#define IDLE_MS                             (2000)
+#define MAX_DELAY_MS                        (10000)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(reflow_profile_store)
+{
+        reflow_profile_store_t store;
+
+        void setup()
+        {
+                CHECK_TRUE(reflow_profile_store_init(&store, IDLE_MS, MAX_DELAY_MS));
+        }
+
+        // Poll as the main loop does, flushing whenever it is due
+        uint32_t poll_until(uint32_t now_ms, uint32_t const end_ms)
+        {
+                for (; end_ms > now_ms; now_ms += 10) {
+                        if (reflow_profile_store_is_flush_due(&store, now_ms)) {
+                                CHECK_TRUE(reflow_profile_store_mark_flushed(&store));
+                        }
+                }
+
+                return now_ms;
+        }
+};
+
+TEST(reflow_profile_store, clean_store_is_never_due)
+{
+        CHECK_FALSE(reflow_profile_store_is_flush_due(&store, 0));
+        CHECK_FALSE(reflow_profile_store_is_flush_due(&store, UINT32_MAX));
+}
+
+TEST(reflow_profile_store, flush_once_idle)
+{
+        CHECK_TRUE(reflow_profile_store_mark_dirty(&store, 1000));
+
+        CHECK_FALSE(reflow_profile_store_is_flush_due(&store, 1000 + IDLE_MS - 1));
+        CHECK_TRUE(reflow_profile_store_is_flush_due(&store, 1000 + IDLE_MS));
+
+        CHECK_TRUE(reflow_profile_store_mark_flushed(&store));
+        CHECK_FALSE(reflow_profile_store_is_flush_due(&store, 1000 + IDLE_MS));
+}
+
+TEST(reflow_profile_store, editing_session_is_one_flush)
+{
+        // Save, delete of the old name and use, as the profile editor does
+        CHECK_TRUE(reflow_profile_store_mark_dirty(&store, 1000));
+        CHECK_TRUE(reflow_profile_store_mark_dirty(&store, 1000));
+        CHECK_TRUE(reflow_profile_store_mark_dirty(&store, 1010));
+
+        (void)poll_until(1020, 20000);
+
+        UNSIGNED_LONGS_EQUAL(1, store.stats.flush_count);
+}
+
+TEST(reflow_profile_store, continuous_changes_flush_on_timeout)
+{
+        uint32_t now_ms;
+
+        // A change every second never lets the store get idle
+        for (now_ms = 0; 25000 > now_ms; now_ms += 1000) {
+                CHECK_TRUE(reflow_profile_store_mark_dirty(&store, now_ms));
+                (void)poll_until(now_ms, now_ms + 1000);
+        }
+
+        UNSIGNED_LONGS_EQUAL(2, store.stats.flush_count);
+}
+
+TEST(reflow_profile_store, failed_flush_is_retried_after_idle)
+{
+        CHECK_TRUE(reflow_profile_store_mark_dirty(&store, 0));
+        CHECK_TRUE(reflow_profile_store_is_flush_due(&store, MAX_DELAY_MS));
+
+        CHECK_TRUE(reflow_profile_store_mark_failed(&store, MAX_DELAY_MS));
+        CHECK_FALSE(reflow_profile_store_is_flush_due(&store, MAX_DELAY_MS + 1));
+        CHECK_TRUE(reflow_profile_store_is_flush_due(&store, MAX_DELAY_MS + IDLE_MS));
+}
+
+TEST(reflow_profile_store, due_across_time_wrap_around)
+{
+        CHECK_TRUE(reflow_profile_store_mark_dirty(&store, UINT32_MAX - 100));
+
+        CHECK_FALSE(reflow_profile_store_is_flush_due(&store, 100));
+        CHECK_TRUE(reflow_profile_store_is_flush_due(&store, IDLE_MS));
+}
+
+TEST_GROUP(reflow_profile_store_snapshot)
+{
+        reflow_profile_catalogue_t catalogue;
+        reflow_profile_catalogue_t decoded;
+        uint8_t buffer[REFLOW_PROFILE_STORE_SNAPSHOT_SIZE_MAX];
+        char default_name[REFLOW_PROFILE_NAME_LEN_MAX + 1];
+        uint8_t version;
+        size_t written;
+
+        void setup()
+        {
+                reflow_profile_t profile = {"Sn60Pb40", 150, 60, 230, 30, 60, 300, 2};
+                reflow_program_t program;
+
+                written = 0;
+                version = 0;
+                memset(default_name, 0, sizeof(default_name));
+                CHECK_TRUE(reflow_profile_catalogue_init(&catalogue));
+                CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+
+                memset(profile.name, 0, sizeof(profile.name));
+                strcpy(profile.name, "SAC305");
+                profile.reflow_temperature = 245;
+                CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+                CHECK_TRUE(reflow_program_from_profile(&profile, &program));
+                program.segments[2] = {180, 1, 0};
+                program.segment_count = 3;
+                CHECK_TRUE(reflow_profile_catalogue_set_program(&catalogue,
+                                                                "SAC305",
+                                                                &program));
+        }
+
+        void encode()
+        {
+                CHECK_TRUE(reflow_profile_store_encode(&catalogue, "SAC305",
+                                                       buffer, sizeof(buffer),
+                                                       &written));
+        }
+
+        reflow_profile_store_error_t decode(size_t const size)
+        {
+                return reflow_profile_store_decode(buffer, size, &decoded,
+                                                   default_name, &version);
+        }
+
+        // Compute the CRC again after the snapshot was tampered with
+        void seal()
+        {
+                size_t const crc_offset = written - REFLOW_PROFILE_STORE_CRC_SIZE;
+
+                byte_codec_put_u16(&buffer[crc_offset],
+                                   byte_codec_crc16(buffer, crc_offset));
+        }
+};
+
+TEST(reflow_profile_store_snapshot, round_trip)
+{
+        reflow_program_t expected;
+        reflow_program_t program;
+        char const * p_list;
+        size_t list_size;
+
+        encode();
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_SUCCESS, decode(written));
+
+        UNSIGNED_LONGS_EQUAL(REFLOW_PROFILE_STORE_SNAPSHOT_VERSION, version);
+        STRCMP_EQUAL("SAC305", default_name);
+        UNSIGNED_LONGS_EQUAL(2, decoded.count);
+        MEMCMP_EQUAL(&catalogue.slots[0].profile, &decoded.slots[0].profile,
+                     sizeof(reflow_profile_t));
+        MEMCMP_EQUAL(&catalogue.slots[1].profile, &decoded.slots[1].profile,
+                     sizeof(reflow_profile_t));
+
+        CHECK_FALSE(reflow_profile_catalogue_get_program(&decoded, "Sn60Pb40",
+                                                         &program));
+        CHECK_TRUE(reflow_profile_catalogue_get_program(&catalogue, "SAC305",
+                                                        &expected));
+        CHECK_TRUE(reflow_profile_catalogue_get_program(&decoded, "SAC305",
+                                                        &program));
+        MEMCMP_EQUAL(&expected, &program, sizeof(program));
+
+        CHECK_TRUE(reflow_profile_catalogue_get_list(&decoded, &p_list,
+                                                     &list_size));
+        STRCMP_EQUAL("Sn60Pb40\nSAC305\n", p_list);
+}
+
+TEST(reflow_profile_store_snapshot, deleted_default_falls_back_to_first)
+{
+        // Default profile deleted, and the snapshot flushed with its name
+        CHECK_TRUE(reflow_profile_catalogue_remove(&catalogue, "SAC305"));
+        encode();
+
+        // Booting again uses the profile left
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_SUCCESS, decode(written));
+        UNSIGNED_LONGS_EQUAL(1, decoded.count);
+        STRCMP_EQUAL("Sn60Pb40", default_name);
+}
+
+TEST(reflow_profile_store_snapshot, only_used_slots_are_written)
+{
+        encode();
+
+        // Header with "SAC305" as default, both records, program sizes, CRC
+        UNSIGNED_LONGS_EQUAL(3 + 6 + 1 +
+                             REFLOW_PROFILE_CODEC_RECORD_SIZE(8) + 1 +
+                             REFLOW_PROFILE_CODEC_RECORD_SIZE(6) + 1 +
+                             REFLOW_PROGRAM_ENCODED_SIZE(3) +
+                             REFLOW_PROFILE_STORE_CRC_SIZE,
+                             written);
+}
+
+TEST(reflow_profile_store_snapshot, full_catalogue_fits)
+{
+        reflow_profile_t profile = catalogue.slots[0].profile;
+        reflow_program_t program = {0};
+        uint8_t i;
+
+        program.segment_count = REFLOW_PROGRAM_SEGMENTS_MAX;
+        program.cooling_temperature = 50;
+        program.cooling_time_s = 300;
+
+        for (i = 0; REFLOW_PROGRAM_SEGMENTS_MAX > i; i++) {
+                program.segments[i] = {200, 2, 10};
+        }
+
+        CHECK_TRUE(reflow_profile_catalogue_init(&catalogue));
+
+        for (i = 0; REFLOW_PROFILE_CATALOGUE_SLOTS_CNT > i; i++) {
+                memset(profile.name, 'a' + i, REFLOW_PROFILE_NAME_LEN_MAX);
+                CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+                CHECK_TRUE(reflow_profile_catalogue_set_program(&catalogue,
+                                                                profile.name,
+                                                                &program));
+        }
+
+        CHECK_TRUE(reflow_profile_store_encode(&catalogue, profile.name,
+                                               buffer, sizeof(buffer),
+                                               &written));
+        UNSIGNED_LONGS_EQUAL(REFLOW_PROFILE_STORE_SNAPSHOT_SIZE_MAX, written);
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_SUCCESS, decode(written));
+}
+
+TEST(reflow_profile_store_snapshot, small_buffer_fails)
+{
+        CHECK_FALSE(reflow_profile_store_encode(&catalogue, "SAC305", buffer,
+                                                REFLOW_PROFILE_STORE_HEADER_SIZE +
+                                                REFLOW_PROFILE_CODEC_RECORD_SIZE_MAX,
+                                                &written));
+
+        // Everything but the CRC fits
+        encode();
+        CHECK_FALSE(reflow_profile_store_encode(&catalogue, "SAC305", buffer,
+                                                written - 1, &written));
+}
+
+TEST(reflow_profile_store_snapshot, malformed_snapshots_leave_catalogue_empty)
+{
+        reflow_profile_t profile = catalogue.slots[1].profile;
+
+        encode();
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_CORRUPTED, decode(written - 1));
+        UNSIGNED_LONGS_EQUAL(0, decoded.count);
+
+        // Count beyond the catalogue capacity, with a valid CRC
+        buffer[3 + 6] = REFLOW_PROFILE_CATALOGUE_SLOTS_CNT + 1;
+        seal();
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_CORRUPTED, decode(written));
+        UNSIGNED_LONGS_EQUAL(0, decoded.count);
+
+        // Same profile twice
+        CHECK_TRUE(reflow_profile_catalogue_init(&catalogue));
+        CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+        strcpy(profile.name, "SAC306");
+        CHECK_TRUE(reflow_profile_catalogue_put(&catalogue, &profile));
+        encode();
+        buffer[3 + 6 + 1 + (REFLOW_PROFILE_CODEC_RECORD_SIZE(6) + 1) + 2 + 5] = '5';
+        seal();
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_CORRUPTED, decode(written));
+        UNSIGNED_LONGS_EQUAL(0, decoded.count);
+
+        buffer[0] = 0;
+        seal();
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_CORRUPTED, decode(written));
+        UNSIGNED_LONGS_EQUAL(0, decoded.count);
+}
+
+TEST(reflow_profile_store_snapshot, any_bit_flip_is_detected)
+{
+        size_t bit;
+
+        encode();
+
+        for (bit = 0; (written * 8) > bit; bit++) {
+                buffer[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+                CHECK(REFLOW_PROFILE_STORE_ERROR_SUCCESS != decode(written));
+                buffer[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+        }
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_SUCCESS, decode(written));
+}
+
+TEST(reflow_profile_store_snapshot, newer_incompatible_snapshot_is_unsupported)
+{
+        encode();
+
+        // Whatever follows the versions can't be interpreted
+        buffer[0] = REFLOW_PROFILE_STORE_SNAPSHOT_VERSION + 1;
+        buffer[1] = REFLOW_PROFILE_STORE_SNAPSHOT_VERSION + 1;
+        buffer[2] = 0xFF;
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_UNSUPPORTED, decode(written));
+        UNSIGNED_LONGS_EQUAL(0, decoded.count);
+}
+
+TEST(reflow_profile_store_snapshot, newer_compatible_snapshot_is_decoded)
+{
+        uint8_t * const p_record = &buffer[3 + 6 + 1];
+        size_t record_size;
+
+        encode();
+        record_size = p_record[0] + 1;
+
+        // A newer firmware appended a field to the records
+        memmove(&p_record[record_size + 2], &p_record[record_size],
+                written - (size_t)(&p_record[record_size] - buffer));
+        p_record[record_size] = 0xAA;
+        p_record[record_size + 1] = 0x55;
+        p_record[0] += 2;
+        written += 2;
+        buffer[0] = REFLOW_PROFILE_STORE_SNAPSHOT_VERSION + 1;
+        seal();
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_SUCCESS, decode(written));
+        UNSIGNED_LONGS_EQUAL(REFLOW_PROFILE_STORE_SNAPSHOT_VERSION + 1, version);
+        UNSIGNED_LONGS_EQUAL(2, decoded.count);
+        MEMCMP_EQUAL(&catalogue.slots[0].profile, &decoded.slots[0].profile,
+                     sizeof(reflow_profile_t));
+        MEMCMP_EQUAL(&catalogue.slots[1].profile, &decoded.slots[1].profile,
+                     sizeof(reflow_profile_t));
+}
+
+TEST(reflow_profile_store_snapshot, version_1_snapshot_is_migrated)
+{
+        reflow_program_t expected;
+        reflow_program_t program;
+        size_t program_size;
+        size_t offset = 0;
+        uint8_t i;
+
+        // Profiles were stored as a copy of their struct, which is laid out
+        // the same on the host
+        buffer[offset++] = 1;
+        memset(&buffer[offset], 0, REFLOW_PROFILE_NAME_LEN_MAX + 1);
+        strcpy((char *)&buffer[offset], "SAC305");
+        offset += REFLOW_PROFILE_NAME_LEN_MAX + 1;
+        buffer[offset++] = catalogue.count;
+
+        for (i = 0; catalogue.count > i; i++) {
+                memcpy(&buffer[offset], &catalogue.slots[i].profile,
+                       REFLOW_PROFILE_CODEC_LEGACY_SIZE);
+                offset += REFLOW_PROFILE_CODEC_LEGACY_SIZE;
+                program_size = 0;
+
+                if (catalogue.slots[i].has_program) {
+                        CHECK_TRUE(reflow_program_encode(&catalogue.slots[i].program,
+                                                         &buffer[offset + 1],
+                                                         sizeof(buffer) - offset - 1,
+                                                         &program_size));
+                }
+
+                buffer[offset] = (uint8_t)program_size;
+                offset += 1 + program_size;
+        }
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_SUCCESS, decode(offset));
+        UNSIGNED_LONGS_EQUAL(1, version);
+        STRCMP_EQUAL("SAC305", default_name);
+        UNSIGNED_LONGS_EQUAL(2, decoded.count);
+        MEMCMP_EQUAL(&catalogue.slots[0].profile, &decoded.slots[0].profile,
+                     sizeof(reflow_profile_t));
+        MEMCMP_EQUAL(&catalogue.slots[1].profile, &decoded.slots[1].profile,
+                     sizeof(reflow_profile_t));
+        CHECK_TRUE(reflow_profile_catalogue_get_program(&catalogue, "SAC305",
+                                                        &expected));
+        CHECK_TRUE(reflow_profile_catalogue_get_program(&decoded, "SAC305",
+                                                        &program));
+        MEMCMP_EQUAL(&expected, &program, sizeof(program));
+
+        ENUMS_EQUAL_INT(REFLOW_PROFILE_STORE_ERROR_CORRUPTED, decode(offset - 1));
+}
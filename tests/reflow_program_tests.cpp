@@ -0,0 +1,213 @@
+/*!
+ *******************************************************************************
+ * @file reflow_program_tests.cpp
+ *
+ * @brief Checks on the reflow programs: import of five phases profiles,
+ *        validation and compact storage format
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include "CppUTest/TestHarness.h"
+
+#include "reflow_profile.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(reflow_program)
+{
+        reflow_program_t program;
+        reflow_program_t decoded;
+        uint8_t buffer[REFLOW_PROGRAM_ENCODED_SIZE_MAX];
+        size_t written;
+
+        void setup()
+        {
+                reflow_profile_t const profile = {
+                        "program", 150, 60, 230, 30, 60, 300, 2
+                };
+
+                memset(&decoded, 0, sizeof(decoded));
+                written = 0;
+                CHECK_TRUE(reflow_program_from_profile(&profile, &program));
+        }
+};
+
+TEST(reflow_program, profile_imports_as_two_segments)
+{
+        UNSIGNED_LONGS_EQUAL(2, program.segment_count);
+
+        UNSIGNED_LONGS_EQUAL(150, program.segments[0].target_temperature);
+        UNSIGNED_LONGS_EQUAL(2, program.segments[0].ramp_speed);
+        UNSIGNED_LONGS_EQUAL(60, program.segments[0].hold_time_s);
+
+        UNSIGNED_LONGS_EQUAL(230, program.segments[1].target_temperature);
+        UNSIGNED_LONGS_EQUAL(2, program.segments[1].ramp_speed);
+        UNSIGNED_LONGS_EQUAL(30, program.segments[1].hold_time_s);
+
+        UNSIGNED_LONGS_EQUAL(60, program.cooling_temperature);
+        UNSIGNED_LONGS_EQUAL(300, program.cooling_time_s);
+
+        CHECK_TRUE(reflow_program_is_valid(&program));
+}
+
+TEST(reflow_program, profile_too_long_above_liquidus_is_not_imported)
+{
+        // Every field within its limits, but over 3 minutes above liquidus
+        reflow_profile_t const profile = {
+                "long", 170, 60, 250, 100, 30, 600, 1
+        };
+
+        CHECK_FALSE(reflow_program_from_profile(&profile, &decoded));
+}
+
+TEST(reflow_program, peak_is_highest_target)
+{
+        // A downward segment after the peak doesn't change it
+        program.segments[2] = {180, 1, 0};
+        program.segment_count = 3;
+
+        UNSIGNED_LONGS_EQUAL(230, reflow_program_get_peak_temperature(&program));
+}
+
+TEST(reflow_program, encode_decode_round_trip)
+{
+        CHECK_TRUE(reflow_program_encode(&program, buffer, sizeof(buffer),
+                                         &written));
+        UNSIGNED_LONGS_EQUAL(REFLOW_PROGRAM_ENCODED_SIZE(2), written);
+
+        CHECK_TRUE(reflow_program_decode(buffer, written, &decoded));
+        MEMCMP_EQUAL(&program, &decoded, sizeof(program));
+}
+
+TEST(reflow_program, encoded_size_only_grows_with_used_segments)
+{
+        UNSIGNED_LONGS_EQUAL(16, REFLOW_PROGRAM_ENCODED_SIZE(2));
+
+        CHECK_FALSE(reflow_program_encode(&program, buffer,
+                                          REFLOW_PROGRAM_ENCODED_SIZE(2) - 1,
+                                          &written));
+}
+
+TEST(reflow_program, decode_rejects_unknown_version)
+{
+        CHECK_TRUE(reflow_program_encode(&program, buffer, sizeof(buffer),
+                                         &written));
+        buffer[0] = REFLOW_PROGRAM_ENCODING_VERSION + 1;
+
+        CHECK_FALSE(reflow_program_decode(buffer, written, &decoded));
+}
+
+TEST(reflow_program, decode_rejects_truncated_input)
+{
+        CHECK_TRUE(reflow_program_encode(&program, buffer, sizeof(buffer),
+                                         &written));
+
+        CHECK_FALSE(reflow_program_decode(buffer, written - 1, &decoded));
+}
+
+TEST(reflow_program, invalid_segments_are_rejected)
+{
+        program.segments[1].ramp_speed = 0;
+        CHECK_FALSE(reflow_program_is_valid(&program));
+        CHECK_FALSE(reflow_program_encode(&program, buffer, sizeof(buffer),
+                                          &written));
+
+        program.segments[1].ramp_speed = 2;
+        program.segments[1].target_temperature = REFLOW_PROGRAM_TARGET_TEMP_MAX_C + 1;
+        CHECK_FALSE(reflow_program_is_valid(&program));
+
+        program.segments[1].target_temperature = 230;
+        program.segment_count = 0;
+        CHECK_FALSE(reflow_program_is_valid(&program));
+
+        program.segment_count = REFLOW_PROGRAM_SEGMENTS_MAX + 1;
+        CHECK_FALSE(reflow_program_is_valid(&program));
+}
+
+TEST(reflow_program, too_long_above_liquidus_is_rejected)
+{
+        // 6.5 s of ramp and 23 s of cooling above liquidus: 2 minutes of
+        // hold still fit, a second more doesn't
+        program.segments[1].hold_time_s = 120;
+        CHECK_TRUE(reflow_program_is_valid(&program));
+
+        program.segments[1].hold_time_s = 121;
+        CHECK_FALSE(reflow_program_is_valid(&program));
+        CHECK_FALSE(reflow_program_encode(&program, buffer, sizeof(buffer),
+                                          &written));
+
+        // Going below liquidus between two stretches doesn't reset the time
+        program.segments[1].hold_time_s = 60;
+        program.segments[2] = {200, 2, 0};
+        program.segments[3] = {230, 2, 60};
+        program.segment_count = 3;
+        CHECK_TRUE(reflow_program_is_valid(&program));
+
+        program.segment_count = 4;
+        CHECK_FALSE(reflow_program_is_valid(&program));
+}
@@ -0,0 +1,252 @@
+/*!
+ *******************************************************************************
+ * @file reflow_trajectory_tests.cpp
+ *
+ * @brief Checks on the compiled trajectories: pieces built from a program,
+ *        setpoint and phase lookups, and agreement of the indexed lookups with
+ *        a plain search of the pieces
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include "CppUTest/TestHarness.h"
+
+#include "reflow_profile.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Temperature at which the checked runs start
+#define START_TEMPERATURE_C                 (30)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(reflow_trajectory)
+{
+        reflow_program_t program;
+        reflow_trajectory_t trajectory;
+
+        void setup()
+        {
+                reflow_profile_t const profile = {
+                        "trajectory", 150, 60, 230, 30, 60, 300, 2
+                };
+
+                CHECK_TRUE(reflow_program_from_profile(&profile, &program));
+                CHECK_TRUE(reflow_trajectory_compile(&program, START_TEMPERATURE_C,
+                                                     &trajectory));
+        }
+
+        uint16_t setpoint_at(uint32_t const time_ms)
+        {
+                uint16_t temperature = 0;
+
+                CHECK_TRUE(reflow_trajectory_get_setpoint(&trajectory, time_ms,
+                                                          &temperature));
+
+                return temperature;
+        }
+
+        void check_phase_at(uint32_t const time_ms,
+                            reflow_trajectory_phase_t const expected_phase,
+                            uint8_t const expected_segment)
+        {
+                reflow_trajectory_phase_t phase;
+                uint8_t segment;
+
+                CHECK_TRUE(reflow_trajectory_get_phase(&trajectory, time_ms,
+                                                       &phase, &segment));
+                ENUMS_EQUAL_INT(expected_phase, phase);
+                UNSIGNED_LONGS_EQUAL(expected_segment, segment);
+        }
+};
+
+TEST(reflow_trajectory, segments_compile_to_ramps_holds_and_cooling)
+{
+        // 30 -> 150 at 2 C/s, hold 60 s, 150 -> 230 at 2 C/s, hold 30 s,
+        // cooling to 60 in 300 s
+        UNSIGNED_LONGS_EQUAL(5, trajectory.piece_count);
+        UNSIGNED_LONGS_EQUAL((60 + 60 + 40 + 30 + 300) * 1000,
+                             trajectory.duration_ms);
+        UNSIGNED_LONGS_EQUAL(230, trajectory.peak_temperature);
+        UNSIGNED_LONGS_EQUAL(60, trajectory.end_temperature);
+
+        UNSIGNED_LONGS_EQUAL(160 * 1000, trajectory.pieces[3].start_ms);
+        UNSIGNED_LONGS_EQUAL(230, trajectory.pieces[3].start_temperature);
+        UNSIGNED_LONGS_EQUAL(230, trajectory.pieces[3].end_temperature);
+}
+
+TEST(reflow_trajectory, setpoint_follows_pieces)
+{
+        UNSIGNED_LONGS_EQUAL(START_TEMPERATURE_C, setpoint_at(0));
+        UNSIGNED_LONGS_EQUAL(90, setpoint_at(30 * 1000));
+        UNSIGNED_LONGS_EQUAL(150, setpoint_at(60 * 1000));
+        UNSIGNED_LONGS_EQUAL(150, setpoint_at(119 * 1000));
+        UNSIGNED_LONGS_EQUAL(190, setpoint_at(140 * 1000));
+        UNSIGNED_LONGS_EQUAL(230, setpoint_at(175 * 1000));
+        UNSIGNED_LONGS_EQUAL(145, setpoint_at((190 + 150) * 1000));
+
+        // Once over, the trajectory stays at its end
+        UNSIGNED_LONGS_EQUAL(60, setpoint_at(490 * 1000));
+        UNSIGNED_LONGS_EQUAL(60, setpoint_at(UINT32_MAX));
+}
+
+TEST(reflow_trajectory, phase_follows_pieces)
+{
+        check_phase_at(0, REFLOW_TRAJECTORY_PHASE_RAMP, 0);
+        check_phase_at(59999, REFLOW_TRAJECTORY_PHASE_RAMP, 0);
+        check_phase_at(60000, REFLOW_TRAJECTORY_PHASE_HOLD, 0);
+        check_phase_at(120000, REFLOW_TRAJECTORY_PHASE_RAMP, 1);
+        check_phase_at(160000, REFLOW_TRAJECTORY_PHASE_HOLD, 1);
+        check_phase_at(190000, REFLOW_TRAJECTORY_PHASE_COOLING, 2);
+        check_phase_at(490000, REFLOW_TRAJECTORY_PHASE_DONE, 2);
+}
+
+TEST(reflow_trajectory, pieces_taking_no_time_are_left_out)
+{
+        program.segments[0].target_temperature = START_TEMPERATURE_C + 20;
+        program.segments[0].hold_time_s = 0;
+        program.segments[1] = {START_TEMPERATURE_C + 20, 1, 10};
+        program.cooling_temperature = START_TEMPERATURE_C + 30;
+
+        CHECK_TRUE(reflow_trajectory_compile(&program, START_TEMPERATURE_C,
+                                             &trajectory));
+
+        // Ramp of the first segment and hold of the second one only
+        UNSIGNED_LONGS_EQUAL(2, trajectory.piece_count);
+        check_phase_at(9999, REFLOW_TRAJECTORY_PHASE_RAMP, 0);
+        check_phase_at(10000, REFLOW_TRAJECTORY_PHASE_HOLD, 1);
+        check_phase_at(20000, REFLOW_TRAJECTORY_PHASE_DONE, 2);
+        UNSIGNED_LONGS_EQUAL(START_TEMPERATURE_C + 20, setpoint_at(20000));
+}
+
+TEST(reflow_trajectory, downward_segment_ramps_down)
+{
+        program.segments[2] = {180, 1, 0};
+        program.segment_count = 3;
+
+        CHECK_TRUE(reflow_trajectory_compile(&program, START_TEMPERATURE_C,
+                                             &trajectory));
+
+        UNSIGNED_LONGS_EQUAL(230, trajectory.peak_temperature);
+        UNSIGNED_LONGS_EQUAL(205, setpoint_at((190 + 25) * 1000));
+        check_phase_at((190 + 25) * 1000, REFLOW_TRAJECTORY_PHASE_RAMP, 2);
+}
+
+TEST(reflow_trajectory, indexed_lookup_matches_search)
+{
+        reflow_trajectory_phase_t phase;
+        uint32_t time_ms;
+        uint8_t segment;
+        uint8_t i;
+        uint8_t expected;
+
+        // Long holds next to short ramps, so buckets span several pieces
+        program.segment_count = REFLOW_PROGRAM_SEGMENTS_MAX;
+
+        for (i = 0; REFLOW_PROGRAM_SEGMENTS_MAX > i; i++) {
+                program.segments[i].target_temperature = (uint16_t)(100 + (i % 2));
+                program.segments[i].ramp_speed = 1;
+                program.segments[i].hold_time_s = (0 == (i % 4)) ?
+                                                  REFLOW_PROGRAM_HOLD_TIME_MAX_S : 1;
+        }
+
+        CHECK_TRUE(reflow_trajectory_compile(&program, START_TEMPERATURE_C,
+                                             &trajectory));
+
+        for (time_ms = 0;
+             trajectory.duration_ms > time_ms;
+             time_ms += 1 + (time_ms / 997)) {
+                expected = 0;
+
+                while (((expected + 1) < trajectory.piece_count) &&
+                       (trajectory.pieces[expected + 1].start_ms <= time_ms)) {
+                        expected++;
+                }
+
+                CHECK_TRUE(reflow_trajectory_get_phase(&trajectory, time_ms,
+                                                       &phase, &segment));
+                ENUMS_EQUAL_INT(trajectory.pieces[expected].phase, phase);
+                UNSIGNED_LONGS_EQUAL(trajectory.pieces[expected].segment, segment);
+        }
+}
+
+TEST(reflow_trajectory, invalid_input_fails)
+{
+        uint16_t temperature;
+        reflow_trajectory_phase_t phase;
+        uint8_t segment;
+
+        program.segment_count = 0;
+        CHECK_FALSE(reflow_trajectory_compile(&program, START_TEMPERATURE_C,
+                                              &trajectory));
+        CHECK_FALSE(reflow_trajectory_compile(NULL, START_TEMPERATURE_C,
+                                              &trajectory));
+        CHECK_FALSE(reflow_trajectory_compile(&program, START_TEMPERATURE_C,
+                                              NULL));
+
+        CHECK_FALSE(reflow_trajectory_get_setpoint(NULL, 0, &temperature));
+        CHECK_FALSE(reflow_trajectory_get_setpoint(&trajectory, 0, NULL));
+        CHECK_FALSE(reflow_trajectory_get_phase(&trajectory, 0, &phase, NULL));
+}
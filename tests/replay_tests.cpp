@@ -0,0 +1,537 @@
+/*!
+ *******************************************************************************
+ * @file replay_tests.cpp
+ *
+ * @brief Checks on the event recorder capture format, and on replaying
+ *        captures through the real state machine states
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "driver/gpio_spy.h"
+
+#include "thermocouple.h"
+#include "thermocouple_fake.h"
+#include "heater.h"
+#include "reflow_profile.h"
+#include "reflow_profile_fake.h"
+#include "state_machine/states/state_machine_states.h"
+#include "state_machine/state_machine.h"
+#include "state_machine/event_recorder.h"
+#include "state_machine_replay.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Size of a buffer fitting any capture
+#define CAPTURE_BUFFER_SIZE                 \
+        EVENT_RECORDER_CAPTURE_SIZE(EVENT_RECORDER_CAPACITY)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(event_recorder)
+{
+        event_recorder_t recorder;
+        uint8_t capture[CAPTURE_BUFFER_SIZE];
+        size_t written;
+
+        void setup()
+        {
+                CHECK_TRUE(event_recorder_init(&recorder));
+                written = 0;
+        }
+
+        void add(uint32_t const time_ms, uint16_t const temperature,
+                 uint8_t const type, uint8_t const data)
+        {
+                event_recorder_record_t record = {time_ms, temperature, type, data};
+
+                CHECK_TRUE(event_recorder_add(&recorder, &record));
+        }
+};
+
+TEST(event_recorder, capture_round_trip)
+{
+        event_recorder_record_t record;
+        uint16_t count = 0;
+
+        add(100, 25, STATE_MACHINE_EVENT_TYPE_ACTION, STATE_MACHINE_ACTION_START);
+        add(70000, 150, STATE_MACHINE_EVENT_TYPE_MESSAGE,
+            STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED);
+
+        CHECK_TRUE(event_recorder_serialize(&recorder, capture, sizeof(capture),
+                                            &written));
+        UNSIGNED_LONGS_EQUAL(EVENT_RECORDER_CAPTURE_SIZE(2), written);
+
+        CHECK_TRUE(event_recorder_get_capture_count(capture, written, &count));
+        UNSIGNED_LONGS_EQUAL(2, count);
+
+        CHECK_TRUE(event_recorder_get_capture_record(capture, written, 1, &record));
+        UNSIGNED_LONGS_EQUAL(70000, record.time_ms);
+        UNSIGNED_LONGS_EQUAL(150, record.temperature);
+        UNSIGNED_LONGS_EQUAL(STATE_MACHINE_EVENT_TYPE_MESSAGE, record.type);
+        UNSIGNED_LONGS_EQUAL(STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED,
+                             record.data);
+
+        CHECK_FALSE(event_recorder_get_capture_record(capture, written, 2, &record));
+}
+
+TEST(event_recorder, capture_keeps_program_of_the_run)
+{
+        reflow_program_t program = {0};
+        reflow_program_t decoded = {0};
+
+        add(100, 25, STATE_MACHINE_EVENT_TYPE_ACTION, STATE_MACHINE_ACTION_START);
+
+        // No run started
+        CHECK_TRUE(event_recorder_serialize(&recorder, capture, sizeof(capture),
+                                            &written));
+        CHECK_FALSE(event_recorder_get_capture_program(capture, written, &decoded));
+
+        program.segment_count = 1;
+        program.segments[0] = {200, 3, 60};
+        program.cooling_temperature = 50;
+        program.cooling_time_s = 200;
+        CHECK_TRUE(event_recorder_set_program(&recorder, &program));
+
+        CHECK_TRUE(event_recorder_serialize(&recorder, capture, sizeof(capture),
+                                            &written));
+        UNSIGNED_LONGS_EQUAL(EVENT_RECORDER_CAPTURE_SIZE(1), written);
+        CHECK_TRUE(event_recorder_get_capture_program(capture, written, &decoded));
+        MEMCMP_EQUAL(&program, &decoded, sizeof(program));
+}
+
+TEST(event_recorder, full_ring_keeps_newest_records)
+{
+        event_recorder_record_t record;
+        uint32_t i;
+
+        for (i = 0; (EVENT_RECORDER_CAPACITY + 10) > i; i++) {
+                add(i, 0, STATE_MACHINE_EVENT_TYPE_MESSAGE, 0);
+        }
+
+        UNSIGNED_LONGS_EQUAL(EVENT_RECORDER_CAPACITY,
+                             event_recorder_get_count(&recorder));
+
+        CHECK_TRUE(event_recorder_get(&recorder, 0, &record));
+        UNSIGNED_LONGS_EQUAL(10, record.time_ms);
+
+        CHECK_TRUE(event_recorder_get(&recorder, EVENT_RECORDER_CAPACITY - 1,
+                                      &record));
+        UNSIGNED_LONGS_EQUAL(EVENT_RECORDER_CAPACITY + 9, record.time_ms);
+}
+
+TEST(event_recorder, corrupted_capture_is_rejected)
+{
+        uint16_t count = 0;
+
+        add(100, 25, STATE_MACHINE_EVENT_TYPE_ACTION, STATE_MACHINE_ACTION_START);
+
+        CHECK_TRUE(event_recorder_serialize(&recorder, capture, sizeof(capture),
+                                            &written));
+
+        // Truncated
+        CHECK_FALSE(event_recorder_get_capture_count(capture, written - 1, &count));
+
+        // Bad magic
+        capture[0] ^= 0xFF;
+        CHECK_FALSE(event_recorder_get_capture_count(capture, written, &count));
+}
+
+TEST(event_recorder, small_buffer_is_rejected)
+{
+        add(100, 25, STATE_MACHINE_EVENT_TYPE_ACTION, STATE_MACHINE_ACTION_START);
+
+        CHECK_FALSE(event_recorder_serialize(&recorder, capture,
+                                             EVENT_RECORDER_CAPTURE_SIZE(1) - 1,
+                                             &written));
+}
+
+TEST_GROUP(replay)
+{
+        event_recorder_t recorder;
+        uint8_t capture[CAPTURE_BUFFER_SIZE];
+        size_t capture_size;
+        state_machine_state_text_t trace[EVENT_RECORDER_CAPACITY];
+        size_t trace_len;
+
+        void setup()
+        {
+                reflow_profile_t profile = {"replay", 150, 60, 230, 30, 60, 300, 2};
+                reflow_program_t program;
+
+                gpio_spy_init();
+                queue_spy_create();
+                task_spy_reset();
+                (void)heater_init((heater_temp_getter_t)thermocouple_fake_get_temperature);
+
+                CHECK_TRUE(reflow_profile_fake_set_current(&profile));
+
+                // The run the events were recorded for
+                CHECK_TRUE(event_recorder_init(&recorder));
+                CHECK_TRUE(reflow_program_from_profile(&profile, &program));
+                CHECK_TRUE(event_recorder_set_program(&recorder, &program));
+                capture_size = 0;
+                trace_len = 0;
+        }
+
+        void teardown()
+        {
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_deinit());
+                queue_spy_destroy();
+                gpio_spy_deinit();
+        }
+
+        void add_action(uint32_t const time_ms, uint16_t const temperature,
+                        state_machine_action_t const action)
+        {
+                event_recorder_record_t record = {
+                        time_ms, temperature,
+                        STATE_MACHINE_EVENT_TYPE_ACTION, (uint8_t)action
+                };
+
+                CHECK_TRUE(event_recorder_add(&recorder, &record));
+        }
+
+        void add_message(uint32_t const time_ms, uint16_t const temperature,
+                         state_machine_msg_t const message)
+        {
+                event_recorder_record_t record = {
+                        time_ms, temperature,
+                        STATE_MACHINE_EVENT_TYPE_MESSAGE, (uint8_t)message
+                };
+
+                CHECK_TRUE(event_recorder_add(&recorder, &record));
+        }
+
+        void replay()
+        {
+                CHECK_TRUE(event_recorder_serialize(&recorder, capture,
+                                                    sizeof(capture),
+                                                    &capture_size));
+                CHECK_TRUE(state_machine_replay_load(capture, capture_size));
+                CHECK_TRUE(state_machine_replay_run(trace,
+                                                    EVENT_RECORDER_CAPACITY,
+                                                    &trace_len));
+        }
+
+        // A full run of a two segments program, paused at the second ramp
+        void record_paused_run()
+        {
+                add_action(1000, 25, STATE_MACHINE_ACTION_START);
+                add_message(61000, 150, STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED);
+                add_message(121000, 152, STATE_MACHINE_MSG_SEGMENT_HOLD_TIME_REACHED);
+                add_action(131000, 180, STATE_MACHINE_ACTION_PAUSE);
+                add_action(191000, 181, STATE_MACHINE_ACTION_PAUSE);
+                add_message(211000, 230, STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED);
+                add_message(241000, 231, STATE_MACHINE_MSG_SEGMENT_HOLD_TIME_REACHED);
+                add_message(421000, 60, STATE_MACHINE_MSG_HEATER_COOLING_TARGET_REACHED);
+        }
+
+        void check_segment(uint8_t const expected_index,
+                           bool const expected_is_holding)
+        {
+                uint8_t index = UINT8_MAX;
+                bool is_holding = !expected_is_holding;
+
+                CHECK_TRUE(state_machine_states_get_segment(&index, &is_holding));
+                UNSIGNED_LONGS_EQUAL(expected_index, index);
+                CHECK_EQUAL(expected_is_holding, is_holding);
+        }
+};
+
+TEST(replay, paused_run_follows_recorded_path)
+{
+        state_machine_state_text_t const expected[] = {
+                STATE_MACHINE_STATE_SEGMENT,
+                STATE_MACHINE_STATE_SEGMENT,
+                STATE_MACHINE_STATE_SEGMENT,
+                STATE_MACHINE_STATE_PAUSED,
+                STATE_MACHINE_STATE_SEGMENT,
+                STATE_MACHINE_STATE_SEGMENT,
+                STATE_MACHINE_STATE_COOLING,
+                STATE_MACHINE_STATE_IDLE,
+        };
+        size_t i;
+
+        record_paused_run();
+        replay();
+
+        UNSIGNED_LONGS_EQUAL(sizeof(expected) / sizeof(expected[0]), trace_len);
+
+        for (i = 0; trace_len > i; i++) {
+                ENUMS_EQUAL_INT(expected[i], trace[i]);
+        }
+
+        // The three target reached messages were acknowledged
+        UNSIGNED_LONGS_EQUAL(3, task_spy_get_notify_count());
+}
+
+TEST(replay, segments_ramp_then_hold_in_order)
+{
+        state_machine_state_text_t state;
+
+        record_paused_run();
+
+        CHECK_TRUE(event_recorder_serialize(&recorder, capture, sizeof(capture),
+                                            &capture_size));
+        CHECK_TRUE(state_machine_replay_load(capture, capture_size));
+
+        CHECK_TRUE(state_machine_replay_step(&state));
+        check_segment(0, false);
+        CHECK_TRUE(state_machine_replay_step(&state));
+        check_segment(0, true);
+        CHECK_TRUE(state_machine_replay_step(&state));
+        check_segment(1, false);
+
+        // Pausing and resuming keeps the progress
+        CHECK_TRUE(state_machine_replay_step(&state));
+        CHECK_TRUE(state_machine_replay_step(&state));
+        check_segment(1, false);
+
+        CHECK_TRUE(state_machine_replay_step(&state));
+        check_segment(1, true);
+}
+
+TEST(replay, multi_segment_program)
+{
+        reflow_program_t program = {0};
+        uint16_t target = 0;
+        size_t i;
+
+        // Bake, then a lead free profile with a slow ramp above the soak
+        program.segment_count = 4;
+        program.segments[0] = {120, 2, 3600};
+        program.segments[1] = {180, 1, 90};
+        program.segments[2] = {217, 2, 0};
+        program.segments[3] = {245, 3, 20};
+        program.cooling_temperature = 50;
+        program.cooling_time_s = 400;
+
+        // Recorded with the run, the current profile is left as it is
+        CHECK_TRUE(event_recorder_set_program(&recorder, &program));
+
+        add_action(1000, 25, STATE_MACHINE_ACTION_START);
+
+        for (i = 0; 4 > i; i++) {
+                add_message(10000 * (i + 1), program.segments[i].target_temperature,
+                            STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED);
+
+                // Segments without hold time are done once their target is reached
+                if (0 < program.segments[i].hold_time_s) {
+                        add_message(10000 * (i + 1) + 5000,
+                                    program.segments[i].target_temperature,
+                                    STATE_MACHINE_MSG_SEGMENT_HOLD_TIME_REACHED);
+                }
+        }
+
+        replay();
+
+        UNSIGNED_LONGS_EQUAL(8, trace_len);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_SEGMENT, trace[5]);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_COOLING, trace[7]);
+
+        // Last segment target was the last heater target set
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_get_target(&target));
+        UNSIGNED_LONGS_EQUAL(245, target);
+}
+
+TEST(replay, invalid_program_ends_in_error)
+{
+        reflow_program_t program = {0};
+
+        CHECK_TRUE(event_recorder_set_program(&recorder, &program));
+
+        add_action(1000, 25, STATE_MACHINE_ACTION_START);
+
+        replay();
+
+        UNSIGNED_LONGS_EQUAL(1, trace_len);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_ERROR, trace[0]);
+}
+
+TEST(replay, program_of_a_run_is_kept_until_the_next_one_starts)
+{
+        reflow_program_t const * p_first = NULL;
+        reflow_program_t const * p_second = NULL;
+        reflow_program_t const * p_current = NULL;
+        reflow_program_t program = {0};
+        reflow_program_t invalid = {0};
+
+        add_action(1000, 25, STATE_MACHINE_ACTION_START);
+        replay();
+        CHECK_TRUE(state_machine_states_get_program(&p_first));
+        UNSIGNED_LONGS_EQUAL(2, p_first->segment_count);
+
+        program.segment_count = 1;
+        program.segments[0] = {200, 2, 10};
+        program.cooling_temperature = 50;
+        program.cooling_time_s = 300;
+
+        CHECK_TRUE(event_recorder_init(&recorder));
+        CHECK_TRUE(event_recorder_set_program(&recorder, &program));
+        add_action(1000, 25, STATE_MACHINE_ACTION_START);
+        replay();
+        CHECK_TRUE(state_machine_states_get_program(&p_second));
+        UNSIGNED_LONGS_EQUAL(1, p_second->segment_count);
+
+        // Readers still holding the previous run are not written under
+        CHECK(p_first != p_second);
+        UNSIGNED_LONGS_EQUAL(2, p_first->segment_count);
+
+        // A run that can't start leaves the last one in place
+        CHECK_TRUE(event_recorder_init(&recorder));
+        CHECK_TRUE(event_recorder_set_program(&recorder, &invalid));
+        add_action(1000, 25, STATE_MACHINE_ACTION_START);
+        replay();
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_ERROR, trace[0]);
+        CHECK_TRUE(state_machine_states_get_program(&p_current));
+        POINTERS_EQUAL(p_second, p_current);
+}
+
+TEST(replay, pause_holds_recorded_temperature)
+{
+        state_machine_state_text_t state;
+        uint16_t target = 0;
+
+        record_paused_run();
+
+        CHECK_TRUE(event_recorder_serialize(&recorder, capture, sizeof(capture),
+                                            &capture_size));
+        CHECK_TRUE(state_machine_replay_load(capture, capture_size));
+
+        do {
+                CHECK_TRUE(state_machine_replay_step(&state));
+        } while (STATE_MACHINE_STATE_PAUSED != state);
+
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_get_target(&target));
+        UNSIGNED_LONGS_EQUAL(180, target);
+}
+
+TEST(replay, same_capture_gives_same_trace)
+{
+        state_machine_state_text_t first[EVENT_RECORDER_CAPACITY];
+        size_t first_len;
+        size_t i;
+
+        record_paused_run();
+
+        replay();
+        first_len = trace_len;
+
+        for (i = 0; trace_len > i; i++) {
+                first[i] = trace[i];
+        }
+
+        replay();
+
+        UNSIGNED_LONGS_EQUAL(first_len, trace_len);
+
+        for (i = 0; trace_len > i; i++) {
+                ENUMS_EQUAL_INT(first[i], trace[i]);
+        }
+}
+
+TEST(replay, phase_messages_are_acknowledged_while_cooling)
+{
+        add_action(1000, 25, STATE_MACHINE_ACTION_START);
+        add_action(20000, 60, STATE_MACHINE_ACTION_ABORT);
+
+        // Raised by thermocouple_task right before the abort went through
+        add_message(20100, 61, STATE_MACHINE_MSG_HEATER_SEGMENT_TARGET_REACHED);
+        add_message(20200, 61, STATE_MACHINE_MSG_HEATER_TOO_SLOW);
+        add_message(20300, 61, STATE_MACHINE_MSG_HEATER_TIMEOUT);
+        add_message(200000, 60, STATE_MACHINE_MSG_HEATER_COOLING_TARGET_REACHED);
+
+        replay();
+
+        UNSIGNED_LONGS_EQUAL(6, trace_len);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_SEGMENT, trace[0]);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_COOLING, trace[1]);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_COOLING, trace[4]);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_IDLE, trace[5]);
+
+        // None of them left thermocouple_task waiting
+        UNSIGNED_LONGS_EQUAL(4, task_spy_get_notify_count());
+}
+
+TEST(replay, stalled_heating_ends_in_error_until_reset)
+{
+        add_action(1000, 25, STATE_MACHINE_ACTION_START);
+        add_message(31000, 26, STATE_MACHINE_MSG_HEATER_TOO_SLOW);
+        add_action(40000, 26, STATE_MACHINE_ACTION_RESET);
+
+        replay();
+
+        UNSIGNED_LONGS_EQUAL(3, trace_len);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_SEGMENT, trace[0]);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_ERROR, trace[1]);
+        ENUMS_EQUAL_INT(STATE_MACHINE_STATE_IDLE, trace[2]);
+        CHECK_FALSE(heater_is_powered());
+}
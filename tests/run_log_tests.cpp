@@ -0,0 +1,425 @@
+/*!
+ *******************************************************************************
+ * @file run_log_tests.cpp
+ *
+ * @brief Checks on the run log and its double buffer, on a fake NOR flash:
+ *        reading back, remounting, wear levelling and power loss
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+
+#include "spi_flash_fake.h"
+#include "run_log.h"
+#include "run_log_buffer.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Number of sectors of the checked logs
+#define SECTORS_CNT                         (4)
+
+//! @brief Records of this size fill a sector with 15 of them
+#define RECORD_PAYLOAD_SIZE                 (256)
+#define RECORDS_PER_SECTOR                  (15)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+static run_log_flash_t const m_flash = {
+        spi_flash_fake_read,
+        spi_flash_fake_write,
+        spi_flash_fake_erase_sector,
+        SECTORS_CNT
+};
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(run_log)
+{
+        run_log_t log;
+
+        void setup()
+        {
+                spi_flash_fake_init(SECTORS_CNT);
+                CHECK_TRUE(run_log_mount(&log, &m_flash));
+        }
+
+        // Payload tagged with its index, so the order can be checked
+        void append(uint32_t const index, size_t const size)
+        {
+                uint8_t payload[RUN_LOG_PAYLOAD_SIZE_MAX];
+
+                memset(payload, (uint8_t)index, size);
+                CHECK_TRUE(run_log_append(&log, RUN_LOG_RECORD_TYPE_TRACE,
+                                          payload, size));
+        }
+
+        // Read every record, checking they are in order, and count them
+        uint32_t read_all(uint32_t * const p_first)
+        {
+                run_log_iterator_t iterator;
+                run_log_record_type_t type;
+                uint8_t payload[RUN_LOG_PAYLOAD_SIZE_MAX];
+                size_t length;
+                uint32_t count = 0;
+
+                CHECK_TRUE(run_log_iterate_start(&log, &iterator));
+
+                while (run_log_iterate_next(&log, &iterator, &type, payload,
+                                            sizeof(payload), &length)) {
+                        if (0 == count) {
+                                *p_first = payload[0];
+                        }
+
+                        UNSIGNED_LONGS_EQUAL((uint8_t)(*p_first + count), payload[0]);
+                        count++;
+                }
+
+                return count;
+        }
+};
+
+TEST(run_log, records_read_back_in_order)
+{
+        run_log_iterator_t iterator;
+        run_log_record_type_t type;
+        uint8_t payload[RUN_LOG_PAYLOAD_SIZE_MAX];
+        uint8_t const start[] = {1, 2, 3};
+        size_t length;
+
+        CHECK_TRUE(run_log_append(&log, RUN_LOG_RECORD_TYPE_RUN_START,
+                                  start, sizeof(start)));
+        append(7, 10);
+        CHECK_TRUE(run_log_append(&log, RUN_LOG_RECORD_TYPE_RUN_END, NULL, 0));
+
+        CHECK_TRUE(run_log_iterate_start(&log, &iterator));
+
+        CHECK_TRUE(run_log_iterate_next(&log, &iterator, &type, payload,
+                                        sizeof(payload), &length));
+        ENUMS_EQUAL_INT(RUN_LOG_RECORD_TYPE_RUN_START, type);
+        UNSIGNED_LONGS_EQUAL(sizeof(start), length);
+        MEMCMP_EQUAL(start, payload, sizeof(start));
+
+        CHECK_TRUE(run_log_iterate_next(&log, &iterator, &type, payload,
+                                        sizeof(payload), &length));
+        ENUMS_EQUAL_INT(RUN_LOG_RECORD_TYPE_TRACE, type);
+        UNSIGNED_LONGS_EQUAL(10, length);
+        UNSIGNED_LONGS_EQUAL(7, payload[9]);
+
+        CHECK_TRUE(run_log_iterate_next(&log, &iterator, &type, payload,
+                                        sizeof(payload), &length));
+        ENUMS_EQUAL_INT(RUN_LOG_RECORD_TYPE_RUN_END, type);
+        UNSIGNED_LONGS_EQUAL(0, length);
+
+        CHECK_FALSE(run_log_iterate_next(&log, &iterator, &type, payload,
+                                         sizeof(payload), &length));
+}
+
+TEST(run_log, empty_log_has_no_records)
+{
+        uint32_t first = 0;
+
+        UNSIGNED_LONGS_EQUAL(0, read_all(&first));
+        UNSIGNED_LONGS_EQUAL(0, spi_flash_fake_get_erase_count(0));
+}
+
+TEST(run_log, remount_appends_after_the_last_record)
+{
+        uint32_t first = 0;
+        uint32_t i;
+
+        for (i = 0; (RECORDS_PER_SECTOR + 3) > i; i++) {
+                append(i, RECORD_PAYLOAD_SIZE);
+        }
+
+        CHECK_TRUE(run_log_mount(&log, &m_flash));
+        UNSIGNED_LONGS_EQUAL(1, log.head_sector);
+
+        append(i, 5);
+
+        UNSIGNED_LONGS_EQUAL(RECORDS_PER_SECTOR + 4, read_all(&first));
+        UNSIGNED_LONGS_EQUAL(0, first);
+        UNSIGNED_LONGS_EQUAL(1, spi_flash_fake_get_erase_count(1));
+}
+
+TEST(run_log, wrapping_around_drops_the_oldest_sector)
+{
+        uint32_t first = 0;
+        uint32_t const count = (RECORDS_PER_SECTOR * SECTORS_CNT) + 1;
+        uint32_t i;
+
+        for (i = 0; count > i; i++) {
+                append(i, RECORD_PAYLOAD_SIZE);
+        }
+
+        // The first sector was taken again for the last record
+        UNSIGNED_LONGS_EQUAL(0, log.head_sector);
+        UNSIGNED_LONGS_EQUAL(1 + (RECORDS_PER_SECTOR * (SECTORS_CNT - 1)),
+                             read_all(&first));
+        UNSIGNED_LONGS_EQUAL(RECORDS_PER_SECTOR, first);
+}
+
+TEST(run_log, sectors_wear_evenly)
+{
+        uint32_t min_count = UINT32_MAX;
+        uint32_t max_count = 0;
+        uint32_t count;
+        uint32_t i;
+
+        for (i = 0; (RECORDS_PER_SECTOR * SECTORS_CNT * 10 + 7) > i; i++) {
+                append(i, RECORD_PAYLOAD_SIZE);
+
+                // Remounting now and then doesn't change the order
+                if (0 == (i % 37)) {
+                        CHECK_TRUE(run_log_mount(&log, &m_flash));
+                }
+        }
+
+        for (i = 0; SECTORS_CNT > i; i++) {
+                count = spi_flash_fake_get_erase_count(i);
+                min_count = (min_count > count) ? count : min_count;
+                max_count = (max_count < count) ? count : max_count;
+        }
+
+        CHECK_TRUE(10 <= min_count);
+        CHECK_TRUE(1 >= (max_count - min_count));
+}
+
+TEST(run_log, power_loss_while_appending_keeps_earlier_records)
+{
+        uint32_t first = 0;
+
+        append(0, 100);
+        append(1, 100);
+
+        // Cut the next record halfway
+        spi_flash_fake_lose_power_at(1);
+        CHECK_FALSE(run_log_append(&log, RUN_LOG_RECORD_TYPE_TRACE,
+                                   (uint8_t const *)"abcdefgh", 8));
+        spi_flash_fake_lose_power_at(0);
+
+        CHECK_TRUE(run_log_mount(&log, &m_flash));
+        UNSIGNED_LONGS_EQUAL(2, read_all(&first));
+
+        // The damaged sector is left, and appending goes on at the next one
+        append(2, 100);
+        UNSIGNED_LONGS_EQUAL(1, log.head_sector);
+        UNSIGNED_LONGS_EQUAL(3, read_all(&first));
+        UNSIGNED_LONGS_EQUAL(0, first);
+}
+
+TEST(run_log, power_loss_while_taking_a_sector_is_recovered)
+{
+        uint8_t payload[RECORD_PAYLOAD_SIZE];
+        uint32_t first = 0;
+        uint32_t i;
+
+        for (i = 0; RECORDS_PER_SECTOR > i; i++) {
+                append(i, RECORD_PAYLOAD_SIZE);
+        }
+
+        // Erase goes through, and the header write is cut
+        memset(payload, 0, sizeof(payload));
+        spi_flash_fake_lose_power_at(2);
+        CHECK_FALSE(run_log_append(&log, RUN_LOG_RECORD_TYPE_TRACE,
+                                   payload, sizeof(payload)));
+        spi_flash_fake_lose_power_at(0);
+
+        CHECK_TRUE(run_log_mount(&log, &m_flash));
+        UNSIGNED_LONGS_EQUAL(0, log.head_sector);
+
+        append(i, RECORD_PAYLOAD_SIZE);
+        UNSIGNED_LONGS_EQUAL(1, log.head_sector);
+        UNSIGNED_LONGS_EQUAL(RECORDS_PER_SECTOR + 1, read_all(&first));
+        UNSIGNED_LONGS_EQUAL(0, first);
+}
+
+TEST(run_log, invalid_input_fails)
+{
+        uint8_t payload[RUN_LOG_PAYLOAD_SIZE_MAX + 1];
+        run_log_flash_t flash = m_flash;
+
+        CHECK_FALSE(run_log_append(&log, RUN_LOG_RECORD_TYPE_COUNT, payload, 1));
+        CHECK_FALSE(run_log_append(&log, RUN_LOG_RECORD_TYPE_TRACE, payload,
+                                   sizeof(payload)));
+        CHECK_FALSE(run_log_append(&log, RUN_LOG_RECORD_TYPE_TRACE, NULL, 1));
+
+        flash.sector_count = 1;
+        CHECK_FALSE(run_log_mount(&log, &flash));
+
+        flash = m_flash;
+        flash.pf_erase = NULL;
+        CHECK_FALSE(run_log_mount(&log, &flash));
+}
+
+TEST_GROUP(run_log_buffer)
+{
+        run_log_buffer_t buffer;
+        run_log_buffer_slot_t * p_slot;
+
+        void setup()
+        {
+                p_slot = NULL;
+                CHECK_TRUE(run_log_buffer_init(&buffer));
+        }
+
+        bool put(uint8_t const value, size_t const size)
+        {
+                uint8_t data[RUN_LOG_PAYLOAD_SIZE_MAX];
+
+                memset(data, value, size);
+
+                return run_log_buffer_put(&buffer, RUN_LOG_RECORD_TYPE_TRACE,
+                                          data, size);
+        }
+};
+
+TEST(run_log_buffer, bytes_are_gathered_until_sealed)
+{
+        CHECK_TRUE(put(1, 8));
+        CHECK_TRUE(put(2, 8));
+        CHECK_FALSE(run_log_buffer_is_pending(&buffer));
+        CHECK_FALSE(run_log_buffer_take(&buffer, &p_slot));
+
+        CHECK_TRUE(run_log_buffer_seal(&buffer));
+        CHECK_TRUE(run_log_buffer_is_pending(&buffer));
+
+        CHECK_TRUE(run_log_buffer_take(&buffer, &p_slot));
+        UNSIGNED_LONGS_EQUAL(16, p_slot->length);
+        UNSIGNED_LONGS_EQUAL(1, p_slot->payload[0]);
+        UNSIGNED_LONGS_EQUAL(2, p_slot->payload[15]);
+        CHECK_TRUE(run_log_buffer_release(&buffer, p_slot));
+        CHECK_FALSE(run_log_buffer_release(&buffer, p_slot));
+}
+
+TEST(run_log_buffer, full_and_retyped_records_are_sealed)
+{
+        uint8_t const end = 9;
+
+        CHECK_TRUE(put(1, RUN_LOG_PAYLOAD_SIZE_MAX - 4));
+
+        // Doesn't fit, goes to the other slot
+        CHECK_TRUE(put(2, 8));
+        CHECK_TRUE(run_log_buffer_is_pending(&buffer));
+
+        CHECK_TRUE(run_log_buffer_take(&buffer, &p_slot));
+        UNSIGNED_LONGS_EQUAL(1, p_slot->payload[0]);
+        CHECK_TRUE(run_log_buffer_release(&buffer, p_slot));
+
+        CHECK_TRUE(run_log_buffer_put(&buffer, RUN_LOG_RECORD_TYPE_RUN_END,
+                                      &end, 1));
+        CHECK_TRUE(run_log_buffer_seal(&buffer));
+
+        CHECK_TRUE(run_log_buffer_take(&buffer, &p_slot));
+        ENUMS_EQUAL_INT(RUN_LOG_RECORD_TYPE_TRACE, p_slot->type);
+        UNSIGNED_LONGS_EQUAL(8, p_slot->length);
+        CHECK_TRUE(run_log_buffer_release(&buffer, p_slot));
+
+        CHECK_TRUE(run_log_buffer_take(&buffer, &p_slot));
+        ENUMS_EQUAL_INT(RUN_LOG_RECORD_TYPE_RUN_END, p_slot->type);
+        CHECK_TRUE(run_log_buffer_release(&buffer, p_slot));
+}
+
+TEST(run_log_buffer, bytes_are_dropped_while_the_writer_lags)
+{
+        run_log_buffer_slot_t * p_other = NULL;
+
+        CHECK_TRUE(put(1, 8));
+        CHECK_TRUE(run_log_buffer_seal(&buffer));
+        CHECK_TRUE(run_log_buffer_take(&buffer, &p_slot));
+
+        // One slot being written, the other one full
+        CHECK_TRUE(put(2, RUN_LOG_PAYLOAD_SIZE_MAX));
+        CHECK_FALSE(put(3, 8));
+        CHECK_FALSE(put(3, 8));
+        UNSIGNED_LONGS_EQUAL(2, buffer.dropped_count);
+
+        // Written slots are filled again, oldest sealed taken first
+        CHECK_TRUE(run_log_buffer_release(&buffer, p_slot));
+        CHECK_TRUE(put(4, 8));
+        CHECK_TRUE(run_log_buffer_seal(&buffer));
+
+        CHECK_TRUE(run_log_buffer_take(&buffer, &p_slot));
+        UNSIGNED_LONGS_EQUAL(2, p_slot->payload[0]);
+        CHECK_TRUE(run_log_buffer_take(&buffer, &p_other));
+        UNSIGNED_LONGS_EQUAL(4, p_other->payload[0]);
+}
+
+TEST(run_log_buffer, room_is_left_only_in_the_record_being_filled)
+{
+        UNSIGNED_LONGS_EQUAL(0, run_log_buffer_get_room(&buffer,
+                                                        RUN_LOG_RECORD_TYPE_TRACE));
+
+        CHECK_TRUE(put(1, 10));
+        UNSIGNED_LONGS_EQUAL(RUN_LOG_PAYLOAD_SIZE_MAX - 10,
+                             run_log_buffer_get_room(&buffer,
+                                                     RUN_LOG_RECORD_TYPE_TRACE));
+        UNSIGNED_LONGS_EQUAL(0, run_log_buffer_get_room(&buffer,
+                                                        RUN_LOG_RECORD_TYPE_RUN_END));
+
+        CHECK_TRUE(run_log_buffer_seal(&buffer));
+        UNSIGNED_LONGS_EQUAL(0, run_log_buffer_get_room(&buffer,
+                                                        RUN_LOG_RECORD_TYPE_TRACE));
+}
@@ -0,0 +1,308 @@
+/*!
+ *******************************************************************************
+ * @file run_statistics_tests.cpp
+ *
+ * @brief Checks on the run statistics: figures computed from synthetic runs,
+ *        and encoding of their summaries
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <string.h>
+
+#include "CppUTest/TestHarness.h"
+
+#include "run_statistics.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Liquidus and settling band of the checked runs, in Celsius
+#define LIQUIDUS_C                          (217)
+#define SETTLING_BAND_C                     (3)
+
+//! @brief Shorthands for the phases
+#define RAMP                                REFLOW_TRAJECTORY_PHASE_RAMP
+#define HOLD                                REFLOW_TRAJECTORY_PHASE_HOLD
+#define COOLING                             REFLOW_TRAJECTORY_PHASE_COOLING
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(run_statistics)
+{
+        run_statistics_t statistics;
+        run_statistics_summary_t summary;
+
+        void setup()
+        {
+                CHECK_TRUE(run_statistics_start(&statistics, "SAC305",
+                                                LIQUIDUS_C, SETTLING_BAND_C));
+        }
+
+        void add(uint32_t const time_ms,
+                 uint16_t const temperature,
+                 reflow_trajectory_phase_t const phase,
+                 uint8_t const segment,
+                 uint16_t const target)
+        {
+                CHECK_TRUE(run_statistics_add_sample(&statistics, time_ms,
+                                                     temperature, phase,
+                                                     segment, target));
+        }
+
+        void finish(void)
+        {
+                CHECK_TRUE(run_statistics_finish(&statistics,
+                                                 RUN_STATISTICS_OUTCOME_COMPLETED,
+                                                 &summary));
+        }
+
+        // Ramp to 240 at 15 C/s, overshoot, settle after a dip, then cool
+        void add_reflow_peak(void)
+        {
+                add(0, 210, RAMP, 0, 240);
+                add(1000, 220, RAMP, 0, 240);
+                add(2000, 240, RAMP, 0, 240);
+                add(3000, 244, HOLD, 0, 240);
+                add(4000, 238, HOLD, 0, 240);
+                add(5000, 236, HOLD, 0, 240);
+                add(6000, 240, HOLD, 0, 240);
+                add(7000, 227, COOLING, 1, 60);
+                add(8000, 207, COOLING, 1, 60);
+        }
+};
+
+TEST(run_statistics, peak_and_time_above_liquidus)
+{
+        add_reflow_peak();
+        finish();
+
+        STRCMP_EQUAL("SAC305", summary.profile_name);
+        UNSIGNED_LONGS_EQUAL(8000, summary.duration_ms);
+        UNSIGNED_LONGS_EQUAL(244, summary.peak_temperature);
+        UNSIGNED_LONGS_EQUAL(3000, summary.peak_time_ms);
+
+        // Crossings are interpolated: 217 is reached 0.7 s into the first
+        // second, and left 0.5 s into the last one
+        UNSIGNED_LONGS_EQUAL(300 + 6000 + 500, summary.time_above_liquidus_ms);
+        UNSIGNED_LONGS_EQUAL(LIQUIDUS_C, summary.liquidus_temperature);
+}
+
+TEST(run_statistics, overshoot_and_settling_time)
+{
+        add_reflow_peak();
+        finish();
+
+        UNSIGNED_LONGS_EQUAL(4, summary.overshoot);
+        UNSIGNED_LONGS_EQUAL(0, summary.overshoot_segment);
+
+        // Last out of the band 2 s after the hold started
+        UNSIGNED_LONGS_EQUAL(2000, summary.settling_time_ms);
+        UNSIGNED_LONGS_EQUAL(0, summary.settling_segment);
+}
+
+TEST(run_statistics, rates_are_measured_over_windows_within_a_phase)
+{
+        add_reflow_peak();
+        finish();
+
+        CHECK_TRUE(summary.rates[RAMP].is_measured);
+        LONGS_EQUAL(150, summary.rates[RAMP].max_rate);
+        LONGS_EQUAL(150, summary.rates[RAMP].min_rate);
+
+        CHECK_TRUE(summary.rates[HOLD].is_measured);
+        LONGS_EQUAL(-40, summary.rates[HOLD].max_rate);
+        LONGS_EQUAL(-40, summary.rates[HOLD].min_rate);
+
+        // Cooling lasted less than a window
+        CHECK_FALSE(summary.rates[COOLING].is_measured);
+}
+
+TEST(run_statistics, rates_keep_extremes_of_each_phase)
+{
+        uint32_t time_ms;
+        uint16_t temperature = 25;
+
+        // 2 C/s for 10 s, then 1 C/s for 10 s, sampled at 4 Hz
+        for (time_ms = 0; 20000 >= time_ms; time_ms += 250) {
+                temperature = (uint16_t)(25 + ((10000 >= time_ms) ?
+                                               (time_ms / 500) :
+                                               (20 + ((time_ms - 10000) / 1000))));
+                add(time_ms, temperature, RAMP, 0, 150);
+        }
+
+        for (time_ms = 20250; 30000 >= time_ms; time_ms += 250) {
+                add(time_ms, (uint16_t)(temperature - ((time_ms - 20000) / 500)),
+                    COOLING, 1, 60);
+        }
+
+        finish();
+
+        LONGS_EQUAL(20, summary.rates[RAMP].max_rate);
+        LONGS_EQUAL(10, summary.rates[RAMP].min_rate);
+        CHECK_FALSE(summary.rates[HOLD].is_measured);
+        LONGS_EQUAL(-20, summary.rates[COOLING].max_rate);
+        LONGS_EQUAL(-20, summary.rates[COOLING].min_rate);
+}
+
+TEST(run_statistics, segments_ramping_down_do_not_overshoot)
+{
+        add(0, 200, RAMP, 0, 150);
+        add(1000, 180, RAMP, 0, 150);
+        add(2000, 150, HOLD, 0, 150);
+        add(3000, 152, HOLD, 0, 150);
+        finish();
+
+        UNSIGNED_LONGS_EQUAL(0, summary.overshoot);
+}
+
+TEST(run_statistics, unsettled_hold_settles_at_its_end)
+{
+        add(0, 150, HOLD, 0, 150);
+        add(1000, 160, HOLD, 0, 150);
+        add(2000, 160, HOLD, 0, 150);
+        finish();
+
+        UNSIGNED_LONGS_EQUAL(2000, summary.settling_time_ms);
+
+        // Finishing again doesn't account the hold twice
+        add(3000, 160, HOLD, 0, 150);
+        finish();
+        UNSIGNED_LONGS_EQUAL(2000, summary.settling_time_ms);
+}
+
+TEST(run_statistics, summary_round_trips)
+{
+        uint8_t buffer[RUN_STATISTICS_SUMMARY_SIZE_MAX];
+        run_statistics_summary_t decoded;
+        size_t written = 0;
+
+        add_reflow_peak();
+        CHECK_TRUE(run_statistics_finish(&statistics,
+                                         RUN_STATISTICS_OUTCOME_ABORTED,
+                                         &summary));
+
+        CHECK_TRUE(run_statistics_encode_summary(&summary, buffer,
+                                                 sizeof(buffer), &written));
+        UNSIGNED_LONGS_EQUAL(RUN_STATISTICS_SUMMARY_FIXED_SIZE + strlen("SAC305"),
+                             written);
+
+        memset(&decoded, 0xA5, sizeof(decoded));
+        CHECK_TRUE(run_statistics_decode_summary(buffer, written, &decoded));
+
+        STRCMP_EQUAL(summary.profile_name, decoded.profile_name);
+        ENUMS_EQUAL_INT(RUN_STATISTICS_OUTCOME_ABORTED, decoded.outcome);
+        UNSIGNED_LONGS_EQUAL(summary.time_above_liquidus_ms,
+                             decoded.time_above_liquidus_ms);
+        UNSIGNED_LONGS_EQUAL(summary.settling_time_ms, decoded.settling_time_ms);
+        UNSIGNED_LONGS_EQUAL(summary.peak_temperature, decoded.peak_temperature);
+        UNSIGNED_LONGS_EQUAL(summary.overshoot, decoded.overshoot);
+        CHECK_TRUE(decoded.rates[HOLD].is_measured);
+        LONGS_EQUAL(-40, decoded.rates[HOLD].min_rate);
+        CHECK_FALSE(decoded.rates[COOLING].is_measured);
+}
+
+TEST(run_statistics, damaged_summary_is_rejected)
+{
+        uint8_t buffer[RUN_STATISTICS_SUMMARY_SIZE_MAX];
+        run_statistics_summary_t decoded;
+        size_t written = 0;
+        size_t i;
+
+        add_reflow_peak();
+        finish();
+        CHECK_TRUE(run_statistics_encode_summary(&summary, buffer,
+                                                 sizeof(buffer), &written));
+
+        for (i = 0; written > i; i++) {
+                buffer[i] ^= 0x10;
+                CHECK_FALSE(run_statistics_decode_summary(buffer, written, &decoded));
+                buffer[i] ^= 0x10;
+        }
+
+        CHECK_FALSE(run_statistics_decode_summary(buffer, written - 1, &decoded));
+        CHECK_TRUE(run_statistics_decode_summary(buffer, written, &decoded));
+}
+
+TEST(run_statistics, invalid_input_fails)
+{
+        uint8_t buffer[RUN_STATISTICS_SUMMARY_SIZE_MAX];
+        size_t written;
+
+        CHECK_FALSE(run_statistics_start(&statistics, "name_way_too_long",
+                                         LIQUIDUS_C, SETTLING_BAND_C));
+        CHECK_FALSE(run_statistics_start(NULL, "a", LIQUIDUS_C, SETTLING_BAND_C));
+
+        add(1000, 100, RAMP, 0, 150);
+        CHECK_FALSE(run_statistics_add_sample(&statistics, 999, 100, RAMP, 0, 150));
+        CHECK_FALSE(run_statistics_add_sample(&statistics, 2000, 100,
+                                              REFLOW_TRAJECTORY_PHASE_COUNT, 0, 150));
+        CHECK_FALSE(run_statistics_finish(&statistics,
+                                          RUN_STATISTICS_OUTCOME_COUNT, &summary));
+
+        finish();
+        CHECK_FALSE(run_statistics_encode_summary(&summary, buffer,
+                                                  RUN_STATISTICS_SUMMARY_FIXED_SIZE,
+                                                  &written));
+}
@@ -0,0 +1,467 @@
+/*!
+ *******************************************************************************
+ * @file run_trace_codec_tests.cpp
+ *
+ * @brief Checks on the run trace codec: round trips, edge values and damaged
+ *        input, and a simulated run, timed when benchmarks are printed
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#if TESTS_PRINT_BENCHMARKS
+#include <chrono>
+#endif // #if TESTS_PRINT_BENCHMARKS
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "CppUTest/TestHarness.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "driver/gpio_spy.h"
+
+#include "thermocouple_fake.h"
+#include "oven_plant_fake.h"
+#include "heater.h"
+#include "run_trace_codec.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Size in bytes of a sample packed as is, as the run log did before
+#define RAW_SAMPLE_SIZE                     (8)
+
+//! @brief Resolution of the simulation, and period of the heater task in it
+#define SIMULATION_STEP_MS                  (10)
+#define HEATER_TASK_PERIOD_MS               (100)
+
+//! @brief Sampling period of the simulated run
+#define SAMPLE_PERIOD_MS                    (250)
+
+//! @brief Number of passes over the simulated run
+#define BENCHMARK_ITERATIONS                (200)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+#if TESTS_PRINT_BENCHMARKS
+static double elapsed_s(std::chrono::steady_clock::time_point const start)
+{
+        std::chrono::duration<double> const elapsed =
+                std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+}
+#endif // #if TESTS_PRINT_BENCHMARKS
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(run_trace_codec)
+{
+        run_trace_codec_t encoder;
+        run_trace_codec_t decoder;
+        uint8_t buffer[64 * RUN_TRACE_CODEC_SAMPLE_SIZE_MAX];
+        size_t length;
+
+        void setup()
+        {
+                length = 0;
+                CHECK_TRUE(run_trace_codec_reset(&encoder));
+                CHECK_TRUE(run_trace_codec_reset(&decoder));
+        }
+
+        size_t encode(uint32_t const time_ms,
+                      uint16_t const temperature,
+                      uint8_t const phase,
+                      uint8_t const segment)
+        {
+                run_trace_codec_sample_t const sample = {
+                        time_ms, temperature, phase, segment
+                };
+                size_t written = 0;
+
+                CHECK_TRUE(run_trace_codec_encode(&encoder, &sample,
+                                                  &buffer[length],
+                                                  sizeof(buffer) - length,
+                                                  &written));
+                length += written;
+
+                return written;
+        }
+
+        void check_decode(size_t * const p_offset,
+                          uint32_t const time_ms,
+                          uint16_t const temperature,
+                          uint8_t const phase,
+                          uint8_t const segment)
+        {
+                run_trace_codec_sample_t sample;
+                size_t consumed = 0;
+
+                CHECK_TRUE(run_trace_codec_decode(&decoder, &buffer[*p_offset],
+                                                  length - *p_offset,
+                                                  &sample, &consumed));
+                *p_offset += consumed;
+
+                UNSIGNED_LONGS_EQUAL(time_ms, sample.time_ms);
+                UNSIGNED_LONGS_EQUAL(temperature, sample.temperature);
+                UNSIGNED_LONGS_EQUAL(phase, sample.phase);
+                UNSIGNED_LONGS_EQUAL(segment, sample.segment);
+        }
+};
+
+TEST(run_trace_codec, steady_samples_take_two_bytes)
+{
+        size_t offset = 0;
+
+        // The first two samples set the period
+        encode(1000, 25, 0, 0);
+        encode(1250, 26, 0, 0);
+        UNSIGNED_LONGS_EQUAL(2, encode(1500, 26, 0, 0));
+        UNSIGNED_LONGS_EQUAL(2, encode(1750, 25, 0, 0));
+
+        // Phase changes add the context
+        UNSIGNED_LONGS_EQUAL(4, encode(2000, 25, 1, 0));
+
+        check_decode(&offset, 1000, 25, 0, 0);
+        check_decode(&offset, 1250, 26, 0, 0);
+        check_decode(&offset, 1500, 26, 0, 0);
+        check_decode(&offset, 1750, 25, 0, 0);
+        check_decode(&offset, 2000, 25, 1, 0);
+        UNSIGNED_LONGS_EQUAL(length, offset);
+}
+
+TEST(run_trace_codec, edge_values_round_trip)
+{
+        size_t offset = 0;
+
+        encode(UINT32_MAX, UINT16_MAX, 0xFF, 0xFF);
+        encode(0, 0, 0, 0);
+        encode(0x80000000, UINT16_MAX, 2, 7);
+        encode(0x80000001, 1, 2, 7);
+        encode(5, 2, 2, 8);
+
+        check_decode(&offset, UINT32_MAX, UINT16_MAX, 0xFF, 0xFF);
+        check_decode(&offset, 0, 0, 0, 0);
+        check_decode(&offset, 0x80000000, UINT16_MAX, 2, 7);
+        check_decode(&offset, 0x80000001, 1, 2, 7);
+        check_decode(&offset, 5, 2, 2, 8);
+        UNSIGNED_LONGS_EQUAL(length, offset);
+        CHECK_TRUE(length <= (5 * RUN_TRACE_CODEC_SAMPLE_SIZE_MAX));
+}
+
+TEST(run_trace_codec, cut_samples_are_rejected_and_leave_the_decoder)
+{
+        run_trace_codec_sample_t sample;
+        size_t consumed = 0;
+        size_t offset = 0;
+        size_t cut;
+        bool is_decoded;
+
+        encode(100, 300, 0, 0);
+        encode(400, 320, 1, 2);
+
+        // Whatever the cut, both samples can't be read
+        for (cut = 0; length > cut; cut++) {
+                CHECK_TRUE(run_trace_codec_reset(&decoder));
+                is_decoded = run_trace_codec_decode(&decoder, buffer, cut,
+                                                    &sample, &consumed);
+
+                if (is_decoded) {
+                        is_decoded = run_trace_codec_decode(&decoder,
+                                                            &buffer[consumed],
+                                                            cut - consumed,
+                                                            &sample, &consumed);
+                }
+
+                CHECK_FALSE(is_decoded);
+        }
+
+        // A failed decode doesn't move the decoder on
+        CHECK_TRUE(run_trace_codec_reset(&decoder));
+        check_decode(&offset, 100, 300, 0, 0);
+        CHECK_FALSE(run_trace_codec_decode(&decoder, &buffer[offset], 1,
+                                           &sample, &consumed));
+        check_decode(&offset, 400, 320, 1, 2);
+}
+
+TEST(run_trace_codec, malformed_input_is_rejected)
+{
+        run_trace_codec_sample_t sample;
+        uint8_t const too_long[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00};
+        uint8_t const too_large[] = {0x80, 0x80, 0x80, 0x80, 0x10, 0x00};
+        uint8_t const below_zero[] = {0x02, 0x00};
+        size_t consumed = 0;
+
+        CHECK_FALSE(run_trace_codec_decode(&decoder, too_long, sizeof(too_long),
+                                           &sample, &consumed));
+        CHECK_FALSE(run_trace_codec_decode(&decoder, too_large, sizeof(too_large),
+                                           &sample, &consumed));
+        CHECK_FALSE(run_trace_codec_decode(&decoder, below_zero,
+                                           sizeof(below_zero), &sample,
+                                           &consumed));
+}
+
+TEST(run_trace_codec, small_buffer_leaves_the_encoder)
+{
+        run_trace_codec_sample_t const sample = {1000, 200, 1, 1};
+        size_t written = 0;
+        size_t offset = 0;
+
+        CHECK_FALSE(run_trace_codec_encode(&encoder, &sample, buffer, 3,
+                                           &written));
+        CHECK_FALSE(run_trace_codec_encode(NULL, &sample, buffer,
+                                           sizeof(buffer), &written));
+
+        encode(1000, 200, 1, 1);
+        check_decode(&offset, 1000, 200, 1, 1);
+}
+
+TEST_GROUP(run_trace_codec_simulation)
+{
+        TaskFunction_t task_function;
+        std::vector<run_trace_codec_sample_t> samples;
+        uint32_t now_ms;
+
+        void setup()
+        {
+                gpio_spy_init();
+                queue_spy_create();
+                oven_plant_fake_init(25.0f);
+                (void)heater_init((heater_temp_getter_t)thermocouple_fake_get_temperature);
+                task_spy_get_task_function(&task_function);
+                now_ms = 0;
+        }
+
+        void teardown()
+        {
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_deinit());
+                queue_spy_destroy();
+                gpio_spy_deinit();
+        }
+
+        void step(uint8_t const phase, uint8_t const segment)
+        {
+                run_trace_codec_sample_t sample;
+
+                if (0 == (now_ms % HEATER_TASK_PERIOD_MS)) {
+                        task_function(NULL);
+                }
+
+                if (0 == (now_ms % SAMPLE_PERIOD_MS)) {
+                        sample.time_ms = now_ms;
+                        (void)thermocouple_fake_get_temperature(&sample.temperature);
+                        sample.phase = phase;
+                        sample.segment = segment;
+                        samples.push_back(sample);
+                }
+
+                oven_plant_fake_step(SIMULATION_STEP_MS);
+                now_ms += SIMULATION_STEP_MS;
+        }
+
+        // Ramp to a target and hold it, through the heater controller
+        void run_segment(uint8_t const segment,
+                         uint16_t const target,
+                         uint32_t const hold_ms)
+        {
+                uint32_t hold_end_ms;
+
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_set_target(target));
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+
+                while (oven_plant_fake_get_temperature() < target) {
+                        step(0, segment);
+                }
+
+                hold_end_ms = now_ms + hold_ms;
+
+                while (now_ms < hold_end_ms) {
+                        step(1, segment);
+                }
+        }
+
+        // Encode the samples one after the other, as the run log does
+        size_t encode_run(run_trace_codec_t * const p_codec,
+                          std::vector<uint8_t> & encoded)
+        {
+                size_t written = 0;
+                size_t offset = 0;
+                size_t i;
+
+                (void)run_trace_codec_reset(p_codec);
+
+                for (i = 0; samples.size() > i; i++) {
+                        (void)run_trace_codec_encode(p_codec, &samples[i],
+                                                     &encoded[offset],
+                                                     encoded.size() - offset,
+                                                     &written);
+                        offset += written;
+                }
+
+                return offset;
+        }
+
+        // Soak and reflow of a lead free profile, then two minutes cooling
+        void simulate_run(void)
+        {
+                uint32_t cooling_end_ms;
+
+                run_segment(0, 150, 90000);
+                run_segment(1, 245, 20000);
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_stop());
+
+                cooling_end_ms = now_ms + 120000;
+
+                while (now_ms < cooling_end_ms) {
+                        step(2, 2);
+                }
+        }
+};
+
+TEST(run_trace_codec_simulation, run_round_trips_in_a_third_of_the_size)
+{
+        std::vector<uint8_t> encoded;
+        run_trace_codec_t codec;
+        run_trace_codec_sample_t sample;
+        size_t written = 0;
+        size_t offset = 0;
+        size_t size;
+        size_t i;
+
+        simulate_run();
+        encoded.resize(samples.size() * RUN_TRACE_CODEC_SAMPLE_SIZE_MAX);
+        size = encode_run(&codec, encoded);
+
+        CHECK_TRUE(run_trace_codec_reset(&codec));
+
+        for (i = 0; samples.size() > i; i++) {
+                CHECK_TRUE(run_trace_codec_decode(&codec, &encoded[offset],
+                                                  size - offset,
+                                                  &sample, &written));
+                offset += written;
+
+                UNSIGNED_LONGS_EQUAL(samples[i].time_ms, sample.time_ms);
+                UNSIGNED_LONGS_EQUAL(samples[i].temperature, sample.temperature);
+                UNSIGNED_LONGS_EQUAL(samples[i].phase, sample.phase);
+                UNSIGNED_LONGS_EQUAL(samples[i].segment, sample.segment);
+        }
+
+        UNSIGNED_LONGS_EQUAL(size, offset);
+        CHECK_TRUE((3 * size) < (samples.size() * RAW_SAMPLE_SIZE));
+}
+
+#if TESTS_PRINT_BENCHMARKS
+TEST(run_trace_codec_simulation, run_throughput)
+{
+        std::chrono::steady_clock::time_point start;
+        std::vector<uint8_t> encoded;
+        run_trace_codec_t codec;
+        run_trace_codec_sample_t sample;
+        size_t written = 0;
+        size_t offset;
+        size_t size = 0;
+        double encode_s;
+        double decode_s;
+        double raw_mb;
+        uint32_t i;
+        size_t j;
+
+        simulate_run();
+        encoded.resize(samples.size() * RUN_TRACE_CODEC_SAMPLE_SIZE_MAX);
+
+        start = std::chrono::steady_clock::now();
+
+        for (i = 0; BENCHMARK_ITERATIONS > i; i++) {
+                size = encode_run(&codec, encoded);
+        }
+
+        encode_s = elapsed_s(start);
+        start = std::chrono::steady_clock::now();
+
+        for (i = 0; BENCHMARK_ITERATIONS > i; i++) {
+                (void)run_trace_codec_reset(&codec);
+                offset = 0;
+
+                for (j = 0; samples.size() > j; j++) {
+                        (void)run_trace_codec_decode(&codec, &encoded[offset],
+                                                     size - offset,
+                                                     &sample, &written);
+                        offset += written;
+                }
+        }
+
+        decode_s = elapsed_s(start);
+        raw_mb = (double)(samples.size() * RAW_SAMPLE_SIZE * BENCHMARK_ITERATIONS) /
+                 1e6;
+
+        printf("\nbenchmark trace codec, %u samples: %u -> %u bytes (%.2f:1), "
+               "encode %.1f MB/s, decode %.1f MB/s\n",
+               (unsigned int)samples.size(),
+               (unsigned int)(samples.size() * RAW_SAMPLE_SIZE),
+               (unsigned int)size,
+               (double)(samples.size() * RAW_SAMPLE_SIZE) / size,
+               raw_mb / encode_s,
+               raw_mb / decode_s);
+}
+#endif // #if TESTS_PRINT_BENCHMARKS
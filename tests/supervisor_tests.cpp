@@ -0,0 +1,399 @@
+/*!
+ *******************************************************************************
+ * @file supervisor_tests.cpp
+ *
+ * @brief Checks on the safety invariants and on the time it takes to cut the
+ *        heater power once one of them is violated, on a simulated oven
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <chrono>
+
+#include "CppUTest/TestHarness.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "driver/gpio_spy.h"
+
+#include "thermocouple.h"
+#include "thermocouple_fake.h"
+#include "oven_plant_fake.h"
+#include "heater.h"
+#include "supervisor.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+//! @brief Resolution of the simulation
+#define SIMULATION_STEP_MS                  (10)
+
+//! @brief Period of the heater task loop
+#define HEATER_TASK_PERIOD_MS               (100)
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(supervisor_invariants)
+{
+        supervisor_invariants_t invariants;
+        supervisor_limits_t limits;
+        supervisor_sample_t sample;
+
+        void setup()
+        {
+                (void)supervisor_invariants_get_default_limits(&limits);
+                (void)supervisor_invariants_init(&invariants, &limits);
+
+                sample.now_ms = 1000;
+                sample.sample_time_ms = 1000;
+                sample.temperature = 25;
+                sample.is_sample_valid = true;
+                sample.is_heater_on = false;
+        }
+
+        supervisor_violation_t check_at(uint32_t const now_ms,
+                                        uint16_t const temperature)
+        {
+                sample.now_ms = now_ms;
+                sample.sample_time_ms = now_ms;
+                sample.temperature = temperature;
+
+                return supervisor_invariants_check(&invariants, &sample);
+        }
+};
+
+TEST(supervisor_invariants, normal_sample_holds)
+{
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(2000, 150));
+}
+
+TEST(supervisor_invariants, invalid_sample_is_stale_sensor)
+{
+        sample.is_sample_valid = false;
+
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_STALE_SENSOR,
+                        supervisor_invariants_check(&invariants, &sample));
+}
+
+TEST(supervisor_invariants, old_sample_is_stale_sensor)
+{
+        sample.now_ms = sample.sample_time_ms + SUPERVISOR_MAX_SAMPLE_AGE_MS + 1;
+
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_STALE_SENSOR,
+                        supervisor_invariants_check(&invariants, &sample));
+}
+
+TEST(supervisor_invariants, over_temperature)
+{
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_OVER_TEMPERATURE,
+                        check_at(2000, SUPERVISOR_MAX_TEMPERATURE_C + 1));
+}
+
+TEST(supervisor_invariants, time_above_liquidus_within_limit_holds)
+{
+        uint16_t const temperature = SUPERVISOR_LIQUIDUS_TEMPERATURE_C + 10;
+
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(10000, temperature));
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE,
+                        check_at(10000 + SUPERVISOR_MAX_TIME_ABOVE_LIQUIDUS_MS,
+                                 temperature));
+}
+
+TEST(supervisor_invariants, time_above_liquidus_exceeded)
+{
+        uint16_t const temperature = SUPERVISOR_LIQUIDUS_TEMPERATURE_C + 10;
+
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(10000, temperature));
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_TIME_ABOVE_LIQUIDUS,
+                        check_at(10001 + SUPERVISOR_MAX_TIME_ABOVE_LIQUIDUS_MS,
+                                 temperature));
+}
+
+TEST(supervisor_invariants, dropping_below_liquidus_restarts_count)
+{
+        uint16_t const temperature = SUPERVISOR_LIQUIDUS_TEMPERATURE_C + 10;
+
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(10000, temperature));
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(100000, 200));
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(101000, temperature));
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE,
+                        check_at(101000 + SUPERVISOR_MAX_TIME_ABOVE_LIQUIDUS_MS,
+                                 temperature));
+}
+
+TEST(supervisor_invariants, heater_on_without_rise)
+{
+        sample.is_heater_on = true;
+
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(10000, 100));
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NO_TEMPERATURE_RISE,
+                        check_at(10000 + SUPERVISOR_HEATER_ON_WINDOW_MS,
+                                 100 + SUPERVISOR_HEATER_ON_MIN_RISE_C - 1));
+}
+
+TEST(supervisor_invariants, heater_on_with_rise_holds)
+{
+        sample.is_heater_on = true;
+
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(10000, 100));
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE,
+                        check_at(10000 + SUPERVISOR_HEATER_ON_WINDOW_MS,
+                                 100 + SUPERVISOR_HEATER_ON_MIN_RISE_C));
+}
+
+TEST(supervisor_invariants, heater_toggling_holds)
+{
+        uint32_t now_ms;
+
+        for (now_ms = 10000; now_ms < 200000; now_ms += 1000) {
+                sample.is_heater_on = (0 == ((now_ms / 1000) % 2));
+                ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NONE, check_at(now_ms, 150));
+        }
+}
+
+TEST_GROUP(supervisor_simulation)
+{
+        TaskFunction_t task_function;
+        supervisor_invariants_t invariants;
+        supervisor_limits_t limits;
+        uint32_t now_ms;
+
+        void setup()
+        {
+                gpio_spy_init();
+                queue_spy_create();
+                oven_plant_fake_init(25.0f);
+                (void)heater_init((heater_temp_getter_t)thermocouple_fake_get_temperature);
+                task_spy_get_task_function(&task_function);
+                (void)supervisor_invariants_get_default_limits(&limits);
+                now_ms = 0;
+        }
+
+        void teardown()
+        {
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_deinit());
+                queue_spy_destroy();
+                gpio_spy_deinit();
+        }
+
+        // Same as the supervisor task does on every period
+        supervisor_violation_t supervise(void)
+        {
+                supervisor_sample_t sample;
+                supervisor_violation_t violation;
+
+                sample.now_ms = now_ms;
+                sample.sample_time_ms = now_ms;
+                sample.is_heater_on = heater_is_powered();
+                sample.is_sample_valid = thermocouple_fake_get_temperature(
+                                &sample.temperature);
+
+                violation = supervisor_invariants_check(&invariants, &sample);
+
+                if (SUPERVISOR_VIOLATION_NONE != violation) {
+                        heater_emergency_stop();
+                }
+
+                return violation;
+        }
+
+        void step(void)
+        {
+                if (0 == (now_ms % HEATER_TASK_PERIOD_MS)) {
+                        task_function(NULL);
+                }
+
+                oven_plant_fake_step(SIMULATION_STEP_MS);
+                now_ms += SIMULATION_STEP_MS;
+        }
+
+        bool is_gpio_high(void)
+        {
+                uint32_t level = 0;
+
+                (void)gpio_spy_get_pin_level(
+                                (gpio_num_t)HEATER_ACTIVE_HIGH_GPIO_PIN, &level);
+
+                return (0 != level);
+        }
+};
+
+TEST(supervisor_simulation, runaway_power_is_cut_within_one_period)
+{
+        uint16_t const limit = 150;
+        uint32_t onset_ms = UINT32_MAX;
+        uint32_t cut_ms = UINT32_MAX;
+        uint16_t temperature;
+
+        limits.max_temperature = limit;
+        CHECK_TRUE(supervisor_invariants_init(&invariants, &limits));
+
+        // Controller target beyond the safe limit, as a runaway would
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_set_target(250));
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+
+        while ((UINT32_MAX == cut_ms) && (now_ms < 600000)) {
+                step();
+
+                (void)thermocouple_fake_get_temperature(&temperature);
+
+                if ((UINT32_MAX == onset_ms) && (limit < temperature)) {
+                        onset_ms = now_ms;
+                }
+
+                if ((0 == (now_ms % SUPERVISOR_PERIOD_MS)) &&
+                    (SUPERVISOR_VIOLATION_OVER_TEMPERATURE == supervise())) {
+                        cut_ms = now_ms;
+                }
+        }
+
+        CHECK_TRUE(UINT32_MAX != onset_ms);
+        CHECK_FALSE(is_gpio_high());
+        CHECK_TRUE((cut_ms - onset_ms) <= SUPERVISOR_PERIOD_MS);
+
+        // Heater task can't power the heater back on after the cut
+        for (uint32_t i = 0; i < 1000; i++) {
+                step();
+                CHECK_FALSE(is_gpio_high());
+        }
+}
+
+TEST(supervisor_simulation, power_cut_is_within_latency_budget)
+{
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+        int64_t worst_us = 0;
+        int64_t elapsed_us;
+
+        CHECK_TRUE(supervisor_invariants_init(&invariants, &limits));
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_set_target(250));
+
+        for (uint32_t i = 0; i < 100; i++) {
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_rearm());
+                ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+                task_function(NULL);
+                CHECK_TRUE(is_gpio_high());
+
+                start = std::chrono::steady_clock::now();
+                heater_emergency_stop();
+                end = std::chrono::steady_clock::now();
+
+                CHECK_FALSE(is_gpio_high());
+
+                elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                end - start).count();
+
+                if (elapsed_us > worst_us) {
+                        worst_us = elapsed_us;
+                }
+        }
+
+        CHECK_TRUE(worst_us <= SUPERVISOR_CUT_LATENCY_BUDGET_US);
+}
+
+TEST(supervisor_simulation, power_cut_is_kept_until_rearmed)
+{
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_set_target(250));
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+        task_function(NULL);
+        CHECK_TRUE(is_gpio_high());
+
+        heater_emergency_stop();
+
+        // The run being cut starts the heater control again on its next state
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+        task_function(NULL);
+        CHECK_FALSE(is_gpio_high());
+
+        // Only a new run powers it again
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_rearm());
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+        task_function(NULL);
+        CHECK_TRUE(is_gpio_high());
+}
+
+TEST(supervisor_simulation, broken_heater_is_detected)
+{
+        supervisor_violation_t violation = SUPERVISOR_VIOLATION_NONE;
+
+        CHECK_TRUE(supervisor_invariants_init(&invariants, &limits));
+        oven_plant_fake_set_heater_broken(true);
+
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_set_target(200));
+        ENUMS_EQUAL_INT(HEATER_ERROR_SUCCESS, heater_start());
+
+        while ((SUPERVISOR_VIOLATION_NONE == violation) && (now_ms < 600000)) {
+                step();
+
+                if (0 == (now_ms % SUPERVISOR_PERIOD_MS)) {
+                        violation = supervise();
+                }
+        }
+
+        ENUMS_EQUAL_INT(SUPERVISOR_VIOLATION_NO_TEMPERATURE_RISE, violation);
+        CHECK_TRUE(now_ms <= (SUPERVISOR_HEATER_ON_WINDOW_MS +
+                              HEATER_TASK_PERIOD_MS + SUPERVISOR_PERIOD_MS));
+        CHECK_FALSE(is_gpio_high());
+}
@@ -0,0 +1,292 @@
+/*!
+ *******************************************************************************
+ * @file telemetry_tests.cpp
+ *
+ * @brief Checks on the telemetry frames and the snapshot ring
+ *
+ * @author Raúl Gotor (raulgotor@gmail.com)
+ * @date 18.10.26
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2026 Raúl Gotor
+ * All rights reserved.
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * #include Statements                                                         *
+ *******************************************************************************
+ */
+
+#include <cstring>
+
+#include "CppUTest/TestHarness.h"
+
+#include "telemetry_frame.h"
+#include "telemetry_ring.h"
+
+/*
+ *******************************************************************************
+ * Private Macros                                                              *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Data types                                                                  *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Constants                                                                   *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Prototypes                                                 *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Public Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Static Data Declarations                                                    *
+ *******************************************************************************
+ */
+
+//! @brief Snapshot of a run holding its reflow segment
+static telemetry_snapshot_t const m_snapshot = {
+        513, 98250, 238, 245, 62, 1, 3,
+        TELEMETRY_SNAPSHOT_FLAG_HOLDING | TELEMETRY_SNAPSHOT_FLAG_HEATER_RUNNING,
+        251, 412
+};
+
+/*
+ *******************************************************************************
+ * Public Function Bodies                                                      *
+ *******************************************************************************
+ */
+
+/*
+ *******************************************************************************
+ * Private Function Bodies                                                     *
+ *******************************************************************************
+ */
+
+static void check_snapshot(telemetry_snapshot_t const * const p_expected,
+                           telemetry_snapshot_t const * const p_actual)
+{
+        UNSIGNED_LONGS_EQUAL(p_expected->sequence, p_actual->sequence);
+        UNSIGNED_LONGS_EQUAL(p_expected->time_ms, p_actual->time_ms);
+        UNSIGNED_LONGS_EQUAL(p_expected->temperature, p_actual->temperature);
+        UNSIGNED_LONGS_EQUAL(p_expected->setpoint, p_actual->setpoint);
+        UNSIGNED_LONGS_EQUAL(p_expected->heater_duty, p_actual->heater_duty);
+        UNSIGNED_LONGS_EQUAL(p_expected->state, p_actual->state);
+        UNSIGNED_LONGS_EQUAL(p_expected->segment, p_actual->segment);
+        UNSIGNED_LONGS_EQUAL(p_expected->flags, p_actual->flags);
+        UNSIGNED_LONGS_EQUAL(p_expected->period_ms, p_actual->period_ms);
+        UNSIGNED_LONGS_EQUAL(p_expected->update_us, p_actual->update_us);
+}
+
+/*
+ *******************************************************************************
+ * Interrupt Service Routines / Tasks / Thread Main Functions                  *
+ *******************************************************************************
+ */
+
+TEST_GROUP(telemetry_frame)
+{
+        uint8_t frame[TELEMETRY_FRAME_SIZE_MAX];
+        size_t length;
+        telemetry_snapshot_t decoded;
+
+        void setup()
+        {
+                length = 0;
+                memset(&decoded, 0, sizeof(decoded));
+        }
+
+        void encode(telemetry_snapshot_t const * const p_snapshot)
+        {
+                size_t i;
+
+                CHECK_TRUE(telemetry_frame_encode(p_snapshot, frame,
+                                                  sizeof(frame), &length));
+
+                // Delimited on both sides, and never inside
+                CHECK(2 < length);
+                UNSIGNED_LONGS_EQUAL(TELEMETRY_FRAME_DELIMITER, frame[0]);
+                UNSIGNED_LONGS_EQUAL(TELEMETRY_FRAME_DELIMITER, frame[length - 1]);
+
+                for (i = 1; (length - 1) > i; i++) {
+                        CHECK(TELEMETRY_FRAME_DELIMITER != frame[i]);
+                }
+        }
+
+        bool decode(void)
+        {
+                return telemetry_frame_decode(&frame[1], length - 2, &decoded);
+        }
+};
+
+TEST(telemetry_frame, snapshot_round_trips)
+{
+        encode(&m_snapshot);
+
+        CHECK_TRUE(decode());
+        check_snapshot(&m_snapshot, &decoded);
+}
+
+TEST(telemetry_frame, zeros_are_stuffed)
+{
+        telemetry_snapshot_t snapshot;
+
+        memset(&snapshot, 0, sizeof(snapshot));
+        encode(&snapshot);
+
+        UNSIGNED_LONGS_EQUAL(TELEMETRY_FRAME_SIZE_MAX, length);
+        CHECK_TRUE(decode());
+        check_snapshot(&snapshot, &decoded);
+
+        memset(&snapshot, 0xFF, sizeof(snapshot));
+        encode(&snapshot);
+
+        CHECK_TRUE(decode());
+        check_snapshot(&snapshot, &decoded);
+}
+
+TEST(telemetry_frame, damaged_frames_are_rejected)
+{
+        size_t i;
+
+        encode(&m_snapshot);
+
+        for (i = 1; (length - 1) > i; i++) {
+                frame[i] ^= 0x01;
+                CHECK_FALSE(decode());
+                frame[i] ^= 0x01;
+        }
+
+        // Cut short
+        CHECK_FALSE(telemetry_frame_decode(&frame[1], length - 3, &decoded));
+        CHECK_FALSE(telemetry_frame_decode(&frame[2], length - 3, &decoded));
+
+        CHECK_TRUE(decode());
+}
+
+TEST(telemetry_frame, text_is_not_taken_for_a_frame)
+{
+        char const * const p_text = "I (1234) telemetry.c: Telemetry period set\n";
+
+        CHECK_FALSE(telemetry_frame_decode((uint8_t const *)p_text,
+                                           strlen(p_text),
+                                           &decoded));
+        CHECK_FALSE(telemetry_frame_decode((uint8_t const *)"OK 0\n", 5, &decoded));
+}
+
+TEST(telemetry_frame, invalid_input_fails)
+{
+        CHECK_FALSE(telemetry_frame_encode(NULL, frame, sizeof(frame), &length));
+        CHECK_FALSE(telemetry_frame_encode(&m_snapshot, NULL, sizeof(frame), &length));
+        CHECK_FALSE(telemetry_frame_encode(&m_snapshot, frame, sizeof(frame), NULL));
+        CHECK_FALSE(telemetry_frame_encode(&m_snapshot, frame, sizeof(frame) - 1,
+                                           &length));
+
+        encode(&m_snapshot);
+
+        CHECK_FALSE(telemetry_frame_decode(NULL, length - 2, &decoded));
+        CHECK_FALSE(telemetry_frame_decode(&frame[1], length - 2, NULL));
+        CHECK_FALSE(telemetry_frame_decode(&frame[1], 0, &decoded));
+}
+
+TEST_GROUP(telemetry_ring)
+{
+        telemetry_ring_t ring;
+        telemetry_snapshot_t snapshot;
+
+        void setup()
+        {
+                CHECK_TRUE(telemetry_ring_init(&ring));
+                snapshot = m_snapshot;
+        }
+};
+
+TEST(telemetry_ring, snapshots_come_out_in_order)
+{
+        telemetry_snapshot_t popped;
+        uint16_t next_pushed = 0;
+        uint16_t next_popped = 0;
+        size_t i;
+
+        // Three pushes for every two pops wraps the ring around several times
+        for (i = 0; (4 * TELEMETRY_RING_SIZE) > i; i++) {
+                snapshot.sequence = next_pushed++;
+                CHECK_TRUE(telemetry_ring_push(&ring, &snapshot));
+
+                if (0 != (i % 3)) {
+                        CHECK_TRUE(telemetry_ring_pop(&ring, &popped));
+                        UNSIGNED_LONGS_EQUAL(next_popped++, popped.sequence);
+                }
+
+                if ((TELEMETRY_RING_SIZE - 1) <= (next_pushed - next_popped)) {
+                        while (telemetry_ring_pop(&ring, &popped)) {
+                                UNSIGNED_LONGS_EQUAL(next_popped++, popped.sequence);
+                        }
+                }
+        }
+
+        while (telemetry_ring_pop(&ring, &popped)) {
+                UNSIGNED_LONGS_EQUAL(next_popped++, popped.sequence);
+        }
+
+        UNSIGNED_LONGS_EQUAL(next_pushed, next_popped);
+        check_snapshot(&snapshot, &popped);
+        UNSIGNED_LONGS_EQUAL(0, telemetry_ring_get_dropped_count(&ring));
+}
+
+TEST(telemetry_ring, full_ring_drops_new_snapshots)
+{
+        telemetry_snapshot_t popped;
+        uint16_t i;
+
+        for (i = 0; (TELEMETRY_RING_SIZE + 3) > i; i++) {
+                snapshot.sequence = i;
+                CHECK_EQUAL((TELEMETRY_RING_SIZE > i),
+                            telemetry_ring_push(&ring, &snapshot));
+        }
+
+        UNSIGNED_LONGS_EQUAL(3, telemetry_ring_get_dropped_count(&ring));
+
+        // The queued ones are kept, and room is made by popping
+        CHECK_TRUE(telemetry_ring_pop(&ring, &popped));
+        UNSIGNED_LONGS_EQUAL(0, popped.sequence);
+        CHECK_TRUE(telemetry_ring_push(&ring, &snapshot));
+
+        for (i = 1; TELEMETRY_RING_SIZE > i; i++) {
+                CHECK_TRUE(telemetry_ring_pop(&ring, &popped));
+                UNSIGNED_LONGS_EQUAL(i, popped.sequence);
+        }
+
+        CHECK_TRUE(telemetry_ring_pop(&ring, &popped));
+        UNSIGNED_LONGS_EQUAL(TELEMETRY_RING_SIZE + 2, popped.sequence);
+        CHECK_FALSE(telemetry_ring_pop(&ring, &popped));
+}
+
+TEST(telemetry_ring, invalid_input_fails)
+{
+        CHECK_FALSE(telemetry_ring_init(NULL));
+        CHECK_FALSE(telemetry_ring_push(NULL, &snapshot));
+        CHECK_FALSE(telemetry_ring_push(&ring, NULL));
+        CHECK_FALSE(telemetry_ring_pop(NULL, &snapshot));
+        CHECK_FALSE(telemetry_ring_pop(&ring, NULL));
+        CHECK_FALSE(telemetry_ring_pop(&ring, &snapshot));
+        UNSIGNED_LONGS_EQUAL(0, telemetry_ring_get_dropped_count(NULL));
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Compare the results of the GUI render benchmark against the ones of a
+previous build, and fail on a regression.
+
+The benchmark (tests/gui_host/benchmark/gui_benchmark.c) writes one CSV line
+per scene. Frames and LVGL heap use don't depend on the speed of the host, so
+any increase of them is a regression. Times do, so only an increase over the
+tolerance is, and only on results taken on the same machine.
+
+Usage:
+
+    gui_benchmark > results.csv
+    gui_benchmark_compare.py baseline.csv results.csv -t 25
+"""
+
+import argparse
+import csv
+import sys
+
+EXACT_COLUMNS = ["frames", "mem_max_used_bytes"]
+TIMED_COLUMNS = ["ms_per_frame"]
+
+
+def read_results(path):
+    with open(path, newline="") as results:
+        return {row["scene"]: row for row in csv.DictReader(results)}
+
+
+def compare(baseline, results, tolerance):
+    """Describe the regressions of each scene, an empty list if none"""
+    regressions = []
+
+    for scene, before in baseline.items():
+        after = results.get(scene)
+
+        if after is None:
+            regressions.append("{}: not rendered".format(scene))
+            continue
+
+        for column in EXACT_COLUMNS:
+            if int(after[column]) > int(before[column]):
+                regressions.append("{}: {} {} -> {}".format(
+                    scene, column, before[column], after[column]))
+
+        for column in TIMED_COLUMNS:
+            limit = float(before[column]) * (1 + tolerance / 100)
+
+            if float(after[column]) > limit:
+                regressions.append("{}: {} {} -> {} (+{:.0f}%)".format(
+                    scene, column, before[column], after[column],
+                    (float(after[column]) / float(before[column]) - 1) * 100))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("baseline", help="results of the previous build")
+    parser.add_argument("results", help="results of the build to check")
+    parser.add_argument("-t", "--tolerance", type=float, default=25,
+                        help="increase of the times allowed, in %% (default: 25)")
+    args = parser.parse_args()
+
+    regressions = compare(read_results(args.baseline),
+                          read_results(args.results),
+                          args.tolerance)
+
+    for regression in regressions:
+        print(regression)
+
+    print("{} regressions".format(len(regressions)), file=sys.stderr)
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+Import and export the reflow profiles of the controller over its serial
+console.
+
+Profiles are kept in plain text files, one profile per line, in the format of
+the `PUT` arguments (see main/reflow_profile_serial.c):
+
+    # name,preheat,soak,reflow,dwell,cooling temp,cooling time,ramp
+    Sn60Pb40,170,5,220,5,30,100,10
+
+Usage:
+
+    profile_transfer.py -p /dev/ttyUSB0 export profiles.txt
+    profile_transfer.py -p /dev/ttyUSB0 import profiles.txt
+    profile_transfer.py -p /dev/ttyUSB0 delete Sn60Pb40
+
+Requires pyserial.
+"""
+
+import argparse
+import sys
+import time
+
+import serial
+
+BAUDRATE = 115200
+TIMEOUT_S = 2.0
+HEADER = "# name,preheat,soak,reflow,dwell,cooling temp,cooling time,ramp\n"
+
+
+class ProfileLink:
+    """Requests to the controller, ignoring the log lines around answers"""
+
+    def __init__(self, port):
+        self.serial = serial.Serial(port, BAUDRATE, timeout=TIMEOUT_S)
+        self.serial.reset_input_buffer()
+
+    def send(self, lines):
+        self.serial.write("".join(line + "\n" for line in lines).encode("ascii"))
+
+    def read_answer(self):
+        """Read up to the next status line, return it and the profiles"""
+        profiles = []
+        deadline = time.monotonic() + TIMEOUT_S
+
+        while time.monotonic() < deadline:
+            line = self.serial.readline().decode("ascii", "replace").strip()
+
+            if line.startswith("PROFILE "):
+                profiles.append(line[len("PROFILE "):])
+            elif line.startswith("OK") or line.startswith("ERR"):
+                return line, profiles
+
+        raise TimeoutError("no answer from the controller")
+
+
+def read_profiles(path):
+    with open(path) as profiles_file:
+        lines = [line.strip() for line in profiles_file]
+
+    return [line for line in lines if line and not line.startswith("#")]
+
+
+def export_profiles(link, path):
+    link.send(["LIST"])
+    status, profiles = link.read_answer()
+
+    if not status.startswith("OK"):
+        raise RuntimeError("export failed: " + status)
+
+    with open(path, "w") as profiles_file:
+        profiles_file.write(HEADER)
+        profiles_file.writelines(profile + "\n" for profile in profiles)
+
+    return len(profiles)
+
+
+def import_profiles(link, path):
+    profiles = read_profiles(path)
+    failed = 0
+
+    # Requests are pipelined, the controller queues a whole catalogue
+    link.send(["PUT " + profile for profile in profiles] + ["SYNC"])
+
+    for profile in profiles:
+        status, _ = link.read_answer()
+
+        if not status.startswith("OK"):
+            failed += 1
+            print("{}: {}".format(profile.split(",")[0], status),
+                  file=sys.stderr)
+
+    status, _ = link.read_answer()
+
+    if not status.startswith("OK"):
+        raise RuntimeError("writing to NVS failed: " + status)
+
+    return len(profiles) - failed, failed
+
+
+def delete_profile(link, name):
+    link.send(["DEL " + name, "SYNC"])
+
+    for _ in range(2):
+        status, _ = link.read_answer()
+
+        if not status.startswith("OK"):
+            raise RuntimeError("delete failed: " + status)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("-p", "--port", required=True,
+                        help="serial port of the controller")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+    subparsers.add_parser("export").add_argument("file")
+    subparsers.add_parser("import").add_argument("file")
+    subparsers.add_parser("delete").add_argument("name")
+    args = parser.parse_args()
+
+    link = ProfileLink(args.port)
+    start = time.monotonic()
+
+    if "export" == args.command:
+        count = export_profiles(link, args.file)
+        print("{} profiles exported".format(count))
+    elif "import" == args.command:
+        count, failed = import_profiles(link, args.file)
+        print("{} profiles imported, {} rejected".format(count, failed))
+    else:
+        delete_profile(link, args.name)
+        print("{} deleted".format(args.name))
+
+    print("took {:.2f} s".format(time.monotonic() - start))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
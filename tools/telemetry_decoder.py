@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""
+Decode the binary telemetry stream of the controller into CSV, for live
+plotting or later analysis.
+
+The stream is started with the `TELEMETRY <period in ms>` console request and
+stopped on exit. Frames are byte stuffed with COBS, delimited by 0x00 and
+checked with a CRC-16 (see main/telemetry_frame.c). Everything else on the
+console, such as log lines and answers, is skipped.
+
+Usage:
+
+    telemetry_decoder.py -p /dev/ttyUSB0 -r 250 > run.csv
+    telemetry_decoder.py -i capture.bin > run.csv
+
+Requires pyserial to read from the controller.
+"""
+
+import argparse
+import struct
+import sys
+
+BAUDRATE = 115200
+READ_SIZE = 256
+FRAME_TYPE_SNAPSHOT = 1
+SNAPSHOT_FORMAT = "<BHIHHBBBBHH"
+CRC_FORMAT = "<H"
+STATES = ["idle", "segment", "cooling", "paused", "error"]
+FLAGS = [(1 << 0, "holding"), (1 << 1, "heater running"), (1 << 2, "heater powered")]
+COLUMNS = ["sequence", "time_ms", "temperature", "setpoint", "heater_duty",
+           "state", "segment", "flags", "period_ms", "update_us"]
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as byte_codec_crc16"""
+    crc = 0xFFFF
+
+    for byte in data:
+        crc ^= byte << 8
+
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+
+    return crc
+
+
+def cobs_decode(data):
+    """Undo the COBS byte stuffing of a frame, None if it isn't valid"""
+    output = bytearray()
+    i = 0
+
+    while i < len(data):
+        code = data[i]
+        i += 1
+
+        if 0 == code or i + code - 1 > len(data):
+            return None
+
+        output += data[i:i + code - 1]
+        i += code - 1
+
+        if 0xFF != code and i < len(data):
+            output.append(0)
+
+    return bytes(output)
+
+
+def decode_frame(data):
+    """Decode the bytes between two delimiters, None if not a snapshot"""
+    raw = cobs_decode(data)
+    payload_size = struct.calcsize(SNAPSHOT_FORMAT)
+
+    if raw is None or payload_size + struct.calcsize(CRC_FORMAT) != len(raw):
+        return None
+
+    payload = raw[:payload_size]
+    (crc,) = struct.unpack(CRC_FORMAT, raw[payload_size:])
+
+    if crc != crc16(payload) or FRAME_TYPE_SNAPSHOT != payload[0]:
+        return None
+
+    return dict(zip(COLUMNS, struct.unpack(SNAPSHOT_FORMAT, payload)[1:]))
+
+
+class StreamDecoder:
+    """Split the received bytes into frames, counting bad and lost ones"""
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.frame_count = 0
+        self.lost_count = 0
+        self.next_sequence = None
+
+    def feed(self, data):
+        self.pending += data
+        *chunks, self.pending = self.pending.split(b"\x00")
+        snapshots = []
+
+        # Text between frames and damaged frames fail to decode alike
+        for chunk in chunks:
+            snapshot = decode_frame(chunk) if chunk else None
+
+            if snapshot is None:
+                continue
+
+            if self.next_sequence is not None:
+                self.lost_count += (snapshot["sequence"] - self.next_sequence) & 0xFFFF
+
+            self.next_sequence = (snapshot["sequence"] + 1) & 0xFFFF
+            self.frame_count += 1
+            snapshots.append(snapshot)
+
+        return snapshots
+
+
+def format_row(snapshot):
+    row = dict(snapshot)
+    state = snapshot["state"]
+    row["state"] = STATES[state] if state < len(STATES) else str(state)
+    row["segment"] = "" if 0xFF == snapshot["segment"] else snapshot["segment"]
+    row["flags"] = "|".join(name for bit, name in FLAGS if snapshot["flags"] & bit)
+
+    return ",".join(str(row[column]) for column in COLUMNS)
+
+
+def read_port(port, period_ms):
+    import serial
+
+    link = serial.Serial(port, BAUDRATE, timeout=0.1)
+    link.reset_input_buffer()
+    link.write("TELEMETRY {}\n".format(period_ms).encode("ascii"))
+
+    try:
+        while True:
+            yield link.read(READ_SIZE)
+    finally:
+        link.write(b"TELEMETRY 0\n")
+        link.close()
+
+
+def read_file(path):
+    with open(path, "rb") as capture:
+        while True:
+            data = capture.read(READ_SIZE)
+
+            if not data:
+                return
+
+            yield data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("-p", "--port", help="serial port of the controller")
+    source.add_argument("-i", "--input", help="raw capture of the console")
+    parser.add_argument("-r", "--period", type=int, default=250,
+                        help="period of the stream in ms (default: 250)")
+    args = parser.parse_args()
+
+    decoder = StreamDecoder()
+    chunks = read_port(args.port, args.period) if args.port else read_file(args.input)
+
+    print(",".join(COLUMNS), flush=True)
+
+    try:
+        for data in chunks:
+            for snapshot in decoder.feed(data):
+                print(format_row(snapshot), flush=True)
+    except KeyboardInterrupt:
+        pass
+
+    print("{} snapshots, {} lost".format(decoder.frame_count, decoder.lost_count),
+          file=sys.stderr)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())